@@ -0,0 +1,129 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#include <toolbox/crc.h>
+
+#define CRC_TEST_FRAME_SIZE        (18U)
+#define CRC_TEST_FRAME_ITERATIONS  (1000U)
+#define CRC_TEST_CHUNK_SIZE        (512U)
+#define CRC_TEST_CHUNK_ITERATIONS  (100U)
+#define CRC_TEST_STREAM_ITERATIONS (200U)
+
+static const char* const crc_test_algorithm_names[CrcAlgorithmNum] = {
+    [CrcAlgorithmIso14443A] = "ISO14443-3A",
+    [CrcAlgorithmIso14443B] = "ISO14443-3B",
+    [CrcAlgorithmPicopass] = "Picopass",
+    [CrcAlgorithmFelica] = "FeliCa",
+    [CrcAlgorithmCrc32] = "CRC32",
+};
+
+MU_TEST(crc_test_check_values) {
+    // Check values, "123456789"
+    static const uint8_t check_data[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    mu_assert_int_eq(0xBF05, crc_calculate(CrcAlgorithmIso14443A, check_data, 9));
+    mu_assert_int_eq(0x906E, crc_calculate(CrcAlgorithmIso14443B, check_data, 9));
+    mu_assert_int_eq(0x31C3, crc_calculate(CrcAlgorithmFelica, check_data, 9));
+    mu_assert_int_eq(0xCBF43926, crc_calculate(CrcAlgorithmCrc32, check_data, 9));
+
+    mu_assert_int_eq(0x6363, crc_calculate(CrcAlgorithmIso14443A, check_data, 0));
+    mu_assert_int_eq(0, crc_calculate(CrcAlgorithmCrc32, check_data, 0));
+}
+
+MU_TEST(crc_test_streaming) {
+    uint8_t data[CRC_TEST_CHUNK_SIZE];
+
+    for(size_t i = 0; i < CRC_TEST_STREAM_ITERATIONS; i++) {
+        furi_hal_random_fill_buf(data, sizeof(data));
+        const CrcAlgorithm algorithm = i % CrcAlgorithmNum;
+        const size_t size = furi_hal_random_get() % sizeof(data);
+        const size_t split = size ? furi_hal_random_get() % size : 0;
+        const uint32_t expected = crc_calculate(algorithm, data, size);
+
+        // Any split and any backend must give the same result
+        CrcContext context;
+        crc_init(&context, algorithm, i & 1 ? CrcBackendHardware : CrcBackendSoftware);
+        crc_update(&context, data, split);
+        crc_update(&context, &data[split], size - split);
+        mu_assert_int_eq(expected, crc_finish(&context));
+
+        // Resume from a finished CRC continues the calculation
+        crc_init(&context, algorithm, CrcBackendSoftware);
+        crc_update(&context, data, split);
+        crc_resume(&context, algorithm, CrcBackendSoftware, crc_finish(&context));
+        crc_update(&context, &data[split], size - split);
+        mu_assert_int_eq(expected, crc_finish(&context));
+    }
+}
+
+static void crc_test_report(const char* name, uint64_t cycles, size_t count) {
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    const uint32_t buffer_cycles = cycles / count;
+
+    printf(
+        "  %s: %lu cycles, %lu.%02lu us per buffer\r\n",
+        name,
+        buffer_cycles,
+        buffer_cycles / cycles_per_us,
+        buffer_cycles % cycles_per_us * 100 / cycles_per_us);
+}
+
+static bool crc_test_bench_run(CrcAlgorithm algorithm, uint8_t* data, size_t size, size_t count) {
+    uint64_t cycles_software = 0;
+    uint64_t cycles_hardware = 0;
+    bool success = true;
+
+    for(size_t i = 0; i < count; i++) {
+        furi_hal_random_fill_buf(data, size);
+
+        uint32_t cycles = DWT->CYCCNT;
+        const uint32_t crc_software = crc_calculate(algorithm, data, size);
+        cycles_software += DWT->CYCCNT - cycles;
+
+        cycles = DWT->CYCCNT;
+        CrcContext context;
+        crc_init(&context, algorithm, CrcBackendHardware);
+        crc_update(&context, data, size);
+        const uint32_t crc_hardware = crc_finish(&context);
+        cycles_hardware += DWT->CYCCNT - cycles;
+
+        success &= crc_software == crc_hardware;
+    }
+
+    crc_test_report("Software", cycles_software, count);
+    crc_test_report("Hardware", cycles_hardware, count);
+
+    return success;
+}
+
+MU_TEST(crc_test_backend_bench) {
+    uint8_t* data = malloc(CRC_TEST_CHUNK_SIZE);
+    bool success = true;
+
+    for(size_t i = 0; i < CrcAlgorithmNum; i++) {
+        printf("%s CRC, %u byte frame:\r\n", crc_test_algorithm_names[i], CRC_TEST_FRAME_SIZE);
+        success &= crc_test_bench_run(i, data, CRC_TEST_FRAME_SIZE, CRC_TEST_FRAME_ITERATIONS);
+    }
+
+    printf("CRC32, %u byte file chunk:\r\n", CRC_TEST_CHUNK_SIZE);
+    success &= crc_test_bench_run(
+        CrcAlgorithmCrc32, data, CRC_TEST_CHUNK_SIZE, CRC_TEST_CHUNK_ITERATIONS);
+
+    free(data);
+
+    mu_assert(success, "CRC backend mismatch");
+}
+
+MU_TEST_SUITE(test_crc_suite) {
+    MU_RUN_TEST(crc_test_check_values);
+    MU_RUN_TEST(crc_test_streaming);
+    MU_RUN_TEST(crc_test_backend_bench);
+}
+
+int run_minunit_test_crc(void) {
+    MU_RUN_SUITE(test_crc_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_crc)
@@ -1,4 +1,5 @@
 #include <furi.h>
+#include <furi_hal.h>
 #include <flipper_format.h>
 #include <infrared.h>
 #include <common/infrared_common_i.h>
@@ -8,6 +9,13 @@
 #define IR_TEST_FILE_PREFIX "test_"
 #define IR_TEST_FILE_SUFFIX ".irtest"
 
+#define IR_BENCH_FILES_DIR   EXT_PATH("infrared/assets/")
+#define IR_BENCH_TIMINGS_MAX (1024U)
+#define IR_BENCH_ITERATIONS  (4U)
+#define IR_BENCH_FRAMES      (3U)
+
+#define TAG "InfraredTest"
+
 typedef struct {
     InfraredDecoderHandler* decoder_handler;
     InfraredEncoderHandler* encoder_handler;
@@ -523,6 +531,189 @@ MU_TEST(infrared_test_encoder_decoder_all) {
     infrared_test_run_encoder_decoder(InfraredProtocolPioneer, 1);
 }
 
+typedef struct {
+    uint32_t signal_count;
+    uint32_t message_count;
+    uint32_t timings_count;
+    uint64_t cycles;
+} InfraredTestBench;
+
+static void infrared_test_bench_callback(const InfraredMessage* message, void* context) {
+    UNUSED(message);
+    uint32_t* message_count = context;
+    ++*message_count;
+}
+
+/* Decodes timings as a whole capture, returns amount of decoded messages */
+static uint32_t infrared_test_bench_decode(
+    InfraredTestBench* bench,
+    const uint32_t* timings,
+    uint32_t timings_count) {
+    uint32_t message_count = 0;
+
+    for(uint32_t i = 0; i < IR_BENCH_ITERATIONS; ++i) {
+        uint32_t cycles = DWT->CYCCNT;
+        infrared_decode_timings(
+            test->decoder_handler,
+            timings,
+            timings_count,
+            infrared_test_bench_callback,
+            i ? NULL : &message_count);
+        bench->cycles += DWT->CYCCNT - cycles;
+        infrared_reset_decoder(test->decoder_handler);
+    }
+
+    bench->signal_count++;
+    bench->timings_count += timings_count * IR_BENCH_ITERATIONS;
+    return message_count;
+}
+
+/* Appends the next encoded frame, the capture always starts with a mark */
+static void infrared_test_bench_encode_frame(uint32_t* timings, uint32_t* timings_count) {
+    bool start_level;
+    uint32_t* frame = timings + *timings_count;
+    uint32_t frame_count = IR_BENCH_TIMINGS_MAX - *timings_count;
+    infrared_test_run_encoder_fill_array(test->encoder_handler, frame, &frame_count, &start_level);
+
+    if(start_level != !(*timings_count % 2)) {
+        /* Leading silence is skipped as receiver does, gap between frames is joined */
+        if(*timings_count) timings[*timings_count - 1] += frame[0];
+        memmove(frame, frame + 1, sizeof(uint32_t) * (frame_count - 1));
+        --frame_count;
+    }
+
+    *timings_count += frame_count;
+}
+
+/* Returns NULL on success or the failure message, the file is closed either way */
+static const char* infrared_test_bench_file(
+    const char* file_name,
+    InfraredTestBench* parsed,
+    InfraredTestBench* repeated,
+    InfraredTestBench* raw) {
+    FuriString* buf = furi_string_alloc();
+    uint32_t* timings = malloc(sizeof(uint32_t) * IR_BENCH_TIMINGS_MAX);
+    const char* error = NULL;
+
+    furi_string_printf(test->file_path, "%s%s", IR_BENCH_FILES_DIR, file_name);
+
+    do {
+        uint32_t format_version;
+        if(!flipper_format_buffered_file_open_existing(
+               test->ff, furi_string_get_cstr(test->file_path))) {
+            FURI_LOG_W(TAG, "Skipping %s: no such file", file_name);
+            break;
+        }
+        if(!flipper_format_read_header(test->ff, buf, &format_version) ||
+           furi_string_cmp_str(buf, "IR library file")) {
+            error = "Invalid library file";
+        }
+
+        while(!error && flipper_format_read_string(test->ff, "name", buf)) {
+            if(!flipper_format_read_string(test->ff, "type", buf)) {
+                error = "Signal without type";
+            } else if(!furi_string_cmp_str(buf, "parsed")) {
+                InfraredMessage message = {0};
+                if(!flipper_format_read_string(test->ff, "protocol", buf) ||
+                   !flipper_format_read_hex(
+                       test->ff, "address", (uint8_t*)&message.address, sizeof(uint32_t)) ||
+                   !flipper_format_read_hex(
+                       test->ff, "command", (uint8_t*)&message.command, sizeof(uint32_t))) {
+                    error = "Invalid parsed signal";
+                    break;
+                }
+                message.protocol = infrared_get_protocol_by_name(furi_string_get_cstr(buf));
+                if(!infrared_is_protocol_valid(message.protocol)) {
+                    error = "Unknown protocol";
+                    break;
+                }
+
+                uint32_t timings_count = 0;
+                infrared_reset_encoder(test->encoder_handler, &message);
+                infrared_test_bench_encode_frame(timings, &timings_count);
+
+                uint32_t message_count =
+                    infrared_test_bench_decode(parsed, timings, timings_count);
+                if(message_count != 1) {
+                    error = "Library signal not decoded";
+                    break;
+                }
+                parsed->message_count += message_count;
+
+                /* Held button: the same frame keeps coming after the first one */
+                for(uint32_t i = 1; i < IR_BENCH_FRAMES; ++i) {
+                    infrared_test_bench_encode_frame(timings, &timings_count);
+                }
+
+                message_count = infrared_test_bench_decode(repeated, timings, timings_count);
+                if(message_count != IR_BENCH_FRAMES) {
+                    error = "Repeated frames not decoded";
+                    break;
+                }
+                repeated->message_count += message_count;
+            } else {
+                uint32_t timings_count;
+                if(!flipper_format_get_value_count(test->ff, "data", &timings_count) ||
+                   timings_count > IR_BENCH_TIMINGS_MAX ||
+                   !flipper_format_read_uint32(test->ff, "data", timings, timings_count)) {
+                    error = "Invalid raw signal";
+                    break;
+                }
+                raw->message_count += infrared_test_bench_decode(raw, timings, timings_count);
+            }
+        }
+
+        flipper_format_buffered_file_close(test->ff);
+    } while(false);
+
+    free(timings);
+    furi_string_free(buf);
+
+    return error;
+}
+
+static void infrared_test_bench_print(const char* name, const InfraredTestBench* bench) {
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    const uint32_t timings_count = MAX(bench->timings_count, 1U);
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu signals, %lu messages, %lu timings, %lu us, %lu cycles per timing",
+        name,
+        bench->signal_count,
+        bench->message_count,
+        bench->timings_count,
+        (uint32_t)(bench->cycles / cycles_per_us),
+        (uint32_t)(bench->cycles / timings_count));
+}
+
+MU_TEST(infrared_test_decoder_benchmark) {
+    static const char* const files[] = {
+        "tv.ir",
+        "ac.ir",
+        "audio.ir",
+        "projectors.ir",
+        "fans.ir",
+        "bluray_dvd.ir",
+        "monitor.ir",
+        "leds.ir",
+        "digital_sign.ir",
+    };
+
+    InfraredTestBench parsed = {0};
+    InfraredTestBench repeated = {0};
+    InfraredTestBench raw = {0};
+
+    for(size_t i = 0; i < COUNT_OF(files); ++i) {
+        const char* error = infrared_test_bench_file(files[i], &parsed, &repeated, &raw);
+        mu_assert(error == NULL, error);
+    }
+
+    infrared_test_bench_print("Parsed", &parsed);
+    infrared_test_bench_print("Repeated", &repeated);
+    infrared_test_bench_print("Raw", &raw);
+}
+
 MU_TEST_SUITE(infrared_test) {
     MU_SUITE_CONFIGURE(&infrared_test_alloc, &infrared_test_free);
 
@@ -543,6 +734,7 @@ MU_TEST_SUITE(infrared_test) {
     MU_RUN_TEST(infrared_test_decoder_pioneer);
     MU_RUN_TEST(infrared_test_decoder_mixed);
     MU_RUN_TEST(infrared_test_encoder_decoder_all);
+    MU_RUN_TEST(infrared_test_decoder_benchmark);
 }
 
 int run_minunit_test_infrared(void) {
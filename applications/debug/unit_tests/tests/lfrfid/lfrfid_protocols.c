@@ -2,10 +2,18 @@
 #include "../test.h" // IWYU pragma: keep
 #include <toolbox/protocols/protocol_dict.h>
 #include <lfrfid/protocols/lfrfid_protocols.h>
+#include <lfrfid/lfrfid_raw_file.h>
+#include <lfrfid/lfrfid_read_scheduler.h>
 #include <toolbox/pulse_protocols/pulse_glue.h>
+#include <toolbox/varint.h>
+#include <storage/storage.h>
 
 #define LF_RFID_READ_TIMING_MULTIPLIER 8
 
+#define LF_RFID_REPLAY_TEST_PATH        EXT_PATH("unit_tests/lfrfid_replay_test.raw")
+#define LF_RFID_REPLAY_TEST_BUFFER_SIZE 512
+#define LF_RFID_REPLAY_TEST_REPEATS     20
+
 #define EM_TEST_DATA                    {0x58, 0x00, 0x85, 0x64, 0x02}
 #define EM_TEST_DATA_SIZE               5
 #define EM_TEST_EMULATION_TIMINGS_COUNT (64 * 2)
@@ -526,6 +534,195 @@ MU_TEST(test_lfrfid_protocol_fdxb_read_simple) {
     protocol_dict_free(dict);
 }
 
+// Capture EM4100 as the raw read does
+static void lfrfid_test_raw_capture_em(
+    Storage* storage,
+    bool compress,
+    size_t* pair_count,
+    size_t* capture_us) {
+    LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+    lfrfid_raw_file_set_compression(file, compress);
+
+    mu_assert(lfrfid_raw_file_open_write(file, LF_RFID_REPLAY_TEST_PATH), "open write failed");
+    mu_assert(
+        lfrfid_raw_file_write_header(file, 125000, 0.5, LF_RFID_REPLAY_TEST_BUFFER_SIZE),
+        "write header failed");
+
+    uint8_t* buffer = malloc(LF_RFID_REPLAY_TEST_BUFFER_SIZE);
+    size_t buffer_size = 0;
+    *pair_count = 0;
+    *capture_us = 0;
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+
+    for(size_t i = 0; i < EM_TEST_EMULATION_TIMINGS_COUNT * LF_RFID_REPLAY_TEST_REPEATS; i++) {
+        bool pulse_pop = pulse_glue_push(
+            pulse_glue,
+            em_test_timings[i % EM_TEST_EMULATION_TIMINGS_COUNT] >= 0,
+            abs(em_test_timings[i % EM_TEST_EMULATION_TIMINGS_COUNT]) *
+                LF_RFID_READ_TIMING_MULTIPLIER);
+
+        if(pulse_pop) {
+            // pulse_glue gives the whole period (high + low) first, then the high pulse
+            uint32_t duration, pulse;
+            pulse_glue_pop(pulse_glue, &duration, &pulse);
+            *capture_us += duration;
+            (*pair_count)++;
+
+            buffer_size += varint_uint32_pack(pulse, &buffer[buffer_size]);
+            buffer_size += varint_uint32_pack(duration, &buffer[buffer_size]);
+
+            if(buffer_size > LF_RFID_REPLAY_TEST_BUFFER_SIZE - 10) {
+                mu_assert(
+                    lfrfid_raw_file_write_buffer(file, buffer, buffer_size),
+                    "write buffer failed");
+                buffer_size = 0;
+            }
+        }
+    }
+
+    if(buffer_size) {
+        mu_assert(lfrfid_raw_file_write_buffer(file, buffer, buffer_size), "write buffer failed");
+    }
+
+    pulse_glue_free(pulse_glue);
+    free(buffer);
+    lfrfid_raw_file_free(file);
+}
+
+MU_TEST(test_lfrfid_raw_file) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    for(size_t compress = 0; compress < 2; compress++) {
+        size_t pair_count, capture_us;
+        lfrfid_test_raw_capture_em(storage, compress, &pair_count, &capture_us);
+
+        LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+        mu_assert(lfrfid_raw_file_open_read(file, LF_RFID_REPLAY_TEST_PATH), "open read failed");
+
+        float frequency, duty_cycle;
+        mu_assert(lfrfid_raw_file_read_header(file, &frequency, &duty_cycle), "bad header");
+        mu_assert_double_eq(125000, frequency);
+        mu_assert_double_eq(0.5, duty_cycle);
+
+        LFRFIDRawFileInfo info;
+        mu_assert(lfrfid_raw_file_get_info(file, &info), "no info");
+        mu_assert_int_eq(2, info.version);
+        mu_assert_int_eq(1000000, info.sample_rate);
+        mu_assert_int_eq(pair_count, info.pair_count);
+        mu_assert_int_eq(capture_us / 1000, info.capture_ms);
+        mu_assert_int_eq(compress, info.compressed);
+        mu_assert(info.indexed, "no index");
+
+        // EM4100 pulses are one or two half bits long
+        uint32_t histogram_pairs = 0;
+        for(size_t i = 0; i < LFRFID_RAW_FILE_HISTOGRAM_SIZE; i++) {
+            histogram_pairs += info.pulse_histogram[i];
+        }
+        mu_assert_int_eq(pair_count, histogram_pairs);
+        mu_assert_int_eq(
+            pair_count,
+            info.pulse_histogram[256 / LFRFID_RAW_FILE_HISTOGRAM_BIN_US] +
+                info.pulse_histogram[512 / LFRFID_RAW_FILE_HISTOGRAM_BIN_US]);
+
+        // whole capture, then wrap around
+        size_t read_us = 0;
+        bool pass_end = false;
+        uint32_t pulse, duration;
+        for(size_t i = 0; i < pair_count; i++) {
+            mu_assert(
+                lfrfid_raw_file_read_pair(file, &duration, &pulse, &pass_end), "read failed");
+            mu_assert(pulse < duration, "bad pair");
+            read_us += duration;
+        }
+        mu_assert(!pass_end, "unexpected end");
+        mu_assert_int_eq(capture_us, read_us);
+        mu_assert(lfrfid_raw_file_read_pair(file, &duration, &pulse, &pass_end), "read failed");
+        mu_assert(pass_end, "no end");
+
+        mu_assert(lfrfid_raw_file_seek(file, info.capture_ms / 2), "seek failed");
+        mu_assert(lfrfid_raw_file_read_pair(file, &duration, &pulse, NULL), "read failed");
+
+        lfrfid_raw_file_free(file);
+    }
+
+    storage_simply_remove(storage, LF_RFID_REPLAY_TEST_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(test_lfrfid_read_scheduler_replay) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    size_t pair_count, capture_us;
+    lfrfid_test_raw_capture_em(storage, false, &pair_count, &capture_us);
+
+    // replay it
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    LFRFIDReadScheduler* scheduler = lfrfid_read_scheduler_alloc();
+    LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+
+    mu_assert(lfrfid_raw_file_open_read(file, LF_RFID_REPLAY_TEST_PATH), "open read failed");
+    ProtocolId protocol = lfrfid_read_scheduler_replay(scheduler, dict, file);
+
+    mu_assert_int_eq(LFRFIDProtocolEM4100, protocol);
+    const uint8_t data[EM_TEST_DATA_SIZE] = EM_TEST_DATA;
+    uint8_t received_data[EM_TEST_DATA_SIZE] = {0};
+    protocol_dict_get_data(dict, protocol, received_data, EM_TEST_DATA_SIZE);
+    mu_assert_mem_eq(data, received_data, EM_TEST_DATA_SIZE);
+
+    LFRFIDReadSchedulerStats stats;
+    lfrfid_read_scheduler_get_stats(scheduler, LFRFIDFeatureASK, &stats);
+    mu_assert_int_eq(1, stats.phase_count);
+    mu_assert_int_eq(1, stats.lock_count);
+    mu_assert_int_eq(0, stats.mismatch_count);
+    mu_assert_int_eq(1, stats.decode_count);
+    mu_assert(stats.first_decode_us > 0, "first decode time not recorded");
+    mu_assert(stats.first_decode_us < capture_us, "first decode time out of capture");
+    mu_assert_int_eq(LFRFIDFeatureASK, lfrfid_read_scheduler_get_feature(scheduler));
+
+    lfrfid_read_scheduler_get_stats(scheduler, LFRFIDFeaturePSK, &stats);
+    mu_assert_int_eq(0, stats.phase_count);
+
+    lfrfid_raw_file_free(file);
+    lfrfid_read_scheduler_free(scheduler);
+    protocol_dict_free(dict);
+
+    storage_simply_remove(storage, LF_RFID_REPLAY_TEST_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(test_lfrfid_read_scheduler_mismatch) {
+    LFRFIDReadScheduler* scheduler = lfrfid_read_scheduler_alloc();
+    mu_assert_int_eq(LFRFIDFeatureASK, lfrfid_read_scheduler_get_feature(scheduler));
+
+    // card in the field, but no timing peaks: other family
+    lfrfid_read_scheduler_phase_start(scheduler, LFRFIDFeatureASK);
+    uint32_t seed = 1;
+    for(size_t i = 0; i < 512; i++) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t duration = 40 + (seed >> 16) % 900;
+        lfrfid_read_scheduler_feed(scheduler, duration / 2, duration);
+    }
+    mu_assert_int_eq(
+        LFRFIDReadSchedulerVerdictMismatch, lfrfid_read_scheduler_get_verdict(scheduler));
+    lfrfid_read_scheduler_phase_end(scheduler);
+    mu_assert_int_eq(LFRFIDFeaturePSK, lfrfid_read_scheduler_get_feature(scheduler));
+
+    // no card in the field
+    lfrfid_read_scheduler_phase_start(scheduler, LFRFIDFeaturePSK);
+    for(size_t i = 0; i < 512; i++) {
+        lfrfid_read_scheduler_feed(scheduler, 20, 1000);
+    }
+    mu_assert_int_eq(LFRFIDReadSchedulerVerdictIdle, lfrfid_read_scheduler_get_verdict(scheduler));
+    lfrfid_read_scheduler_phase_end(scheduler);
+    mu_assert_int_eq(LFRFIDFeaturePSK, lfrfid_read_scheduler_get_feature(scheduler));
+
+    LFRFIDReadSchedulerStats stats;
+    lfrfid_read_scheduler_get_stats(scheduler, LFRFIDFeatureASK, &stats);
+    mu_assert_int_eq(1, stats.mismatch_count);
+    mu_assert_int_eq(0, stats.decode_count);
+
+    lfrfid_read_scheduler_free(scheduler);
+}
+
 MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_em_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_em_emulate_simple);
@@ -540,6 +737,10 @@ MU_TEST_SUITE(test_lfrfid_protocols_suite) {
 
     MU_RUN_TEST(test_lfrfid_protocol_fdxb_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_fdxb_emulate_simple);
+
+    MU_RUN_TEST(test_lfrfid_raw_file);
+    MU_RUN_TEST(test_lfrfid_read_scheduler_replay);
+    MU_RUN_TEST(test_lfrfid_read_scheduler_mismatch);
 }
 
 int run_minunit_test_lfrfid_protocols(void) {
@@ -4,12 +4,16 @@
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/helpers/crypto1.h>
+#include <nfc/helpers/nfc_util.h>
+#include <bit_lib/bit_lib.h>
 #include <nfc/nfc_poller.h>
 #include <nfc/nfc_listener.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a_poller.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a_poller_sync.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight.h>
+#include <nfc/protocols/mf_ultralight/mf_ultralight_poller.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight_poller_sync.h>
 #include <nfc/protocols/mf_classic/mf_classic_poller_sync.h>
 #include <nfc/protocols/felica/felica.h>
@@ -32,9 +36,14 @@
 
 #define NFC_TEST_NFC_DEV_PATH                  EXT_PATH("unit_tests/nfc/nfc_device_test.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_dict.nfc")
+#define NFC_TEST_DICT_COMPILED_EXTENSION       ".kdc"
 
 #define NFC_TEST_FLAG_WORKER_DONE (1)
 
+#define NFC_TEST_CRYPTO1_BS_KEY_COUNT   (2048U)
+#define NFC_TEST_CRYPTO1_BS_NONCE_COUNT (8U)
+#define NFC_TEST_CRYPTO1_BS_KEY_STRIDE  (67U)
+
 typedef enum {
     NfcTestMfClassicSendFrameTestStateAuth,
     NfcTestMfClassicSendFrameTestStateReadBlock,
@@ -50,6 +59,14 @@ typedef struct {
     FuriThreadId thread_id;
 } NfcTestMfClassicSendFrameTest;
 
+typedef struct {
+    uint8_t page;
+    MfUltralightPage page_before;
+    MfUltralightPage page_written;
+    bool success;
+    FuriThreadId thread_id;
+} NfcTestMfUltralightReadCacheTest;
+
 typedef enum {
     NfcTestSlixPollerSetPasswordStateGetRandomNumber,
     NfcTestSlixPollerSetPasswordStateSetPassword,
@@ -387,6 +404,91 @@ static void mf_ultralight_write(void) {
     nfc_free(poller);
 }
 
+static NfcCommand mf_ultralight_read_cache_callback(NfcGenericEventEx event, void* context) {
+    furi_check(event.poller);
+    furi_check(event.parent_event_data);
+    furi_check(context);
+
+    MfUltralightPoller* instance = event.poller;
+    NfcTestMfUltralightReadCacheTest* cache_test = context;
+    Iso14443_3aPollerEvent* iso3_event = event.parent_event_data;
+
+    cache_test->success = false;
+    do {
+        if(iso3_event->type != Iso14443_3aPollerEventTypeReady) break;
+
+        // Every READ that covers the page is answered before the write
+        MfUltralightPageReadCommandData data = {};
+        uint8_t page = cache_test->page;
+        bool read_ok = true;
+        for(uint8_t i = 0; i < COUNT_OF(data.page) && read_ok; i++) {
+            read_ok = mf_ultralight_poller_read_page(instance, page - i, &data) ==
+                          MfUltralightErrorNone &&
+                      memcmp(&data.page[i], &cache_test->page_before, sizeof(MfUltralightPage)) ==
+                          0;
+        }
+        if(!read_ok) break;
+
+        if(mf_ultralight_poller_write_page(instance, page, &cache_test->page_written) !=
+           MfUltralightErrorNone) {
+            break;
+        }
+
+        // Written data must be in all of them after the write
+        for(uint8_t i = 0; i < COUNT_OF(data.page) && read_ok; i++) {
+            read_ok = mf_ultralight_poller_read_page(instance, page - i, &data) ==
+                          MfUltralightErrorNone &&
+                      memcmp(&data.page[i], &cache_test->page_written, sizeof(MfUltralightPage)) ==
+                          0;
+        }
+        cache_test->success = read_ok;
+    } while(false);
+
+    furi_thread_flags_set(cache_test->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+
+    return NfcCommandStop;
+}
+
+MU_TEST(mf_ultralight_read_cache_test) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeNTAG215, nfc_device);
+    MfUltralightData* data =
+        (MfUltralightData*)nfc_device_get_data(nfc_device, NfcProtocolMfUltralight);
+
+    NfcTestMfUltralightReadCacheTest context = {
+        .page = 10,
+        .thread_id = furi_thread_get_current_id(),
+    };
+    furi_hal_random_fill_buf(data->page[context.page].data, sizeof(MfUltralightPage));
+    context.page_before = data->page[context.page];
+    do {
+        furi_hal_random_fill_buf(context.page_written.data, sizeof(MfUltralightPage));
+    } while(memcmp(&context.page_written, &context.page_before, sizeof(MfUltralightPage)) == 0);
+
+    NfcListener* mfu_listener = nfc_listener_alloc(listener, NfcProtocolMfUltralight, data);
+    nfc_listener_start(mfu_listener, NULL, NULL);
+
+    NfcPoller* mfu_poller = nfc_poller_alloc(poller, NfcProtocolMfUltralight);
+    nfc_poller_start_ex(mfu_poller, mf_ultralight_read_cache_callback, &context);
+
+    uint32_t flag =
+        furi_thread_flags_wait(NFC_TEST_FLAG_WORKER_DONE, FuriFlagWaitAny, FuriWaitForever);
+    mu_assert(flag == NFC_TEST_FLAG_WORKER_DONE, "Wrong thread flag");
+    nfc_poller_stop(mfu_poller);
+    nfc_poller_free(mfu_poller);
+
+    nfc_listener_stop(mfu_listener);
+    nfc_listener_free(mfu_listener);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(context.success, "READ after WRITE returned stale data");
+}
+
 static void mf_classic_reader(void) {
     Nfc* poller = nfc_alloc();
     Nfc* listener = nfc_alloc();
@@ -590,6 +692,8 @@ MU_TEST(mf_classic_dict_test) {
             storage_simply_remove(storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH),
             "Remove test dict failed");
     }
+    storage_simply_remove(
+        storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH NFC_TEST_DICT_COMPILED_EXTENSION);
 
     KeysDict* dict = keys_dict_alloc(
         NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
@@ -627,6 +731,54 @@ MU_TEST(mf_classic_dict_test) {
         key_idx++;
     }
 
+    // Reopened dictionary is served from its compiled copy, read it in blocks
+    mu_assert(keys_dict_rewind(dict), "keys_dict_rewind() failed");
+    MfClassicKey key_block[8] = {};
+    size_t block_count = 0;
+    key_idx = 0;
+    while((block_count = keys_dict_get_next_keys(
+               dict, (uint8_t*)key_block, sizeof(MfClassicKey), COUNT_OF(key_block))) > 0) {
+        mu_assert(
+            memcmp(&key_arr_ref[key_idx], key_block, block_count * sizeof(MfClassicKey)) == 0,
+            "Loaded key block mismatch");
+        key_idx += block_count;
+    }
+    mu_assert(key_idx == test_key_num, "keys_dict_get_next_keys() failed");
+
+    MfClassicKey key_absent = key_arr_ref[0];
+    key_absent.data[0] ^= 0xFF;
+    mu_assert(
+        !keys_dict_is_key_present(dict, key_absent.data, sizeof(MfClassicKey)),
+        "keys_dict_is_key_present() false positive");
+
+    keys_dict_free(dict);
+
+    // Mark the first key of the compiled copy, the next open must return the marked key
+    File* compiled = storage_file_alloc(storage);
+    mu_assert(
+        storage_file_open(
+            compiled,
+            NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH NFC_TEST_DICT_COMPILED_EXTENSION,
+            FSAM_READ_WRITE,
+            FSOM_OPEN_EXISTING),
+        "Compiled dict missing");
+    const uint64_t keys_offset =
+        storage_file_size(compiled) - test_key_num * sizeof(MfClassicKey) * 2;
+    mu_assert(
+        storage_file_seek(compiled, keys_offset, true) &&
+            storage_file_write(compiled, key_absent.data, sizeof(MfClassicKey)) ==
+                sizeof(MfClassicKey),
+        "Compiled dict write failed");
+    storage_file_free(compiled);
+
+    dict = keys_dict_alloc(
+        NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+    mu_assert(dict != NULL, "keys_dict_alloc() failed");
+    mu_assert(
+        keys_dict_get_next_key(dict, key_dut.data, sizeof(MfClassicKey)) &&
+            memcmp(key_absent.data, key_dut.data, sizeof(MfClassicKey)) == 0,
+        "Compiled dict not used");
+
     uint32_t delete_keys_idx[] = {1, 3, 9, 11, 19, 27};
 
     for(size_t i = 0; i < COUNT_OF(delete_keys_idx); i++) {
@@ -643,6 +795,10 @@ MU_TEST(mf_classic_dict_test) {
     mu_assert(
         dict_keys_total == test_key_num - COUNT_OF(delete_keys_idx),
         "keys_dict_keys_total() failed");
+    mu_assert(
+        !storage_file_exists(
+            storage, NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH NFC_TEST_DICT_COMPILED_EXTENSION),
+        "Compiled dict not dropped on modification");
 
     keys_dict_free(dict);
     free(key_arr_ref);
@@ -823,6 +979,90 @@ MU_TEST(slix_set_password_access_all_passwords_cap) {
         EXT_PATH("unit_tests/nfc/Slix_cap_accept_all_pass.nfc"), 0x12341234, false);
 }
 
+MU_TEST(mf_classic_crypto1_bs_test) {
+    // Stock dictionary sized search against hard PRNG nonces, scalar and bitsliced
+    const size_t key_count = NFC_TEST_CRYPTO1_BS_KEY_COUNT;
+    MfClassicKey* keys = malloc(sizeof(MfClassicKey) * key_count);
+    furi_hal_random_fill_buf((uint8_t*)keys, sizeof(MfClassicKey) * key_count);
+
+    // Card key is planted across the dictionary, stride moves it through all lanes
+    MfClassicKey card_key = keys[0];
+    size_t planted_count = 0;
+    for(size_t i = 0; i < key_count; i += NFC_TEST_CRYPTO1_BS_KEY_STRIDE) {
+        keys[i] = card_key;
+        planted_count++;
+    }
+
+    // Nested nonces and parity as the card encrypts them with its key
+    uint32_t cuid = furi_hal_random_get();
+    uint32_t nt[NFC_TEST_CRYPTO1_BS_NONCE_COUNT];
+    uint32_t nt_enc[NFC_TEST_CRYPTO1_BS_NONCE_COUNT];
+    uint8_t nt_par_enc[NFC_TEST_CRYPTO1_BS_NONCE_COUNT];
+    for(size_t i = 0; i < NFC_TEST_CRYPTO1_BS_NONCE_COUNT; i++) {
+        Crypto1 crypto;
+        crypto1_init(&crypto, bit_lib_bytes_to_num_be(card_key.data, sizeof(card_key.data)));
+        nt[i] = furi_hal_random_get();
+        uint32_t ks = crypto1_word(&crypto, nt[i] ^ cuid, 0);
+        nt_enc[i] = nt[i] ^ ks;
+        nt_par_enc[i] = (nfc_util_even_parity8(nt[i] >> 24) ^ FURI_BIT(ks, 16)) << 3 |
+                        (nfc_util_even_parity8(nt[i] >> 16) ^ FURI_BIT(ks, 8)) << 2 |
+                        (nfc_util_even_parity8(nt[i] >> 8) ^ FURI_BIT(ks, 0)) << 1 |
+                        (furi_hal_random_get() & 1);
+    }
+
+    uint32_t* scalar_match = malloc(sizeof(uint32_t) * key_count / CRYPTO1_BS_LANES);
+    size_t scalar_match_count = 0;
+    uint32_t start = DWT->CYCCNT;
+    for(size_t i = 0; i < key_count; i++) {
+        bool match = true;
+        for(size_t j = 0; (j < NFC_TEST_CRYPTO1_BS_NONCE_COUNT) && match; j++) {
+            uint32_t nt_dec = crypto1_decrypt_nt_enc(cuid, nt_enc[j], keys[i]);
+            match = crypto1_nonce_matches_encrypted_parity_bits(
+                nt_dec, nt_dec ^ nt_enc[j], nt_par_enc[j]);
+        }
+        if(match) {
+            scalar_match[i / CRYPTO1_BS_LANES] |= 1UL << (i % CRYPTO1_BS_LANES);
+            scalar_match_count++;
+        }
+    }
+    uint32_t scalar_cycles = DWT->CYCCNT - start;
+
+    uint32_t mismatch_count = 0;
+    uint32_t nt_mismatch_count = 0;
+    start = DWT->CYCCNT;
+    for(size_t i = 0; i < key_count; i += CRYPTO1_BS_LANES) {
+        Crypto1Bs bs;
+        crypto1_bs_init(&bs, &keys[i], CRYPTO1_BS_LANES);
+        uint32_t match = bs.lanes;
+        uint32_t nt_dec[CRYPTO1_BS_LANES];
+        for(size_t j = 0; (j < NFC_TEST_CRYPTO1_BS_NONCE_COUNT) && match; j++) {
+            match &= crypto1_bs_nonce_matches_encrypted_parity_bits(
+                &bs, cuid, nt_enc[j], nt_par_enc[j], nt_dec);
+        }
+        if(match != scalar_match[i / CRYPTO1_BS_LANES]) mismatch_count++;
+        for(size_t lane = 0; lane < CRYPTO1_BS_LANES; lane++) {
+            if((match & (1UL << lane)) &&
+               nt_dec[lane] != nt[NFC_TEST_CRYPTO1_BS_NONCE_COUNT - 1]) {
+                nt_mismatch_count++;
+            }
+        }
+    }
+    uint32_t bs_cycles = DWT->CYCCNT - start;
+
+    uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    printf(
+        "Crypto1 nested dict check: scalar %lu keys/s, bitsliced %lu keys/s\r\n",
+        (uint32_t)((uint64_t)key_count * cycles_per_us * 1000000 / scalar_cycles),
+        (uint32_t)((uint64_t)key_count * cycles_per_us * 1000000 / bs_cycles));
+
+    free(scalar_match);
+    free(keys);
+
+    mu_assert(scalar_match_count >= planted_count, "Scalar crypto1 missed the card key");
+    mu_assert(mismatch_count == 0, "Bitsliced and scalar crypto1 results differ");
+    mu_assert(nt_mismatch_count == 0, "Bitsliced crypto1 decrypted a wrong nonce");
+}
+
 MU_TEST_SUITE(nfc) {
     nfc_test_alloc();
 
@@ -835,6 +1075,7 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_ultralight_c_reader);
 
     MU_RUN_TEST(mf_ultralight_write);
+    MU_RUN_TEST(mf_ultralight_read_cache_test);
 
     MU_RUN_TEST(iso14443_3a_4b_file_test);
     MU_RUN_TEST(iso14443_3a_7b_file_test);
@@ -864,6 +1105,7 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_value_block);
     MU_RUN_TEST(mf_classic_send_frame_test);
     MU_RUN_TEST(mf_classic_dict_test);
+    MU_RUN_TEST(mf_classic_crypto1_bs_test);
     MU_RUN_TEST(felica_read);
     MU_RUN_TEST(felica_read_auth);
 
@@ -0,0 +1,600 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include <nfc/nfc.h>
+#include <nfc/nfc_mock.h>
+#include <nfc/nfc_device.h>
+#include <nfc/nfc_poller.h>
+#include <nfc/nfc_listener.h>
+#include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/helpers/iso14443_crc.h>
+#include <nfc/helpers/crypto1.h>
+#include <nfc/helpers/nfc_util.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a_poller.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a_listener.h>
+#include <nfc/protocols/mf_ultralight/mf_ultralight_poller.h>
+#include <nfc/protocols/mf_classic/mf_classic_poller.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#define TAG "NfcBench"
+
+#define NFC_BENCH_FLAG_WORKER_DONE (1)
+
+#define NFC_BENCH_PHASE_MAX (12U)
+
+#define NFC_BENCH_MFU_READ_COUNT (8U)
+
+#define NFC_BENCH_MFC_DICT_KEY_COUNT     (64U)
+#define NFC_BENCH_MFC_SECTORS_LOCKED     (2U)
+#define NFC_BENCH_MFC_NESTED_TIME_MAX_MS (10000U)
+
+#define NFC_BENCH_ISO14443_4A_EXCHANGE_COUNT (128U)
+#define NFC_BENCH_ISO14443_4A_READ_SIZE      (32U)
+#define NFC_BENCH_DESFIRE_CMD_READ_DATA      (0xBD)
+#define NFC_BENCH_DESFIRE_STATUS_OK          (0x00)
+
+#define NFC_BENCH_FRAME_SIZE       (18U)
+#define NFC_BENCH_FRAME_ITERATIONS (1000U)
+#define NFC_BENCH_FRAME_KEY        (0xA0A1A2A3A4A5ULL)
+
+// Time, frames and heap accounted to the phase the poller is in
+typedef struct {
+    const char* name;
+    uint64_t cycles;
+    uint32_t frames;
+} NfcBenchPhase;
+
+typedef struct {
+    NfcBenchPhase phase[NFC_BENCH_PHASE_MAX];
+    size_t phase_count;
+    size_t phase_current;
+    uint32_t cycles_last;
+    uint32_t frames_last;
+    size_t heap_free_start;
+    size_t heap_free_min;
+} NfcBench;
+
+typedef struct {
+    NfcBench bench;
+    FuriThreadId thread_id;
+    bool success;
+} NfcBenchMfUltralightContext;
+
+typedef struct {
+    NfcBench bench;
+    FuriThreadId thread_id;
+    MfClassicData* mode_data;
+    const MfClassicKey* keys;
+    size_t key_count;
+    size_t key_current;
+    uint32_t nested_start;
+    bool nested_time_out;
+    bool success;
+} NfcBenchMfClassicContext;
+
+typedef struct {
+    NfcBench bench;
+    FuriThreadId thread_id;
+    Nfc* listener;
+    BitBuffer* tx_buf;
+    BitBuffer* rx_buf;
+    uint32_t exchanges;
+    bool success;
+} NfcBenchIso14443_4aContext;
+
+static const char* const nfc_bench_mfc_nested_phase_name[] = {
+    [MfClassicNestedPhaseNone] = "Dictionary",
+    [MfClassicNestedPhaseAnalyzePRNG] = "Nested PRNG analysis",
+    [MfClassicNestedPhaseDictAttack] = "Nested dictionary",
+    [MfClassicNestedPhaseDictAttackVerify] = "Nested verify",
+    [MfClassicNestedPhaseDictAttackResume] = "Nested dictionary",
+    [MfClassicNestedPhaseCalibrate] = "Nested calibration",
+    [MfClassicNestedPhaseRecalibrate] = "Nested calibration",
+    [MfClassicNestedPhaseCollectNtEnc] = "Nested nonce collection",
+    [MfClassicNestedPhaseFinished] = "Nested finished",
+};
+
+static uint32_t nfc_bench_get_frames(void) {
+    NfcMockStats stats;
+    nfc_mock_get_stats(&stats);
+    return stats.poller_frames + stats.listener_frames;
+}
+
+static void nfc_bench_sample(NfcBench* bench) {
+    uint32_t cycles = DWT->CYCCNT;
+    uint32_t frames = nfc_bench_get_frames();
+
+    NfcBenchPhase* phase = &bench->phase[bench->phase_current];
+    phase->cycles += cycles - bench->cycles_last;
+    phase->frames += frames - bench->frames_last;
+    bench->cycles_last = cycles;
+    bench->frames_last = frames;
+
+    bench->heap_free_min = MIN(bench->heap_free_min, memmgr_get_free_heap());
+}
+
+static void nfc_bench_enter(NfcBench* bench, const char* name) {
+    nfc_bench_sample(bench);
+    if(strcmp(bench->phase[bench->phase_current].name, name) == 0) return;
+
+    size_t i = 0;
+    while(i < bench->phase_count && strcmp(bench->phase[i].name, name) != 0) {
+        i++;
+    }
+    if(i == bench->phase_count) {
+        furi_check(bench->phase_count < NFC_BENCH_PHASE_MAX);
+        bench->phase[bench->phase_count++].name = name;
+    }
+    bench->phase_current = i;
+}
+
+static void nfc_bench_start(NfcBench* bench, const char* name) {
+    memset(bench, 0, sizeof(NfcBench));
+    bench->phase[0].name = name;
+    bench->phase_count = 1;
+    bench->heap_free_start = memmgr_get_free_heap();
+    bench->heap_free_min = bench->heap_free_start;
+
+    nfc_mock_reset_stats();
+    bench->cycles_last = DWT->CYCCNT;
+}
+
+static void nfc_bench_report(NfcBench* bench, const char* name) {
+    nfc_bench_sample(bench);
+
+    NfcMockStats stats;
+    nfc_mock_get_stats(&stats);
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+
+    uint64_t cycles = 0;
+    for(size_t i = 0; i < bench->phase_count; i++) {
+        cycles += bench->phase[i].cycles;
+    }
+    uint32_t frames = stats.poller_frames + stats.listener_frames;
+    uint32_t time_us = cycles / cycles_per_us;
+
+    printf(
+        "%s: %lu frames in %lu ms, %lu frames/s, %lu timeouts, heap peak %zu bytes\r\n",
+        name,
+        frames,
+        time_us / 1000,
+        time_us ? (uint32_t)((uint64_t)frames * 1000000 / time_us) : 0,
+        stats.timeouts,
+        bench->heap_free_start - bench->heap_free_min);
+    if(stats.poller_frames) {
+        printf(
+            "  Listener: %lu us per response\r\n",
+            (uint32_t)(stats.listener_cycles / cycles_per_us / stats.poller_frames));
+    }
+    for(size_t i = 0; i < bench->phase_count; i++) {
+        const NfcBenchPhase* phase = &bench->phase[i];
+        uint32_t phase_us = phase->cycles / cycles_per_us;
+        printf(
+            "  %s: %lu frames in %lu us, %lu frames/s\r\n",
+            phase->name,
+            phase->frames,
+            phase_us,
+            phase_us ? (uint32_t)((uint64_t)phase->frames * 1000000 / phase_us) : 0);
+    }
+}
+
+static NfcCommand nfc_bench_mf_ultralight_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolMfUltralight);
+
+    NfcBenchMfUltralightContext* bench_ctx = context;
+    MfUltralightPollerEvent* mfu_event = event.event_data;
+    NfcCommand command = NfcCommandContinue;
+
+    if(mfu_event->type == MfUltralightPollerEventTypeRequestMode) {
+        nfc_bench_enter(&bench_ctx->bench, "Read");
+    } else if(mfu_event->type == MfUltralightPollerEventTypeAuthRequest) {
+        mfu_event->data->auth_context.skip_auth = true;
+        nfc_bench_sample(&bench_ctx->bench);
+    } else if(mfu_event->type == MfUltralightPollerEventTypeReadSuccess) {
+        bench_ctx->success = true;
+        command = NfcCommandStop;
+    } else if(mfu_event->type == MfUltralightPollerEventTypeReadFailed) {
+        command = NfcCommandStop;
+    }
+
+    if(command == NfcCommandStop) {
+        nfc_bench_sample(&bench_ctx->bench);
+        furi_thread_flags_set(bench_ctx->thread_id, NFC_BENCH_FLAG_WORKER_DONE);
+    }
+
+    return command;
+}
+
+MU_TEST(mf_ultralight_read_bench) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeNTAG216, nfc_device);
+    NfcListener* mfu_listener = nfc_listener_alloc(
+        listener,
+        NfcProtocolMfUltralight,
+        nfc_device_get_data(nfc_device, NfcProtocolMfUltralight));
+    nfc_listener_start(mfu_listener, NULL, NULL);
+
+    NfcBenchMfUltralightContext context = {
+        .thread_id = furi_thread_get_current_id(),
+    };
+    nfc_bench_start(&context.bench, "Activation");
+
+    size_t reads = 0;
+    for(; reads < NFC_BENCH_MFU_READ_COUNT; reads++) {
+        context.success = false;
+        context.bench.phase_current = 0;
+        NfcPoller* mfu_poller = nfc_poller_alloc(poller, NfcProtocolMfUltralight);
+        nfc_poller_start(mfu_poller, nfc_bench_mf_ultralight_callback, &context);
+        furi_thread_flags_wait(NFC_BENCH_FLAG_WORKER_DONE, FuriFlagWaitAny, FuriWaitForever);
+        nfc_poller_stop(mfu_poller);
+        nfc_poller_free(mfu_poller);
+
+        if(!context.success) break;
+    }
+
+    nfc_bench_report(&context.bench, "Ultralight read and emulation");
+
+    nfc_listener_stop(mfu_listener);
+    nfc_listener_free(mfu_listener);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(reads == NFC_BENCH_MFU_READ_COUNT, "Ultralight read failed");
+}
+
+static NfcCommand nfc_bench_mf_classic_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolMfClassic);
+
+    NfcBenchMfClassicContext* bench_ctx = context;
+    MfClassicPollerEvent* mfc_event = event.event_data;
+    NfcCommand command = NfcCommandContinue;
+
+    if(mfc_event->type == MfClassicPollerEventTypeRequestMode) {
+        mfc_event->data->poller_mode.mode = MfClassicPollerModeDictAttackEnhanced;
+        mfc_event->data->poller_mode.data = bench_ctx->mode_data;
+        nfc_bench_enter(&bench_ctx->bench, "Dictionary");
+    } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
+        if(bench_ctx->key_current < bench_ctx->key_count) {
+            mfc_event->data->key_request_data.key = bench_ctx->keys[bench_ctx->key_current++];
+            mfc_event->data->key_request_data.key_provided = true;
+        } else {
+            mfc_event->data->key_request_data.key_provided = false;
+        }
+        nfc_bench_sample(&bench_ctx->bench);
+    } else if(mfc_event->type == MfClassicPollerEventTypeNextSector) {
+        bench_ctx->key_current = 0;
+        nfc_bench_sample(&bench_ctx->bench);
+    } else if(mfc_event->type == MfClassicPollerEventTypeKeyAttackStart) {
+        nfc_bench_enter(&bench_ctx->bench, "Key reuse");
+    } else if(mfc_event->type == MfClassicPollerEventTypeKeyAttackStop) {
+        bench_ctx->key_current = 0;
+        nfc_bench_enter(&bench_ctx->bench, "Dictionary");
+    } else if(mfc_event->type == MfClassicPollerEventTypeDataUpdate) {
+        MfClassicNestedPhase nested_phase = mfc_event->data->data_update.nested_phase;
+        if(nested_phase == MfClassicNestedPhaseNone) {
+            nfc_bench_sample(&bench_ctx->bench);
+        } else {
+            nfc_bench_enter(&bench_ctx->bench, nfc_bench_mfc_nested_phase_name[nested_phase]);
+            if(bench_ctx->nested_start == 0) bench_ctx->nested_start = furi_get_tick();
+            // Hardnested against a random nonce listener runs for minutes, cap it
+            if(furi_get_tick() - bench_ctx->nested_start > NFC_BENCH_MFC_NESTED_TIME_MAX_MS) {
+                bench_ctx->nested_time_out = true;
+                command = NfcCommandStop;
+            }
+        }
+    } else if(mfc_event->type == MfClassicPollerEventTypeSuccess) {
+        bench_ctx->success = true;
+        command = NfcCommandStop;
+    } else if(mfc_event->type == MfClassicPollerEventTypeFail) {
+        command = NfcCommandStop;
+    } else {
+        nfc_bench_sample(&bench_ctx->bench);
+    }
+
+    if(command == NfcCommandStop) {
+        nfc_bench_sample(&bench_ctx->bench);
+        furi_thread_flags_set(bench_ctx->thread_id, NFC_BENCH_FLAG_WORKER_DONE);
+    }
+
+    return command;
+}
+
+MU_TEST(mf_classic_dict_attack_bench) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassic1k_7b, nfc_device);
+    const MfClassicData* mfc_data = nfc_device_get_data(nfc_device, NfcProtocolMfClassic);
+
+    // Last sectors use keys missing from the dictionary to get into the nested attack
+    uint8_t sectors_total = mf_classic_get_total_sectors_num(mfc_data->type);
+    for(uint8_t i = sectors_total - NFC_BENCH_MFC_SECTORS_LOCKED; i < sectors_total; i++) {
+        MfClassicSectorTrailer* sec_tr = mf_classic_get_sector_trailer_by_sector(mfc_data, i);
+        furi_hal_random_fill_buf(sec_tr->key_a.data, sizeof(MfClassicKey));
+        furi_hal_random_fill_buf(sec_tr->key_b.data, sizeof(MfClassicKey));
+    }
+
+    // Default key comes last so every sector goes through the whole dictionary
+    MfClassicKey* keys = malloc(NFC_BENCH_MFC_DICT_KEY_COUNT * sizeof(MfClassicKey));
+    furi_hal_random_fill_buf((uint8_t*)keys, NFC_BENCH_MFC_DICT_KEY_COUNT * sizeof(MfClassicKey));
+    memset(keys[NFC_BENCH_MFC_DICT_KEY_COUNT - 1].data, 0xff, sizeof(MfClassicKey));
+
+    NfcListener* mfc_listener = nfc_listener_alloc(listener, NfcProtocolMfClassic, mfc_data);
+    nfc_listener_start(mfc_listener, NULL, NULL);
+
+    NfcBenchMfClassicContext context = {
+        .thread_id = furi_thread_get_current_id(),
+        .mode_data = mf_classic_alloc(),
+        .keys = keys,
+        .key_count = NFC_BENCH_MFC_DICT_KEY_COUNT,
+    };
+    context.mode_data->type = mfc_data->type;
+    iso14443_3a_copy(context.mode_data->iso14443_3a_data, mfc_data->iso14443_3a_data);
+
+    nfc_bench_start(&context.bench, "Activation");
+
+    NfcPoller* mfc_poller = nfc_poller_alloc(poller, NfcProtocolMfClassic);
+    nfc_poller_start(mfc_poller, nfc_bench_mf_classic_callback, &context);
+    furi_thread_flags_wait(NFC_BENCH_FLAG_WORKER_DONE, FuriFlagWaitAny, FuriWaitForever);
+    nfc_poller_stop(mfc_poller);
+
+    nfc_bench_report(&context.bench, "MIFARE Classic dictionary and nested attack");
+
+    const MfClassicData* mfc_poller_data = nfc_poller_get_data(mfc_poller);
+    uint8_t sectors_read = 0;
+    uint8_t keys_found = 0;
+    mf_classic_get_read_sectors_and_keys(mfc_poller_data, &sectors_read, &keys_found);
+
+    nfc_poller_free(mfc_poller);
+    nfc_listener_stop(mfc_listener);
+    nfc_listener_free(mfc_listener);
+    mf_classic_free(context.mode_data);
+    free(keys);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(context.success || context.nested_time_out, "Dictionary attack failed");
+    mu_assert(
+        keys_found >= (sectors_total - NFC_BENCH_MFC_SECTORS_LOCKED) * 2,
+        "Dictionary keys not found");
+}
+
+static NfcCommand nfc_bench_iso14443_4a_listener_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolIso14443_4a);
+
+    NfcBenchIso14443_4aContext* bench_ctx = context;
+    Iso14443_4aListenerEvent* iso14443_4a_event = event.event_data;
+
+    if(iso14443_4a_event->type == Iso14443_4aListenerEventTypeReceivedData) {
+        // Answer DESFire ReadData in the same I-block: PCB, status, file data
+        const BitBuffer* rx_buf = iso14443_4a_event->data->buffer;
+        bit_buffer_reset(bench_ctx->tx_buf);
+        bit_buffer_append_byte(bench_ctx->tx_buf, bit_buffer_get_byte(rx_buf, 0));
+        if(bit_buffer_get_size_bytes(rx_buf) > 1 &&
+           bit_buffer_get_byte(rx_buf, 1) == NFC_BENCH_DESFIRE_CMD_READ_DATA) {
+            bit_buffer_append_byte(bench_ctx->tx_buf, NFC_BENCH_DESFIRE_STATUS_OK);
+            for(size_t i = 0; i < NFC_BENCH_ISO14443_4A_READ_SIZE; i++) {
+                bit_buffer_append_byte(bench_ctx->tx_buf, i);
+            }
+        }
+        iso14443_crc_append(Iso14443CrcTypeA, bench_ctx->tx_buf);
+        nfc_listener_tx(bench_ctx->listener, bench_ctx->tx_buf);
+    }
+
+    return NfcCommandContinue;
+}
+
+static NfcCommand nfc_bench_iso14443_4a_poller_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolIso14443_4a);
+
+    NfcBenchIso14443_4aContext* bench_ctx = context;
+    Iso14443_4aPollerEvent* iso14443_4a_event = event.event_data;
+
+    if(iso14443_4a_event->type == Iso14443_4aPollerEventTypeReady) {
+        nfc_bench_enter(&bench_ctx->bench, "Exchange");
+
+        const uint8_t read_data_cmd[] = {
+            NFC_BENCH_DESFIRE_CMD_READ_DATA,
+            0x01,
+            0x00,
+            0x00,
+            0x00,
+            NFC_BENCH_ISO14443_4A_READ_SIZE,
+            0x00,
+            0x00,
+        };
+        bit_buffer_copy_bytes(bench_ctx->tx_buf, read_data_cmd, sizeof(read_data_cmd));
+
+        bench_ctx->success = true;
+        for(; bench_ctx->exchanges < NFC_BENCH_ISO14443_4A_EXCHANGE_COUNT;
+            bench_ctx->exchanges++) {
+            Iso14443_4aError error = iso14443_4a_poller_send_block(
+                event.instance, bench_ctx->tx_buf, bench_ctx->rx_buf);
+            if(error != Iso14443_4aErrorNone ||
+               bit_buffer_get_size_bytes(bench_ctx->rx_buf) !=
+                   NFC_BENCH_ISO14443_4A_READ_SIZE + 1 ||
+               bit_buffer_get_byte(bench_ctx->rx_buf, 0) != NFC_BENCH_DESFIRE_STATUS_OK) {
+                bench_ctx->success = false;
+                break;
+            }
+            nfc_bench_sample(&bench_ctx->bench);
+        }
+    }
+
+    nfc_bench_sample(&bench_ctx->bench);
+    furi_thread_flags_set(bench_ctx->thread_id, NFC_BENCH_FLAG_WORKER_DONE);
+
+    return NfcCommandStop;
+}
+
+MU_TEST(iso14443_4a_exchange_bench) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    Iso14443_4aData* iso14443_4a_data = iso14443_4a_alloc();
+    Iso14443_3aData* iso14443_3a_data = iso14443_4a_get_base_data(iso14443_4a_data);
+    const Iso14443_3aData iso14443_3a_listener_data = {
+        .uid_len = 7,
+        .uid = {0x04, 0x2F, 0x1A, 0x52, 0xB3, 0x6C, 0x80},
+        .atqa = {0x44, 0x03},
+        .sak = 0x20,
+    };
+    iso14443_3a_copy(iso14443_3a_data, &iso14443_3a_listener_data);
+    // DESFire EV1 ATS: FSCI 64 bytes, TA1, TB1 and TC1 present
+    iso14443_4a_data->ats_data.tl = 0x06;
+    iso14443_4a_data->ats_data.t0 = 0x75;
+    iso14443_4a_data->ats_data.ta_1 = 0x77;
+    iso14443_4a_data->ats_data.tb_1 = 0x81;
+    iso14443_4a_data->ats_data.tc_1 = 0x02;
+
+    NfcBenchIso14443_4aContext context = {
+        .thread_id = furi_thread_get_current_id(),
+        .listener = listener,
+        .tx_buf = bit_buffer_alloc(64),
+        .rx_buf = bit_buffer_alloc(64),
+    };
+    NfcBenchIso14443_4aContext listener_context = {
+        .listener = listener,
+        .tx_buf = bit_buffer_alloc(64),
+    };
+
+    NfcListener* iso4_listener =
+        nfc_listener_alloc(listener, NfcProtocolIso14443_4a, iso14443_4a_data);
+    nfc_listener_start(iso4_listener, nfc_bench_iso14443_4a_listener_callback, &listener_context);
+
+    nfc_bench_start(&context.bench, "Activation");
+
+    NfcPoller* iso4_poller = nfc_poller_alloc(poller, NfcProtocolIso14443_4a);
+    nfc_poller_start(iso4_poller, nfc_bench_iso14443_4a_poller_callback, &context);
+    furi_thread_flags_wait(NFC_BENCH_FLAG_WORKER_DONE, FuriFlagWaitAny, FuriWaitForever);
+    nfc_poller_stop(iso4_poller);
+    nfc_poller_free(iso4_poller);
+
+    nfc_bench_report(&context.bench, "ISO14443-4 DESFire exchange");
+
+    nfc_listener_stop(iso4_listener);
+    nfc_listener_free(iso4_listener);
+    bit_buffer_free(listener_context.tx_buf);
+    bit_buffer_free(context.tx_buf);
+    bit_buffer_free(context.rx_buf);
+    iso14443_4a_free(iso14443_4a_data);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(context.success, "ISO14443-4 exchange failed");
+    mu_assert(
+        context.exchanges == NFC_BENCH_ISO14443_4A_EXCHANGE_COUNT, "Wrong number of exchanges");
+}
+
+static void nfc_bench_frame_report(const char* name, uint64_t cycles) {
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    const uint32_t frame_cycles = cycles / NFC_BENCH_FRAME_ITERATIONS;
+
+    printf(
+        "  %s: %lu cycles, %lu.%02lu us per frame\r\n",
+        name,
+        frame_cycles,
+        frame_cycles / cycles_per_us,
+        frame_cycles % cycles_per_us * 100 / cycles_per_us);
+}
+
+MU_TEST(bit_buffer_frame_bench) {
+    uint8_t frame[NFC_BENCH_FRAME_SIZE];
+    uint8_t bitstream[NFC_BENCH_FRAME_SIZE * 2];
+    size_t bits_written = 0;
+
+    BitBuffer* plain = bit_buffer_alloc(NFC_BENCH_FRAME_SIZE);
+    BitBuffer* reference = bit_buffer_alloc(NFC_BENCH_FRAME_SIZE);
+    BitBuffer* encrypted = bit_buffer_alloc(NFC_BENCH_FRAME_SIZE);
+    BitBuffer* decrypted = bit_buffer_alloc(NFC_BENCH_FRAME_SIZE);
+    Crypto1* crypto = crypto1_alloc();
+    Crypto1* crypto_reference = crypto1_alloc();
+
+    uint64_t cycles_parity = 0;
+    uint64_t cycles_pack = 0;
+    uint64_t cycles_unpack = 0;
+    uint64_t cycles_encrypt = 0;
+    bool success = true;
+
+    for(size_t i = 0; i < NFC_BENCH_FRAME_ITERATIONS && success; i++) {
+        furi_hal_random_fill_buf(frame, sizeof(frame));
+        bit_buffer_copy_bytes(plain, frame, sizeof(frame));
+
+        uint32_t cycles = DWT->CYCCNT;
+        for(size_t j = 0; j < sizeof(frame); j++) {
+            bool parity_bit = nfc_util_odd_parity8(frame[j]);
+            bit_buffer_set_byte_with_parity(plain, j, frame[j], parity_bit);
+        }
+        cycles_parity += DWT->CYCCNT - cycles;
+
+        cycles = DWT->CYCCNT;
+        bit_buffer_write_bytes_with_parity(plain, bitstream, sizeof(bitstream), &bits_written);
+        cycles_pack += DWT->CYCCNT - cycles;
+
+        cycles = DWT->CYCCNT;
+        bit_buffer_copy_bytes_with_parity(reference, bitstream, bits_written);
+        cycles_unpack += DWT->CYCCNT - cycles;
+
+        success &= memcmp(bit_buffer_get_data(reference), frame, sizeof(frame)) == 0;
+        success &= memcmp(
+                       bit_buffer_get_parity(reference),
+                       bit_buffer_get_parity(plain),
+                       (sizeof(frame) + 7) / 8) == 0;
+
+        cycles = DWT->CYCCNT;
+        crypto1_init(crypto, NFC_BENCH_FRAME_KEY);
+        crypto1_encrypt(crypto, NULL, plain, encrypted);
+        cycles_encrypt += DWT->CYCCNT - cycles;
+
+        // Encrypted parity bit is the keystream bit after the byte over the plain parity
+        crypto1_init(crypto_reference, NFC_BENCH_FRAME_KEY);
+        const uint8_t* parity_encrypted = bit_buffer_get_parity(encrypted);
+        for(size_t j = 0; j < sizeof(frame); j++) {
+            crypto1_byte(crypto_reference, 0, 0);
+            Crypto1 keystream_next = *crypto_reference;
+            bool parity_bit = crypto1_bit(&keystream_next, 0, 0) ^ nfc_util_odd_parity8(frame[j]);
+            success &= FURI_BIT(parity_encrypted[j / 8], j % 8) == parity_bit;
+        }
+
+        crypto1_init(crypto, NFC_BENCH_FRAME_KEY);
+        crypto1_decrypt(crypto, encrypted, decrypted);
+        success &= memcmp(bit_buffer_get_data(decrypted), frame, sizeof(frame)) == 0;
+    }
+
+    printf("BitBuffer %u byte frame:\r\n", NFC_BENCH_FRAME_SIZE);
+    nfc_bench_frame_report("Parity, byte by byte", cycles_parity);
+    nfc_bench_frame_report("Pack with parity", cycles_pack);
+    nfc_bench_frame_report("Unpack with parity", cycles_unpack);
+    nfc_bench_frame_report("Crypto1 encrypt", cycles_encrypt);
+
+    crypto1_free(crypto_reference);
+    crypto1_free(crypto);
+    bit_buffer_free(decrypted);
+    bit_buffer_free(encrypted);
+    bit_buffer_free(reference);
+    bit_buffer_free(plain);
+
+    mu_assert(success, "BitBuffer frame processing mismatch");
+}
+
+MU_TEST_SUITE(nfc_bench) {
+    MU_RUN_TEST(mf_ultralight_read_bench);
+    MU_RUN_TEST(mf_classic_dict_attack_bench);
+    MU_RUN_TEST(iso14443_4a_exchange_bench);
+    MU_RUN_TEST(bit_buffer_frame_bench);
+}
+
+int run_minunit_test_nfc_bench(void) {
+    MU_RUN_SUITE(nfc_bench);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_nfc_bench)
@@ -9,6 +9,13 @@ typedef enum {
     TestDictProtocolMax,
 } TestDictProtocols;
 
+typedef enum {
+    TestDictWindowedProtocol0,
+    TestDictWindowedProtocol1,
+
+    TestDictWindowedProtocolMax,
+} TestDictWindowedProtocols;
+
 /*********************** PROTOCOL 0 START ***********************/
 
 typedef struct {
@@ -138,11 +145,33 @@ static const ProtocolBase protocol_1 = {
         },
 };
 
+// Protocol 0 that only acts upon durations around its trigger
+static const ProtocolBase protocol_0_windowed = {
+    .name = "Protocol 0 Windowed",
+    .manufacturer = "Manufacturer 0",
+    .data_size = 4,
+    .alloc = (ProtocolAlloc)protocol_0_alloc,
+    .free = (ProtocolFree)protocol_0_free,
+    .get_data = (ProtocolGetData)protocol_0_get_data,
+    .decoder =
+        {
+            .start = (ProtocolDecoderStart)protocol_0_decoder_start,
+            .feed = (ProtocolDecoderFeed)protocol_0_decoder_feed,
+            .duration_min = 600,
+            .duration_max = 700,
+        },
+};
+
 static const ProtocolBase* test_protocols_base[] = {
     [TestDictProtocol0] = &protocol_0,
     [TestDictProtocol1] = &protocol_1,
 };
 
+static const ProtocolBase* test_windowed_protocols_base[] = {
+    [TestDictWindowedProtocol0] = &protocol_0_windowed,
+    [TestDictWindowedProtocol1] = &protocol_1,
+};
+
 MU_TEST(test_protocol_dict) {
     ProtocolDict* dict = protocol_dict_alloc(test_protocols_base, TestDictProtocolMax);
     size_t max_data_size = protocol_dict_get_max_data_size(dict);
@@ -212,8 +241,56 @@ MU_TEST(test_protocol_dict) {
     free(data);
 }
 
+MU_TEST(test_protocol_dict_active_set) {
+    ProtocolDict* dict =
+        protocol_dict_alloc(test_windowed_protocols_base, TestDictWindowedProtocolMax);
+    ProtocolDictDecoderStats stats;
+    ProtocolId protocol_id = PROTOCOL_NO;
+
+    protocol_dict_decoders_start(dict);
+    protocol_dict_reset_decoder_stats(dict);
+
+    // Out of window durations park the windowed decoder
+    for(size_t i = 0; i < 100; i++) {
+        protocol_id = protocol_dict_decoders_feed(dict, i % 2, 100);
+        mu_assert_int_eq(PROTOCOL_NO, protocol_id);
+    }
+
+    protocol_dict_get_decoder_stats(dict, TestDictWindowedProtocol0, &stats);
+    mu_assert_int_eq(8, stats.feed_count);
+    mu_assert_int_eq(1, stats.park_count);
+    protocol_dict_get_decoder_stats(dict, TestDictWindowedProtocol1, &stats);
+    mu_assert_int_eq(100, stats.feed_count);
+    mu_assert_int_eq(0, stats.park_count);
+
+    // In window duration brings it back
+    protocol_id = protocol_dict_decoders_feed(dict, true, 666);
+    mu_assert_int_eq(TestDictWindowedProtocol0, protocol_id);
+    protocol_dict_get_decoder_stats(dict, TestDictWindowedProtocol0, &stats);
+    mu_assert_int_eq(9, stats.feed_count);
+
+    // Parked decoders are periodically fed again
+    protocol_dict_decoders_start(dict);
+    protocol_dict_reset_decoder_stats(dict);
+
+    for(size_t i = 0; i < 300; i++) {
+        protocol_dict_decoders_feed(dict, i % 2, 100);
+    }
+
+    protocol_dict_get_decoder_stats(dict, TestDictWindowedProtocol0, &stats);
+    mu_assert_int_eq(16, stats.feed_count);
+    mu_assert_int_eq(2, stats.park_count);
+
+    // Feeding by id ignores the active set
+    protocol_id = protocol_dict_decoders_feed_by_id(dict, TestDictWindowedProtocol0, true, 666);
+    mu_assert_int_eq(TestDictWindowedProtocol0, protocol_id);
+
+    protocol_dict_free(dict);
+}
+
 MU_TEST_SUITE(test_protocol_dict_suite) {
     MU_RUN_TEST(test_protocol_dict);
+    MU_RUN_TEST(test_protocol_dict_active_set);
 }
 
 int run_minunit_test_protocol_dict(void) {
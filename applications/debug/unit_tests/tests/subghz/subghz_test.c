@@ -5,9 +5,13 @@
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_binary.h>
+#include <lib/subghz/subghz_worker.h>
+#include <lib/subghz/blocks/pwm.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
+#include <lib/subghz/devices/replay/replay_interconnect.h>
 #include <lib/subghz/devices/cc1101_configs.h>
 
 #define TAG "SubGhzTest"
@@ -18,7 +22,16 @@
 #define ALUTECH_AT_4N_DIR_NAME  EXT_PATH("subghz/assets/alutech_at_4n")
 #define TEST_RANDOM_DIR_NAME    EXT_PATH("unit_tests/subghz/test_random_raw.sub")
 #define TEST_RANDOM_COUNT_PARSE 329
+#define TEST_RANDOM_BIN_NAME    EXT_PATH("unit_tests/subghz/test_random_raw_bin.tmp")
+#define TEST_RANDOM_TEXT_NAME   EXT_PATH("unit_tests/subghz/test_random_raw_text.tmp")
 #define TEST_TIMEOUT            10000
+#define TEST_REPLAY_TX_SIZE     2048
+#define TEST_RANDOM_AIR_TIME    98000 // test_random_raw.sub at real time, ms
+#define TEST_BENCHMARK_PASSES   4
+#define TEST_KEELOQ_PASSES      64
+#define TEST_KEELOQ_KEY_COUNT   1024 // Keystore size of a typical community key list
+#define TEST_KEELOQ_KEYS_NAME   EXT_PATH("unit_tests/subghz/keeloq_bench_keys.tmp")
+#define TEST_KEYSTORE_EDIT_NAME EXT_PATH("unit_tests/subghz/keystore_edit.tmp")
 
 static SubGhzEnvironment* environment_handler;
 static SubGhzReceiver* receiver_handler;
@@ -147,6 +160,71 @@ static bool subghz_decode_random_test(const char* path) {
     }
 }
 
+static bool subghz_receiver_benchmark(const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
+    uint32_t buffer_size = 0;
+    int32_t* buffer = NULL;
+    uint64_t cycles = 0;
+    bool result = false;
+
+    subghz_receiver_reset(receiver_handler);
+    subghz_receiver_reset_stats(receiver_handler);
+
+    for(size_t pass = 0; pass < TEST_BENCHMARK_PASSES; pass++) {
+        if(!flipper_format_file_open_existing(fff_data_file, path)) {
+            FURI_LOG_E(TAG, "Error open file %s", path);
+            break;
+        }
+
+        // Pulses are loaded line by line, only the receiver itself is timed
+        uint32_t count = 0;
+        while(flipper_format_get_value_count(fff_data_file, "RAW_Data", &count) && count) {
+            if(count > buffer_size) {
+                buffer = realloc(buffer, count * sizeof(int32_t)); //-V701
+                buffer_size = count;
+            }
+            if(!flipper_format_read_int32(fff_data_file, "RAW_Data", buffer, count)) break;
+
+            uint32_t start = DWT->CYCCNT;
+            for(size_t i = 0; i < count; i++) {
+                bool level = buffer[i] > 0;
+                uint32_t duration = level ? buffer[i] : -buffer[i];
+                subghz_receiver_decode(receiver_handler, level, duration);
+            }
+            cycles += DWT->CYCCNT - start;
+        }
+        flipper_format_file_close(fff_data_file);
+        result = true;
+    }
+
+    uint32_t pulse_count = subghz_receiver_get_pulse_count(receiver_handler);
+    uint64_t time_us = cycles / furi_hal_cortex_instructions_per_microsecond();
+    if(result && pulse_count && time_us) {
+        printf(
+            "Receiver: %lu pulses in %lu us, %lu pulses/s\r\n",
+            pulse_count,
+            (uint32_t)time_us,
+            (uint32_t)((uint64_t)pulse_count * 1000000 / time_us));
+
+        for(size_t i = 0; i < subghz_receiver_get_decoder_count(receiver_handler); i++) {
+            uint32_t feed_count = subghz_receiver_get_decoder_feed_count(receiver_handler, i);
+            if(!feed_count) continue;
+            SubGhzProtocolDecoderBase* decoder =
+                subghz_receiver_get_decoder_base_by_index(receiver_handler, i);
+            printf(
+                "  %-24s %3lu%%\r\n",
+                decoder->protocol->name,
+                (uint32_t)((uint64_t)feed_count * 100 / pulse_count));
+        }
+    }
+
+    free(buffer);
+    flipper_format_free(fff_data_file);
+    furi_record_close(RECORD_STORAGE);
+    return result && pulse_count;
+}
+
 static bool subghz_encoder_test(const char* path) {
     subghz_test_decoder_count = 0;
     uint32_t test_start = furi_get_tick();
@@ -215,6 +293,92 @@ MU_TEST(subghz_keystore_test) {
         "Test keystore error");
 }
 
+static bool subghz_keystore_write_edit_file(Storage* storage, const char* key_line) {
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    uint32_t encryption = 0;
+    bool result = false;
+    do {
+        if(!flipper_format_file_open_always(flipper_format, TEST_KEYSTORE_EDIT_NAME)) break;
+        if(!flipper_format_write_header_cstr(flipper_format, "Flipper SubGhz Keystore File", 0)) {
+            break;
+        }
+        if(!flipper_format_write_uint32(flipper_format, "Encryption", &encryption, 1)) break;
+        Stream* stream = flipper_format_get_raw_stream(flipper_format);
+        result = stream_write_cstring(stream, key_line) == strlen(key_line);
+    } while(false);
+    flipper_format_free(flipper_format);
+    return result;
+}
+
+static bool subghz_keystore_edit_loads(uint64_t key, const char* name) {
+    SubGhzKeystore* keystore = subghz_keystore_alloc();
+    bool result = subghz_keystore_load(keystore, TEST_KEYSTORE_EDIT_NAME);
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    result = result && SubGhzKeyArray_size(*keys) == 1;
+    if(result) {
+        const SubGhzKey* loaded = SubGhzKeyArray_cget(*keys, 0);
+        result = loaded->key == key && furi_string_cmp_str(loaded->name, name) == 0;
+    }
+    subghz_keystore_free(keystore);
+    return result;
+}
+
+MU_TEST(subghz_keystore_compiled_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, KEYSTORE_DIR_NAME ".kc");
+
+    // First load compiles the keystore, second one must read the same keys back
+    SubGhzKeystore* source = subghz_keystore_alloc();
+    SubGhzKeystore* compiled = subghz_keystore_alloc();
+    uint32_t start = furi_get_tick();
+    bool source_loaded = subghz_keystore_load(source, KEYSTORE_DIR_NAME);
+    uint32_t source_time = furi_get_tick() - start;
+    start = furi_get_tick();
+    bool compiled_loaded = subghz_keystore_load(compiled, KEYSTORE_DIR_NAME);
+    uint32_t compiled_time = furi_get_tick() - start;
+
+    bool exists = storage_file_exists(storage, KEYSTORE_DIR_NAME ".kc");
+    SubGhzKeyArray_t* source_keys = subghz_keystore_get_data(source);
+    SubGhzKeyArray_t* compiled_keys = subghz_keystore_get_data(compiled);
+    size_t count = SubGhzKeyArray_size(*source_keys);
+    bool equal = count == SubGhzKeyArray_size(*compiled_keys);
+    for(size_t i = 0; equal && i < count; i++) {
+        const SubGhzKey* a = SubGhzKeyArray_cget(*source_keys, i);
+        const SubGhzKey* b = SubGhzKeyArray_cget(*compiled_keys, i);
+        equal = a->key == b->key && a->type == b->type && furi_string_equal(a->name, b->name);
+    }
+    printf(
+        "Keystore %zu keys: source %lu ms, compiled %lu ms\r\n",
+        count,
+        source_time,
+        compiled_time);
+
+    subghz_keystore_free(compiled);
+    subghz_keystore_free(source);
+
+    // Changed source must replace the keys of its compiled copy
+    bool edit_loaded =
+        subghz_keystore_write_edit_file(storage, "0123456789ABCDEF:1:Before\n") &&
+        subghz_keystore_edit_loads(0x0123456789ABCDEFULL, "Before") &&
+        subghz_keystore_edit_loads(0x0123456789ABCDEFULL, "Before");
+    bool edit_compiled = storage_file_exists(storage, TEST_KEYSTORE_EDIT_NAME ".kc");
+    bool edit_reloaded =
+        subghz_keystore_write_edit_file(storage, "FEDCBA9876543210:2:After_edit\n") &&
+        subghz_keystore_edit_loads(0xFEDCBA9876543210ULL, "After_edit") &&
+        subghz_keystore_edit_loads(0xFEDCBA9876543210ULL, "After_edit");
+
+    storage_simply_remove(storage, TEST_KEYSTORE_EDIT_NAME);
+    storage_simply_remove(storage, TEST_KEYSTORE_EDIT_NAME ".kc");
+    storage_simply_remove(storage, KEYSTORE_DIR_NAME ".kc");
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(source_loaded && compiled_loaded, "Keystore load error");
+    mu_assert(exists, "Compiled keystore missing");
+    mu_assert(equal, "Compiled keystore mismatch");
+    mu_assert(edit_loaded && edit_compiled, "Edited keystore load error");
+    mu_assert(edit_reloaded, "Compiled keystore not invalidated by source change");
+}
+
 typedef enum {
     SubGhzHalAsyncTxTestTypeNormal,
     SubGhzHalAsyncTxTestTypeInvalidStart,
@@ -370,6 +534,93 @@ MU_TEST(subghz_hal_async_tx_test) {
 }
 
 //test decoders
+static const SubGhzBlockConst subghz_block_pwm_test_const = {
+    .te_short = 400,
+    .te_long = 800,
+    .te_delta = 100,
+    .min_count_bit_for_found = 8,
+};
+
+static const SubGhzBlockConst subghz_block_pwm_test_const_other = {
+    .te_short = 250,
+    .te_long = 500,
+    .te_delta = 120,
+    .min_count_bit_for_found = 8,
+};
+
+static bool
+    subghz_block_pwm_test_frame(const SubGhzBlockPwmConst* pwm, uint8_t data, uint8_t expected) {
+    SubGhzBlockDecoder decoder = {0};
+    const uint32_t te_short = pwm->timing->te_short;
+    const uint32_t te_long = pwm->timing->te_long;
+    bool frame_end = false;
+
+    frame_end |= subghz_block_pwm_feed(pwm, &decoder, false, te_short * pwm->header_short);
+    // Stray low pulse before the start bit
+    frame_end |= subghz_block_pwm_feed(pwm, &decoder, false, te_short);
+    frame_end |= subghz_block_pwm_feed(pwm, &decoder, true, te_short * pwm->start_short);
+    for(int8_t i = 7; i >= 0; i--) {
+        bool bit = (data >> i) & 1;
+        frame_end |= subghz_block_pwm_feed(pwm, &decoder, false, bit ? te_long : te_short);
+        frame_end |= subghz_block_pwm_feed(pwm, &decoder, true, bit ? te_short : te_long);
+    }
+    if(frame_end) return false;
+    frame_end = subghz_block_pwm_feed(pwm, &decoder, false, te_short * pwm->gap_short);
+
+    return frame_end && (decoder.decode_count_bit == 8) && (decoder.decode_data == expected) &&
+           (decoder.parser_step == SubGhzBlockPwmStepFoundStartBit);
+}
+
+MU_TEST(subghz_block_pwm_test) {
+    SubGhzBlockPwmConst pwm = {
+        .timing = &subghz_block_pwm_test_const,
+        .header_short = 30,
+        .header_delta = 10,
+        .start_short = 1,
+        .start_delta = 1,
+        .long_delta = 1,
+        .gap_short = 10,
+        .gap_delta = 0,
+        .flags = SubGhzBlockPwmFlagStartSkipLow,
+    };
+    mu_assert(subghz_block_pwm_test_frame(&pwm, 0xA5, 0xA5), "PWM frame not decoded\r\n");
+
+    pwm.flags = SubGhzBlockPwmFlagNone;
+    mu_assert(!subghz_block_pwm_test_frame(&pwm, 0xA5, 0xA5), "PWM stray low not rejected\r\n");
+
+    pwm.flags = SubGhzBlockPwmFlagStartSkipLow | SubGhzBlockPwmFlagInverted;
+    mu_assert(subghz_block_pwm_test_frame(&pwm, 0x3C, 0xC3), "PWM inverted frame not decoded\r\n");
+
+    SubGhzDecoderWakeWindow window;
+    subghz_block_pwm_get_wake_window(&pwm, &window);
+    mu_assert_int_eq(400 * 30, window.duration);
+    mu_assert_int_eq(100 * 10, window.delta);
+
+    // Table lookup classifies like every description on its own
+    const SubGhzBlockPwmConst pwm_other = {
+        .timing = &subghz_block_pwm_test_const_other,
+        .header_short = 36,
+        .header_delta = 18,
+        .start_short = 1,
+        .start_delta = 0,
+        .long_delta = 2,
+        .gap_short = 4,
+        .gap_delta = 3,
+        .flags = SubGhzBlockPwmFlagNone,
+    };
+    const SubGhzBlockPwmConst* table_pwm[] = {&pwm, &pwm_other};
+    SubGhzBlockPwmTable* table = subghz_block_pwm_table_alloc(table_pwm, COUNT_OF(table_pwm));
+    uint32_t mismatch = 0;
+    for(uint32_t duration = 0; duration < 20000; duration++) {
+        const uint8_t* classes = subghz_block_pwm_table_get_classes(table, duration);
+        for(size_t i = 0; i < COUNT_OF(table_pwm); i++) {
+            if(classes[i] != subghz_block_pwm_get_class(table_pwm[i], duration)) mismatch++;
+        }
+    }
+    subghz_block_pwm_table_free(table);
+    mu_assert_int_eq(0, mismatch);
+}
+
 MU_TEST(subghz_decoder_came_atomo_test) {
     mu_assert(
         subghz_decoder_test(
@@ -872,12 +1123,335 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+static uint32_t subghz_keeloq_benchmark_decode(
+    SubGhzEnvironment* environment,
+    SubGhzProtocolDecoderBase* decoder,
+    FlipperFormat* flipper_format,
+    FuriString* text) {
+    subghz_environment_reset_keeloq(environment);
+    furi_string_reset(text);
+
+    flipper_format_rewind(flipper_format);
+    uint32_t start = DWT->CYCCNT;
+    subghz_protocol_decoder_base_deserialize(decoder, flipper_format);
+    subghz_protocol_decoder_base_get_string(decoder, text);
+    return DWT->CYCCNT - start;
+}
+
+// Pads the keystore with made up keys up to TEST_KEELOQ_KEY_COUNT
+static bool subghz_keeloq_benchmark_pad_keystore(Storage* storage, SubGhzKeystore* keystore) {
+    size_t key_count = SubGhzKeyArray_size(*subghz_keystore_get_data(keystore));
+    if(key_count >= TEST_KEELOQ_KEY_COUNT) return true;
+
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    uint32_t encryption = 0;
+    bool result = false;
+    do {
+        if(!flipper_format_file_open_always(flipper_format, TEST_KEELOQ_KEYS_NAME)) break;
+        if(!flipper_format_write_header_cstr(flipper_format, "Flipper SubGhz Keystore File", 0)) {
+            break;
+        }
+        if(!flipper_format_write_uint32(flipper_format, "Encryption", &encryption, 1)) break;
+
+        // Simple, normal and magic XOR learning, the ones tried on every key
+        static const uint16_t types[] = {1, 2, 4};
+        Stream* stream = flipper_format_get_raw_stream(flipper_format);
+        result = true;
+        for(size_t i = key_count; i < TEST_KEELOQ_KEY_COUNT && result; i++) {
+            result = stream_write_format(
+                         stream,
+                         "%08lX%08lX:%hu:Bench_%zu\n",
+                         furi_hal_random_get(),
+                         furi_hal_random_get(),
+                         types[i % COUNT_OF(types)],
+                         i) > 0;
+        }
+    } while(false);
+    flipper_format_free(flipper_format);
+
+    return result && subghz_keystore_load(keystore, TEST_KEELOQ_KEYS_NAME);
+}
+
+static bool subghz_keeloq_benchmark(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    // Own environment, padding keys stay out of the other tests
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+    SubGhzReceiver* receiver = NULL;
+    SubGhzProtocolDecoderBase* decoder = NULL;
+    FlipperFormat* known = flipper_format_file_alloc(storage);
+    FlipperFormat* unknown = flipper_format_string_alloc();
+    FuriString* text = furi_string_alloc();
+    uint32_t cpu_mhz = furi_hal_cortex_instructions_per_microsecond();
+    uint64_t unknown_cycles = 0;
+    uint64_t known_cycles = 0;
+    uint32_t first_cycles = 0;
+    bool result = false;
+
+    do {
+        // Real keys go first, the known remote still decodes with them
+        if(!subghz_environment_load_keystore(environment, KEYSTORE_DIR_NAME)) break;
+        SubGhzKeystore* keystore = subghz_environment_get_keystore(environment);
+        if(!subghz_keeloq_benchmark_pad_keystore(storage, keystore)) break;
+
+        receiver = subghz_receiver_alloc_init(environment);
+        decoder =
+            subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_KEELOQ_NAME);
+        if(!decoder) break;
+
+        if(!flipper_format_file_open_existing(known, EXT_PATH("unit_tests/subghz/doorhan.sub"))) {
+            break;
+        }
+
+        // Packets that match no key walk the whole keystore
+        uint32_t bit = 64;
+        uint8_t key[8];
+        for(size_t pass = 0; pass < TEST_BENCHMARK_PASSES; pass++) {
+            furi_hal_random_fill_buf(key, sizeof(key));
+            stream_clean(flipper_format_get_raw_stream(unknown));
+            flipper_format_write_uint32(unknown, "Bit", &bit, 1);
+            flipper_format_write_hex(unknown, "Key", key, sizeof(key));
+            unknown_cycles += subghz_keeloq_benchmark_decode(environment, decoder, unknown, text);
+        }
+
+        // Known remote, first decode fills the hit cache
+        for(size_t pass = 0; pass < TEST_KEELOQ_PASSES; pass++) {
+            uint32_t cycles = subghz_keeloq_benchmark_decode(environment, decoder, known, text);
+            if(pass == 0) {
+                first_cycles = cycles;
+            } else {
+                known_cycles += cycles;
+            }
+        }
+        if(furi_string_search_str(text, "MF:Unknown") != FURI_STRING_FAILURE) break;
+
+        printf(
+            "KeeLoq keystore: %zu keys\r\n",
+            SubGhzKeyArray_size(*subghz_keystore_get_data(keystore)));
+        printf(
+            "Unknown packet: %lu us, %lu attempts/s\r\n",
+            (uint32_t)(unknown_cycles / TEST_BENCHMARK_PASSES / cpu_mhz),
+            (uint32_t)((uint64_t)TEST_BENCHMARK_PASSES * cpu_mhz * 1000000 / unknown_cycles));
+        printf(
+            "Known remote: first %lu us, cached %lu us, %lu attempts/s\r\n",
+            first_cycles / cpu_mhz,
+            (uint32_t)(known_cycles / (TEST_KEELOQ_PASSES - 1) / cpu_mhz),
+            (uint32_t)((uint64_t)(TEST_KEELOQ_PASSES - 1) * cpu_mhz * 1000000 / known_cycles));
+        result = true;
+    } while(false);
+
+    furi_string_free(text);
+    flipper_format_free(unknown);
+    flipper_format_free(known);
+    if(receiver) subghz_receiver_free(receiver);
+    subghz_environment_free(environment);
+    storage_simply_remove(storage, TEST_KEELOQ_KEYS_NAME);
+    storage_simply_remove(storage, TEST_KEELOQ_KEYS_NAME ".kc");
+    furi_record_close(RECORD_STORAGE);
+
+    return result;
+}
+
+MU_TEST(subghz_keeloq_benchmark_test) {
+    mu_assert(subghz_keeloq_benchmark(), "KeeLoq benchmark error\r\n");
+}
+
+MU_TEST(subghz_raw_binary_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    mu_assert(
+        subghz_raw_binary_import_text(storage, TEST_RANDOM_DIR_NAME, TEST_RANDOM_BIN_NAME),
+        "Binary RAW import error\r\n");
+    mu_assert(subghz_decode_random_test(TEST_RANDOM_BIN_NAME), "Binary RAW decode error\r\n");
+
+    mu_assert(
+        subghz_raw_binary_export_text(storage, TEST_RANDOM_BIN_NAME, TEST_RANDOM_TEXT_NAME),
+        "Binary RAW export error\r\n");
+    mu_assert(subghz_decode_random_test(TEST_RANDOM_TEXT_NAME), "Text RAW decode error\r\n");
+
+    storage_simply_remove(storage, TEST_RANDOM_BIN_NAME);
+    storage_simply_remove(storage, TEST_RANDOM_TEXT_NAME);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void subghz_replay_rx_callback(bool level, uint32_t duration, void* context) {
+    UNUSED(context);
+    subghz_receiver_decode(receiver_handler, level, duration);
+}
+
+static bool subghz_replay_rx_test(const char* path) {
+    const SubGhzDevice* device = subghz_devices_get_by_name(SUBGHZ_DEVICE_REPLAY_NAME);
+    if(!device) return false;
+
+    subghz_test_decoder_count = 0;
+    subghz_receiver_reset(receiver_handler);
+
+    subghz_devices_begin(device);
+    subghz_device_replay_set_source(path);
+    subghz_device_replay_set_speed(0);
+    subghz_devices_start_async_rx(device, subghz_replay_rx_callback, NULL);
+
+    uint32_t test_start = furi_get_tick();
+    while(!subghz_device_replay_is_rx_complete() &&
+          (furi_get_tick() - test_start < TEST_TIMEOUT * 10)) {
+        furi_delay_ms(10);
+    }
+    subghz_devices_stop_async_rx(device);
+
+    SubGhzDeviceReplayStats stats;
+    subghz_device_replay_get_stats(&stats);
+    bool result = subghz_device_replay_is_rx_complete() && stats.rx_pulse_count;
+    subghz_devices_end(device);
+
+    FURI_LOG_D(
+        TAG,
+        "Replay RX pulses %lu, decoded %d",
+        stats.rx_pulse_count,
+        subghz_test_decoder_count);
+    return result && (subghz_test_decoder_count == TEST_RANDOM_COUNT_PARSE);
+}
+
+static bool subghz_replay_tx_test(const char* path, const char* protocol_name) {
+    const SubGhzDevice* device = subghz_devices_get_by_name(SUBGHZ_DEVICE_REPLAY_NAME);
+    if(!device) return false;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
+    SubGhzTransmitter* transmitter =
+        subghz_transmitter_alloc_init(environment_handler, protocol_name);
+    int32_t* buffer = malloc(TEST_REPLAY_TX_SIZE * sizeof(int32_t));
+    SubGhzDeviceReplayStats stats = {0};
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_existing(fff_data_file, path)) break;
+        if(subghz_transmitter_deserialize(transmitter, fff_data_file) != SubGhzProtocolStatusOk)
+            break;
+
+        subghz_devices_begin(device);
+        subghz_device_replay_set_speed(0);
+        subghz_device_replay_set_tx_buffer(buffer, TEST_REPLAY_TX_SIZE);
+        subghz_devices_start_async_tx(device, subghz_transmitter_yield, transmitter);
+
+        uint32_t test_start = furi_get_tick();
+        while(!subghz_devices_is_async_complete_tx(device) &&
+              (furi_get_tick() - test_start < TEST_TIMEOUT)) {
+            furi_delay_ms(10);
+        }
+        result = subghz_devices_is_async_complete_tx(device);
+        subghz_devices_stop_async_tx(device);
+        subghz_device_replay_get_stats(&stats);
+        subghz_devices_end(device);
+        if(!result) break;
+
+        // What went on air must decode back
+        subghz_test_decoder_count = 0;
+        subghz_receiver_reset(receiver_handler);
+        size_t count = MIN(stats.tx_sample_count, (uint32_t)TEST_REPLAY_TX_SIZE);
+        for(size_t i = 0; i < count; i++) {
+            bool level = buffer[i] > 0;
+            subghz_receiver_decode(receiver_handler, level, level ? buffer[i] : -buffer[i]);
+        }
+        result = subghz_test_decoder_count > 0;
+    } while(false);
+
+    FURI_LOG_D(
+        TAG,
+        "Replay TX samples %lu, refills %lu, underruns %lu, max refill %luus",
+        stats.tx_sample_count,
+        stats.tx_refill_count,
+        stats.tx_underrun_count,
+        stats.tx_refill_max);
+
+    free(buffer);
+    subghz_transmitter_free(transmitter);
+    flipper_format_free(fff_data_file);
+    furi_record_close(RECORD_STORAGE);
+    return result;
+}
+
+// Replay through the worker stream buffer like the app does, pulses it can not take are dropped
+static bool subghz_replay_load(const char* path, uint32_t speed, uint32_t* dropped) {
+    const SubGhzDevice* device = subghz_devices_get_by_name(SUBGHZ_DEVICE_REPLAY_NAME);
+    if(!device) return false;
+
+    SubGhzWorker* worker = subghz_worker_alloc();
+    subghz_worker_set_overrun_callback(worker, (SubGhzWorkerOverrunCallback)subghz_receiver_reset);
+    subghz_worker_set_batch_callback(
+        worker, (SubGhzWorkerBatchCallback)subghz_receiver_decode_batch);
+    subghz_worker_set_context(worker, receiver_handler);
+
+    subghz_test_decoder_count = 0;
+    subghz_receiver_reset(receiver_handler);
+
+    subghz_devices_begin(device);
+    subghz_device_replay_set_source(path);
+    subghz_device_replay_set_speed(speed);
+    subghz_worker_start(worker);
+    subghz_devices_start_async_rx(device, subghz_worker_rx_callback, worker);
+
+    uint32_t test_start = furi_get_tick();
+    while(!subghz_device_replay_is_rx_complete() &&
+          (furi_get_tick() - test_start < TEST_RANDOM_AIR_TIME / speed + TEST_TIMEOUT)) {
+        furi_delay_ms(10);
+    }
+    bool result = subghz_device_replay_is_rx_complete();
+    subghz_devices_stop_async_rx(device);
+    // Let the worker drain the stream buffer
+    furi_delay_ms(100);
+    subghz_worker_stop(worker);
+
+    SubGhzDeviceReplayStats stats;
+    subghz_device_replay_get_stats(&stats);
+    SubGhzWorkerStats worker_stats;
+    subghz_worker_get_stats(worker, &worker_stats);
+    subghz_devices_end(device);
+    subghz_worker_free(worker);
+
+    printf(
+        "Replay %lux: %lu pulses, %lu dropped, %lu late (max %lu us), "
+        "%lu source underruns, %d decoded\r\n",
+        speed,
+        stats.rx_pulse_count,
+        worker_stats.overrun_count,
+        stats.rx_late_count,
+        stats.rx_late_max,
+        stats.rx_source_underrun_count,
+        subghz_test_decoder_count);
+
+    *dropped = worker_stats.overrun_count;
+    return result && stats.rx_pulse_count;
+}
+
+MU_TEST(subghz_replay_load_test) {
+    uint32_t dropped = 0;
+    // The RX path has to keep up with twice the real pulse rate, higher rates show the limit
+    mu_assert(subghz_replay_load(TEST_RANDOM_DIR_NAME, 2, &dropped), "Replay 2x error\r\n");
+    mu_assert_int_eq(0, dropped);
+    mu_assert(subghz_replay_load(TEST_RANDOM_DIR_NAME, 5, &dropped), "Replay 5x error\r\n");
+    mu_assert(subghz_replay_load(TEST_RANDOM_DIR_NAME, 10, &dropped), "Replay 10x error\r\n");
+}
+
+MU_TEST(subghz_replay_device_test) {
+    mu_assert(subghz_replay_rx_test(TEST_RANDOM_DIR_NAME), "Replay device RX error\r\n");
+    mu_assert(
+        subghz_replay_tx_test(EXT_PATH("unit_tests/subghz/princeton.sub"), "Princeton"),
+        "Replay device TX error\r\n");
+}
+
+MU_TEST(subghz_receiver_benchmark_test) {
+    mu_assert(subghz_receiver_benchmark(TEST_RANDOM_DIR_NAME), "Receiver benchmark error\r\n");
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
+    MU_RUN_TEST(subghz_keystore_compiled_test);
 
     MU_RUN_TEST(subghz_hal_async_tx_test);
 
+    MU_RUN_TEST(subghz_block_pwm_test);
+
     MU_RUN_TEST(subghz_decoder_came_atomo_test);
     MU_RUN_TEST(subghz_decoder_came_test);
     MU_RUN_TEST(subghz_decoder_came_twee_test);
@@ -955,6 +1529,11 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_encoder_dickert_test);
 
     MU_RUN_TEST(subghz_random_test);
+    MU_RUN_TEST(subghz_raw_binary_test);
+    MU_RUN_TEST(subghz_replay_device_test);
+    MU_RUN_TEST(subghz_replay_load_test);
+    MU_RUN_TEST(subghz_receiver_benchmark_test);
+    MU_RUN_TEST(subghz_keeloq_benchmark_test);
     subghz_test_deinit();
 }
 
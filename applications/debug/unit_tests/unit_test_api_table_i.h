@@ -1,6 +1,7 @@
 #include <update_util/resources/manifest.h>
 #include <nfc/protocols/slix/slix_i.h>
 #include <nfc/protocols/iso15693_3/iso15693_3_poller_i.h>
+#include <nfc/nfc_mock.h>
 #include <FreeRTOS.h>
 #include <FreeRTOS-Kernel/include/queue.h>
 #include <task.h>
@@ -9,6 +10,15 @@
 #include <flipper.pb.h>
 #include <applications/system/js_app/js_thread.h>
 
+// Nfc mock replaces the transport layer only in the full unit test firmware
+#ifdef FW_CFG_unit_tests
+#define UNIT_TESTS_NFC_MOCK_API                 \
+    API_METHOD(nfc_mock_reset_stats, void, ()), \
+    API_METHOD(nfc_mock_get_stats, void, (NfcMockStats*)),
+#else
+#define UNIT_TESTS_NFC_MOCK_API
+#endif
+
 static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_alloc, ResourceManifestReader*, (Storage*)),
     API_METHOD(resource_manifest_reader_free, void, (ResourceManifestReader*)),
@@ -17,6 +27,7 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_previous, ResourceManifestEntry*, (ResourceManifestReader*)),
     API_METHOD(slix_process_iso15693_3_error, SlixError, (Iso15693_3Error)),
     API_METHOD(iso15693_3_poller_get_data, const Iso15693_3Data*, (Iso15693_3Poller*)),
+    UNIT_TESTS_NFC_MOCK_API
     API_METHOD(rpc_system_storage_get_error, PB_CommandStatus, (FS_Error)),
     API_METHOD(xQueueSemaphoreTake, BaseType_t, (QueueHandle_t, TickType_t)),
     API_METHOD(
@@ -245,52 +245,62 @@ static bool
     return ret;
 }
 
+typedef struct {
+    InfraredSignal* signal;
+    FlipperFormat* output_file;
+    const char* signal_name;
+    bool is_saved;
+} InfraredCliDecodeContext;
+
+static void
+    infrared_cli_decode_raw_signal_callback(const InfraredMessage* message, void* context) {
+    InfraredCliDecodeContext* decode_context = context;
+
+    printf(
+        "Protocol: %s address: 0x%lX command: 0x%lX %s\r\n",
+        infrared_get_protocol_name(message->protocol),
+        message->address,
+        message->command,
+        (message->repeat ? "R" : ""));
+    if(decode_context->output_file && decode_context->is_saved && !message->repeat) {
+        infrared_signal_set_message(decode_context->signal, message);
+        decode_context->is_saved = infrared_cli_save_signal(
+            decode_context->signal, decode_context->output_file, decode_context->signal_name);
+    }
+}
+
 static bool infrared_cli_decode_raw_signal(
     const InfraredRawSignal* raw_signal,
     InfraredDecoderHandler* decoder,
     FlipperFormat* output_file,
     const char* signal_name) {
-    InfraredSignal* signal = infrared_signal_alloc();
-    bool ret = false, level = true, is_decoded = false;
-
-    size_t i;
-    for(i = 0; i < raw_signal->timings_size; ++i) {
-        const InfraredMessage* message = infrared_decode(decoder, level, raw_signal->timings[i]);
-
-        if(message) {
-            is_decoded = true;
-            printf(
-                "Protocol: %s address: 0x%lX command: 0x%lX %s\r\n",
-                infrared_get_protocol_name(message->protocol),
-                message->address,
-                message->command,
-                (message->repeat ? "R" : ""));
-            if(output_file && !message->repeat) {
-                infrared_signal_set_message(signal, message);
-                if(!infrared_cli_save_signal(signal, output_file, signal_name)) break;
-            }
-        }
-
-        level = !level;
-    }
-
-    if(i == raw_signal->timings_size) {
-        if(!is_decoded && output_file) {
-            infrared_signal_set_raw_signal(
-                signal,
-                raw_signal->timings,
-                raw_signal->timings_size,
-                raw_signal->frequency,
-                raw_signal->duty_cycle);
-            ret = infrared_cli_save_signal(signal, output_file, signal_name);
-        } else {
-            ret = true;
-        }
+    InfraredCliDecodeContext context = {
+        .signal = infrared_signal_alloc(),
+        .output_file = output_file,
+        .signal_name = signal_name,
+        .is_saved = true,
+    };
+
+    size_t message_count = infrared_decode_timings(
+        decoder,
+        raw_signal->timings,
+        raw_signal->timings_size,
+        infrared_cli_decode_raw_signal_callback,
+        &context);
+
+    if(!message_count && output_file) {
+        infrared_signal_set_raw_signal(
+            context.signal,
+            raw_signal->timings,
+            raw_signal->timings_size,
+            raw_signal->frequency,
+            raw_signal->duty_cycle);
+        context.is_saved = infrared_cli_save_signal(context.signal, output_file, signal_name);
     }
 
     infrared_reset_decoder(decoder);
-    infrared_signal_free(signal);
-    return ret;
+    infrared_signal_free(context.signal);
+    return context.is_saved;
 }
 
 static bool infrared_cli_decode_file(FlipperFormat* input_file, FlipperFormat* output_file) {
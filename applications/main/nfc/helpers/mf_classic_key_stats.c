@@ -0,0 +1,289 @@
+#include "mf_classic_key_stats.h"
+
+#include <furi/furi.h>
+#include <storage/storage.h>
+
+#define TAG "MfClassicKeyStats"
+
+#define NFC_APP_KEY_STATS_FOLDER    "/ext/nfc/.cache"
+#define NFC_APP_KEY_STATS_FILE_PATH NFC_APP_KEY_STATS_FOLDER "/mf_classic_key_stats.bin"
+
+#define MF_CLASSIC_KEY_STATS_MAGIC       0x534B434D // "MCKS"
+#define MF_CLASSIC_KEY_STATS_VERSION     1
+#define MF_CLASSIC_KEY_STATS_RECORDS_MAX 256
+
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved;
+    uint16_t record_count;
+    uint32_t attempts;
+    uint32_t keys_found;
+} MfClassicKeyStatsHeader;
+
+// Hits of one key on one sector, records are sorted by key then sector
+typedef struct FURI_PACKED {
+    MfClassicKey key;
+    uint8_t sector;
+    uint8_t reserved;
+    uint16_t hits;
+} MfClassicKeyStatsRecord;
+
+struct MfClassicKeyStats {
+    MfClassicKeyStatsHeader header;
+    MfClassicKeyStatsRecord* records;
+};
+
+static int mf_classic_key_stats_record_cmp(
+    const MfClassicKeyStatsRecord* record,
+    const MfClassicKey* key,
+    uint8_t sector) {
+    int cmp = memcmp(record->key.data, key->data, sizeof(MfClassicKey));
+    if(cmp == 0) cmp = (int)record->sector - (int)sector;
+    return cmp;
+}
+
+static size_t mf_classic_key_stats_find(
+    MfClassicKeyStats* instance,
+    const MfClassicKey* key,
+    uint8_t sector,
+    bool* found) {
+    size_t low = 0;
+    size_t high = instance->header.record_count;
+    *found = false;
+
+    while(low < high) {
+        size_t mid = low + (high - low) / 2;
+        int cmp = mf_classic_key_stats_record_cmp(&instance->records[mid], key, sector);
+        if(cmp == 0) {
+            *found = true;
+            return mid;
+        } else if(cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+static void mf_classic_key_stats_remove(MfClassicKeyStats* instance, size_t index) {
+    instance->header.record_count--;
+    memmove(
+        &instance->records[index],
+        &instance->records[index + 1],
+        (instance->header.record_count - index) * sizeof(MfClassicKeyStatsRecord));
+}
+
+// Halve all counters so old hits weigh less than recent ones
+static void mf_classic_key_stats_age(MfClassicKeyStats* instance) {
+    size_t i = 0;
+    while(i < instance->header.record_count) {
+        instance->records[i].hits /= 2;
+        if(instance->records[i].hits == 0) {
+            mf_classic_key_stats_remove(instance, i);
+        } else {
+            i++;
+        }
+    }
+}
+
+static void mf_classic_key_stats_add_hit(
+    MfClassicKeyStats* instance,
+    const MfClassicKey* key,
+    uint8_t sector) {
+    bool found = false;
+    size_t index = mf_classic_key_stats_find(instance, key, sector, &found);
+
+    if(found) {
+        if(instance->records[index].hits == UINT16_MAX) {
+            mf_classic_key_stats_age(instance);
+            index = mf_classic_key_stats_find(instance, key, sector, &found);
+        }
+        if(found) {
+            instance->records[index].hits++;
+            return;
+        }
+    }
+
+    if(instance->header.record_count == MF_CLASSIC_KEY_STATS_RECORDS_MAX) {
+        // Make room by dropping the least used record
+        size_t victim = 0;
+        for(size_t i = 1; i < instance->header.record_count; i++) {
+            if(instance->records[i].hits < instance->records[victim].hits) victim = i;
+        }
+        mf_classic_key_stats_remove(instance, victim);
+        if(victim < index) index--;
+    }
+
+    memmove(
+        &instance->records[index + 1],
+        &instance->records[index],
+        (instance->header.record_count - index) * sizeof(MfClassicKeyStatsRecord));
+    instance->records[index] = (MfClassicKeyStatsRecord){
+        .key = *key,
+        .sector = sector,
+        .hits = 1,
+    };
+    instance->header.record_count++;
+}
+
+MfClassicKeyStats* mf_classic_key_stats_alloc(void) {
+    MfClassicKeyStats* instance = malloc(sizeof(MfClassicKeyStats));
+    instance->header.magic = MF_CLASSIC_KEY_STATS_MAGIC;
+    instance->header.version = MF_CLASSIC_KEY_STATS_VERSION;
+    instance->records = malloc(MF_CLASSIC_KEY_STATS_RECORDS_MAX * sizeof(MfClassicKeyStatsRecord));
+
+    return instance;
+}
+
+void mf_classic_key_stats_free(MfClassicKeyStats* instance) {
+    furi_assert(instance);
+
+    free(instance->records);
+    free(instance);
+}
+
+bool mf_classic_key_stats_load(MfClassicKeyStats* instance) {
+    furi_assert(instance);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    MfClassicKeyStatsHeader header;
+
+    bool load_success = false;
+    do {
+        if(!storage_file_open(file, NFC_APP_KEY_STATS_FILE_PATH, FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != MF_CLASSIC_KEY_STATS_MAGIC ||
+           header.version != MF_CLASSIC_KEY_STATS_VERSION ||
+           header.record_count > MF_CLASSIC_KEY_STATS_RECORDS_MAX) {
+            FURI_LOG_W(TAG, "Unknown key stats format");
+            break;
+        }
+        size_t records_size = header.record_count * sizeof(MfClassicKeyStatsRecord);
+        if(storage_file_read(file, instance->records, records_size) != records_size) break;
+
+        instance->header = header;
+        FURI_LOG_I(
+            TAG,
+            "Loaded %u records, %lu keys found in %lu attempts",
+            header.record_count,
+            header.keys_found,
+            header.attempts);
+        load_success = true;
+    } while(false);
+
+    if(!load_success) instance->header.record_count = 0;
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return load_success;
+}
+
+bool mf_classic_key_stats_save(MfClassicKeyStats* instance) {
+    furi_assert(instance);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    bool save_success = false;
+    do {
+        if(!storage_simply_mkdir(storage, NFC_APP_KEY_STATS_FOLDER)) break;
+        if(!storage_file_open(file, NFC_APP_KEY_STATS_FILE_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+        if(storage_file_write(file, &instance->header, sizeof(instance->header)) !=
+           sizeof(instance->header))
+            break;
+        size_t records_size = instance->header.record_count * sizeof(MfClassicKeyStatsRecord);
+        if(storage_file_write(file, instance->records, records_size) != records_size) break;
+
+        save_success = true;
+    } while(false);
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return save_success;
+}
+
+void mf_classic_key_stats_add_data(
+    MfClassicKeyStats* instance,
+    const MfClassicData* data,
+    size_t attempts) {
+    furi_assert(instance);
+    furi_assert(data);
+
+    size_t keys_found = 0;
+    uint8_t sectors_total = mf_classic_get_total_sectors_num(data->type);
+    for(uint8_t i = 0; i < sectors_total; i++) {
+        MfClassicSectorTrailer* sec_tr = mf_classic_get_sector_trailer_by_sector(data, i);
+        bool key_a_found = mf_classic_is_key_found(data, i, MfClassicKeyTypeA);
+        bool key_b_found = mf_classic_is_key_found(data, i, MfClassicKeyTypeB);
+
+        // Same key for A and B unlocked the sector once
+        bool keys_equal =
+            memcmp(sec_tr->key_a.data, sec_tr->key_b.data, sizeof(MfClassicKey)) == 0;
+
+        if(key_a_found) {
+            mf_classic_key_stats_add_hit(instance, &sec_tr->key_a, i);
+            keys_found++;
+        }
+        if(key_b_found) {
+            if(!(key_a_found && keys_equal)) {
+                mf_classic_key_stats_add_hit(instance, &sec_tr->key_b, i);
+            }
+            keys_found++;
+        }
+    }
+
+    instance->header.attempts += attempts;
+    instance->header.keys_found += keys_found;
+    if(keys_found) {
+        FURI_LOG_I(TAG, "%zu keys found in %zu attempts", keys_found, attempts);
+    }
+}
+
+size_t mf_classic_key_stats_get_ranked_keys(
+    MfClassicKeyStats* instance,
+    uint8_t sector,
+    MfClassicKey* keys,
+    size_t count) {
+    furi_assert(instance);
+    furi_assert(keys);
+
+    uint64_t scores[MF_CLASSIC_KEY_STATS_RANKED_MAX];
+    count = MIN(count, (size_t)MF_CLASSIC_KEY_STATS_RANKED_MAX);
+    size_t ranked = 0;
+
+    size_t i = 0;
+    while(i < instance->header.record_count) {
+        // Records of one key are next to each other
+        const MfClassicKey* key = &instance->records[i].key;
+        uint32_t hits_total = 0;
+        uint32_t hits_sector = 0;
+        for(; i < instance->header.record_count &&
+              memcmp(instance->records[i].key.data, key->data, sizeof(MfClassicKey)) == 0;
+            i++) {
+            hits_total += instance->records[i].hits;
+            if(instance->records[i].sector == sector) hits_sector = instance->records[i].hits;
+        }
+
+        uint64_t score = ((uint64_t)hits_sector << 32) | hits_total;
+        size_t pos = ranked;
+        while(pos > 0 && scores[pos - 1] < score) pos--;
+        if(pos >= count) continue;
+
+        size_t tail = MIN(ranked, count - 1) - pos;
+        memmove(&scores[pos + 1], &scores[pos], tail * sizeof(uint64_t));
+        memmove(&keys[pos + 1], &keys[pos], tail * sizeof(MfClassicKey));
+        scores[pos] = score;
+        keys[pos] = *key;
+        if(ranked < count) ranked++;
+    }
+
+    return ranked;
+}
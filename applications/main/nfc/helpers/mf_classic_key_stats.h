@@ -0,0 +1,51 @@
+#pragma once
+
+#include <nfc/protocols/mf_classic/mf_classic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MF_CLASSIC_KEY_STATS_RANKED_MAX (16)
+
+typedef struct MfClassicKeyStats MfClassicKeyStats;
+
+MfClassicKeyStats* mf_classic_key_stats_alloc(void);
+
+void mf_classic_key_stats_free(MfClassicKeyStats* instance);
+
+bool mf_classic_key_stats_load(MfClassicKeyStats* instance);
+
+bool mf_classic_key_stats_save(MfClassicKeyStats* instance);
+
+/** Count every key found on a card as a hit for its sector
+ *
+ * @param instance  - MfClassicKeyStats instance
+ * @param data      - Card data with found keys
+ * @param attempts  - Number of keys tried to get them
+ */
+void mf_classic_key_stats_add_data(
+    MfClassicKeyStats* instance,
+    const MfClassicData* data,
+    size_t attempts);
+
+/** Get keys to try first for a sector
+ * Keys that unlocked this sector most often come first, then keys with the
+ * most hits on any sector.
+ *
+ * @param instance  - MfClassicKeyStats instance
+ * @param sector    - Sector number
+ * @param keys      - Array of count keys where to store keys
+ * @param count     - Maximum number of keys
+ *
+ * @return Number of keys stored
+ */
+size_t mf_classic_key_stats_get_ranked_keys(
+    MfClassicKeyStats* instance,
+    uint8_t sector,
+    MfClassicKey* keys,
+    size_t count);
+
+#ifdef __cplusplus
+}
+#endif
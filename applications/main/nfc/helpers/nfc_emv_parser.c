@@ -1,35 +1,409 @@
 #include "nfc_emv_parser.h"
-#include <flipper_format/flipper_format.h>
+#include <toolbox/hex.h>
+#include <toolbox/stream/buffered_file_stream.h>
+
+#define TAG "NfcEmvParser"
+
+#define NFC_EMV_PARSER_COMPILED_EXTENSION ".idx"
+#define NFC_EMV_PARSER_COMPILED_MAGIC     0x49524D45 // "EMRI"
+#define NFC_EMV_PARSER_COMPILED_VERSION   1
+#define NFC_EMV_PARSER_KEY_SIZE_MAX       16
+#define NFC_EMV_PARSER_CACHE_SIZE         8
+#define NFC_EMV_PARSER_CACHE_NAME_SIZE    32
 
 static const char* nfc_resources_header = "Flipper EMV resources";
 static const uint32_t nfc_resources_file_version = 1;
 
-static bool nfc_emv_parser_search_data(
-    Storage* storage,
-    const char* file_name,
-    FuriString* key,
-    FuriString* data) {
-    bool parsed = false;
-    FlipperFormat* file = flipper_format_file_alloc(storage);
-    FuriString* temp_str;
-    temp_str = furi_string_alloc();
+static const char* nfc_emv_parser_resource_paths[NfcEmvParserResourceNum] = {
+    [NfcEmvParserResourceAid] = EXT_PATH("nfc/assets/aid.nfc"),
+    [NfcEmvParserResourceCountry] = EXT_PATH("nfc/assets/country_code.nfc"),
+    [NfcEmvParserResourceCurrency] = EXT_PATH("nfc/assets/currency_code.nfc"),
+};
+
+// Compiled resource: header, entries sorted by key, then a pool of names
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved[3];
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t entry_count;
+} NfcEmvParserCompiledHeader;
+
+typedef struct FURI_PACKED {
+    uint8_t key_len;
+    uint8_t key[NFC_EMV_PARSER_KEY_SIZE_MAX];
+    uint8_t name_len;
+    uint16_t name_offset;
+} NfcEmvParserCompiledEntry;
+
+typedef struct {
+    uint8_t key_len;
+    uint8_t key[NFC_EMV_PARSER_KEY_SIZE_MAX];
+    NfcEmvParserResource resource;
+    uint32_t last_used;
+    char name[NFC_EMV_PARSER_CACHE_NAME_SIZE];
+} NfcEmvParserCacheEntry;
+
+typedef struct {
+    NfcEmvParserCacheEntry entries[NFC_EMV_PARSER_CACHE_SIZE];
+    uint32_t use_counter;
+} NfcEmvParserCache;
+
+// Recent answers, a card shows the same few codes over and over
+static NfcEmvParserCache nfc_emv_parser_cache;
+
+static int nfc_emv_parser_key_cmp(
+    const uint8_t* key_a,
+    uint8_t key_a_len,
+    const uint8_t* key_b,
+    uint8_t key_b_len) {
+    if(key_a_len != key_b_len) return (int)key_a_len - (int)key_b_len;
+    return memcmp(key_a, key_b, key_a_len);
+}
+
+static bool nfc_emv_parser_cache_get(
+    NfcEmvParserResource resource,
+    const uint8_t* key,
+    uint8_t key_len,
+    FuriString* name) {
+    NfcEmvParserCache* cache = &nfc_emv_parser_cache;
+
+    for(size_t i = 0; i < NFC_EMV_PARSER_CACHE_SIZE; i++) {
+        NfcEmvParserCacheEntry* entry = &cache->entries[i];
+        if(entry->last_used == 0 || entry->resource != resource) continue;
+        if(nfc_emv_parser_key_cmp(entry->key, entry->key_len, key, key_len) != 0) continue;
+
+        entry->last_used = ++cache->use_counter;
+        furi_string_set_str(name, entry->name);
+        return true;
+    }
+
+    return false;
+}
+
+static void nfc_emv_parser_cache_put(
+    NfcEmvParserResource resource,
+    const uint8_t* key,
+    uint8_t key_len,
+    const char* name) {
+    NfcEmvParserCache* cache = &nfc_emv_parser_cache;
+    if(strlen(name) >= NFC_EMV_PARSER_CACHE_NAME_SIZE) return;
+
+    NfcEmvParserCacheEntry* victim = &cache->entries[0];
+    for(size_t i = 1; i < NFC_EMV_PARSER_CACHE_SIZE; i++) {
+        if(cache->entries[i].last_used < victim->last_used) victim = &cache->entries[i];
+    }
+
+    victim->resource = resource;
+    victim->key_len = key_len;
+    memcpy(victim->key, key, key_len);
+    strlcpy(victim->name, name, sizeof(victim->name));
+    victim->last_used = ++cache->use_counter;
+}
+
+static bool nfc_emv_parser_parse_line(
+    FuriString* line,
+    NfcEmvParserCompiledEntry* entry,
+    FuriString* name) {
+    furi_string_trim(line);
+    if(furi_string_empty(line) || furi_string_get_char(line, 0) == '#') return false;
+
+    size_t separator = furi_string_search_str(line, ": ");
+    if(separator == FURI_STRING_FAILURE || separator % 2 ||
+       separator / 2 > NFC_EMV_PARSER_KEY_SIZE_MAX)
+        return false;
+
+    const char* line_str = furi_string_get_cstr(line);
+    entry->key_len = separator / 2;
+    for(size_t i = 0; i < entry->key_len; i++) {
+        if(!hex_char_to_uint8(line_str[i * 2], line_str[i * 2 + 1], &entry->key[i])) {
+            return false;
+        }
+    }
+
+    furi_string_set_str(name, &line_str[separator + 2]);
+    furi_string_trim(name);
+    return furi_string_size(name) <= UINT8_MAX;
+}
+
+static bool nfc_emv_parser_compile(
+    Stream* source,
+    const char* compiled_path,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    FuriString* line = furi_string_alloc();
+    FuriString* name = furi_string_alloc();
+    FuriString* names = furi_string_alloc();
+    NfcEmvParserCompiledEntry* entries = NULL;
+    size_t entry_count = 0;
+    bool compiled = false;
 
     do {
-        // Open file
-        if(!flipper_format_file_open_existing(file, file_name)) break;
-        // Read file header and version
-        uint32_t version = 0;
-        if(!flipper_format_read_header(file, temp_str, &version)) break;
-        if(furi_string_cmp_str(temp_str, nfc_resources_header) ||
-           (version != nfc_resources_file_version))
+        // Validate file header
+        if(!stream_read_line(source, line)) break;
+        furi_string_trim(line);
+        if(!furi_string_start_with_str(line, "Filetype: ")) break;
+        furi_string_right(line, strlen("Filetype: "));
+        if(furi_string_cmp_str(line, nfc_resources_header) != 0) break;
+        if(!stream_read_line(source, line)) break;
+        furi_string_trim(line);
+        if(!furi_string_start_with_str(line, "Version: ")) break;
+        uint32_t version = strtoul(furi_string_get_cstr(line) + strlen("Version: "), NULL, 10);
+        if(version != nfc_resources_file_version) break;
+
+        // Entries are kept sorted while reading, the first one of equal keys wins
+        size_t entry_capacity = 64;
+        entries = malloc(entry_capacity * sizeof(NfcEmvParserCompiledEntry));
+        NfcEmvParserCompiledEntry entry = {};
+        bool pool_full = false;
+        while(stream_read_line(source, line)) {
+            if(!nfc_emv_parser_parse_line(line, &entry, name)) continue;
+
+            size_t low = 0;
+            size_t high = entry_count;
+            bool duplicate = false;
+            while(low < high && !duplicate) {
+                size_t mid = low + (high - low) / 2;
+                int cmp = nfc_emv_parser_key_cmp(
+                    entries[mid].key, entries[mid].key_len, entry.key, entry.key_len);
+                if(cmp == 0) {
+                    duplicate = true;
+                } else if(cmp < 0) {
+                    low = mid + 1;
+                } else {
+                    high = mid;
+                }
+            }
+            if(duplicate) continue;
+            if(furi_string_size(names) + furi_string_size(name) > UINT16_MAX) {
+                pool_full = true;
+                break;
+            }
+
+            if(entry_count == entry_capacity) {
+                entry_capacity *= 2;
+                entries = realloc(entries, entry_capacity * sizeof(NfcEmvParserCompiledEntry));
+            }
+            memmove(
+                &entries[low + 1],
+                &entries[low],
+                (entry_count - low) * sizeof(NfcEmvParserCompiledEntry));
+            entry.name_len = furi_string_size(name);
+            entry.name_offset = furi_string_size(names);
+            entries[low] = entry;
+            entry_count++;
+            furi_string_cat(names, name);
+        }
+        // A truncated table would silently miss names, keep no table at all
+        if(pool_full) {
+            FURI_LOG_E(
+                TAG,
+                "Names of %s exceed %u bytes after %zu entries",
+                compiled_path,
+                UINT16_MAX,
+                entry_count);
             break;
-        if(!flipper_format_read_string(file, furi_string_get_cstr(key), data)) break;
-        parsed = true;
+        }
+
+        NfcEmvParserCompiledHeader header = {
+            .magic = NFC_EMV_PARSER_COMPILED_MAGIC,
+            .version = NFC_EMV_PARSER_COMPILED_VERSION,
+            .source_size = source_size,
+            .source_timestamp = source_timestamp,
+            .entry_count = entry_count,
+        };
+        size_t entries_size = entry_count * sizeof(NfcEmvParserCompiledEntry);
+
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        File* file = storage_file_alloc(storage);
+        if(storage_file_open(file, compiled_path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+           storage_file_write(file, &header, sizeof(header)) == sizeof(header) &&
+           storage_file_write(file, entries, entries_size) == entries_size &&
+           storage_file_write(file, furi_string_get_cstr(names), furi_string_size(names)) ==
+               furi_string_size(names)) {
+            FURI_LOG_I(TAG, "Compiled %s with %zu entries", compiled_path, entry_count);
+            compiled = true;
+        }
+        storage_file_free(file);
+        if(!compiled) storage_common_remove(storage, compiled_path);
+        furi_record_close(RECORD_STORAGE);
     } while(false);
 
-    furi_string_free(temp_str);
-    flipper_format_free(file);
-    return parsed;
+    free(entries);
+    furi_string_free(names);
+    furi_string_free(name);
+    furi_string_free(line);
+
+    return compiled;
+}
+
+static bool nfc_emv_parser_compiled_check(File* file, uint32_t source_size, uint32_t timestamp) {
+    NfcEmvParserCompiledHeader header;
+
+    if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) return false;
+    if(header.magic != NFC_EMV_PARSER_COMPILED_MAGIC ||
+       header.version != NFC_EMV_PARSER_COMPILED_VERSION)
+        return false;
+
+    return header.source_size == source_size && header.source_timestamp == timestamp;
+}
+
+// Open the compiled copy of a resource, rebuilding it when the source changed
+static bool nfc_emv_parser_open_compiled(
+    Storage* storage,
+    NfcEmvParserResource resource,
+    File* file,
+    uint32_t* entry_count) {
+    const char* source_path = nfc_emv_parser_resource_paths[resource];
+    FuriString* compiled_path =
+        furi_string_alloc_printf("%s%s", source_path, NFC_EMV_PARSER_COMPILED_EXTENSION);
+    Stream* source = buffered_file_stream_alloc(storage);
+    bool opened = false;
+
+    do {
+        if(!buffered_file_stream_open(source, source_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        uint32_t source_size = stream_size(source);
+        uint32_t source_timestamp = 0;
+        if(storage_common_timestamp(storage, source_path, &source_timestamp) != FSE_OK) break;
+
+        const char* path = furi_string_get_cstr(compiled_path);
+        if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            if(nfc_emv_parser_compiled_check(file, source_size, source_timestamp)) {
+                opened = true;
+                break;
+            }
+            storage_file_close(file);
+        }
+
+        if(!nfc_emv_parser_compile(source, path, source_size, source_timestamp)) break;
+        if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        opened = nfc_emv_parser_compiled_check(file, source_size, source_timestamp);
+    } while(false);
+
+    if(opened) {
+        storage_file_seek(file, offsetof(NfcEmvParserCompiledHeader, entry_count), true);
+        opened = storage_file_read(file, entry_count, sizeof(uint32_t)) == sizeof(uint32_t);
+    }
+
+    buffered_file_stream_close(source);
+    stream_free(source);
+    furi_string_free(compiled_path);
+
+    return opened;
+}
+
+static bool nfc_emv_parser_compiled_search(
+    File* file,
+    uint32_t entry_count,
+    const uint8_t* key,
+    uint8_t key_len,
+    FuriString* name) {
+    const uint32_t entries_offset = sizeof(NfcEmvParserCompiledHeader);
+    NfcEmvParserCompiledEntry entry;
+    size_t low = 0;
+    size_t high = entry_count;
+    bool found = false;
+
+    while(low < high) {
+        size_t mid = low + (high - low) / 2;
+        if(!storage_file_seek(file, entries_offset + mid * sizeof(entry), true) ||
+           storage_file_read(file, &entry, sizeof(entry)) != sizeof(entry)) {
+            break;
+        }
+
+        int cmp = nfc_emv_parser_key_cmp(entry.key, entry.key_len, key, key_len);
+        if(cmp == 0) {
+            found = true;
+            break;
+        } else if(cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if(found) {
+        char name_str[UINT8_MAX + 1];
+        uint32_t names_offset = entries_offset + entry_count * sizeof(entry);
+        found = storage_file_seek(file, names_offset + entry.name_offset, true) &&
+                storage_file_read(file, name_str, entry.name_len) == entry.name_len;
+        if(found) {
+            name_str[entry.name_len] = '\0';
+            furi_string_set_str(name, name_str);
+        }
+    }
+
+    return found;
+}
+
+static void nfc_emv_parser_get_request_key(
+    const NfcEmvParserRequest* request,
+    uint8_t* key,
+    uint8_t* key_len) {
+    if(request->resource == NfcEmvParserResourceAid) {
+        *key_len = MIN(request->aid_len, NFC_EMV_PARSER_KEY_SIZE_MAX);
+        memcpy(key, request->aid, *key_len);
+    } else {
+        *key_len = sizeof(uint16_t);
+        key[0] = request->code >> 8;
+        key[1] = request->code & 0xFF;
+    }
+}
+
+size_t nfc_emv_parser_get_names(Storage* storage, NfcEmvParserRequest* requests, size_t count) {
+    furi_assert(storage);
+    furi_assert(requests);
+
+    uint8_t key[NFC_EMV_PARSER_KEY_SIZE_MAX];
+    uint8_t key_len = 0;
+    bool pending[NfcEmvParserResourceNum] = {};
+    size_t found_count = 0;
+
+    for(size_t i = 0; i < count; i++) {
+        NfcEmvParserRequest* request = &requests[i];
+        furi_check(request->resource < NfcEmvParserResourceNum);
+
+        nfc_emv_parser_get_request_key(request, key, &key_len);
+        request->found = nfc_emv_parser_cache_get(request->resource, key, key_len, request->name);
+        if(request->found) {
+            found_count++;
+        } else if(key_len) {
+            pending[request->resource] = true;
+        }
+    }
+
+    // Each resource file is opened once for all requests left
+    File* file = storage_file_alloc(storage);
+    for(size_t resource = 0; resource < NfcEmvParserResourceNum; resource++) {
+        if(!pending[resource]) continue;
+
+        uint32_t entry_count = 0;
+        if(!nfc_emv_parser_open_compiled(storage, resource, file, &entry_count)) {
+            FURI_LOG_W(TAG, "Failed to open %s", nfc_emv_parser_resource_paths[resource]);
+            continue;
+        }
+
+        for(size_t i = 0; i < count; i++) {
+            NfcEmvParserRequest* request = &requests[i];
+            if(request->resource != resource || request->found) continue;
+
+            nfc_emv_parser_get_request_key(request, key, &key_len);
+            if(!key_len) continue;
+            request->found =
+                nfc_emv_parser_compiled_search(file, entry_count, key, key_len, request->name);
+            if(request->found) {
+                nfc_emv_parser_cache_put(
+                    resource, key, key_len, furi_string_get_cstr(request->name));
+                found_count++;
+            }
+        }
+
+        storage_file_close(file);
+    }
+    storage_file_free(file);
+
+    return found_count;
 }
 
 bool nfc_emv_parser_get_aid_name(
@@ -38,45 +412,39 @@ bool nfc_emv_parser_get_aid_name(
     uint8_t aid_len,
     FuriString* aid_name) {
     furi_assert(storage);
-    bool parsed = false;
-    FuriString* key;
-    key = furi_string_alloc();
-    for(uint8_t i = 0; i < aid_len; i++) {
-        furi_string_cat_printf(key, "%02X", aid[i]);
-    }
-    if(nfc_emv_parser_search_data(storage, EXT_PATH("nfc/assets/aid.nfc"), key, aid_name)) {
-        parsed = true;
-    }
-    furi_string_free(key);
-    return parsed;
+
+    NfcEmvParserRequest request = {
+        .resource = NfcEmvParserResourceAid,
+        .aid = aid,
+        .aid_len = aid_len,
+        .name = aid_name,
+    };
+
+    return nfc_emv_parser_get_names(storage, &request, 1) == 1;
 }
 
 bool nfc_emv_parser_get_country_name(
     Storage* storage,
     uint16_t country_code,
     FuriString* country_name) {
-    bool parsed = false;
-    FuriString* key;
-    key = furi_string_alloc_printf("%04X", country_code);
-    if(nfc_emv_parser_search_data(
-           storage, EXT_PATH("nfc/assets/country_code.nfc"), key, country_name)) {
-        parsed = true;
-    }
-    furi_string_free(key);
-    return parsed;
+    NfcEmvParserRequest request = {
+        .resource = NfcEmvParserResourceCountry,
+        .code = country_code,
+        .name = country_name,
+    };
+
+    return nfc_emv_parser_get_names(storage, &request, 1) == 1;
 }
 
 bool nfc_emv_parser_get_currency_name(
     Storage* storage,
     uint16_t currency_code,
     FuriString* currency_name) {
-    bool parsed = false;
-    FuriString* key;
-    key = furi_string_alloc_printf("%04X", currency_code);
-    if(nfc_emv_parser_search_data(
-           storage, EXT_PATH("nfc/assets/currency_code.nfc"), key, currency_name)) {
-        parsed = true;
-    }
-    furi_string_free(key);
-    return parsed;
+    NfcEmvParserRequest request = {
+        .resource = NfcEmvParserResourceCurrency,
+        .code = currency_code,
+        .name = currency_name,
+    };
+
+    return nfc_emv_parser_get_names(storage, &request, 1) == 1;
 }
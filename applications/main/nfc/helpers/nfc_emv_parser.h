@@ -4,6 +4,35 @@
 #include <stdbool.h>
 #include <storage/storage.h>
 
+/** Resources names can be looked up in */
+typedef enum {
+    NfcEmvParserResourceAid,
+    NfcEmvParserResourceCountry,
+    NfcEmvParserResourceCurrency,
+
+    NfcEmvParserResourceNum,
+} NfcEmvParserResource;
+
+/** One name lookup for nfc_emv_parser_get_names() */
+typedef struct {
+    NfcEmvParserResource resource; /**< Resource to search */
+    const uint8_t* aid; /**< AID number array, for NfcEmvParserResourceAid */
+    uint8_t aid_len; /**< AID length */
+    uint16_t code; /**< Country or currency code for the other resources */
+    FuriString* name; /**< String to keep the name, left untouched if not found */
+    bool found; /**< Set to true if the name was found */
+} NfcEmvParserRequest;
+
+/** Get names for several codes at once
+ * Every resource file is opened once for all its requests. Resources are
+ * compiled to a sorted table next to the source file on first use.
+ * @param storage Storage instance
+ * @param requests - array of requests
+ * @param count - number of requests
+ * @return - number of names found
+ */
+size_t nfc_emv_parser_get_names(Storage* storage, NfcEmvParserRequest* requests, size_t count);
+
 /** Get EMV application name by number
  * @param storage Storage instance
  * @param aid - AID number array
@@ -8,6 +8,10 @@
 #include <flipper_application/plugins/composite_resolver.h>
 #include <loader/firmware_api/firmware_api.h>
 
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
+#include <bit_lib/bit_lib.h>
+
 #include <furi.h>
 #include <path.h>
 #include <m-array.h>
@@ -17,6 +21,11 @@
 #define NFC_SUPPORTED_CARDS_PLUGINS_PATH  APP_DATA_PATH("plugins")
 #define NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX "_parser.fal"
 
+#define NFC_SUPPORTED_CARDS_INDEX_PATH     APP_DATA_PATH("plugins.idx")
+#define NFC_SUPPORTED_CARDS_INDEX_MAGIC    0x58444950 // "PIDX"
+#define NFC_SUPPORTED_CARDS_INDEX_VERSION  1
+#define NFC_SUPPORTED_CARDS_INDEX_NAME_LEN 64
+
 typedef enum {
     NfcSupportedCardsPluginFeatureHasVerify = (1U << 0),
     NfcSupportedCardsPluginFeatureHasRead = (1U << 1),
@@ -25,12 +34,30 @@ typedef enum {
 
 typedef struct {
     FuriString* name;
+    uint32_t timestamp;
     NfcProtocol protocol;
     NfcSupportedCardsPluginFeature feature;
+    NfcSupportedCardPluginHint hint;
 } NfcSupportedCardsPluginCache;
 
 ARRAY_DEF(NfcSupportedCardsPluginCache, NfcSupportedCardsPluginCache, M_POD_OPLIST);
 
+// Plugin index: header, then one record per plugin file
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;
+    uint32_t record_count;
+} NfcSupportedCardsIndexHeader;
+
+typedef struct FURI_PACKED {
+    char name[NFC_SUPPORTED_CARDS_INDEX_NAME_LEN];
+    uint32_t timestamp;
+    uint8_t protocol;
+    uint8_t feature;
+    NfcSupportedCardPluginHint hint;
+} NfcSupportedCardsIndexRecord;
+
 typedef enum {
     NfcSupportedCardsLoadStateIdle,
     NfcSupportedCardsLoadStateInProgress,
@@ -50,6 +77,9 @@ struct NfcSupportedCards {
     NfcSupportedCardsPluginCache_t plugins_cache_arr;
     NfcSupportedCardsLoadState load_state;
     NfcSupportedCardsLoadContext* load_context;
+    // Last matching plugin stays loaded, its cache entry is kept first
+    FlipperApplication* resident_app;
+    const NfcSupportedCardsPlugin* resident_plugin;
 };
 
 NfcSupportedCards* nfc_supported_cards_alloc(void) {
@@ -76,6 +106,10 @@ void nfc_supported_cards_free(NfcSupportedCards* instance) {
     }
     NfcSupportedCardsPluginCache_clear(instance->plugins_cache_arr);
 
+    if(instance->resident_app) {
+        flipper_application_free(instance->resident_app);
+    }
+
     composite_api_resolver_free(instance->api_resolver);
     free(instance);
 }
@@ -131,7 +165,9 @@ static const NfcSupportedCardsPlugin* nfc_supported_cards_get_plugin(
         if(descriptor == NULL) break;
 
         if(strcmp(descriptor->appid, NFC_SUPPORTED_CARD_PLUGIN_APP_ID) != 0) break;
-        if(descriptor->ep_api_version != NFC_SUPPORTED_CARD_PLUGIN_API_VERSION) break;
+        if(descriptor->ep_api_version == 0 ||
+           descriptor->ep_api_version > NFC_SUPPORTED_CARD_PLUGIN_API_VERSION)
+            break;
 
         plugin = descriptor->entry_point;
     } while(false);
@@ -140,12 +176,20 @@ static const NfcSupportedCardsPlugin* nfc_supported_cards_get_plugin(
     return plugin;
 }
 
-static const NfcSupportedCardsPlugin* nfc_supported_cards_get_next_plugin(
-    NfcSupportedCardsLoadContext* instance,
-    const ElfApiInterface* api_interface) {
-    const NfcSupportedCardsPlugin* plugin = NULL;
+static const NfcSupportedCardPluginHint*
+    nfc_supported_cards_get_plugin_hint(NfcSupportedCardsLoadContext* instance) {
+    const FlipperAppPluginDescriptor* descriptor =
+        flipper_application_plugin_get_descriptor(instance->app);
+    const NfcSupportedCardsPlugin* plugin = descriptor->entry_point;
 
-    do {
+    // Version 1 plugins end before the hint field
+    return (descriptor->ep_api_version >= 2) ? plugin->hint : NULL;
+}
+
+static bool nfc_supported_cards_get_next_plugin_name(NfcSupportedCardsLoadContext* instance) {
+    bool name_found = false;
+
+    while(!name_found) {
         if(!storage_file_is_open(instance->directory)) break;
         if(!storage_dir_read(
                instance->directory, NULL, instance->file_name, sizeof(instance->file_name)))
@@ -153,22 +197,146 @@ static const NfcSupportedCardsPlugin* nfc_supported_cards_get_next_plugin(
 
         const size_t suffix_len = strlen(NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX);
         const size_t file_name_len = strlen(instance->file_name);
-        if(file_name_len <= suffix_len) break;
+        if(file_name_len <= suffix_len) continue;
 
         size_t suffix_start_pos = file_name_len - suffix_len;
         if(memcmp(
                &instance->file_name[suffix_start_pos],
                NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX,
                suffix_len) != 0) //-V1051
-            break;
+            continue;
 
         // Trim suffix from file_name to save memory. The suffix will be concatenated on plugin load.
         instance->file_name[suffix_start_pos] = '\0';
+        name_found = true;
+    }
 
-        plugin = nfc_supported_cards_get_plugin(instance, instance->file_name, api_interface);
-    } while(plugin == NULL); //-V654
+    return name_found;
+}
 
-    return plugin;
+static uint32_t nfc_supported_cards_get_plugin_timestamp(
+    NfcSupportedCardsLoadContext* instance,
+    const char* name) {
+    uint32_t timestamp = 0;
+    FuriString* plugin_path = furi_string_alloc_printf(
+        "%s/%s%s", NFC_SUPPORTED_CARDS_PLUGINS_PATH, name, NFC_SUPPORTED_CARDS_PLUGIN_SUFFIX);
+    storage_common_timestamp(instance->storage, furi_string_get_cstr(plugin_path), &timestamp);
+    furi_string_free(plugin_path);
+
+    return timestamp;
+}
+
+static void nfc_supported_cards_index_load(
+    NfcSupportedCardsLoadContext* instance,
+    NfcSupportedCardsPluginCache_t index) {
+    File* file = storage_file_alloc(instance->storage);
+    NfcSupportedCardsIndexHeader header;
+    NfcSupportedCardsIndexRecord record;
+
+    do {
+        if(!storage_file_open(file, NFC_SUPPORTED_CARDS_INDEX_PATH, FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != NFC_SUPPORTED_CARDS_INDEX_MAGIC ||
+           header.version != NFC_SUPPORTED_CARDS_INDEX_VERSION ||
+           header.record_size != sizeof(NfcSupportedCardsIndexRecord))
+            break;
+
+        for(uint32_t i = 0; i < header.record_count; i++) {
+            if(storage_file_read(file, &record, sizeof(record)) != sizeof(record)) break;
+            if(record.protocol >= NfcProtocolNum) continue;
+
+            record.name[NFC_SUPPORTED_CARDS_INDEX_NAME_LEN - 1] = '\0';
+            NfcSupportedCardsPluginCache plugin_cache = {
+                .name = furi_string_alloc_set(record.name),
+                .timestamp = record.timestamp,
+                .protocol = record.protocol,
+                .feature = record.feature,
+                .hint = record.hint,
+            };
+            NfcSupportedCardsPluginCache_push_back(index, plugin_cache);
+        }
+    } while(false);
+
+    storage_file_free(file);
+}
+
+static void nfc_supported_cards_index_save(NfcSupportedCards* instance) {
+    File* file = storage_file_alloc(instance->load_context->storage);
+    NfcSupportedCardsIndexHeader header = {
+        .magic = NFC_SUPPORTED_CARDS_INDEX_MAGIC,
+        .version = NFC_SUPPORTED_CARDS_INDEX_VERSION,
+        .record_size = sizeof(NfcSupportedCardsIndexRecord),
+    };
+
+    // Plugins with names too long for a record are just not indexed
+    NfcSupportedCardsPluginCache_it_t iter;
+    for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
+        !NfcSupportedCardsPluginCache_end_p(iter);
+        NfcSupportedCardsPluginCache_next(iter)) {
+        const NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_cref(iter);
+        if(furi_string_size(plugin_cache->name) < NFC_SUPPORTED_CARDS_INDEX_NAME_LEN) {
+            header.record_count++;
+        }
+    }
+
+    bool save_success = false;
+    do {
+        if(!storage_file_open(
+               file, NFC_SUPPORTED_CARDS_INDEX_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS))
+            break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+
+        bool record_write_success = true;
+        for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
+            !NfcSupportedCardsPluginCache_end_p(iter) && record_write_success;
+            NfcSupportedCardsPluginCache_next(iter)) {
+            const NfcSupportedCardsPluginCache* plugin_cache =
+                NfcSupportedCardsPluginCache_cref(iter);
+            if(furi_string_size(plugin_cache->name) >= NFC_SUPPORTED_CARDS_INDEX_NAME_LEN) {
+                continue;
+            }
+
+            NfcSupportedCardsIndexRecord record = {
+                .timestamp = plugin_cache->timestamp,
+                .protocol = plugin_cache->protocol,
+                .feature = plugin_cache->feature,
+                .hint = plugin_cache->hint,
+            };
+            strlcpy(record.name, furi_string_get_cstr(plugin_cache->name), sizeof(record.name));
+            record_write_success = storage_file_write(file, &record, sizeof(record)) ==
+                                   sizeof(record);
+        }
+        save_success = record_write_success;
+    } while(false);
+
+    storage_file_free(file);
+
+    if(!save_success) {
+        FURI_LOG_W(TAG, "Failed to save plugin index");
+        storage_common_remove(instance->load_context->storage, NFC_SUPPORTED_CARDS_INDEX_PATH);
+    }
+}
+
+static NfcSupportedCardsPluginCache*
+    nfc_supported_cards_index_find(NfcSupportedCardsPluginCache_t index, const char* name) {
+    NfcSupportedCardsPluginCache_it_t iter;
+    for(NfcSupportedCardsPluginCache_it(iter, index); !NfcSupportedCardsPluginCache_end_p(iter);
+        NfcSupportedCardsPluginCache_next(iter)) {
+        NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
+        if(furi_string_equal_str(plugin_cache->name, name)) return plugin_cache;
+    }
+
+    return NULL;
+}
+
+static void nfc_supported_cards_index_free(NfcSupportedCardsPluginCache_t index) {
+    NfcSupportedCardsPluginCache_it_t iter;
+    for(NfcSupportedCardsPluginCache_it(iter, index); !NfcSupportedCardsPluginCache_end_p(iter);
+        NfcSupportedCardsPluginCache_next(iter)) {
+        furi_string_free(NfcSupportedCardsPluginCache_ref(iter)->name);
+    }
+    NfcSupportedCardsPluginCache_clear(index);
 }
 
 void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
@@ -181,15 +349,39 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
 
         instance->load_context = nfc_supported_cards_load_context_alloc();
 
-        while(true) {
+        NfcSupportedCardsPluginCache_t index;
+        NfcSupportedCardsPluginCache_init(index);
+        nfc_supported_cards_index_load(instance->load_context, index);
+
+        size_t index_hits = 0;
+        bool index_changed = false;
+
+        // Only plugins missing from the index or changed since are loaded
+        while(nfc_supported_cards_get_next_plugin_name(instance->load_context)) {
+            const char* name = instance->load_context->file_name;
+            uint32_t timestamp =
+                nfc_supported_cards_get_plugin_timestamp(instance->load_context, name);
+
+            const NfcSupportedCardsPluginCache* indexed =
+                nfc_supported_cards_index_find(index, name);
+            if(indexed && indexed->timestamp == timestamp) {
+                NfcSupportedCardsPluginCache plugin_cache = *indexed;
+                plugin_cache.name = furi_string_alloc_set(indexed->name);
+                NfcSupportedCardsPluginCache_push_back(instance->plugins_cache_arr, plugin_cache);
+                index_hits++;
+                continue;
+            }
+
+            index_changed = true;
             const ElfApiInterface* api_interface =
                 composite_api_resolver_get(instance->api_resolver);
             const NfcSupportedCardsPlugin* plugin =
-                nfc_supported_cards_get_next_plugin(instance->load_context, api_interface);
-            if(plugin == NULL) break; //-V547
+                nfc_supported_cards_get_plugin(instance->load_context, name, api_interface);
+            if(plugin == NULL) continue; //-V547
 
             NfcSupportedCardsPluginCache plugin_cache = {}; //-V779
-            plugin_cache.name = furi_string_alloc_set(instance->load_context->file_name);
+            plugin_cache.name = furi_string_alloc_set(name);
+            plugin_cache.timestamp = timestamp;
             plugin_cache.protocol = plugin->protocol;
             if(plugin->verify) {
                 plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasVerify;
@@ -200,9 +392,22 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
             if(plugin->parse) {
                 plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasParse;
             }
+            const NfcSupportedCardPluginHint* hint =
+                nfc_supported_cards_get_plugin_hint(instance->load_context);
+            if(hint) {
+                plugin_cache.hint = *hint;
+            }
             NfcSupportedCardsPluginCache_push_back(instance->plugins_cache_arr, plugin_cache);
         }
 
+        if(index_hits != NfcSupportedCardsPluginCache_size(index)) index_changed = true;
+        nfc_supported_cards_index_free(index);
+
+        if(index_changed) {
+            nfc_supported_cards_index_save(instance);
+        }
+        FURI_LOG_D(TAG, "%zu plugins taken from index", index_hits);
+
         nfc_supported_cards_load_context_free(instance->load_context);
 
         size_t plugins_loaded = NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr);
@@ -217,6 +422,88 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
     } while(false);
 }
 
+static bool nfc_supported_cards_hint_match(
+    const NfcSupportedCardPluginHint* hint,
+    const NfcDevice* device,
+    bool check_key) {
+    NfcProtocol protocol = nfc_device_get_protocol(device);
+    bool hint_matched = false;
+
+    do {
+        if(hint->uid_len) {
+            size_t uid_len = 0;
+            nfc_device_get_uid(device, &uid_len);
+            if(uid_len != hint->uid_len) break;
+        }
+
+        if(hint->sak_mask) {
+            if(protocol != NfcProtocolIso14443_3a &&
+               !nfc_protocol_has_parent(protocol, NfcProtocolIso14443_3a))
+                break;
+            const Iso14443_3aData* data = nfc_device_get_data(device, NfcProtocolIso14443_3a);
+            if((iso14443_3a_get_sak(data) & hint->sak_mask) != (hint->sak & hint->sak_mask))
+                break;
+        }
+
+        if(check_key && hint->key_count) {
+            if(protocol != NfcProtocolMfClassic) break;
+            const MfClassicData* data = nfc_device_get_data(device, NfcProtocolMfClassic);
+            if(hint->key_sector >= mf_classic_get_total_sectors_num(data->type)) break;
+
+            const MfClassicSectorTrailer* sec_tr =
+                mf_classic_get_sector_trailer_by_sector(data, hint->key_sector);
+            const MfClassicKey* key = (hint->key_type == MfClassicKeyTypeA) ? &sec_tr->key_a :
+                                                                              &sec_tr->key_b;
+            uint64_t key_num = bit_lib_bytes_to_num_be(key->data, sizeof(MfClassicKey));
+
+            bool key_matched = false;
+            for(size_t i = 0; i < MIN(hint->key_count, NFC_SUPPORTED_CARD_PLUGIN_HINT_KEYS_MAX);
+                i++) {
+                if(hint->keys[i] == key_num) {
+                    key_matched = true;
+                    break;
+                }
+            }
+            if(!key_matched) break;
+        }
+
+        hint_matched = true;
+    } while(false);
+
+    return hint_matched;
+}
+
+static const NfcSupportedCardsPlugin*
+    nfc_supported_cards_get_cached_plugin(NfcSupportedCards* instance, size_t index) {
+    if(index == 0 && instance->resident_plugin) return instance->resident_plugin;
+
+    const NfcSupportedCardsPluginCache* plugin_cache =
+        NfcSupportedCardsPluginCache_cget(instance->plugins_cache_arr, index);
+    const ElfApiInterface* api_interface = composite_api_resolver_get(instance->api_resolver);
+
+    return nfc_supported_cards_get_plugin(
+        instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
+}
+
+static void nfc_supported_cards_set_resident(
+    NfcSupportedCards* instance,
+    size_t index,
+    const NfcSupportedCardsPlugin* plugin) {
+    if(index == 0 && plugin == instance->resident_plugin) return;
+
+    if(instance->resident_app) {
+        flipper_application_free(instance->resident_app);
+    }
+    instance->resident_app = instance->load_context->app;
+    instance->resident_plugin = plugin;
+    instance->load_context->app = NULL;
+
+    // Keep the resident plugin first so the next card tries it before loading others
+    NfcSupportedCardsPluginCache plugin_cache;
+    NfcSupportedCardsPluginCache_pop_at(&plugin_cache, instance->plugins_cache_arr, index);
+    NfcSupportedCardsPluginCache_push_at(instance->plugins_cache_arr, 0, plugin_cache);
+}
+
 bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nfc* nfc) {
     furi_assert(instance);
     furi_assert(device);
@@ -230,18 +517,16 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
 
         instance->load_context = nfc_supported_cards_load_context_alloc();
 
-        NfcSupportedCardsPluginCache_it_t iter;
-        for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
-            !NfcSupportedCardsPluginCache_end_p(iter);
-            NfcSupportedCardsPluginCache_next(iter)) {
-            NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
+        for(size_t i = 0; i < NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr);
+            i++) {
+            const NfcSupportedCardsPluginCache* plugin_cache =
+                NfcSupportedCardsPluginCache_cget(instance->plugins_cache_arr, i);
             if(plugin_cache->protocol != protocol) continue;
             if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasRead) == 0) continue;
+            if(!nfc_supported_cards_hint_match(&plugin_cache->hint, device, false)) continue;
 
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
-                instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
+            const NfcSupportedCardsPlugin* plugin =
+                nfc_supported_cards_get_cached_plugin(instance, i);
             if(plugin == NULL) continue;
 
             if(plugin->verify) {
@@ -250,6 +535,7 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
 
             if(plugin->read) {
                 if(plugin->read(nfc, device)) {
+                    nfc_supported_cards_set_resident(instance, i, plugin);
                     card_read = true;
                     break;
                 }
@@ -278,22 +564,21 @@ bool nfc_supported_cards_parse(
 
         instance->load_context = nfc_supported_cards_load_context_alloc();
 
-        NfcSupportedCardsPluginCache_it_t iter;
-        for(NfcSupportedCardsPluginCache_it(iter, instance->plugins_cache_arr);
-            !NfcSupportedCardsPluginCache_end_p(iter);
-            NfcSupportedCardsPluginCache_next(iter)) {
-            NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
+        for(size_t i = 0; i < NfcSupportedCardsPluginCache_size(instance->plugins_cache_arr);
+            i++) {
+            const NfcSupportedCardsPluginCache* plugin_cache =
+                NfcSupportedCardsPluginCache_cget(instance->plugins_cache_arr, i);
             if(plugin_cache->protocol != protocol) continue;
             if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasParse) == 0) continue;
+            if(!nfc_supported_cards_hint_match(&plugin_cache->hint, device, true)) continue;
 
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
-                instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
+            const NfcSupportedCardsPlugin* plugin =
+                nfc_supported_cards_get_cached_plugin(instance, i);
             if(plugin == NULL) continue;
 
             if(plugin->parse) {
                 if(plugin->parse(device, parsed_data)) {
+                    nfc_supported_cards_set_resident(instance, i, plugin);
                     card_parsed = true;
                     break;
                 }
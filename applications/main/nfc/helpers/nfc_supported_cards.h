@@ -37,6 +37,9 @@ void nfc_supported_cards_free(NfcSupportedCards* instance);
 /**
  * @brief Load plugins information to cache.
  *
+ * Plugin information is kept in an index file next to the plugins directory,
+ * only plugins that are new or changed since the index was written are loaded.
+ *
  * @note This function must be called before calling read and parse fanctions.
  *
  * @param[in, out] instance pointer to NfcSupportedCards instance.
@@ -48,7 +51,8 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance);
  *
  * This function will load all suitable supported card plugins one by one and
  * try to execute the custom read procedure specified in each. Upon first success,
- * no further attempts will be made and the function will return.
+ * no further attempts will be made and the function will return. The successful
+ * plugin stays loaded and is tried first next time.
  *
  * @param[in, out] instance pointer to NfcSupportedCards instance.
  * @param[in,out] device pointer to a device instance to hold the read data.
@@ -64,7 +68,8 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
  *
  * This function will load all suitable supported card plugins one by one and
  * try to parse the data according to each implementation. Upon first success,
- * no further attempts will be made and the function will return.
+ * no further attempts will be made and the function will return. The successful
+ * plugin stays loaded and is tried first next time.
  *
  * @param[in, out] instance pointer to NfcSupportedCards instance.
  * @param[in] device pointer to a device instance holding the data is to be parsed.
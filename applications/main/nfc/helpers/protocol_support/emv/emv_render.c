@@ -99,8 +99,23 @@ void nfc_render_emv_transactions(const EmvApplication* apl, FuriString* str) {
         return;
     }
 
+    // Currency and country names of all transactions are looked up at once
+    NfcEmvParserRequest* names = malloc(len * 2 * sizeof(NfcEmvParserRequest));
+    for(int i = 0; i < len; i++) {
+        names[i * 2] = (NfcEmvParserRequest){
+            .resource = NfcEmvParserResourceCurrency,
+            .code = apl->trans[i].currency,
+            .name = furi_string_alloc_set_str("UNK"),
+        };
+        names[i * 2 + 1] = (NfcEmvParserRequest){
+            .resource = NfcEmvParserResourceCountry,
+            .code = apl->trans[i].country,
+            .name = furi_string_alloc_set_str("UNK"),
+        };
+    }
     Storage* storage = furi_record_open(RECORD_STORAGE);
-    FuriString* tmp = furi_string_alloc();
+    nfc_emv_parser_get_names(storage, names, len * 2);
+    furi_record_close(RECORD_STORAGE);
 
     furi_string_cat_printf(str, "Transactions:\n");
     for(int i = 0; i < len; i++) {
@@ -125,15 +140,12 @@ void nfc_render_emv_transactions(const EmvApplication* apl, FuriString* str) {
         }
 
         if(apl->trans[i].currency) {
-            furi_string_set_str(tmp, "UNK");
-            nfc_emv_parser_get_currency_name(storage, apl->trans[i].currency, tmp);
-            furi_string_cat_printf(str, " %s\n", furi_string_get_cstr(tmp));
+            furi_string_cat_printf(str, " %s\n", furi_string_get_cstr(names[i * 2].name));
         }
 
         if(apl->trans[i].country) {
-            furi_string_set_str(tmp, "UNK");
-            nfc_emv_parser_get_country_name(storage, apl->trans[i].country, tmp);
-            furi_string_cat_printf(str, "Country: %s\n", furi_string_get_cstr(tmp));
+            furi_string_cat_printf(
+                str, "Country: %s\n", furi_string_get_cstr(names[i * 2 + 1].name));
         }
 
         if(apl->trans[i].date)
@@ -156,8 +168,10 @@ void nfc_render_emv_transactions(const EmvApplication* apl, FuriString* str) {
         furi_string_cat_printf(str, "\n");
     }
 
-    furi_string_free(tmp);
-    furi_record_close(RECORD_STORAGE);
+    for(int i = 0; i < len * 2; i++) {
+        furi_string_free(names[i].name);
+    }
+    free(names);
 }
 
 void nfc_render_emv_extra(const EmvData* data, FuriString* str) {
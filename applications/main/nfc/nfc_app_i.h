@@ -33,6 +33,7 @@
 #include "helpers/mfkey32_logger.h"
 #include "helpers/nfc_emv_parser.h"
 #include "helpers/mf_classic_key_cache.h"
+#include "helpers/mf_classic_key_stats.h"
 #include "helpers/nfc_supported_cards.h"
 #include "helpers/felica_auth.h"
 #include "helpers/slix_unlock.h"
@@ -104,6 +105,11 @@ typedef struct {
     uint16_t nested_target_key;
     uint16_t msb_count;
     bool enhanced_dict;
+    MfClassicKeyStats* key_stats;
+    MfClassicKey ranked_keys[MF_CLASSIC_KEY_STATS_RANKED_MAX];
+    size_t ranked_keys_total;
+    size_t ranked_keys_current;
+    size_t keys_attempts;
 } NfcMfClassicDictAttackContext;
 
 struct NfcApp {
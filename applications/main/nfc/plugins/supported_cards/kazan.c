@@ -393,12 +393,21 @@ static bool kazan_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+/* Only cards with a known ticket sector key can be parsed */
+static const NfcSupportedCardPluginHint kazan_plugin_hint = {
+    .key_sector = 8,
+    .key_type = MfClassicKeyTypeA,
+    .key_count = 2,
+    .keys = {0xE954024EE754, 0x2058EAEE8446},
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin kazan_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = kazan_verify,
     .read = kazan_read,
     .parse = kazan_parse,
+    .hint = &kazan_plugin_hint,
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
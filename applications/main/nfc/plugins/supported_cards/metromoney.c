@@ -169,12 +169,21 @@ static bool metromoney_parse(const NfcDevice* device, FuriString* parsed_data) {
     return parsed;
 }
 
+/* Only cards with a known ticket sector key can be parsed */
+static const NfcSupportedCardPluginHint metromoney_plugin_hint = {
+    .key_sector = 1,
+    .key_type = MfClassicKeyTypeA,
+    .key_count = 1,
+    .keys = {0x9C616585E26D},
+};
+
 /* Actual implementation of app<>plugin interface */
 static const NfcSupportedCardsPlugin metromoney_plugin = {
     .protocol = NfcProtocolMfClassic,
     .verify = metromoney_verify,
     .read = metromoney_read,
     .parse = metromoney_parse,
+    .hint = &metromoney_plugin_hint,
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
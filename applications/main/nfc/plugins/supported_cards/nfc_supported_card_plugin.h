@@ -35,8 +35,15 @@
 
 /**
  * @brief Currently supported plugin API version.
+ *
+ * Version 2 adds the optional hint field, version 1 plugins are still loaded.
  */
-#define NFC_SUPPORTED_CARD_PLUGIN_API_VERSION 1
+#define NFC_SUPPORTED_CARD_PLUGIN_API_VERSION 2
+
+/**
+ * @brief Maximum number of identifying keys in a plugin hint.
+ */
+#define NFC_SUPPORTED_CARD_PLUGIN_HINT_KEYS_MAX 2
 
 /**
  * @brief Verify that the card is of a supported type.
@@ -81,6 +88,24 @@ typedef bool (*NfcSupportedCardPluginRead)(Nfc* nfc, NfcDevice* device);
  */
 typedef bool (*NfcSupportedCardPluginParse)(const NfcDevice* device, FuriString* parsed_data);
 
+/**
+ * @brief Cheap checks a card must pass before the plugin is loaded.
+ *
+ * The hint is stored in the plugin index, so a card that does not pass it
+ * never causes the plugin to be loaded. Every check is optional, leave the
+ * field zeroed to skip it. UID and SAK are checked before read() and parse(),
+ * the key is only checked before parse() since it is not known before reading.
+ */
+typedef struct {
+    uint8_t uid_len; /**< Required UID length in bytes, 0 if any. */
+    uint8_t sak; /**< Required SAK of ISO14443-3A based cards, compared under sak_mask. */
+    uint8_t sak_mask; /**< SAK bits to compare, 0 if any. */
+    uint8_t key_sector; /**< MIFARE Classic sector holding the identifying key. */
+    uint8_t key_type; /**< MfClassicKeyType of the identifying key. */
+    uint8_t key_count; /**< Number of accepted identifying keys, 0 if none. */
+    uint64_t keys[NFC_SUPPORTED_CARD_PLUGIN_HINT_KEYS_MAX]; /**< Accepted identifying keys. */
+} NfcSupportedCardPluginHint;
+
 /**
  * @brief Supported card plugin interface.
  *
@@ -91,4 +116,5 @@ typedef struct {
     NfcSupportedCardPluginVerify verify; /**< Pointer to the verify() function. */
     NfcSupportedCardPluginRead read; /**< Pointer to the read() function. */
     NfcSupportedCardPluginParse parse; /**< Pointer to the parse() function. */
+    const NfcSupportedCardPluginHint* hint; /**< Optional pre-match hint, may be NULL. */
 } NfcSupportedCardsPlugin;
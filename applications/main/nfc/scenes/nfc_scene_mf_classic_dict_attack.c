@@ -14,6 +14,36 @@ typedef enum {
     DictAttackStateSystemDictInProgress,
 } DictAttackState;
 
+static void nfc_dict_attack_rank_keys(NfcApp* instance, uint8_t sector) {
+    NfcMfClassicDictAttackContext* mfc_dict = &instance->nfc_dict_context;
+
+    mfc_dict->ranked_keys_total = mf_classic_key_stats_get_ranked_keys(
+        mfc_dict->key_stats, sector, mfc_dict->ranked_keys, MF_CLASSIC_KEY_STATS_RANKED_MAX);
+    mfc_dict->ranked_keys_current = 0;
+}
+
+// Keys that unlocked this sector before go first, then the dictionary without them
+static bool nfc_dict_attack_get_next_key(NfcApp* instance, MfClassicKey* key) {
+    NfcMfClassicDictAttackContext* mfc_dict = &instance->nfc_dict_context;
+
+    if(mfc_dict->ranked_keys_current < mfc_dict->ranked_keys_total) {
+        *key = mfc_dict->ranked_keys[mfc_dict->ranked_keys_current++];
+        return true;
+    }
+
+    while(keys_dict_get_next_key(mfc_dict->dict, key->data, sizeof(MfClassicKey))) {
+        mfc_dict->dict_keys_current++;
+        bool is_ranked = false;
+        for(size_t i = 0; i < mfc_dict->ranked_keys_total && !is_ranked; i++) {
+            is_ranked =
+                memcmp(mfc_dict->ranked_keys[i].data, key->data, sizeof(MfClassicKey)) == 0;
+        }
+        if(!is_ranked) return true;
+    }
+
+    return false;
+}
+
 NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context) {
     furi_assert(context);
     furi_assert(event.event_data);
@@ -43,16 +73,16 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
             mfc_data,
             &instance->nfc_dict_context.sectors_read,
             &instance->nfc_dict_context.keys_found);
+        nfc_dict_attack_rank_keys(instance, 0);
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
         MfClassicKey key = {};
-        if(keys_dict_get_next_key(
-               instance->nfc_dict_context.dict, key.data, sizeof(MfClassicKey))) {
+        if(nfc_dict_attack_get_next_key(instance, &key)) {
             mfc_event->data->key_request_data.key = key;
             mfc_event->data->key_request_data.key_provided = true;
-            instance->nfc_dict_context.dict_keys_current++;
-            if(instance->nfc_dict_context.dict_keys_current % 10 == 0) {
+            instance->nfc_dict_context.keys_attempts++;
+            if(instance->nfc_dict_context.keys_attempts % 10 == 0) {
                 view_dispatcher_send_custom_event(
                     instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
             }
@@ -76,6 +106,7 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
         instance->nfc_dict_context.dict_keys_current = 0;
         instance->nfc_dict_context.current_sector =
             mfc_event->data->next_sector_data.current_sector;
+        nfc_dict_attack_rank_keys(instance, instance->nfc_dict_context.current_sector);
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeFoundKeyA) {
@@ -94,6 +125,7 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
         keys_dict_rewind(instance->nfc_dict_context.dict);
         instance->nfc_dict_context.is_key_attack = false;
         instance->nfc_dict_context.dict_keys_current = 0;
+        instance->nfc_dict_context.ranked_keys_current = 0;
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeSuccess) {
@@ -230,6 +262,9 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance) {
 void nfc_scene_mf_classic_dict_attack_on_enter(void* context) {
     NfcApp* instance = context;
 
+    instance->nfc_dict_context.key_stats = mf_classic_key_stats_alloc();
+    mf_classic_key_stats_load(instance->nfc_dict_context.key_stats);
+
     scene_manager_set_scene_state(
         instance->scene_manager, NfcSceneMfClassicDictAttack, DictAttackStateCUIDDictInProgress);
     nfc_scene_mf_classic_dict_attack_prepare_view(instance);
@@ -358,6 +393,15 @@ void nfc_scene_mf_classic_dict_attack_on_exit(void* context) {
     NfcApp* instance = context;
 
     nfc_poller_stop(instance->poller);
+
+    // Remember which keys worked to try them first next time
+    const MfClassicData* mfc_data = nfc_poller_get_data(instance->poller);
+    mf_classic_key_stats_add_data(
+        instance->nfc_dict_context.key_stats, mfc_data, instance->nfc_dict_context.keys_attempts);
+    mf_classic_key_stats_save(instance->nfc_dict_context.key_stats);
+    mf_classic_key_stats_free(instance->nfc_dict_context.key_stats);
+    instance->nfc_dict_context.key_stats = NULL;
+
     nfc_poller_free(instance->poller);
 
     dict_attack_reset(instance->dict_attack);
@@ -381,6 +425,9 @@ void nfc_scene_mf_classic_dict_attack_on_exit(void* context) {
     instance->nfc_dict_context.nested_target_key = 0;
     instance->nfc_dict_context.msb_count = 0;
     instance->nfc_dict_context.enhanced_dict = false;
+    instance->nfc_dict_context.ranked_keys_total = 0;
+    instance->nfc_dict_context.ranked_keys_current = 0;
+    instance->nfc_dict_context.keys_attempts = 0;
 
     // Clean up temporary files used for nested dictionary attack
     if(keys_dict_check_presence(NFC_APP_MF_CLASSIC_DICT_USER_NESTED_PATH)) {
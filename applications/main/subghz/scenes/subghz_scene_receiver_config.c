@@ -77,6 +77,11 @@ const char* const combobox_text[COMBO_BOX_COUNT] = {
     "ON",
 };
 
+const char* const raw_format_text[COMBO_BOX_COUNT] = {
+    "Text",
+    "Binary",
+};
+
 #define HOPPING_MODE_COUNT 12
 const char* const hopping_mode_text[HOPPING_MODE_COUNT] = {
     "OFF",
@@ -405,6 +410,15 @@ static void subghz_scene_receiver_config_set_autosave(VariableItem* item) {
     subghz->last_settings->autosave = index == 1;
 }
 
+static void subghz_scene_receiver_config_set_raw_format(VariableItem* item) {
+    SubGhz* subghz = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, raw_format_text[index]);
+
+    subghz->last_settings->raw_binary_format = index == 1;
+}
+
 static inline bool subghz_scene_receiver_config_ignore_filter_get_index(
     SubGhzProtocolFilter filter,
     SubGhzProtocolFilter flag) {
@@ -735,6 +749,16 @@ void subghz_scene_receiver_config_on_enter(void* context) {
             RAW_THRESHOLD_RSSI_COUNT);
         variable_item_set_current_value_index(item, value_index);
         variable_item_set_current_value_text(item, raw_threshold_rssi_text[value_index]);
+
+        item = variable_item_list_add(
+            subghz->variable_item_list,
+            "RAW Format",
+            COMBO_BOX_COUNT,
+            subghz_scene_receiver_config_set_raw_format,
+            subghz);
+        value_index = subghz->last_settings->raw_binary_format;
+        variable_item_set_current_value_index(item, value_index);
+        variable_item_set_current_value_text(item, raw_format_text[value_index]);
     }
 
     variable_item_list_set_selected_item(
@@ -9,6 +9,7 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_binary.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
 #include <lib/subghz/devices/devices.h>
@@ -16,6 +17,8 @@
 
 #include <lib/toolbox/args.h>
 #include <lib/toolbox/strint.h>
+#include <lib/toolbox/dir_walk.h>
+#include <toolbox/stream/file_stream.h>
 
 #include "helpers/subghz_chat.h"
 
@@ -548,6 +551,15 @@ void subghz_cli_command_decode_raw(Cli* cli, FuriString* args, void* context) {
 
         printf("\r\nPackets received \033[0;32m%zu\033[0m\r\n", instance->packet_count);
 
+        SubGhzFileEncoderWorkerStats stats;
+        subghz_file_encoder_worker_get_stats(file_worker_encoder, &stats);
+        printf(
+            "Pulses %lu, underruns %lu, storage read avg %luus max %luus\r\n",
+            stats.pulse_count,
+            stats.underrun_count,
+            stats.read_count ? stats.read_time_total / stats.read_count : 0,
+            stats.read_time_max);
+
         // Cleanup
         subghz_receiver_free(receiver);
         subghz_environment_free(environment);
@@ -561,6 +573,277 @@ void subghz_cli_command_decode_raw(Cli* cli, FuriString* args, void* context) {
     furi_string_free(file_name);
 }
 
+typedef struct SubGhzCliDecodeDir SubGhzCliDecodeDir;
+
+typedef struct {
+    SubGhzCliDecodeDir* owner;
+    SubGhzProtocolDecoderBase* decoder;
+    uint64_t cycles;
+    uint32_t packet_count;
+} SubGhzCliDecodeDirSlot;
+
+struct SubGhzCliDecodeDir {
+    SubGhzCliDecodeDirSlot* slots;
+    size_t slot_count;
+    int32_t* block;
+
+    Stream* report;
+    FuriString* file_name;
+    FuriString* text;
+
+    uint32_t file_count;
+    uint32_t file_error_count;
+    uint32_t file_packet_count;
+    uint32_t packet_count;
+    uint32_t pulse_count;
+};
+
+static void subghz_cli_command_decode_dir_callback(
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    SubGhzCliDecodeDirSlot* slot = context;
+    SubGhzCliDecodeDir* instance = slot->owner;
+    slot->packet_count++;
+    instance->file_packet_count++;
+    instance->packet_count++;
+
+    // One line per packet, so reports from two firmware builds can be diffed
+    subghz_protocol_decoder_base_get_string(decoder_base, instance->text);
+    furi_string_replace_all(instance->text, "\r\n", " ");
+    furi_string_replace_all(instance->text, "\n", " ");
+    furi_string_trim(instance->text);
+    printf("  %s\r\n", furi_string_get_cstr(instance->text));
+    if(instance->report) {
+        stream_write_format(
+            instance->report,
+            "%s\t%s\n",
+            furi_string_get_cstr(instance->file_name),
+            furi_string_get_cstr(instance->text));
+    }
+
+    for(size_t i = 0; i < instance->slot_count; i++) {
+        const SubGhzProtocol* protocol = instance->slots[i].decoder->protocol;
+        protocol->decoder->reset(instance->slots[i].decoder);
+    }
+}
+
+static void subghz_cli_command_decode_dir_feed(
+    SubGhzCliDecodeDir* instance,
+    const int32_t* data,
+    size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        int32_t duration = data[i];
+        if((duration < -1000000) || (duration > 1000000)) {
+            duration = (duration > 0) ? 100 : -100;
+        }
+        bool level = duration > 0;
+        uint32_t abs_duration = level ? duration : -duration;
+
+        for(size_t j = 0; j < instance->slot_count; j++) {
+            SubGhzCliDecodeDirSlot* slot = &instance->slots[j];
+            uint32_t start = DWT->CYCCNT;
+            slot->decoder->protocol->decoder->feed(slot->decoder, level, abs_duration);
+            slot->cycles += DWT->CYCCNT - start;
+        }
+    }
+    instance->pulse_count += count;
+}
+
+static bool subghz_cli_command_decode_dir_file(
+    Cli* cli,
+    SubGhzCliDecodeDir* instance,
+    FlipperFormat* fff_data_file) {
+    FuriString* temp_str = furi_string_alloc();
+    uint32_t temp_data32;
+    SubGhzRawBinaryReader* binary_reader = NULL;
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_existing(
+               fff_data_file, furi_string_get_cstr(instance->file_name))) {
+            break;
+        }
+        if(!flipper_format_read_header(fff_data_file, temp_str, &temp_data32)) break;
+        if(strcmp(furi_string_get_cstr(temp_str), SUBGHZ_RAW_FILE_TYPE) != 0 ||
+           temp_data32 != SUBGHZ_KEY_FILE_VERSION) {
+            break;
+        }
+
+        for(size_t i = 0; i < instance->slot_count; i++) {
+            instance->slots[i].decoder->protocol->decoder->reset(instance->slots[i].decoder);
+        }
+
+        Stream* stream = flipper_format_get_raw_stream(fff_data_file);
+        while(!cli_cmd_interrupt_received(cli) && stream_read_line(stream, temp_str)) {
+            // Binary recordings have a marker line in place of the first RAW_Data line
+            if(subghz_raw_binary_is_marker(furi_string_get_cstr(temp_str))) {
+                binary_reader = subghz_raw_binary_reader_alloc(stream);
+                break;
+            }
+            if(!furi_string_start_with_str(temp_str, "RAW_Data:")) continue;
+
+            char* str = strchr(furi_string_get_cstr(temp_str), ' ');
+            size_t count = 0;
+            int32_t duration;
+            while(str && strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
+                instance->block[count++] = duration;
+                if(count == SUBGHZ_RAW_BINARY_BLOCK_SIZE) {
+                    subghz_cli_command_decode_dir_feed(instance, instance->block, count);
+                    count = 0;
+                }
+                if(*str == ',') str++;
+            }
+            subghz_cli_command_decode_dir_feed(instance, instance->block, count);
+        }
+
+        if(binary_reader) {
+            size_t count;
+            while(!cli_cmd_interrupt_received(cli) &&
+                  (count = subghz_raw_binary_reader_read_block(binary_reader, instance->block))) {
+                subghz_cli_command_decode_dir_feed(instance, instance->block, count);
+            }
+            subghz_raw_binary_reader_free(binary_reader);
+        }
+
+        result = true;
+    } while(false);
+
+    flipper_format_file_close(fff_data_file);
+    furi_string_free(temp_str);
+    return result;
+}
+
+static void subghz_cli_command_decode_dir(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+    FuriString* dir_name = furi_string_alloc_set(EXT_PATH("subghz"));
+    FuriString* report_name = furi_string_alloc();
+
+    if(furi_string_size(args)) {
+        if(!args_read_probably_quoted_string_and_trim(args, dir_name)) {
+            cli_print_usage(
+                "subghz decode_dir",
+                "<dir_name: path_RAW_dir> <report: path_report_file>",
+                furi_string_get_cstr(args));
+            furi_string_free(report_name);
+            furi_string_free(dir_name);
+            return;
+        }
+        args_read_probably_quoted_string_and_trim(args, report_name);
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    SubGhzEnvironment* environment = subghz_cli_environment_init();
+
+    SubGhzCliDecodeDir* instance = malloc(sizeof(SubGhzCliDecodeDir));
+    instance->file_name = furi_string_alloc();
+    instance->text = furi_string_alloc();
+    instance->block = malloc(SUBGHZ_RAW_BINARY_BLOCK_SIZE * sizeof(int32_t));
+
+    // Decoders are driven directly instead of through SubGhzReceiver to time each protocol
+    const SubGhzProtocolRegistry* registry = &subghz_protocol_registry;
+    size_t protocol_count = subghz_protocol_registry_count(registry);
+    instance->slots = malloc(protocol_count * sizeof(SubGhzCliDecodeDirSlot));
+    for(size_t i = 0; i < protocol_count; i++) {
+        const SubGhzProtocol* protocol = subghz_protocol_registry_get_by_index(registry, i);
+        if(!protocol->decoder || !protocol->decoder->alloc) continue;
+        if((protocol->flag & SubGhzProtocolFlag_Decodable) == 0) continue;
+
+        SubGhzCliDecodeDirSlot* slot = &instance->slots[instance->slot_count++];
+        slot->owner = instance;
+        slot->decoder = protocol->decoder->alloc(environment);
+        subghz_protocol_decoder_base_set_decoder_callback(
+            slot->decoder, subghz_cli_command_decode_dir_callback, slot);
+    }
+
+    if(!furi_string_empty(report_name)) {
+        instance->report = file_stream_alloc(storage);
+        if(!file_stream_open(
+               instance->report,
+               furi_string_get_cstr(report_name),
+               FSAM_WRITE,
+               FSOM_CREATE_ALWAYS)) {
+            printf("Unable to create report %s\r\n", furi_string_get_cstr(report_name));
+            stream_free(instance->report);
+            instance->report = NULL;
+        }
+    }
+
+    FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
+    DirWalk* dir_walk = dir_walk_alloc(storage);
+    FileInfo file_info;
+    uint32_t start = furi_get_tick();
+
+    if(!dir_walk_open(dir_walk, furi_string_get_cstr(dir_name))) {
+        printf(
+            "subghz decode_dir \033[0;31mError open dir\033[0m %s\r\n",
+            furi_string_get_cstr(dir_name));
+    } else {
+        while(!cli_cmd_interrupt_received(cli) &&
+              dir_walk_read(dir_walk, instance->file_name, &file_info) == DirWalkOK) {
+            if(file_info_is_dir(&file_info)) continue;
+            if(!furi_string_end_with_str(instance->file_name, SUBGHZ_APP_FILENAME_EXTENSION))
+                continue;
+
+            printf("%s\r\n", furi_string_get_cstr(instance->file_name));
+            instance->file_packet_count = 0;
+            if(subghz_cli_command_decode_dir_file(cli, instance, fff_data_file)) {
+                instance->file_count++;
+                if(!instance->file_packet_count) printf("  \033[0;33mNothing decoded\033[0m\r\n");
+            } else {
+                instance->file_error_count++;
+                printf("  \033[0;33mNot a RAW file\033[0m\r\n");
+            }
+        }
+        dir_walk_close(dir_walk);
+    }
+
+    uint32_t time_ms = furi_get_tick() - start;
+    printf(
+        "\r\nFiles \033[0;32m%lu\033[0m, skipped %lu, packets \033[0;32m%lu\033[0m, pulses %lu\r\n",
+        instance->file_count,
+        instance->file_error_count,
+        instance->packet_count,
+        instance->pulse_count);
+    printf(
+        "Done in %lu ms, %lu pulses/s\r\n",
+        time_ms,
+        time_ms ? (uint32_t)((uint64_t)instance->pulse_count * 1000 / time_ms) : 0);
+
+    if(instance->pulse_count) {
+        printf("\r\n%-24s %8s %10s\r\n", "Protocol", "Packets", "ns/pulse");
+        uint64_t instructions_per_us = furi_hal_cortex_instructions_per_microsecond();
+        for(size_t i = 0; i < instance->slot_count; i++) {
+            SubGhzCliDecodeDirSlot* slot = &instance->slots[i];
+            printf(
+                "%-24s %8lu %10lu\r\n",
+                slot->decoder->protocol->name,
+                slot->packet_count,
+                (uint32_t)(slot->cycles * 1000 / instructions_per_us / instance->pulse_count));
+        }
+    }
+
+    // Cleanup
+    dir_walk_free(dir_walk);
+    flipper_format_free(fff_data_file);
+    if(instance->report) {
+        file_stream_close(instance->report);
+        stream_free(instance->report);
+    }
+    for(size_t i = 0; i < instance->slot_count; i++) {
+        instance->slots[i].decoder->protocol->decoder->free(instance->slots[i].decoder);
+    }
+    free(instance->slots);
+    free(instance->block);
+    furi_string_free(instance->text);
+    furi_string_free(instance->file_name);
+    free(instance);
+
+    subghz_environment_free(environment);
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(report_name);
+    furi_string_free(dir_name);
+}
+
 static FuriHalSubGhzPreset subghz_cli_get_preset_name(const char* preset_name) {
     FuriHalSubGhzPreset preset = FuriHalSubGhzPresetIDLE;
     if(!strcmp(preset_name, "FuriHalSubGhzPresetOok270Async")) {
@@ -836,6 +1119,11 @@ static void subghz_cli_command_print_usage(void) {
     printf("\trx <frequency:in Hz> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Receive\r\n");
     printf("\trx_raw <frequency:in Hz>\t - Receive RAW\r\n");
     printf("\tdecode_raw <file_name: path_RAW_file>\t - Testing\r\n");
+    printf(
+        "\tdecode_dir <dir_name: path_RAW_dir> <report: path_report_file>\t - Decode all RAW files in dir\r\n");
+    printf("\traw_pack <path_text_RAW_file> <path_binary_RAW_file>\t - Convert RAW to binary\r\n");
+    printf(
+        "\traw_unpack <path_binary_RAW_file> <path_text_RAW_file>\t - Convert binary RAW to text\r\n");
     printf(
         "\ttx_from_file <file_name: path_file> <repeat: count> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Transmitting from file\r\n");
 
@@ -927,6 +1215,54 @@ static void subghz_cli_command_encrypt_raw(Cli* cli, FuriString* args) {
     furi_string_free(source);
 }
 
+static void subghz_cli_command_raw_convert(Cli* cli, FuriString* args, bool pack) {
+    UNUSED(cli);
+
+    FuriString* source = furi_string_alloc();
+    FuriString* destination = furi_string_alloc();
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    do {
+        if(!args_read_probably_quoted_string_and_trim(args, source)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        if(!args_read_probably_quoted_string_and_trim(args, destination)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        uint32_t start = furi_get_tick();
+        bool result = pack ? subghz_raw_binary_import_text(
+                                 storage,
+                                 furi_string_get_cstr(source),
+                                 furi_string_get_cstr(destination)) :
+                             subghz_raw_binary_export_text(
+                                 storage,
+                                 furi_string_get_cstr(source),
+                                 furi_string_get_cstr(destination));
+        if(!result) {
+            printf("Failed to convert %s\r\n", furi_string_get_cstr(source));
+            break;
+        }
+
+        FileInfo src_info = {};
+        FileInfo dst_info = {};
+        storage_common_stat(storage, furi_string_get_cstr(source), &src_info);
+        storage_common_stat(storage, furi_string_get_cstr(destination), &dst_info);
+        printf(
+            "Done in %lu ms, %lu -> %lu bytes\r\n",
+            furi_get_tick() - start,
+            (uint32_t)src_info.size,
+            (uint32_t)dst_info.size);
+    } while(false);
+
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(destination);
+    furi_string_free(source);
+}
+
 static void subghz_cli_command_chat(Cli* cli, FuriString* args) {
     uint32_t frequency = 433920000;
     uint32_t device_ind = 0; // 0 - CC1101_INT, 1 - CC1101_EXT
@@ -1152,6 +1488,21 @@ static void subghz_cli_command(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "decode_dir") == 0) {
+            subghz_cli_command_decode_dir(cli, args, context);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "raw_pack") == 0) {
+            subghz_cli_command_raw_convert(cli, args, true);
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "raw_unpack") == 0) {
+            subghz_cli_command_raw_convert(cli, args, false);
+            break;
+        }
+
         if(furi_string_cmp_str(cmd, "tx_from_file") == 0) {
             subghz_cli_command_tx_from_file(cli, args, context);
             break;
@@ -1,5 +1,6 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
+#include <toolbox/stream/stream.h>
 #include <rpc/rpc.h>
 
 #include <furi.h>
@@ -7,25 +8,45 @@
 #define SUBGHZ_HISTORY_MAX       65535 // uint16_t index max, ram limit below
 #define SUBGHZ_HISTORY_FREE_HEAP (10240 * (3 - MIN(rpc_get_sessions_count(instance->rpc), 2U)))
 
+#define SUBGHZ_HISTORY_INDEX_INIT_SIZE 32 // Power of two
+#define SUBGHZ_HISTORY_EXPANDED_NONE   UINT32_MAX
+
 #define TAG "SubGhzHistory"
 
 typedef struct {
-    FuriString* item_str;
-    FlipperFormat* flipper_string;
-    uint8_t type;
-    SubGhzRadioPreset* preset;
-    DateTime datetime;
+    char* data; // Menu text, '\0', serialized FlipperFormat
+    uint32_t data_size;
+    uint32_t frequency;
     uint32_t hash_data;
     const SubGhzProtocol* protocol;
-    uint16_t repeats;
+    DateTime datetime;
     float latitude;
     float longitude;
+    uint16_t repeats;
+    uint8_t preset;
+    uint8_t type;
 } SubGhzHistoryItem;
 
 ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
 
 #define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
 
+typedef struct {
+    FuriString* name;
+    uint8_t* data;
+    size_t data_size;
+} SubGhzHistoryPreset;
+
+ARRAY_DEF(SubGhzHistoryPresetArray, SubGhzHistoryPreset, M_POD_OPLIST)
+
+// Repeat counter of a (protocol, hash_data) pair, count is the number of items in history
+typedef struct {
+    const SubGhzProtocol* protocol;
+    uint32_t hash_data;
+    uint16_t repeats;
+    uint16_t count;
+} SubGhzHistoryIndexEntry;
+
 typedef struct {
     SubGhzHistoryItemArray_t data;
 } SubGhzHistoryStruct;
@@ -37,13 +58,156 @@ struct SubGhzHistory {
     FuriString* tmp_string;
     SubGhzHistoryStruct* history;
     Rpc* rpc;
+
+    SubGhzHistoryIndexEntry* index;
+    size_t index_size;
+    size_t index_used;
+
+    SubGhzHistoryPresetArray_t presets;
+    SubGhzRadioPreset radio_preset;
+
+    FlipperFormat* packer; // Receive path serializes here before packing
+    FlipperFormat* expanded; // Item handed out by subghz_history_get_raw_data
+    uint32_t expanded_idx;
+    size_t memory_used;
 };
 
+static inline uint32_t
+    subghz_history_index_hash(const SubGhzProtocol* protocol, uint32_t hash_data) {
+    uint32_t hash = hash_data ^ ((uint32_t)(uintptr_t)protocol * 0x9E3779B1);
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6B;
+    hash ^= hash >> 13;
+    return hash;
+}
+
+// Returns matching entry or the free slot where it should be inserted
+static SubGhzHistoryIndexEntry* subghz_history_index_find(
+    SubGhzHistory* instance,
+    const SubGhzProtocol* protocol,
+    uint32_t hash_data) {
+    size_t mask = instance->index_size - 1;
+    size_t pos = subghz_history_index_hash(protocol, hash_data) & mask;
+    while(instance->index[pos].protocol) {
+        SubGhzHistoryIndexEntry* entry = &instance->index[pos];
+        if(entry->protocol == protocol && entry->hash_data == hash_data) break;
+        pos = (pos + 1) & mask;
+    }
+    return &instance->index[pos];
+}
+
+static void subghz_history_index_grow(SubGhzHistory* instance) {
+    SubGhzHistoryIndexEntry* old_index = instance->index;
+    size_t old_size = instance->index_size;
+
+    instance->index_size *= 2;
+    instance->index = malloc(instance->index_size * sizeof(SubGhzHistoryIndexEntry));
+    for(size_t i = 0; i < old_size; i++) {
+        if(!old_index[i].protocol) continue;
+        *subghz_history_index_find(instance, old_index[i].protocol, old_index[i].hash_data) =
+            old_index[i];
+    }
+    free(old_index);
+}
+
+static SubGhzHistoryIndexEntry* subghz_history_index_get(
+    SubGhzHistory* instance,
+    const SubGhzProtocol* protocol,
+    uint32_t hash_data) {
+    SubGhzHistoryIndexEntry* entry = subghz_history_index_find(instance, protocol, hash_data);
+    if(!entry->protocol) {
+        // Keep load factor under 70%, linear probing degrades quickly above that
+        if((instance->index_used + 1) * 10 > instance->index_size * 7) {
+            subghz_history_index_grow(instance);
+            entry = subghz_history_index_find(instance, protocol, hash_data);
+        }
+        entry->protocol = protocol;
+        entry->hash_data = hash_data;
+        instance->index_used++;
+    }
+    return entry;
+}
+
+static void subghz_history_index_reset(SubGhzHistory* instance) {
+    free(instance->index);
+    instance->index_size = SUBGHZ_HISTORY_INDEX_INIT_SIZE;
+    instance->index = malloc(instance->index_size * sizeof(SubGhzHistoryIndexEntry));
+    instance->index_used = 0;
+}
+
+static uint8_t subghz_history_preset_get(SubGhzHistory* instance, SubGhzRadioPreset* preset) {
+    size_t idx = 0;
+    for
+        M_EACH(item, instance->presets, SubGhzHistoryPresetArray_t) {
+            if(item->data == preset->data && item->data_size == preset->data_size &&
+               furi_string_equal(item->name, preset->name)) {
+                return idx;
+            }
+            idx++;
+        }
+
+    furi_check(idx <= UINT8_MAX);
+    SubGhzHistoryPreset* item = SubGhzHistoryPresetArray_push_raw(instance->presets);
+    item->name = furi_string_alloc_set(preset->name);
+    item->data = preset->data;
+    item->data_size = preset->data_size;
+    return idx;
+}
+
+static void subghz_history_preset_reset(SubGhzHistory* instance) {
+    for
+        M_EACH(item, instance->presets, SubGhzHistoryPresetArray_t) {
+            furi_string_free(item->name);
+        }
+    SubGhzHistoryPresetArray_reset(instance->presets);
+}
+
+static inline uint32_t subghz_history_item_memory(SubGhzHistoryItem* item) {
+    return sizeof(SubGhzHistoryItem) + item->data_size;
+}
+
+// Pack menu text and the serialized signal currently held in `packer`
+static void subghz_history_item_pack(
+    SubGhzHistory* instance,
+    SubGhzHistoryItem* item,
+    FuriString* item_str) {
+    Stream* stream = flipper_format_get_raw_stream(instance->packer);
+    size_t text_size = furi_string_size(item_str) + 1;
+    size_t serialized_size = stream_size(stream);
+
+    item->data_size = text_size + serialized_size;
+    item->data = malloc(item->data_size);
+    memcpy(item->data, furi_string_get_cstr(item_str), text_size);
+    stream_rewind(stream);
+    if(stream_read(stream, (uint8_t*)item->data + text_size, serialized_size) !=
+       serialized_size) {
+        FURI_LOG_E(TAG, "Pack error");
+    }
+    instance->memory_used += subghz_history_item_memory(item);
+    FURI_LOG_D(
+        TAG,
+        "Item %luB, history %zuB",
+        subghz_history_item_memory(item),
+        instance->memory_used);
+}
+
+static void subghz_history_item_free(SubGhzHistory* instance, SubGhzHistoryItem* item) {
+    instance->memory_used -= subghz_history_item_memory(item);
+    free(item->data);
+    item->data = NULL;
+    item->type = 0;
+}
+
 SubGhzHistory* subghz_history_alloc(void) {
     SubGhzHistory* instance = malloc(sizeof(SubGhzHistory));
     instance->tmp_string = furi_string_alloc();
     instance->history = malloc(sizeof(SubGhzHistoryStruct));
     SubGhzHistoryItemArray_init(instance->history->data);
+    SubGhzHistoryPresetArray_init(instance->presets);
+    subghz_history_index_reset(instance);
+    instance->packer = flipper_format_string_alloc();
+    instance->expanded = flipper_format_string_alloc();
+    instance->expanded_idx = SUBGHZ_HISTORY_EXPANDED_NONE;
     instance->rpc = furi_record_open(RECORD_RPC);
     return instance;
 }
@@ -53,14 +217,15 @@ void subghz_history_free(SubGhzHistory* instance) {
     furi_string_free(instance->tmp_string);
     for
         M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
+            subghz_history_item_free(instance, item);
         }
     SubGhzHistoryItemArray_clear(instance->history->data);
     free(instance->history);
+    subghz_history_preset_reset(instance);
+    SubGhzHistoryPresetArray_clear(instance->presets);
+    free(instance->index);
+    flipper_format_free(instance->packer);
+    flipper_format_free(instance->expanded);
     furi_record_close(RECORD_RPC);
     free(instance);
 }
@@ -86,19 +251,27 @@ uint16_t subghz_history_get_repeats(SubGhzHistory* instance, uint16_t idx) {
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    return item->frequency;
 }
 
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    SubGhzHistoryPreset* preset = SubGhzHistoryPresetArray_get(instance->presets, item->preset);
+    instance->radio_preset.name = preset->name;
+    instance->radio_preset.frequency = item->frequency;
+    instance->radio_preset.data = preset->data;
+    instance->radio_preset.data_size = preset->data_size;
+    instance->radio_preset.latitude = item->latitude;
+    instance->radio_preset.longitude = item->longitude;
+    return &instance->radio_preset;
 }
 
 const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    SubGhzHistoryPreset* preset = SubGhzHistoryPresetArray_get(instance->presets, item->preset);
+    return furi_string_get_cstr(preset->name);
 }
 
 float subghz_history_get_latitude(SubGhzHistory* instance, uint16_t idx) {
@@ -118,13 +291,12 @@ void subghz_history_reset(SubGhzHistory* instance) {
     furi_string_reset(instance->tmp_string);
     for
         M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
+            subghz_history_item_free(instance, item);
         }
     SubGhzHistoryItemArray_reset(instance->history->data);
+    subghz_history_preset_reset(instance);
+    subghz_history_index_reset(instance);
+    instance->expanded_idx = SUBGHZ_HISTORY_EXPANDED_NONE;
     instance->last_index_write = 0;
     instance->code_last_hash_data = 0;
 }
@@ -134,12 +306,13 @@ void subghz_history_delete_item(SubGhzHistory* instance, uint16_t idx) {
 
     if(idx < SubGhzHistoryItemArray_size(instance->history->data)) {
         SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-        furi_string_free(item->item_str);
-        furi_string_free(item->preset->name);
-        free(item->preset);
-        flipper_format_free(item->flipper_string);
-        item->type = 0;
+        SubGhzHistoryIndexEntry* entry =
+            subghz_history_index_find(instance, item->protocol, item->hash_data);
+        // Last copy gone, the next one starts counting from scratch
+        if(entry->protocol && entry->count) entry->count--;
+        subghz_history_item_free(instance, item);
         SubGhzHistoryItemArray_remove_v(instance->history->data, idx, idx + 1);
+        instance->expanded_idx = SUBGHZ_HISTORY_EXPANDED_NONE;
         instance->last_index_write--;
     }
 }
@@ -158,17 +331,12 @@ uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx)
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(!item || !item->flipper_string) {
+    if(!item || !item->protocol) {
         FURI_LOG_E(TAG, "Missing Item");
         furi_string_reset(instance->tmp_string);
         return furi_string_get_cstr(instance->tmp_string);
     }
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        furi_string_reset(instance->tmp_string);
-    }
-    return furi_string_get_cstr(instance->tmp_string);
+    return item->protocol->name;
 }
 
 DateTime subghz_history_get_datetime(SubGhzHistory* instance, uint16_t idx) {
@@ -184,11 +352,17 @@ DateTime subghz_history_get_datetime(SubGhzHistory* instance, uint16_t idx) {
 FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
-    } else {
-        return NULL;
+    if(!item->data) return NULL;
+
+    if(instance->expanded_idx != idx) {
+        Stream* stream = flipper_format_get_raw_stream(instance->expanded);
+        size_t text_size = strlen(item->data) + 1;
+        stream_clean(stream);
+        stream_write(stream, (const uint8_t*)item->data + text_size, item->data_size - text_size);
+        instance->expanded_idx = idx;
     }
+    flipper_format_rewind(instance->expanded);
+    return instance->expanded;
 }
 bool subghz_history_get_text_space_left(
     SubGhzHistory* instance,
@@ -220,15 +394,22 @@ bool subghz_history_get_text_space_left(
 uint16_t subghz_history_get_last_index(SubGhzHistory* instance) {
     return instance->last_index_write;
 }
+
 void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    furi_string_set(output, item->item_str);
+    furi_string_set(output, item->data);
 }
 
 void subghz_history_get_time_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
     DateTime* t = &item->datetime;
-    furi_string_printf(output, "%.2d:%.2d:%.2d ", t->hour, t->minute, t->second);
+    furi_string_printf(
+        output,
+        "%.2d:%.2d:%.2d %luB",
+        t->hour,
+        t->minute,
+        t->second,
+        subghz_history_item_memory(item));
 }
 
 bool subghz_history_add_to_history(
@@ -248,34 +429,24 @@ bool subghz_history_add_to_history(
         return false;
     }
 
-    uint16_t repeats = 0;
-    SubGhzHistoryItemArray_it_t it;
-    SubGhzHistoryItemArray_it_last(it, instance->history->data);
-    while(!SubGhzHistoryItemArray_end_p(it)) {
-        SubGhzHistoryItem* search = SubGhzHistoryItemArray_ref(it);
-        if(search->hash_data == hash_data && search->protocol == decoder_base->protocol) {
-            repeats = search->repeats + 1;
-            break;
-        }
-        SubGhzHistoryItemArray_previous(it);
-    }
+    SubGhzHistoryIndexEntry* entry =
+        subghz_history_index_get(instance, decoder_base->protocol, hash_data);
+    uint16_t repeats = entry->count ? entry->repeats + 1 : 0;
+    entry->repeats = repeats;
+    entry->count++;
 
     instance->code_last_hash_data = hash_data;
     instance->last_update_timestamp = furi_get_tick();
 
     SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
     item->type = decoder_base->protocol->type;
     if(decoder_base->protocol->filter & SubGhzProtocolFilter_Weather) {
         // Other code uses protocol type to check if signal is usable
         // so we can't change the actual protocol type, we fake it here
         item->type = SubGhzProtocolWeatherStation;
     }
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    furi_string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
+    item->frequency = preset->frequency;
+    item->preset = subghz_history_preset_get(instance, preset);
     furi_hal_rtc_get_datetime(&item->datetime);
     item->hash_data = hash_data;
     item->protocol = decoder_base->protocol;
@@ -283,77 +454,83 @@ bool subghz_history_add_to_history(
     item->latitude = preset->latitude;
     item->longitude = preset->longitude;
 
-    item->item_str = furi_string_alloc();
-    item->flipper_string = flipper_format_string_alloc();
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
+    // Serialize into the packer, never into `expanded`: a caller of
+    // subghz_history_get_raw_data may still be reading that one
+    FlipperFormat* flipper_string = instance->packer;
+    stream_clean(flipper_format_get_raw_stream(flipper_string));
+    subghz_protocol_decoder_base_serialize(decoder_base, flipper_string, preset);
+
+    FuriString* item_str = furi_string_alloc();
 
     if(decoder_base->protocol && decoder_base->protocol->decoder &&
        decoder_base->protocol->decoder->get_string_brief) {
-        decoder_base->protocol->decoder->get_string_brief(decoder_base, item->item_str);
-        instance->last_index_write++;
-        return true;
-    }
-
-    FuriString* text = furi_string_alloc();
+        decoder_base->protocol->decoder->get_string_brief(decoder_base, item_str);
+    } else {
+        FuriString* text = furi_string_alloc();
 
-    do {
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-            FURI_LOG_E(TAG, "Missing Protocol");
-            break;
-        }
-        if(!strcmp(furi_string_get_cstr(instance->tmp_string), "KeeLoq")) {
-            furi_string_set(instance->tmp_string, "KL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
-                FURI_LOG_E(TAG, "Missing Protocol");
+        do {
+            if(!flipper_format_rewind(flipper_string)) {
+                FURI_LOG_E(TAG, "Rewind error");
                 break;
             }
-            furi_string_cat(instance->tmp_string, text);
-        } else if(!strcmp(furi_string_get_cstr(instance->tmp_string), "Star Line")) {
-            furi_string_set(instance->tmp_string, "SL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
+            if(!flipper_format_read_string(flipper_string, "Protocol", instance->tmp_string)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
                 break;
             }
-            furi_string_cat(instance->tmp_string, text);
-        }
-        if(!flipper_format_rewind(item->flipper_string)) {
-            FURI_LOG_E(TAG, "Rewind error");
-            break;
-        }
-        uint8_t key_data[sizeof(uint64_t)] = {0};
-        if(!flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
-            FURI_LOG_D(TAG, "No Key");
-        }
-        uint64_t data = 0;
-        for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
-            data = (data << 8) | key_data[i];
-        }
-        if(data != 0) {
-            if(!(uint32_t)(data >> 32)) {
-                furi_string_printf(
-                    item->item_str,
-                    "%s %lX",
-                    furi_string_get_cstr(instance->tmp_string),
-                    (uint32_t)(data & 0xFFFFFFFF));
+            if(!strcmp(furi_string_get_cstr(instance->tmp_string), "KeeLoq")) {
+                furi_string_set(instance->tmp_string, "KL ");
+                if(!flipper_format_read_string(flipper_string, "Manufacture", text)) {
+                    FURI_LOG_E(TAG, "Missing Protocol");
+                    break;
+                }
+                furi_string_cat(instance->tmp_string, text);
+            } else if(!strcmp(furi_string_get_cstr(instance->tmp_string), "Star Line")) {
+                furi_string_set(instance->tmp_string, "SL ");
+                if(!flipper_format_read_string(flipper_string, "Manufacture", text)) {
+                    FURI_LOG_E(TAG, "Missing Protocol");
+                    break;
+                }
+                furi_string_cat(instance->tmp_string, text);
+            }
+            if(!flipper_format_rewind(flipper_string)) {
+                FURI_LOG_E(TAG, "Rewind error");
+                break;
+            }
+            uint8_t key_data[sizeof(uint64_t)] = {0};
+            if(!flipper_format_read_hex(flipper_string, "Key", key_data, sizeof(uint64_t))) {
+                FURI_LOG_D(TAG, "No Key");
+            }
+            uint64_t data = 0;
+            for(uint8_t i = 0; i < sizeof(uint64_t); i++) {
+                data = (data << 8) | key_data[i];
+            }
+            if(data != 0) {
+                if(!(uint32_t)(data >> 32)) {
+                    furi_string_printf(
+                        item_str,
+                        "%s %lX",
+                        furi_string_get_cstr(instance->tmp_string),
+                        (uint32_t)(data & 0xFFFFFFFF));
+                } else {
+                    furi_string_printf(
+                        item_str,
+                        "%s %lX%08lX",
+                        furi_string_get_cstr(instance->tmp_string),
+                        (uint32_t)(data >> 32),
+                        (uint32_t)(data & 0xFFFFFFFF));
+                }
             } else {
-                furi_string_printf(
-                    item->item_str,
-                    "%s %lX%08lX",
-                    furi_string_get_cstr(instance->tmp_string),
-                    (uint32_t)(data >> 32),
-                    (uint32_t)(data & 0xFFFFFFFF));
+                furi_string_printf(item_str, "%s", furi_string_get_cstr(instance->tmp_string));
             }
-        } else {
-            furi_string_printf(item->item_str, "%s", furi_string_get_cstr(instance->tmp_string));
-        }
 
-    } while(false);
+        } while(false);
+
+        furi_string_free(text);
+    }
+
+    subghz_history_item_pack(instance, item, item_str);
+    furi_string_free(item_str);
 
-    furi_string_free(text);
     instance->last_index_write++;
     return true;
 }
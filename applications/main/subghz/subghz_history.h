@@ -61,6 +61,13 @@ uint16_t subghz_history_get_repeats(SubGhzHistory* instance, uint16_t idx);
  */
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx);
 
+/** Get preset to history[idx]
+ * Returned preset is shared, name is owned by history
+ * 
+ * @param instance  - SubGhzHistory instance
+ * @param idx       - record index
+ * @return preset   - SubGhzRadioPreset*
+ */
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx);
 
 /** Get preset to history[idx]
@@ -110,7 +117,7 @@ DateTime subghz_history_get_datetime(SubGhzHistory* instance, uint16_t idx);
  */
 void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx);
 
-/** Get time item menu to history[idx]
+/** Get time item menu to history[idx], followed by memory taken by the record
  * 
  * @param instance  - SubGhzHistory instance
  * @param output    - FuriString* output
@@ -154,6 +161,8 @@ bool subghz_history_add_to_history(
     SubGhzRadioPreset* preset);
 
 /** Get SubGhzProtocolCommonLoad to load into the protocol decoder bin data
+ * Records are kept packed, the returned FlipperFormat is shared and stays valid
+ * until the next call or until history is modified
  * 
  * @param instance  - SubGhzHistory instance
  * @param idx       - record index
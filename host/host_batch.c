@@ -0,0 +1,268 @@
+#include "host_batch.h"
+
+#include <dirent.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define HOST_BATCH_FILE_MARK  '@'
+#define HOST_BATCH_TOTAL_MARK '='
+
+static void host_batch_add(HostBatch* batch, const char* path) {
+    if((batch->count & (batch->count + 1)) == 0) {
+        batch->files = realloc(batch->files, (batch->count + 1) * 2 * sizeof(char*));
+    }
+    batch->files[batch->count++] = strdup(path);
+}
+
+static bool host_batch_has_extension(const char* path, const char* extension) {
+    size_t path_size = strlen(path);
+    size_t extension_size = strlen(extension);
+    return path_size > extension_size &&
+           strcasecmp(path + path_size - extension_size, extension) == 0;
+}
+
+static void host_batch_walk(HostBatch* batch, const char* dir_path, const char* extension) {
+    DIR* dir = opendir(dir_path);
+    if(!dir) return;
+
+    struct dirent* entry;
+    while((entry = readdir(dir))) {
+        if(entry->d_name[0] == '.') continue;
+
+        size_t path_size = strlen(dir_path) + strlen(entry->d_name) + 2;
+        char* path = malloc(path_size);
+        snprintf(path, path_size, "%s/%s", dir_path, entry->d_name);
+
+        struct stat st;
+        if(stat(path, &st) == 0) {
+            if(S_ISDIR(st.st_mode)) {
+                host_batch_walk(batch, path, extension);
+            } else if(host_batch_has_extension(path, extension)) {
+                host_batch_add(batch, path);
+            }
+        }
+        free(path);
+    }
+    closedir(dir);
+}
+
+static int host_batch_compare_str(const void* a, const void* b) {
+    return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+bool host_batch_collect(
+    HostBatch* batch,
+    char* const* paths,
+    size_t path_count,
+    const char* extension) {
+    bool result = true;
+
+    for(size_t i = 0; i < path_count; i++) {
+        struct stat st;
+        if(stat(paths[i], &st) != 0) {
+            fprintf(stderr, "%s: no such file or directory\n", paths[i]);
+            result = false;
+        } else if(S_ISDIR(st.st_mode)) {
+            size_t first = batch->count;
+            host_batch_walk(batch, paths[i], extension);
+            // Directory order is up to the file system, keep runs comparable
+            qsort(
+                batch->files + first,
+                batch->count - first,
+                sizeof(char*),
+                host_batch_compare_str);
+        } else {
+            host_batch_add(batch, paths[i]);
+        }
+    }
+
+    return result;
+}
+
+void host_batch_free(HostBatch* batch) {
+    for(size_t i = 0; i < batch->count; i++) {
+        free(batch->files[i]);
+    }
+    free(batch->files);
+    batch->files = NULL;
+    batch->count = 0;
+}
+
+size_t host_batch_get_cpu_count(void) {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (size_t)count : 1;
+}
+
+static void host_batch_work(
+    const HostBatch* batch,
+    const HostBatchWorker* worker,
+    void* context,
+    size_t* next,
+    FILE* output) {
+    void* instance = worker->alloc(context);
+
+    while(true) {
+        size_t index = __atomic_fetch_add(next, 1, __ATOMIC_RELAXED);
+        if(index >= batch->count) break;
+
+        fprintf(output, "%c%zu\n", HOST_BATCH_FILE_MARK, index);
+        worker->process(instance, batch->files[index], output);
+    }
+
+    fprintf(output, "%c\n", HOST_BATCH_TOTAL_MARK);
+    worker->finish(instance, output);
+    worker->free(instance);
+    fflush(output);
+}
+
+/* Sort worker output by file: every file gets its own buffer of result lines */
+static void host_batch_split(
+    const HostBatch* batch,
+    const HostBatchWorker* worker,
+    void* context,
+    FILE* output,
+    char** results,
+    size_t* result_sizes) {
+    char* line = NULL;
+    size_t line_size = 0;
+    ssize_t length;
+    size_t index = SIZE_MAX;
+    bool totals = false;
+
+    rewind(output);
+    while((length = getline(&line, &line_size, output)) > 0) {
+        if(line[0] == HOST_BATCH_FILE_MARK) {
+            index = strtoul(line + 1, NULL, 10);
+        } else if(line[0] == HOST_BATCH_TOTAL_MARK) {
+            totals = true;
+        } else if(totals) {
+            line[strcspn(line, "\n")] = '\0';
+            worker->merge_total(context, line);
+        } else if(index < batch->count) {
+            results[index] = realloc(results[index], result_sizes[index] + length + 1);
+            memcpy(results[index] + result_sizes[index], line, length + 1);
+            result_sizes[index] += length;
+        }
+    }
+    free(line);
+}
+
+bool host_batch_run(
+    const HostBatch* batch,
+    size_t jobs,
+    const HostBatchWorker* worker,
+    void* context) {
+    if(jobs < 1) jobs = 1;
+    if(jobs > batch->count) jobs = batch->count ? batch->count : 1;
+
+    // Next file to take, shared by all workers
+    size_t* next =
+        mmap(NULL, sizeof(size_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if(next == MAP_FAILED) return false;
+    *next = 0;
+
+    FILE** outputs = calloc(jobs, sizeof(FILE*));
+    pid_t* pids = calloc(jobs, sizeof(pid_t));
+    bool result = true;
+
+    for(size_t i = 0; i < jobs; i++) {
+        outputs[i] = tmpfile();
+        if(!outputs[i]) {
+            result = false;
+            break;
+        }
+
+        if(jobs == 1) {
+            host_batch_work(batch, worker, context, next, outputs[i]);
+        } else {
+            fflush(NULL);
+            pids[i] = fork();
+            if(pids[i] == 0) {
+                host_batch_work(batch, worker, context, next, outputs[i]);
+                _exit(0);
+            } else if(pids[i] < 0) {
+                result = false;
+                break;
+            }
+        }
+    }
+
+    for(size_t i = 0; i < jobs; i++) {
+        int status;
+        if(pids[i] > 0 && (waitpid(pids[i], &status, 0) < 0 || !WIFEXITED(status) ||
+                           WEXITSTATUS(status) != 0)) {
+            fprintf(stderr, "Worker %zu crashed, its last file is incomplete\n", i);
+            result = false;
+        }
+    }
+
+    char** results = calloc(batch->count, sizeof(char*));
+    size_t* result_sizes = calloc(batch->count, sizeof(size_t));
+    for(size_t i = 0; i < jobs; i++) {
+        if(!outputs[i]) continue;
+        host_batch_split(batch, worker, context, outputs[i], results, result_sizes);
+        fclose(outputs[i]);
+    }
+
+    for(size_t index = 0; index < batch->count; index++) {
+        char* save = NULL;
+        for(char* line = results[index] ? strtok_r(results[index], "\n", &save) : NULL; line;
+            line = strtok_r(NULL, "\n", &save)) {
+            worker->merge_file(context, index, batch->files[index], line);
+        }
+        free(results[index]);
+    }
+
+    free(result_sizes);
+    free(results);
+    free(pids);
+    free(outputs);
+    munmap(next, sizeof(size_t));
+    return result;
+}
+
+int host_batch_compare(const char* expected_path, char** lines, size_t count, FILE* output) {
+    FILE* file = fopen(expected_path, "r");
+    if(!file) return -1;
+
+    HostBatch expected = {0};
+    char* line = NULL;
+    size_t line_size = 0;
+    while(getline(&line, &line_size, file) > 0) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if(line[0]) host_batch_add(&expected, line);
+    }
+    free(line);
+    fclose(file);
+
+    qsort(expected.files, expected.count, sizeof(char*), host_batch_compare_str);
+    qsort(lines, count, sizeof(char*), host_batch_compare_str);
+
+    // Both sides are sorted, walk them together like diff of two multisets
+    int differences = 0;
+    size_t i = 0, j = 0;
+    while(i < expected.count || j < count) {
+        int order = (i == expected.count) ? 1 :
+                    (j == count)          ? -1 :
+                                            strcmp(expected.files[i], lines[j]);
+        if(order < 0) {
+            fprintf(output, "- %s\n", expected.files[i++]);
+            differences++;
+        } else if(order > 0) {
+            fprintf(output, "+ %s\n", lines[j++]);
+            differences++;
+        } else {
+            i++;
+            j++;
+        }
+    }
+
+    host_batch_free(&expected);
+    return differences;
+}
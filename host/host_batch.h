@@ -0,0 +1,84 @@
+/**
+ * @file host_batch.h
+ * Parallel batch processing of capture files for the host tools
+ *
+ * Files are handed out one at a time to worker processes. Processes rather than
+ * threads keep the static state some decoders have private to every worker.
+ * Workers write text lines, which are merged back in file order, so the output
+ * does not depend on the number of jobs.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    char** files;
+    size_t count;
+} HostBatch;
+
+typedef struct {
+    /** Worker process: allocate decoders, called once per worker */
+    void* (*alloc)(void* context);
+    /** Worker process: write result lines for one file */
+    void (*process)(void* worker, const char* path, FILE* output);
+    /** Worker process: write total lines once all files are done */
+    void (*finish)(void* worker, FILE* output);
+    /** Worker process: free decoders */
+    void (*free)(void* worker);
+
+    /** Main process: one result line of a file, called in file order */
+    void (*merge_file)(void* context, size_t index, const char* path, char* line);
+    /** Main process: one total line of a worker */
+    void (*merge_total)(void* context, char* line);
+} HostBatchWorker;
+
+/** Collect files with the extension, directories are walked recursively
+ * @param batch empty batch
+ * @param paths files and directories
+ * @param path_count amount of paths
+ * @param extension file extension, e.g. ".sub"
+ * @return false if a path does not exist
+ */
+bool host_batch_collect(
+    HostBatch* batch,
+    char* const* paths,
+    size_t path_count,
+    const char* extension);
+
+/** Free collected file names */
+void host_batch_free(HostBatch* batch);
+
+/** Process all files
+ * @param batch collected files
+ * @param jobs amount of worker processes, 1 runs in this process
+ * @param worker callbacks
+ * @param context context for alloc and merge callbacks
+ * @return false if a worker crashed
+ */
+bool host_batch_run(
+    const HostBatch* batch,
+    size_t jobs,
+    const HostBatchWorker* worker,
+    void* context);
+
+/** Default amount of jobs: online CPU cores */
+size_t host_batch_get_cpu_count(void);
+
+/** Compare report lines with a previous report, print "-" missing and "+" new lines
+ * @param expected_path report file of a previous run
+ * @param lines report lines of this run, sorted in place
+ * @param count amount of lines
+ * @param output where differences are printed
+ * @return amount of differences, -1 if the report can not be read
+ */
+int host_batch_compare(const char* expected_path, char** lines, size_t count, FILE* output);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,551 @@
+/**
+ * Batch LF RFID decoder for RAW captures
+ *
+ * Replays .raw captures through protocol_dict_decoders_feed once, restarting
+ * decoders after every decode like the read worker does. Prints the card read
+ * from every file, decode and false positive counts, edges per second of every
+ * protocol decoder, writes a report and compares it with the report of a
+ * previous run.
+ *
+ * The card a capture holds can be given by a key file next to it: "x.raw",
+ * "x.ask.raw" and "x.psk.raw" use "x.rfid". Without one the card is guessed.
+ */
+#include <furi.h>
+#include <storage/storage.h>
+#include <toolbox/protocols/protocol_dict.h>
+#include <lfrfid/lfrfid_raw_file.h>
+#include <lfrfid/lfrfid_dict_file.h>
+#include <lfrfid/protocols/lfrfid_protocols.h>
+
+#include <getopt.h>
+
+#include "host_batch.h"
+
+#define LFRFID_DECODE_EXTENSION     ".raw"
+#define LFRFID_DECODE_KEY_EXTENSION ".rfid"
+
+typedef enum {
+    LFRFIDDecodeExpectedNone,
+    LFRFIDDecodeExpectedRead,
+    LFRFIDDecodeExpectedMissed,
+} LFRFIDDecodeExpected;
+
+typedef struct {
+    uint32_t file_count;
+    uint32_t decode_count;
+    uint32_t false_count;
+    uint64_t feed_count;
+    uint64_t park_count;
+    uint64_t feed_ns;
+} LFRFIDDecodeProtocol;
+
+typedef struct {
+    bool quiet;
+    FILE* report;
+
+    // Merged results
+    char** report_lines;
+    size_t report_count;
+    uint32_t file_count;
+    uint32_t file_error_count;
+    uint32_t file_decoded_count;
+    uint32_t file_expected_count;
+    uint32_t file_missed_count;
+    uint32_t guessed_false_count;
+    uint64_t pair_count;
+    uint64_t decode_ns;
+
+    LFRFIDDecodeProtocol protocols[LFRFIDProtocolMax];
+} LFRFIDDecode;
+
+typedef struct {
+    ProtocolId protocol;
+    uint8_t* data;
+    uint32_t count;
+} LFRFIDDecodeCandidate;
+
+typedef struct {
+    Storage* storage;
+    ProtocolDict* dict;
+    ProtocolDict* key_dict;
+    FuriString* key_path;
+    size_t data_size;
+    uint8_t* data;
+    uint8_t* key_data;
+
+    uint32_t* pairs;
+    size_t pair_count;
+    size_t pair_capacity;
+
+    LFRFIDDecodeCandidate* candidates;
+    size_t candidate_count;
+    size_t candidate_capacity;
+} LFRFIDDecodeWorker;
+
+static void* lfrfid_decode_worker_alloc(void* context) {
+    UNUSED(context);
+    LFRFIDDecodeWorker* worker = malloc(sizeof(LFRFIDDecodeWorker));
+
+    worker->storage = furi_record_open(RECORD_STORAGE);
+    worker->dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    worker->key_dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    worker->key_path = furi_string_alloc();
+    worker->data_size = protocol_dict_get_max_data_size(worker->dict);
+    worker->data = malloc(worker->data_size);
+    worker->key_data = malloc(worker->data_size);
+    protocol_dict_reset_decoder_stats(worker->dict);
+    return worker;
+}
+
+static void lfrfid_decode_worker_free(void* context) {
+    LFRFIDDecodeWorker* worker = context;
+
+    for(size_t i = 0; i < worker->candidate_capacity; i++) {
+        free(worker->candidates[i].data);
+    }
+    free(worker->candidates);
+    free(worker->pairs);
+    free(worker->key_data);
+    free(worker->data);
+    furi_string_free(worker->key_path);
+    protocol_dict_free(worker->key_dict);
+    protocol_dict_free(worker->dict);
+    furi_record_close(RECORD_STORAGE);
+    free(worker);
+}
+
+/* One pass of the capture is loaded first, so decoding is timed without file reading */
+static bool lfrfid_decode_load(LFRFIDDecodeWorker* worker, const char* path) {
+    LFRFIDRawFile* file = lfrfid_raw_file_alloc(worker->storage);
+    float frequency;
+    float duty_cycle;
+    bool result = false;
+
+    worker->pair_count = 0;
+
+    if(lfrfid_raw_file_open_read(file, path) &&
+       lfrfid_raw_file_read_header(file, &frequency, &duty_cycle)) {
+        bool pass_end = false;
+        uint32_t pulse;
+        uint32_t duration;
+        while(lfrfid_raw_file_read_pair(file, &duration, &pulse, &pass_end) && !pass_end) {
+            if(worker->pair_count == worker->pair_capacity) {
+                worker->pair_capacity = MAX(worker->pair_capacity * 2, 4096U);
+                worker->pairs =
+                    realloc(worker->pairs, worker->pair_capacity * 2 * sizeof(uint32_t));
+            }
+            worker->pairs[worker->pair_count * 2] = pulse;
+            worker->pairs[worker->pair_count * 2 + 1] = duration;
+            worker->pair_count++;
+        }
+        result = true;
+    }
+
+    lfrfid_raw_file_free(file);
+    return result;
+}
+
+static void lfrfid_decode_add(LFRFIDDecodeWorker* worker, ProtocolId protocol) {
+    size_t data_size = protocol_dict_get_data_size(worker->dict, protocol);
+    protocol_dict_get_data(worker->dict, protocol, worker->data, data_size);
+
+    for(size_t i = 0; i < worker->candidate_count; i++) {
+        LFRFIDDecodeCandidate* candidate = &worker->candidates[i];
+        if(candidate->protocol == protocol &&
+           memcmp(candidate->data, worker->data, data_size) == 0) {
+            candidate->count++;
+            return;
+        }
+    }
+
+    if(worker->candidate_count == worker->candidate_capacity) {
+        worker->candidate_capacity = MAX(worker->candidate_capacity * 2, 8U);
+        worker->candidates = realloc(
+            worker->candidates, worker->candidate_capacity * sizeof(LFRFIDDecodeCandidate));
+        for(size_t i = worker->candidate_count; i < worker->candidate_capacity; i++) {
+            worker->candidates[i].data = malloc(worker->data_size);
+        }
+    }
+
+    LFRFIDDecodeCandidate* candidate = &worker->candidates[worker->candidate_count++];
+    candidate->protocol = protocol;
+    memcpy(candidate->data, worker->data, data_size);
+    candidate->count = 1;
+}
+
+/* Key file of the capture: strip ".raw" and the ".ask" or ".psk" the app adds */
+static ProtocolId lfrfid_decode_load_key(LFRFIDDecodeWorker* worker, const char* path) {
+    FuriString* key_path = worker->key_path;
+
+    furi_string_set(key_path, path);
+    furi_string_left(key_path, furi_string_size(key_path) - strlen(LFRFID_DECODE_EXTENSION));
+    if(furi_string_end_with_str(key_path, ".ask") || furi_string_end_with_str(key_path, ".psk")) {
+        furi_string_left(key_path, furi_string_size(key_path) - strlen(".ask"));
+    }
+    furi_string_cat_str(key_path, LFRFID_DECODE_KEY_EXTENSION);
+
+    if(!storage_file_exists(worker->storage, furi_string_get_cstr(key_path))) return PROTOCOL_NO;
+
+    ProtocolId protocol = lfrfid_dict_file_load(worker->key_dict, furi_string_get_cstr(key_path));
+    if(protocol != PROTOCOL_NO) {
+        protocol_dict_get_data(
+            worker->key_dict,
+            protocol,
+            worker->key_data,
+            protocol_dict_get_data_size(worker->key_dict, protocol));
+    } else {
+        FURI_LOG_W("LfRfidDecode", "Unable to load %s", furi_string_get_cstr(key_path));
+    }
+    return protocol;
+}
+
+static void lfrfid_decode_worker_process(void* context, const char* path, FILE* output) {
+    LFRFIDDecodeWorker* worker = context;
+
+    if(!lfrfid_decode_load(worker, path)) {
+        fprintf(output, "S\terror\n");
+        return;
+    }
+
+    worker->candidate_count = 0;
+    protocol_dict_decoders_start(worker->dict);
+
+    uint64_t start = furi_shim_get_ns();
+    for(size_t i = 0; i < worker->pair_count; i++) {
+        uint32_t pulse = worker->pairs[i * 2];
+        uint32_t duration = worker->pairs[i * 2 + 1];
+        if(pulse > duration) continue;
+
+        ProtocolId protocol = protocol_dict_decoders_feed(worker->dict, true, pulse);
+        if(protocol == PROTOCOL_NO) {
+            protocol = protocol_dict_decoders_feed(worker->dict, false, duration - pulse);
+        }
+
+        if(protocol != PROTOCOL_NO) {
+            lfrfid_decode_add(worker, protocol);
+            protocol_dict_decoders_start(worker->dict);
+        }
+    }
+    uint64_t decode_ns = furi_shim_get_ns() - start;
+
+    // With a key file the card is known, otherwise it is the most frequent result read more
+    // often than the protocol validates, the same as the read worker would show
+    ProtocolId key_protocol = lfrfid_decode_load_key(worker, path);
+    LFRFIDDecodeCandidate* card = NULL;
+    for(size_t i = 0; i < worker->candidate_count; i++) {
+        LFRFIDDecodeCandidate* candidate = &worker->candidates[i];
+        if(key_protocol != PROTOCOL_NO) {
+            if(candidate->protocol == key_protocol &&
+               memcmp(
+                   candidate->data,
+                   worker->key_data,
+                   protocol_dict_get_data_size(worker->dict, key_protocol)) == 0) {
+                card = candidate;
+            }
+        } else {
+            uint32_t validate_count =
+                protocol_dict_get_validate_count(worker->dict, candidate->protocol);
+            if(candidate->count > validate_count && (!card || candidate->count > card->count)) {
+                card = candidate;
+            }
+        }
+    }
+
+    uint32_t decode_count = 0;
+    uint32_t false_count = 0;
+    for(size_t i = 0; i < worker->candidate_count; i++) {
+        LFRFIDDecodeCandidate* candidate = &worker->candidates[i];
+        bool is_false = candidate != card;
+        fprintf(
+            output,
+            "C\t%ld\t%lu\t%d\n",
+            (long)candidate->protocol,
+            (unsigned long)candidate->count,
+            is_false);
+        decode_count += candidate->count;
+        if(is_false) false_count += candidate->count;
+    }
+
+    fprintf(output, "S\tok\t%zu\t%llu\t", worker->pair_count, (unsigned long long)decode_ns);
+    if(card) {
+        fprintf(output, "%s\t", protocol_dict_get_name(worker->dict, card->protocol));
+        for(size_t i = 0; i < protocol_dict_get_data_size(worker->dict, card->protocol); i++) {
+            fprintf(output, "%02X", card->data[i]);
+        }
+    } else {
+        fprintf(output, "-\t-");
+    }
+    fprintf(
+        output,
+        "\t%lu\t%lu\t%d\n",
+        (unsigned long)decode_count,
+        (unsigned long)false_count,
+        (key_protocol == PROTOCOL_NO) ? LFRFIDDecodeExpectedNone :
+        card                          ? LFRFIDDecodeExpectedRead :
+                                        LFRFIDDecodeExpectedMissed);
+}
+
+static void lfrfid_decode_worker_finish(void* context, FILE* output) {
+    LFRFIDDecodeWorker* worker = context;
+
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        ProtocolDictDecoderStats stats;
+        protocol_dict_get_decoder_stats(worker->dict, i, &stats);
+        // Cycles are nanoseconds on the host
+        fprintf(
+            output,
+            "T\t%zu\t%lu\t%lu\t%llu\n",
+            i,
+            (unsigned long)stats.feed_count,
+            (unsigned long)stats.park_count,
+            (unsigned long long)stats.feed_cycles);
+    }
+}
+
+static void lfrfid_decode_merge_file(void* context, size_t index, const char* path, char* line) {
+    UNUSED(index);
+    LFRFIDDecode* instance = context;
+
+    if(line[0] == 'C') {
+        long protocol;
+        unsigned long count;
+        int is_false;
+        if(sscanf(line, "C\t%ld\t%lu\t%d", &protocol, &count, &is_false) == 3 && protocol >= 0 &&
+           protocol < LFRFIDProtocolMax) {
+            instance->protocols[protocol].decode_count += count;
+            if(is_false) instance->protocols[protocol].false_count += count;
+        }
+        return;
+    }
+
+    if(!instance->quiet) printf("%s\n", path);
+
+    char* save = NULL;
+    strtok_r(line, "\t", &save);
+    const char* status = strtok_r(NULL, "\t", &save);
+    if(strcmp(status, "ok") != 0) {
+        instance->file_error_count++;
+        if(!instance->quiet) printf("  Not a raw file\n");
+        return;
+    }
+
+    const char* pairs = strtok_r(NULL, "\t", &save);
+    const char* decode_ns = strtok_r(NULL, "\t", &save);
+    const char* name = strtok_r(NULL, "\t", &save);
+    const char* data = strtok_r(NULL, "\t", &save);
+    unsigned long decode_count = strtoul(strtok_r(NULL, "\t", &save), NULL, 10);
+    unsigned long false_count = strtoul(strtok_r(NULL, "\t", &save), NULL, 10);
+    LFRFIDDecodeExpected expected = strtoul(strtok_r(NULL, "\t", &save), NULL, 10);
+
+    instance->file_count++;
+    instance->pair_count += strtoull(pairs, NULL, 10);
+    instance->decode_ns += strtoull(decode_ns, NULL, 10);
+    if(strcmp(name, "-") != 0) {
+        instance->file_decoded_count++;
+        for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+            if(strcmp(lfrfid_protocols[i]->name, name) == 0) {
+                instance->protocols[i].file_count++;
+                break;
+            }
+        }
+    }
+
+    const char* expected_text = "";
+    if(expected == LFRFIDDecodeExpectedNone) {
+        instance->guessed_false_count += false_count;
+    } else {
+        instance->file_expected_count++;
+        expected_text = ", key file read";
+        if(expected == LFRFIDDecodeExpectedMissed) {
+            instance->file_missed_count++;
+            expected_text = ", key file MISSED";
+        }
+    }
+
+    if(!instance->quiet) {
+        printf(
+            "  %s\t%s, decodes %lu, false %lu%s\n",
+            name,
+            data,
+            decode_count,
+            false_count,
+            expected_text);
+    }
+
+    // Report line: file, protocol, data, decodes and false positives
+    size_t size = strlen(path) + strlen(name) + strlen(data) + 32;
+    char* report_line = malloc(size);
+    snprintf(
+        report_line, size, "%s\t%s\t%s\t%lu\t%lu", path, name, data, decode_count, false_count);
+    if(instance->report) fprintf(instance->report, "%s\n", report_line);
+    instance->report_lines =
+        realloc(instance->report_lines, (instance->report_count + 1) * sizeof(char*));
+    instance->report_lines[instance->report_count++] = report_line;
+}
+
+static void lfrfid_decode_merge_total(void* context, char* line) {
+    LFRFIDDecode* instance = context;
+
+    size_t index;
+    unsigned long feed_count, park_count;
+    unsigned long long feed_ns;
+    if(sscanf(line, "T\t%zu\t%lu\t%lu\t%llu", &index, &feed_count, &park_count, &feed_ns) == 4 &&
+       index < LFRFIDProtocolMax) {
+        instance->protocols[index].feed_count += feed_count;
+        instance->protocols[index].park_count += park_count;
+        instance->protocols[index].feed_ns += feed_ns;
+    }
+}
+
+static const HostBatchWorker lfrfid_decode_worker = {
+    .alloc = lfrfid_decode_worker_alloc,
+    .process = lfrfid_decode_worker_process,
+    .finish = lfrfid_decode_worker_finish,
+    .free = lfrfid_decode_worker_free,
+    .merge_file = lfrfid_decode_merge_file,
+    .merge_total = lfrfid_decode_merge_total,
+};
+
+static void lfrfid_decode_print_usage(const char* name) {
+    printf("Usage: %s [options] <file or dir>...\n", name);
+    printf("Decode LF RFID RAW captures (.raw) with every protocol\n\n");
+    printf("  -j <jobs>    worker processes, default: CPU cores\n");
+    printf("  -r <file>    write report, one line per capture:\n");
+    printf("               <file>\\t<protocol>\\t<data>\\t<decodes>\\t<false>\n");
+    printf("  -c <file>    compare with a report of a previous run, exit 1 on difference\n");
+    printf("  -q           print summary only\n");
+    printf("  -v           print library log, repeat for more\n\n");
+    printf("A key file next to a capture, x.rfid for x.raw, x.ask.raw or x.psk.raw,\n");
+    printf("tells which card it holds. Every other decode is a false positive.\n");
+}
+
+int main(int argc, char** argv) {
+    LFRFIDDecode* instance = malloc(sizeof(LFRFIDDecode));
+    size_t jobs = host_batch_get_cpu_count();
+    const char* report_path = NULL;
+    const char* compare_path = NULL;
+    FuriLogLevel log_level = FuriLogLevelNone;
+    int opt;
+
+    while((opt = getopt(argc, argv, "j:r:c:qvh")) != -1) {
+        switch(opt) {
+        case 'j':
+            jobs = strtoul(optarg, NULL, 10);
+            break;
+        case 'r':
+            report_path = optarg;
+            break;
+        case 'c':
+            compare_path = optarg;
+            break;
+        case 'q':
+            instance->quiet = true;
+            break;
+        case 'v':
+            if(log_level < FuriLogLevelTrace) log_level++;
+            break;
+        default:
+            lfrfid_decode_print_usage(argv[0]);
+            return (opt == 'h') ? 0 : 2;
+        }
+    }
+
+    furi_log_set_level(log_level);
+
+    if(optind >= argc) {
+        lfrfid_decode_print_usage(argv[0]);
+        return 2;
+    }
+
+    if(report_path) {
+        instance->report = fopen(report_path, "w");
+        if(!instance->report) {
+            fprintf(stderr, "Unable to create report %s\n", report_path);
+            return 2;
+        }
+    }
+
+    HostBatch batch = {0};
+    if(!host_batch_collect(&batch, &argv[optind], argc - optind, LFRFID_DECODE_EXTENSION)) {
+        return 2;
+    }
+
+    uint64_t start = furi_shim_get_ns();
+    bool batch_ok = host_batch_run(&batch, jobs, &lfrfid_decode_worker, instance);
+    uint64_t time_ns = furi_shim_get_ns() - start;
+
+    printf(
+        "\nFiles %lu, skipped %lu, decoded %lu, pairs %llu\n",
+        (unsigned long)instance->file_count,
+        (unsigned long)instance->file_error_count,
+        (unsigned long)instance->file_decoded_count,
+        (unsigned long long)instance->pair_count);
+    printf(
+        "Done in %llu ms with %zu jobs, %llu pairs/s, decoding %llu ns/pair\n",
+        (unsigned long long)(time_ns / 1000000),
+        MIN(MAX(jobs, 1U), MAX(batch.count, 1U)),
+        (unsigned long long)(time_ns ? instance->pair_count * 1000000000ULL / time_ns : 0),
+        (unsigned long long)(instance->pair_count ? instance->decode_ns / instance->pair_count :
+                                                    0));
+    printf(
+        "Key files %lu, card read %lu, missed %lu\n",
+        (unsigned long)instance->file_expected_count,
+        (unsigned long)(instance->file_expected_count - instance->file_missed_count),
+        (unsigned long)instance->file_missed_count);
+
+    // Edges per second of decoder time, parked decoders are not fed
+    printf(
+        "\n%-16s %6s %8s %8s %12s %8s %12s\n",
+        "Protocol",
+        "Files",
+        "Decodes",
+        "False %",
+        "Edges",
+        "Parked",
+        "Edges/s");
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        LFRFIDDecodeProtocol* protocol = &instance->protocols[i];
+        printf(
+            "%-16s %6lu %8lu %8.1f %12llu %8llu %12llu\n",
+            lfrfid_protocols[i]->name,
+            (unsigned long)protocol->file_count,
+            (unsigned long)protocol->decode_count,
+            protocol->decode_count ? protocol->false_count * 100.0 / protocol->decode_count : 0,
+            (unsigned long long)protocol->feed_count,
+            (unsigned long long)protocol->park_count,
+            (unsigned long long)(protocol->feed_ns ?
+                                     protocol->feed_count * 1000000000ULL / protocol->feed_ns :
+                                     0));
+    }
+
+    if(instance->guessed_false_count) {
+        printf(
+            "\n%lu false positives are from captures without a key file. There the card is\n"
+            "guessed as the most frequent decode read more often than the protocol\n"
+            "validates, which is a heuristic.\n",
+            (unsigned long)instance->guessed_false_count);
+    }
+
+    int result = batch_ok ? 0 : 2;
+    if(compare_path) {
+        printf("\nCompare with %s\n", compare_path);
+        int differences = host_batch_compare(
+            compare_path, instance->report_lines, instance->report_count, stdout);
+        if(differences < 0) {
+            fprintf(stderr, "Unable to read report %s\n", compare_path);
+            result = 2;
+        } else {
+            printf("%d differences\n", differences);
+            if(differences && !result) result = 1;
+        }
+    }
+
+    if(instance->report) fclose(instance->report);
+    for(size_t i = 0; i < instance->report_count; i++) {
+        free(instance->report_lines[i]);
+    }
+    free(instance->report_lines);
+    host_batch_free(&batch);
+    free(instance);
+    return result;
+}
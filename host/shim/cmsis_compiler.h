@@ -0,0 +1,8 @@
+/**
+ * @file cmsis_compiler.h
+ * Host stand-in: the host never runs with masked interrupts or in ISR mode
+ */
+#pragma once
+
+#define __get_PRIMASK() (0U)
+#define __get_IPSR()    (0U)
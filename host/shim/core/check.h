@@ -0,0 +1,37 @@
+/**
+ * @file check.h
+ * Host stand-in for furi check: failed checks print their location and abort
+ */
+#pragma once
+
+#include <m-core.h>
+#include <core/common_defines.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+FURI_NORETURN void furi_shim_crash(const char* file, int line, const char* message);
+
+#define __furi_crash(message) furi_shim_crash(__FILE__, __LINE__, message)
+
+/** Crash with an optional message (const char*) */
+#define furi_crash(...) __furi_crash((const char*[1]){__VA_ARGS__}[0])
+
+#define furi_halt(...) furi_crash(__VA_ARGS__)
+
+#define __furi_check(__e, __m)   \
+    do {                         \
+        if(!(__e)) {             \
+            __furi_crash(__m);   \
+        }                        \
+    } while(0)
+
+#define furi_check(...) M_APPLY(__furi_check, M_DEFAULT_ARGS(2, (#__VA_ARGS__), __VA_ARGS__))
+
+/** Asserts are checked on the host, a decoder tripping one is a bug worth seeing */
+#define furi_assert(...) furi_check(__VA_ARGS__)
+
+#ifdef __cplusplus
+}
+#endif
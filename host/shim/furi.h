@@ -0,0 +1,42 @@
+/**
+ * @file furi.h
+ * Host stand-in for furi.h
+ *
+ * Provides the part of the furi core that decoding libraries use: checks,
+ * logging, memory, ticks, records and FuriString. Threads, timers and other
+ * kernel objects are not available on the host.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include <core/common_defines.h>
+#include <core/check.h>
+#include <core/kernel.h>
+#include <core/log.h>
+#include <core/pubsub.h>
+#include <core/record.h>
+#include <core/string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Furi malloc never fails and returns zeroed memory, decoders rely on both */
+void* furi_shim_malloc(size_t size);
+
+#define malloc(size) furi_shim_malloc(size)
+
+/** Stand-in for the DWT cycle counter, nanoseconds of the monotonic clock */
+uint64_t furi_shim_get_ns(void);
+
+/** Cycle counter reads, cycles are nanoseconds on the host */
+#define DWT (&(const struct { uint32_t CYCCNT; }){(uint32_t)furi_shim_get_ns()})
+
+#ifdef __cplusplus
+}
+#endif
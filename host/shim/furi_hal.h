@@ -0,0 +1,25 @@
+/**
+ * @file furi_hal.h
+ * Host stand-in for furi_hal.h
+ *
+ * Only the HAL parts reachable from decoders are declared. Crypto enclave and
+ * CRC peripheral report failure, so callers fall back to software paths.
+ */
+#pragma once
+
+#include <furi_hal_crc.h>
+#include <furi_hal_crypto.h>
+#include <furi_hal_random.h>
+#include <furi_hal_rtc.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int8_t furi_hal_subghz_get_rolling_counter_mult(void);
+
+void furi_hal_subghz_set_rolling_counter_mult(int8_t mult);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,183 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <locale/locale.h>
+
+#include <stdarg.h>
+#include <time.h>
+
+#undef malloc
+
+static FuriLogLevel furi_shim_log_level = FuriLogLevelWarn;
+static int furi_shim_record;
+
+void* furi_shim_malloc(size_t size) {
+    void* p = calloc(1, size ? size : 1);
+    if(!p) furi_crash("out of memory");
+    return p;
+}
+
+void furi_shim_crash(const char* file, int line, const char* message) {
+    fflush(stdout);
+    fprintf(stderr, "furi_crash: %s (%s:%d)\n", message ? message : "", file, line);
+    abort();
+}
+
+uint64_t furi_shim_get_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Kernel
+
+uint32_t furi_kernel_get_tick_frequency(void) {
+    return 1000;
+}
+
+uint32_t furi_get_tick(void) {
+    return furi_shim_get_ns() / 1000000ULL;
+}
+
+uint32_t furi_ms_to_ticks(uint32_t milliseconds) {
+    return milliseconds;
+}
+
+void furi_delay_us(uint32_t microseconds) {
+    struct timespec ts = {
+        .tv_sec = microseconds / 1000000U,
+        .tv_nsec = (microseconds % 1000000U) * 1000U,
+    };
+    nanosleep(&ts, NULL);
+}
+
+void furi_delay_ms(uint32_t milliseconds) {
+    furi_delay_us(milliseconds * 1000U);
+}
+
+void furi_delay_tick(uint32_t ticks) {
+    furi_delay_ms(ticks);
+}
+
+// Log
+
+void furi_log_set_level(FuriLogLevel level) {
+    furi_shim_log_level = (level == FuriLogLevelDefault) ? FuriLogLevelWarn : level;
+}
+
+FuriLogLevel furi_log_get_level(void) {
+    return furi_shim_log_level;
+}
+
+void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
+    if(level > furi_shim_log_level) return;
+
+    static const char level_char[] = {' ', ' ', 'E', 'W', 'I', 'D', 'T'};
+    fprintf(stderr, "[%c][%s]: ", level_char[level % sizeof(level_char)], tag);
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
+
+void furi_log_print_raw_format(FuriLogLevel level, const char* format, ...) {
+    if(level > furi_shim_log_level) return;
+
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+}
+
+// Records: services are not running, callers only pass the handle around
+
+void* furi_record_open(const char* name) {
+    UNUSED(name);
+    return &furi_shim_record;
+}
+
+void furi_record_close(const char* name) {
+    UNUSED(name);
+}
+
+// HAL
+
+bool furi_hal_crc_acquire(void) {
+    return false;
+}
+
+void furi_hal_crc_release(void) {
+}
+
+void furi_hal_crc_configure(uint32_t polynomial, uint8_t width, bool reflected) {
+    UNUSED(polynomial);
+    UNUSED(width);
+    UNUSED(reflected);
+}
+
+uint32_t furi_hal_crc_feed(uint32_t crc, const uint8_t* data, size_t size) {
+    UNUSED(data);
+    UNUSED(size);
+    return crc;
+}
+
+bool furi_hal_crypto_enclave_load_key(uint8_t slot, const uint8_t* iv) {
+    UNUSED(slot);
+    UNUSED(iv);
+    return false;
+}
+
+bool furi_hal_crypto_enclave_unload_key(uint8_t slot) {
+    UNUSED(slot);
+    return true;
+}
+
+bool furi_hal_crypto_encrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    UNUSED(input);
+    UNUSED(output);
+    UNUSED(size);
+    return false;
+}
+
+bool furi_hal_crypto_decrypt(const uint8_t* input, uint8_t* output, size_t size) {
+    UNUSED(input);
+    UNUSED(output);
+    UNUSED(size);
+    return false;
+}
+
+uint32_t furi_hal_random_get(void) {
+    return ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+}
+
+void furi_hal_random_fill_buf(uint8_t* buf, uint32_t len) {
+    for(uint32_t i = 0; i < len; i++) {
+        buf[i] = furi_hal_random_get();
+    }
+}
+
+uint32_t furi_hal_rtc_get_timestamp(void) {
+    return time(NULL);
+}
+
+FuriHalRtcLocaleUnits furi_hal_rtc_get_locale_units(void) {
+    return FuriHalRtcLocaleUnitsMetric;
+}
+
+int8_t furi_hal_subghz_get_rolling_counter_mult(void) {
+    return 1;
+}
+
+void furi_hal_subghz_set_rolling_counter_mult(int8_t mult) {
+    UNUSED(mult);
+}
+
+// Locale
+
+float locale_fahrenheit_to_celsius(float temp_f) {
+    return (temp_f - 32.f) / 1.8f;
+}
+
+float locale_celsius_to_fahrenheit(float temp_c) {
+    return temp_c * 1.8f + 32.f;
+}
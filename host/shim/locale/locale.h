@@ -0,0 +1,17 @@
+/**
+ * @file locale.h
+ * Host stand-in for the locale service: unit conversion only
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+float locale_fahrenheit_to_celsius(float temp_f);
+
+float locale_celsius_to_fahrenheit(float temp_c);
+
+#ifdef __cplusplus
+}
+#endif
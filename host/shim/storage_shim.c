@@ -0,0 +1,339 @@
+#include <furi.h>
+#include <storage/storage.h>
+
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "storage_shim.h"
+
+typedef enum {
+    FileTypeClosed,
+    FileTypeFile,
+    FileTypeDir,
+} FileType;
+
+struct File {
+    FileType type;
+    FILE* file;
+    DIR* dir;
+    FS_Error error;
+    FuriString* path;
+};
+
+static const char* storage_shim_ext_root = NULL;
+
+void storage_shim_set_ext_root(const char* path) {
+    storage_shim_ext_root = path;
+}
+
+/* "/ext/..." goes to the ext root when one is set, every other path is a host path */
+static const char* storage_shim_resolve(FuriString* output, const char* path) {
+    const size_t prefix_size = strlen(STORAGE_EXT_PATH_PREFIX);
+    if(storage_shim_ext_root && strncmp(path, STORAGE_EXT_PATH_PREFIX, prefix_size) == 0 &&
+       (path[prefix_size] == '/' || path[prefix_size] == '\0')) {
+        furi_string_printf(output, "%s%s", storage_shim_ext_root, path + prefix_size);
+    } else {
+        furi_string_set(output, path);
+    }
+    return furi_string_get_cstr(output);
+}
+
+static FS_Error storage_shim_error(int error) {
+    switch(error) {
+    case 0:
+        return FSE_OK;
+    case ENOENT:
+    case ENOTDIR:
+        return FSE_NOT_EXIST;
+    case EEXIST:
+        return FSE_EXIST;
+    case EACCES:
+    case EPERM:
+    case EROFS:
+        return FSE_DENIED;
+    case EINVAL:
+        return FSE_INVALID_PARAMETER;
+    case ENAMETOOLONG:
+        return FSE_INVALID_NAME;
+    default:
+        return FSE_INTERNAL;
+    }
+}
+
+File* storage_file_alloc(Storage* storage) {
+    UNUSED(storage);
+    File* file = malloc(sizeof(File));
+    file->path = furi_string_alloc();
+    return file;
+}
+
+void storage_file_free(File* file) {
+    if(file->type == FileTypeFile) storage_file_close(file);
+    if(file->type == FileTypeDir) storage_dir_close(file);
+    furi_string_free(file->path);
+    free(file);
+}
+
+bool storage_file_open(
+    File* file,
+    const char* path,
+    FS_AccessMode access_mode,
+    FS_OpenMode open_mode) {
+    furi_check(file->type == FileTypeClosed);
+    const char* host_path = storage_shim_resolve(file->path, path);
+
+    bool exists = access(host_path, F_OK) == 0;
+    const char* mode = NULL;
+    if(open_mode & FSOM_OPEN_EXISTING) {
+        mode = (access_mode & FSAM_WRITE) ? "r+b" : "rb";
+    } else if(open_mode & FSOM_CREATE_NEW) {
+        mode = exists ? NULL : ((access_mode & FSAM_READ) ? "w+b" : "wb");
+    } else if(open_mode & FSOM_CREATE_ALWAYS) {
+        mode = (access_mode & FSAM_READ) ? "w+b" : "wb";
+    } else if(open_mode & FSOM_OPEN_APPEND) {
+        mode = (access_mode & FSAM_READ) ? "a+b" : "ab";
+    } else if(open_mode & FSOM_OPEN_ALWAYS) {
+        mode = exists ? ((access_mode & FSAM_WRITE) ? "r+b" : "rb") : "w+b";
+    }
+
+    if(!mode) {
+        file->error = FSE_EXIST;
+        return false;
+    }
+
+    file->file = fopen(host_path, mode);
+    if(!file->file) {
+        file->error = storage_shim_error(errno);
+        return false;
+    }
+
+    file->type = FileTypeFile;
+    file->error = FSE_OK;
+    return true;
+}
+
+bool storage_file_close(File* file) {
+    if(file->type != FileTypeFile) return false;
+    fclose(file->file);
+    file->file = NULL;
+    file->type = FileTypeClosed;
+    return true;
+}
+
+bool storage_file_is_open(File* file) {
+    return file->type != FileTypeClosed;
+}
+
+bool storage_file_is_dir(File* file) {
+    return file->type == FileTypeDir;
+}
+
+size_t storage_file_read(File* file, void* buff, size_t bytes_to_read) {
+    furi_check(file->type == FileTypeFile);
+    size_t result = fread(buff, 1, bytes_to_read, file->file);
+    file->error = ferror(file->file) ? FSE_INTERNAL : FSE_OK;
+    return result;
+}
+
+size_t storage_file_write(File* file, const void* buff, size_t bytes_to_write) {
+    furi_check(file->type == FileTypeFile);
+    size_t result = fwrite(buff, 1, bytes_to_write, file->file);
+    file->error = (result == bytes_to_write) ? FSE_OK : FSE_INTERNAL;
+    return result;
+}
+
+bool storage_file_seek(File* file, uint32_t offset, bool from_start) {
+    furi_check(file->type == FileTypeFile);
+    bool result = fseek(file->file, offset, from_start ? SEEK_SET : SEEK_CUR) == 0;
+    file->error = result ? FSE_OK : FSE_INVALID_PARAMETER;
+    return result;
+}
+
+uint64_t storage_file_tell(File* file) {
+    furi_check(file->type == FileTypeFile);
+    return ftell(file->file);
+}
+
+bool storage_file_truncate(File* file) {
+    furi_check(file->type == FileTypeFile);
+    fflush(file->file);
+    bool result = ftruncate(fileno(file->file), ftell(file->file)) == 0;
+    file->error = result ? FSE_OK : storage_shim_error(errno);
+    return result;
+}
+
+uint64_t storage_file_size(File* file) {
+    furi_check(file->type == FileTypeFile);
+    struct stat st;
+    fflush(file->file);
+    return (fstat(fileno(file->file), &st) == 0) ? (uint64_t)st.st_size : 0;
+}
+
+bool storage_file_sync(File* file) {
+    furi_check(file->type == FileTypeFile);
+    return fflush(file->file) == 0;
+}
+
+bool storage_file_eof(File* file) {
+    furi_check(file->type == FileTypeFile);
+    return storage_file_tell(file) >= storage_file_size(file);
+}
+
+FS_Error storage_file_get_error(File* file) {
+    return file->error;
+}
+
+const char* storage_file_get_error_desc(File* file) {
+    return filesystem_api_error_get_desc(file->error);
+}
+
+bool storage_dir_open(File* file, const char* path) {
+    furi_check(file->type == FileTypeClosed);
+    file->dir = opendir(storage_shim_resolve(file->path, path));
+    if(!file->dir) {
+        file->error = storage_shim_error(errno);
+        return false;
+    }
+    file->type = FileTypeDir;
+    file->error = FSE_OK;
+    return true;
+}
+
+bool storage_dir_close(File* file) {
+    if(file->type != FileTypeDir) return false;
+    closedir(file->dir);
+    file->dir = NULL;
+    file->type = FileTypeClosed;
+    return true;
+}
+
+bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length) {
+    furi_check(file->type == FileTypeDir);
+    struct dirent* entry;
+    do {
+        entry = readdir(file->dir);
+    } while(entry && (!strcmp(entry->d_name, ".") || !strcmp(entry->d_name, "..")));
+
+    if(!entry) {
+        file->error = FSE_NOT_EXIST;
+        return false;
+    }
+
+    if(name) snprintf(name, name_length, "%s", entry->d_name);
+    if(fileinfo) {
+        FuriString* entry_path =
+            furi_string_alloc_printf("%s/%s", furi_string_get_cstr(file->path), entry->d_name);
+        struct stat st = {0};
+        stat(furi_string_get_cstr(entry_path), &st);
+        fileinfo->flags = S_ISDIR(st.st_mode) ? FSF_DIRECTORY : 0;
+        fileinfo->size = st.st_size;
+        furi_string_free(entry_path);
+    }
+    file->error = FSE_OK;
+    return true;
+}
+
+FS_Error storage_common_stat(Storage* storage, const char* path, FileInfo* fileinfo) {
+    UNUSED(storage);
+    FuriString* host_path = furi_string_alloc();
+    struct stat st;
+    FS_Error error = FSE_OK;
+    if(stat(storage_shim_resolve(host_path, path), &st) != 0) {
+        error = storage_shim_error(errno);
+    } else if(fileinfo) {
+        fileinfo->flags = S_ISDIR(st.st_mode) ? FSF_DIRECTORY : 0;
+        fileinfo->size = st.st_size;
+    }
+    furi_string_free(host_path);
+    return error;
+}
+
+FS_Error storage_common_timestamp(Storage* storage, const char* path, uint32_t* timestamp) {
+    UNUSED(storage);
+    FuriString* host_path = furi_string_alloc();
+    struct stat st;
+    FS_Error error = FSE_OK;
+    if(stat(storage_shim_resolve(host_path, path), &st) != 0) {
+        error = storage_shim_error(errno);
+    } else {
+        *timestamp = st.st_mtime;
+    }
+    furi_string_free(host_path);
+    return error;
+}
+
+bool storage_common_exists(Storage* storage, const char* path) {
+    return storage_common_stat(storage, path, NULL) == FSE_OK;
+}
+
+bool storage_file_exists(Storage* storage, const char* path) {
+    FileInfo fileinfo;
+    return storage_common_stat(storage, path, &fileinfo) == FSE_OK &&
+           !file_info_is_dir(&fileinfo);
+}
+
+bool storage_dir_exists(Storage* storage, const char* path) {
+    FileInfo fileinfo;
+    return storage_common_stat(storage, path, &fileinfo) == FSE_OK &&
+           file_info_is_dir(&fileinfo);
+}
+
+FS_Error storage_common_remove(Storage* storage, const char* path) {
+    UNUSED(storage);
+    FuriString* host_path = furi_string_alloc();
+    FS_Error error =
+        (remove(storage_shim_resolve(host_path, path)) == 0) ? FSE_OK : storage_shim_error(errno);
+    furi_string_free(host_path);
+    return error;
+}
+
+FS_Error storage_common_mkdir(Storage* storage, const char* path) {
+    UNUSED(storage);
+    FuriString* host_path = furi_string_alloc();
+    FS_Error error = (mkdir(storage_shim_resolve(host_path, path), 0777) == 0) ?
+                         FSE_OK :
+                         storage_shim_error(errno);
+    furi_string_free(host_path);
+    return error;
+}
+
+bool storage_simply_remove(Storage* storage, const char* path) {
+    FS_Error error = storage_common_remove(storage, path);
+    return error == FSE_OK || error == FSE_NOT_EXIST;
+}
+
+bool storage_simply_mkdir(Storage* storage, const char* path) {
+    FS_Error error = storage_common_mkdir(storage, path);
+    return error == FSE_OK || error == FSE_EXIST;
+}
+
+void storage_get_next_filename(
+    Storage* storage,
+    const char* dirname,
+    const char* filename,
+    const char* fileextension,
+    FuriString* nextfilename,
+    uint8_t max_len) {
+    FuriString* temp_str;
+    uint16_t num = 0;
+
+    temp_str = furi_string_alloc_printf("%s/%s%s", dirname, filename, fileextension);
+
+    while(storage_common_stat(storage, furi_string_get_cstr(temp_str), NULL) == FSE_OK) {
+        num++;
+        furi_string_printf(temp_str, "%s/%s%d%s", dirname, filename, num, fileextension);
+    }
+    if(num && (max_len > strlen(filename))) {
+        furi_string_printf(nextfilename, "%s%d", filename, num);
+    } else {
+        furi_string_printf(nextfilename, "%s", filename);
+    }
+
+    furi_string_free(temp_str);
+}
+
+const char* storage_error_get_desc(FS_Error error_id) {
+    return filesystem_api_error_get_desc(error_id);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Map "/ext/..." paths to a host directory, e.g. the SD card assets in the tree
+ * @param path host directory, NULL keeps every path as is
+ */
+void storage_shim_set_ext_root(const char* path);
+
+#ifdef __cplusplus
+}
+#endif
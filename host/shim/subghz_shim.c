@@ -0,0 +1,49 @@
+#include <furi.h>
+#include <lib/toolbox/level_duration.h>
+#include <lib/subghz/subghz_file_encoder_worker.h>
+
+/* RAW playback needs a worker thread, the host only decodes, so starting it always fails */
+
+struct SubGhzFileEncoderWorker {
+    bool running;
+};
+
+SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
+    return malloc(sizeof(SubGhzFileEncoderWorker));
+}
+
+void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
+    free(instance);
+}
+
+void subghz_file_encoder_worker_callback_end(
+    SubGhzFileEncoderWorker* instance,
+    SubGhzFileEncoderWorkerCallbackEnd callback_end,
+    void* context_end) {
+    UNUSED(instance);
+    UNUSED(callback_end);
+    UNUSED(context_end);
+}
+
+bool subghz_file_encoder_worker_start(
+    SubGhzFileEncoderWorker* instance,
+    const char* file_path,
+    const char* radio_device_name) {
+    UNUSED(instance);
+    UNUSED(file_path);
+    UNUSED(radio_device_name);
+    return false;
+}
+
+void subghz_file_encoder_worker_stop(SubGhzFileEncoderWorker* instance) {
+    UNUSED(instance);
+}
+
+bool subghz_file_encoder_worker_is_running(SubGhzFileEncoderWorker* instance) {
+    return instance->running;
+}
+
+LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
+    UNUSED(context);
+    return level_duration_reset();
+}
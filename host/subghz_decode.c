@@ -0,0 +1,503 @@
+/**
+ * Batch Sub-GHz decoder for RAW captures
+ *
+ * Feeds .sub RAW recordings (text or binary container) through SubGhzReceiver
+ * with every decodable protocol, like the Sub-GHz app does while receiving.
+ * Prints decoded packets per file, throughput and ns per pulse per protocol,
+ * writes a report and compares it with the report of a previous run.
+ */
+#include <furi.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/strint.h>
+
+#include <lib/subghz/receiver.h>
+#include <lib/subghz/subghz_raw_binary.h>
+#include <lib/subghz/protocols/protocol_items.h>
+
+#include <getopt.h>
+
+#include "host_batch.h"
+#include "shim/storage_shim.h"
+
+#define SUBGHZ_DECODE_KEYSTORE_MAX 8
+#define SUBGHZ_DECODE_PULSE_LIMIT  1000000
+
+typedef struct {
+    const char* keystores[SUBGHZ_DECODE_KEYSTORE_MAX];
+    size_t keystore_count;
+    bool ext_root;
+    bool quiet;
+    FILE* report;
+
+    // Merged results
+    char** report_lines;
+    size_t report_count;
+    size_t file_index;
+    uint32_t file_packet_count;
+    uint32_t file_count;
+    uint32_t file_error_count;
+    uint64_t packet_count;
+    uint64_t pulse_count;
+    uint64_t receiver_ns;
+
+    size_t protocol_count;
+    uint32_t* protocol_packets;
+    uint64_t* protocol_ns;
+    uint64_t* protocol_pulses;
+} SubGhzDecode;
+
+typedef struct {
+    SubGhzEnvironment* environment;
+    FlipperFormat* flipper_format;
+    FuriString* text;
+    FILE* output;
+
+    int32_t* pulses;
+    size_t pulse_count;
+    size_t pulse_capacity;
+
+    // Every decodable protocol on its own, to time it over all pulses
+    SubGhzProtocolDecoderBase** decoders;
+    uint64_t* decoder_ns;
+    uint64_t decoder_pulses;
+} SubGhzDecodeWorker;
+
+static void subghz_decode_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    SubGhzDecodeWorker* worker = context;
+
+    // One line per packet, same text as the CLI decode_dir report
+    furi_string_reset(worker->text);
+    subghz_protocol_decoder_base_get_string(decoder_base, worker->text);
+    furi_string_replace_all(worker->text, "\r\n", " ");
+    furi_string_replace_all(worker->text, "\n", " ");
+    furi_string_replace_all(worker->text, "\t", " ");
+    furi_string_trim(worker->text);
+    fprintf(
+        worker->output,
+        "P\t%s\t%s\n",
+        decoder_base->protocol->name,
+        furi_string_get_cstr(worker->text));
+
+    subghz_receiver_reset(receiver);
+}
+
+static void* subghz_decode_worker_alloc(void* context) {
+    SubGhzDecode* instance = context;
+    SubGhzDecodeWorker* worker = malloc(sizeof(SubGhzDecodeWorker));
+
+    worker->environment = subghz_environment_alloc();
+    for(size_t i = 0; i < instance->keystore_count; i++) {
+        subghz_environment_load_keystore(worker->environment, instance->keystores[i]);
+    }
+    // Empty name tells the decoders there is no table, same as a missing file but quiet
+    subghz_environment_set_alutech_at_4n_rainbow_table_file_name(
+        worker->environment, instance->ext_root ? SUBGHZ_ALUTECH_AT_4N_DIR_NAME : "");
+    subghz_environment_set_nice_flor_s_rainbow_table_file_name(
+        worker->environment, instance->ext_root ? SUBGHZ_NICE_FLOR_S_DIR_NAME : "");
+    subghz_environment_set_protocol_registry(
+        worker->environment, (void*)&subghz_protocol_registry);
+
+    worker->decoders = malloc(instance->protocol_count * sizeof(SubGhzProtocolDecoderBase*));
+    worker->decoder_ns = malloc(instance->protocol_count * sizeof(uint64_t));
+    for(size_t i = 0; i < instance->protocol_count; i++) {
+        const SubGhzProtocol* protocol =
+            subghz_protocol_registry_get_by_index(&subghz_protocol_registry, i);
+        if(protocol->decoder && protocol->decoder->alloc &&
+           (protocol->flag & SubGhzProtocolFlag_Decodable)) {
+            worker->decoders[i] = protocol->decoder->alloc(worker->environment);
+        }
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    worker->flipper_format = flipper_format_file_alloc(storage);
+    worker->text = furi_string_alloc();
+    return worker;
+}
+
+static void subghz_decode_worker_free(void* context) {
+    SubGhzDecodeWorker* worker = context;
+
+    for(size_t i = 0; i < subghz_protocol_registry_count(&subghz_protocol_registry); i++) {
+        if(worker->decoders[i]) {
+            worker->decoders[i]->protocol->decoder->free(worker->decoders[i]);
+        }
+    }
+    free(worker->decoder_ns);
+    free(worker->decoders);
+
+    furi_string_free(worker->text);
+    flipper_format_free(worker->flipper_format);
+    furi_record_close(RECORD_STORAGE);
+    subghz_environment_free(worker->environment);
+    free(worker->pulses);
+    free(worker);
+}
+
+static void
+    subghz_decode_add_pulses(SubGhzDecodeWorker* worker, const int32_t* data, size_t count) {
+    if(worker->pulse_count + count > worker->pulse_capacity) {
+        worker->pulse_capacity = MAX(worker->pulse_capacity * 2, worker->pulse_count + count);
+        worker->pulses = realloc(worker->pulses, worker->pulse_capacity * sizeof(int32_t));
+    }
+    memcpy(&worker->pulses[worker->pulse_count], data, count * sizeof(int32_t));
+    worker->pulse_count += count;
+}
+
+/* Whole recording is loaded first, so decoding is timed without file parsing */
+static bool subghz_decode_load(SubGhzDecodeWorker* worker, const char* path) {
+    FlipperFormat* flipper_format = worker->flipper_format;
+    FuriString* temp_str = furi_string_alloc();
+    int32_t* block = malloc(SUBGHZ_RAW_BINARY_BLOCK_SIZE * sizeof(int32_t));
+    uint32_t version;
+    bool result = false;
+
+    worker->pulse_count = 0;
+
+    do {
+        if(!flipper_format_file_open_existing(flipper_format, path)) break;
+        if(!flipper_format_read_header(flipper_format, temp_str, &version)) break;
+        if(furi_string_cmp_str(temp_str, SUBGHZ_RAW_FILE_TYPE) != 0 ||
+           version != SUBGHZ_RAW_FILE_VERSION) {
+            break;
+        }
+
+        Stream* stream = flipper_format_get_raw_stream(flipper_format);
+        SubGhzRawBinaryReader* binary_reader = NULL;
+        while(stream_read_line(stream, temp_str)) {
+            // Binary recordings have a marker line in place of the first RAW_Data line
+            if(subghz_raw_binary_is_marker(furi_string_get_cstr(temp_str))) {
+                binary_reader = subghz_raw_binary_reader_alloc(stream);
+                break;
+            }
+            if(!furi_string_start_with_str(temp_str, "RAW_Data:")) continue;
+
+            char* str = strchr(furi_string_get_cstr(temp_str), ' ');
+            size_t count = 0;
+            int32_t duration;
+            while(str && strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
+                block[count++] = duration;
+                if(count == SUBGHZ_RAW_BINARY_BLOCK_SIZE) {
+                    subghz_decode_add_pulses(worker, block, count);
+                    count = 0;
+                }
+                if(*str == ',') str++;
+            }
+            subghz_decode_add_pulses(worker, block, count);
+        }
+
+        if(binary_reader) {
+            size_t count;
+            while((count = subghz_raw_binary_reader_read_block(binary_reader, block))) {
+                subghz_decode_add_pulses(worker, block, count);
+            }
+            subghz_raw_binary_reader_free(binary_reader);
+        }
+
+        result = true;
+    } while(false);
+
+    flipper_format_file_close(flipper_format);
+    free(block);
+    furi_string_free(temp_str);
+    return result;
+}
+
+static inline bool subghz_decode_get_pulse(int32_t raw, uint32_t* duration) {
+    // Same clamp as the file encoder worker applies to corrupted durations
+    if((raw < -SUBGHZ_DECODE_PULSE_LIMIT) || (raw > SUBGHZ_DECODE_PULSE_LIMIT)) {
+        raw = (raw > 0) ? 100 : -100;
+    }
+    *duration = (raw > 0) ? raw : -raw;
+    return raw > 0;
+}
+
+static void subghz_decode_worker_process(void* context, const char* path, FILE* output) {
+    SubGhzDecodeWorker* worker = context;
+    worker->output = output;
+
+    if(!subghz_decode_load(worker, path)) {
+        fprintf(output, "S\terror\t0\t0\n");
+        return;
+    }
+
+    // Not every decoder clears all of its state on reset, a new receiver per file keeps
+    // results independent of which worker decoded which files before
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(worker->environment);
+    subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
+    subghz_receiver_set_rx_callback(receiver, subghz_decode_rx_callback, worker);
+
+    uint32_t duration;
+    uint64_t start = furi_shim_get_ns();
+    for(size_t i = 0; i < worker->pulse_count; i++) {
+        bool level = subghz_decode_get_pulse(worker->pulses[i], &duration);
+        subghz_receiver_decode(receiver, level, duration);
+    }
+    uint64_t receiver_ns = furi_shim_get_ns() - start;
+    subghz_receiver_free(receiver);
+
+    for(size_t j = 0; j < subghz_protocol_registry_count(&subghz_protocol_registry); j++) {
+        SubGhzProtocolDecoderBase* decoder = worker->decoders[j];
+        if(!decoder) continue;
+
+        decoder->protocol->decoder->reset(decoder);
+        start = furi_shim_get_ns();
+        for(size_t i = 0; i < worker->pulse_count; i++) {
+            bool level = subghz_decode_get_pulse(worker->pulses[i], &duration);
+            decoder->protocol->decoder->feed(decoder, level, duration);
+        }
+        worker->decoder_ns[j] += furi_shim_get_ns() - start;
+    }
+    worker->decoder_pulses += worker->pulse_count;
+
+    fprintf(
+        output,
+        "S\tok\t%zu\t%llu\n",
+        worker->pulse_count,
+        (unsigned long long)receiver_ns);
+}
+
+static void subghz_decode_worker_finish(void* context, FILE* output) {
+    SubGhzDecodeWorker* worker = context;
+
+    for(size_t i = 0; i < subghz_protocol_registry_count(&subghz_protocol_registry); i++) {
+        if(!worker->decoders[i]) continue;
+        fprintf(
+            output,
+            "T\t%zu\t%llu\t%llu\n",
+            i,
+            (unsigned long long)worker->decoder_ns[i],
+            (unsigned long long)worker->decoder_pulses);
+    }
+}
+
+static void
+    subghz_decode_merge_file(void* context, size_t index, const char* path, char* line) {
+    SubGhzDecode* instance = context;
+
+    if(index != instance->file_index) {
+        instance->file_index = index;
+        instance->file_packet_count = 0;
+        if(!instance->quiet) printf("%s\n", path);
+    }
+
+    char* save = NULL;
+    const char* type = strtok_r(line, "\t", &save);
+    if(!strcmp(type, "P")) {
+        const char* name = strtok_r(NULL, "\t", &save);
+        const char* text = strtok_r(NULL, "", &save);
+        if(!text) text = "";
+
+        instance->file_packet_count++;
+        instance->packet_count++;
+        for(size_t i = 0; i < instance->protocol_count; i++) {
+            if(!strcmp(
+                   subghz_protocol_registry_get_by_index(&subghz_protocol_registry, i)->name,
+                   name)) {
+                instance->protocol_packets[i]++;
+                break;
+            }
+        }
+
+        if(!instance->quiet) printf("  %s\n", text);
+        if(instance->report) fprintf(instance->report, "%s\t%s\n", path, text);
+
+        size_t size = strlen(path) + strlen(text) + 2;
+        char* report_line = malloc(size);
+        snprintf(report_line, size, "%s\t%s", path, text);
+        instance->report_lines =
+            realloc(instance->report_lines, (instance->report_count + 1) * sizeof(char*));
+        instance->report_lines[instance->report_count++] = report_line;
+    } else if(!strcmp(type, "S")) {
+        const char* status = strtok_r(NULL, "\t", &save);
+        const char* pulses = strtok_r(NULL, "\t", &save);
+        const char* receiver_ns = strtok_r(NULL, "\t", &save);
+
+        if(!strcmp(status, "ok")) {
+            instance->file_count++;
+            instance->pulse_count += strtoull(pulses, NULL, 10);
+            instance->receiver_ns += strtoull(receiver_ns, NULL, 10);
+            if(!instance->quiet && !instance->file_packet_count) printf("  Nothing decoded\n");
+        } else {
+            instance->file_error_count++;
+            if(!instance->quiet) printf("  Not a RAW file\n");
+        }
+    }
+}
+
+static void subghz_decode_merge_total(void* context, char* line) {
+    SubGhzDecode* instance = context;
+
+    size_t index;
+    unsigned long long ns, pulses;
+    if(sscanf(line, "T\t%zu\t%llu\t%llu", &index, &ns, &pulses) == 3 &&
+       index < instance->protocol_count) {
+        instance->protocol_ns[index] += ns;
+        instance->protocol_pulses[index] += pulses;
+    }
+}
+
+static const HostBatchWorker subghz_decode_worker = {
+    .alloc = subghz_decode_worker_alloc,
+    .process = subghz_decode_worker_process,
+    .finish = subghz_decode_worker_finish,
+    .free = subghz_decode_worker_free,
+    .merge_file = subghz_decode_merge_file,
+    .merge_total = subghz_decode_merge_total,
+};
+
+static void subghz_decode_print_usage(const char* name) {
+    printf("Usage: %s [options] <file or dir>...\n", name);
+    printf("Decode Sub-GHz RAW captures (.sub) with every decodable protocol\n\n");
+    printf("  -j <jobs>    worker processes, default: CPU cores\n");
+    printf("  -k <file>    load KeeLoq keystore, plain text only, may be repeated\n");
+    printf("  -e <dir>     directory used for /ext paths, e.g. a copy of the SD card\n");
+    printf("               default keystores and rainbow tables are loaded from it\n");
+    printf("  -r <file>    write report, one '<file>\\t<packet>' line per packet\n");
+    printf("  -c <file>    compare with a report of a previous run, exit 1 on difference\n");
+    printf("  -q           print summary only\n");
+    printf("  -v           print library log, repeat for more\n");
+}
+
+int main(int argc, char** argv) {
+    SubGhzDecode* instance = malloc(sizeof(SubGhzDecode));
+    size_t jobs = host_batch_get_cpu_count();
+    const char* report_path = NULL;
+    const char* compare_path = NULL;
+    FuriLogLevel log_level = FuriLogLevelNone;
+    int opt;
+
+    while((opt = getopt(argc, argv, "j:k:e:r:c:qvh")) != -1) {
+        switch(opt) {
+        case 'j':
+            jobs = strtoul(optarg, NULL, 10);
+            break;
+        case 'k':
+            if(instance->keystore_count < SUBGHZ_DECODE_KEYSTORE_MAX) {
+                instance->keystores[instance->keystore_count++] = optarg;
+            }
+            break;
+        case 'e':
+            storage_shim_set_ext_root(optarg);
+            instance->ext_root = true;
+            break;
+        case 'r':
+            report_path = optarg;
+            break;
+        case 'c':
+            compare_path = optarg;
+            break;
+        case 'q':
+            instance->quiet = true;
+            break;
+        case 'v':
+            if(log_level < FuriLogLevelTrace) log_level++;
+            break;
+        default:
+            subghz_decode_print_usage(argv[0]);
+            return (opt == 'h') ? 0 : 2;
+        }
+    }
+
+    // Decoders log every odd packet, only wanted when looking into one
+    furi_log_set_level(log_level);
+
+    if(optind >= argc) {
+        subghz_decode_print_usage(argv[0]);
+        return 2;
+    }
+
+    if(instance->ext_root && instance->keystore_count + 2 <= SUBGHZ_DECODE_KEYSTORE_MAX) {
+        instance->keystores[instance->keystore_count++] = SUBGHZ_KEYSTORE_DIR_NAME;
+        instance->keystores[instance->keystore_count++] = SUBGHZ_KEYSTORE_DIR_USER_NAME;
+    }
+
+    // Keystores are loaded once here to report problems, workers load their own copy
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    for(size_t i = 0; i < instance->keystore_count; i++) {
+        if(!subghz_environment_load_keystore(environment, instance->keystores[i])) {
+            fprintf(
+                stderr,
+                "Keystore %s not loaded, encrypted keystores need the device\n",
+                instance->keystores[i]);
+        }
+    }
+    subghz_environment_free(environment);
+
+    if(report_path) {
+        instance->report = fopen(report_path, "w");
+        if(!instance->report) {
+            fprintf(stderr, "Unable to create report %s\n", report_path);
+            return 2;
+        }
+    }
+
+    HostBatch batch = {0};
+    if(!host_batch_collect(&batch, &argv[optind], argc - optind, SUBGHZ_APP_FILENAME_EXTENSION)) {
+        return 2;
+    }
+
+    instance->protocol_count = subghz_protocol_registry_count(&subghz_protocol_registry);
+    instance->protocol_packets = malloc(instance->protocol_count * sizeof(uint32_t));
+    instance->protocol_ns = malloc(instance->protocol_count * sizeof(uint64_t));
+    instance->protocol_pulses = malloc(instance->protocol_count * sizeof(uint64_t));
+    instance->file_index = SIZE_MAX;
+
+    uint64_t start = furi_shim_get_ns();
+    bool batch_ok = host_batch_run(&batch, jobs, &subghz_decode_worker, instance);
+    uint64_t time_ns = furi_shim_get_ns() - start;
+
+    printf(
+        "\nFiles %lu, skipped %lu, packets %llu, pulses %llu\n",
+        (unsigned long)instance->file_count,
+        (unsigned long)instance->file_error_count,
+        (unsigned long long)instance->packet_count,
+        (unsigned long long)instance->pulse_count);
+    printf(
+        "Done in %llu ms with %zu jobs, %llu pulses/s, receiver %llu ns/pulse\n",
+        (unsigned long long)(time_ns / 1000000),
+        MIN(MAX(jobs, 1U), MAX(batch.count, 1U)),
+        (unsigned long long)(time_ns ? instance->pulse_count * 1000000000ULL / time_ns : 0),
+        (unsigned long long)(instance->pulse_count ?
+                                 instance->receiver_ns / instance->pulse_count :
+                                 0));
+
+    printf("\n%-24s %8s %10s\n", "Protocol", "Packets", "ns/pulse");
+    for(size_t i = 0; i < instance->protocol_count; i++) {
+        if(!instance->protocol_pulses[i]) continue;
+        printf(
+            "%-24s %8lu %10.1f\n",
+            subghz_protocol_registry_get_by_index(&subghz_protocol_registry, i)->name,
+            (unsigned long)instance->protocol_packets[i],
+            (double)instance->protocol_ns[i] / instance->protocol_pulses[i]);
+    }
+
+    int result = batch_ok ? 0 : 2;
+    if(compare_path) {
+        printf("\nCompare with %s\n", compare_path);
+        int differences = host_batch_compare(
+            compare_path, instance->report_lines, instance->report_count, stdout);
+        if(differences < 0) {
+            fprintf(stderr, "Unable to read report %s\n", compare_path);
+            result = 2;
+        } else {
+            printf("%d differences\n", differences);
+            if(differences && !result) result = 1;
+        }
+    }
+
+    if(instance->report) fclose(instance->report);
+    for(size_t i = 0; i < instance->report_count; i++) {
+        free(instance->report_lines[i]);
+    }
+    free(instance->report_lines);
+    free(instance->protocol_pulses);
+    free(instance->protocol_ns);
+    free(instance->protocol_packets);
+    host_batch_free(&batch);
+    free(instance);
+    return result;
+}
@@ -217,6 +217,19 @@ InfraredMessage* infrared_common_decoder_check_ready(InfraredCommonDecoder* deco
     return message;
 }
 
+/* Decoder waits for the start of a message: no preamble matched and no bits decoded yet */
+bool infrared_common_decoder_is_idle(InfraredCommonDecoder* decoder) {
+    furi_assert(decoder);
+
+    if(decoder->state == InfraredCommonDecoderStateWaitPreamble) {
+        return true;
+    }
+
+    /* protocols without preamble enter decoding at any timing */
+    return (decoder->protocol->timings.preamble_mark == 0) &&
+           (decoder->state == InfraredCommonDecoderStateDecode) && (decoder->databit_cnt == 0);
+}
+
 InfraredMessage*
     infrared_common_decode(InfraredCommonDecoder* decoder, bool level, uint32_t duration) {
     furi_assert(decoder);
@@ -20,6 +20,7 @@ typedef struct {
     InfraredDecoderReset reset;
     InfraredFree free;
     InfraredDecoderCheckReady check_ready;
+    InfraredDecoderIsIdle is_idle;
 } InfraredDecoders;
 
 typedef struct {
@@ -29,8 +30,27 @@ typedef struct {
     InfraredFree free;
 } InfraredEncoders;
 
+#define INFRARED_DECODER_HISTORY_SIZE (8U)
+
+typedef struct {
+    uint32_t duration;
+    bool level;
+} InfraredDecoderTiming;
+
+typedef enum {
+    InfraredDecoderScopeStart, /* all decoders, waiting for leading mark */
+    InfraredDecoderScopeMark, /* all decoders, waiting for leading space */
+    InfraredDecoderScopeNarrow, /* decoders that accepted leading mark and space */
+    InfraredDecoderScopeAll, /* all decoders, none accepted leading mark and space */
+} InfraredDecoderScope;
+
 struct InfraredDecoderHandler {
     void** ctx;
+    uint32_t active; /* decoders fed with timings, one bit per decoder */
+    InfraredDecoderScope scope;
+    /* last timings, to catch up decoders that are fed again */
+    InfraredDecoderTiming history[INFRARED_DECODER_HISTORY_SIZE];
+    size_t history_count;
 };
 
 struct InfraredEncoderHandler {
@@ -51,6 +71,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_nec_decode,
              .reset = infrared_decoder_nec_reset,
              .check_ready = infrared_decoder_nec_check_ready,
+             .is_idle = infrared_decoder_nec_is_idle,
              .free = infrared_decoder_nec_free},
         .encoder =
             {.alloc = infrared_encoder_nec_alloc,
@@ -65,6 +86,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_samsung32_decode,
              .reset = infrared_decoder_samsung32_reset,
              .check_ready = infrared_decoder_samsung32_check_ready,
+             .is_idle = infrared_decoder_samsung32_is_idle,
              .free = infrared_decoder_samsung32_free},
         .encoder =
             {.alloc = infrared_encoder_samsung32_alloc,
@@ -79,6 +101,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc5_decode,
              .reset = infrared_decoder_rc5_reset,
              .check_ready = infrared_decoder_rc5_check_ready,
+             .is_idle = infrared_decoder_rc5_is_idle,
              .free = infrared_decoder_rc5_free},
         .encoder =
             {.alloc = infrared_encoder_rc5_alloc,
@@ -93,6 +116,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rc6_decode,
              .reset = infrared_decoder_rc6_reset,
              .check_ready = infrared_decoder_rc6_check_ready,
+             .is_idle = infrared_decoder_rc6_is_idle,
              .free = infrared_decoder_rc6_free},
         .encoder =
             {.alloc = infrared_encoder_rc6_alloc,
@@ -107,6 +131,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_sirc_decode,
              .reset = infrared_decoder_sirc_reset,
              .check_ready = infrared_decoder_sirc_check_ready,
+             .is_idle = infrared_decoder_sirc_is_idle,
              .free = infrared_decoder_sirc_free},
         .encoder =
             {.alloc = infrared_encoder_sirc_alloc,
@@ -121,6 +146,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_pioneer_decode,
              .reset = infrared_decoder_pioneer_reset,
              .check_ready = infrared_decoder_pioneer_check_ready,
+             .is_idle = infrared_decoder_pioneer_is_idle,
              .free = infrared_decoder_pioneer_free},
         .encoder =
             {.alloc = infrared_encoder_pioneer_alloc,
@@ -135,6 +161,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_kaseikyo_decode,
              .reset = infrared_decoder_kaseikyo_reset,
              .check_ready = infrared_decoder_kaseikyo_check_ready,
+             .is_idle = infrared_decoder_kaseikyo_is_idle,
              .free = infrared_decoder_kaseikyo_free},
         .encoder =
             {.alloc = infrared_encoder_kaseikyo_alloc,
@@ -149,6 +176,7 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
              .decode = infrared_decoder_rca_decode,
              .reset = infrared_decoder_rca_reset,
              .check_ready = infrared_decoder_rca_check_ready,
+             .is_idle = infrared_decoder_rca_is_idle,
              .free = infrared_decoder_rca_free},
         .encoder =
             {.alloc = infrared_encoder_rca_alloc,
@@ -159,28 +187,137 @@ static const InfraredEncoderDecoder infrared_encoder_decoder[] = {
     },
 };
 
+#define INFRARED_DECODERS_ALL ((1UL << COUNT_OF(infrared_encoder_decoder)) - 1)
+
 static int infrared_find_index_by_protocol(InfraredProtocol protocol);
 static const InfraredProtocolVariant* infrared_get_variant_by_protocol(InfraredProtocol protocol);
 
+static bool infrared_decoder_is_idle(InfraredDecoderHandler* handler, size_t index) {
+    const InfraredDecoders* decoder = &infrared_encoder_decoder[index].decoder;
+    return !decoder->is_idle || decoder->is_idle(handler->ctx[index]);
+}
+
+static void infrared_decoder_history_add(
+    InfraredDecoderHandler* handler,
+    bool level,
+    uint32_t duration) {
+    InfraredDecoderTiming* timing =
+        &handler->history[handler->history_count % INFRARED_DECODER_HISTORY_SIZE];
+    timing->level = level;
+    timing->duration = duration;
+    ++handler->history_count;
+}
+
+/* Feed all decoders again, skipped ones are reset and catch up from history */
+static void infrared_decoder_widen(InfraredDecoderHandler* handler, bool replay) {
+    size_t history_size = MIN(handler->history_count, INFRARED_DECODER_HISTORY_SIZE);
+    size_t history_start = handler->history_count - history_size;
+
+    for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        if(handler->active & (1UL << i)) continue;
+
+        const InfraredDecoders* decoder = &infrared_encoder_decoder[i].decoder;
+        if(decoder->reset) decoder->reset(handler->ctx[i]);
+        if(!replay || !decoder->decode) continue;
+
+        bool mark_received = false;
+        for(size_t j = history_start; j < handler->history_count; ++j) {
+            const InfraredDecoderTiming* timing =
+                &handler->history[j % INFRARED_DECODER_HISTORY_SIZE];
+            mark_received |= timing->level;
+            if(mark_received) decoder->decode(handler->ctx[i], timing->level, timing->duration);
+        }
+    }
+
+    handler->active = INFRARED_DECODERS_ALL;
+    handler->scope = InfraredDecoderScopeStart;
+}
+
+/* Leave only decoders that accepted the leading mark and space */
+static void infrared_decoder_narrow(InfraredDecoderHandler* handler) {
+    uint32_t active = 0;
+
+    for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        if(!infrared_decoder_is_idle(handler, i)) {
+            active |= (1UL << i);
+        }
+    }
+
+    if(active) {
+        handler->active = active;
+        handler->scope = InfraredDecoderScopeNarrow;
+    } else {
+        handler->scope = InfraredDecoderScopeAll;
+    }
+}
+
 const InfraredMessage*
     infrared_decode(InfraredDecoderHandler* handler, bool level, uint32_t duration) {
     furi_check(handler);
 
     InfraredMessage* message = NULL;
     InfraredMessage* result = NULL;
+    bool narrowed = (handler->scope == InfraredDecoderScopeNarrow);
+    bool idle = true;
+
+    infrared_decoder_history_add(handler, level, duration);
 
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        if(!(handler->active & (1UL << i))) continue;
+
         if(infrared_encoder_decoder[i].decoder.decode) {
             message = infrared_encoder_decoder[i].decoder.decode(handler->ctx[i], level, duration);
             if(!result && message) {
                 result = message;
             }
         }
+        if(narrowed && idle) {
+            idle = infrared_decoder_is_idle(handler, i);
+        }
+    }
+
+    if(narrowed && idle) {
+        /* decoders are done with the message, next one can be of another protocol */
+        infrared_decoder_widen(handler, true);
+    } else if(handler->scope == InfraredDecoderScopeStart && level) {
+        handler->scope = InfraredDecoderScopeMark;
+    } else if(handler->scope == InfraredDecoderScopeMark && !level) {
+        infrared_decoder_narrow(handler);
     }
 
     return result;
 }
 
+size_t infrared_decode_timings(
+    InfraredDecoderHandler* handler,
+    const uint32_t* timings,
+    size_t timings_count,
+    InfraredDecodeCallback callback,
+    void* context) {
+    furi_check(handler);
+    furi_check(timings || !timings_count);
+
+    size_t message_count = 0;
+    bool level = true;
+
+    for(size_t i = 0; i < timings_count; ++i) {
+        const InfraredMessage* message = infrared_decode(handler, level, timings[i]);
+        if(message) {
+            ++message_count;
+            if(callback) callback(message, context);
+        }
+        level = !level;
+    }
+
+    const InfraredMessage* message = infrared_check_decoder_ready(handler);
+    if(message) {
+        ++message_count;
+        if(callback) callback(message, context);
+    }
+
+    return message_count;
+}
+
 InfraredDecoderHandler* infrared_alloc_decoder(void) {
     InfraredDecoderHandler* handler = malloc(sizeof(InfraredDecoderHandler));
     handler->ctx = malloc(sizeof(void*) * COUNT_OF(infrared_encoder_decoder));
@@ -215,6 +352,10 @@ void infrared_reset_decoder(InfraredDecoderHandler* handler) {
         if(infrared_encoder_decoder[i].decoder.reset)
             infrared_encoder_decoder[i].decoder.reset(handler->ctx[i]);
     }
+
+    handler->active = INFRARED_DECODERS_ALL;
+    handler->scope = InfraredDecoderScopeStart;
+    handler->history_count = 0;
 }
 
 const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* handler) {
@@ -224,6 +365,8 @@ const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* hand
     InfraredMessage* result = NULL;
 
     for(size_t i = 0; i < COUNT_OF(infrared_encoder_decoder); ++i) {
+        if(!(handler->active & (1UL << i))) continue;
+
         if(infrared_encoder_decoder[i].decoder.check_ready) {
             message = infrared_encoder_decoder[i].decoder.check_ready(handler->ctx[i]);
             if(!result && message) {
@@ -232,6 +375,10 @@ const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* hand
         }
     }
 
+    /* signal is over, next one can be of another protocol */
+    infrared_decoder_widen(handler, false);
+    handler->history_count = 0;
+
     return result;
 }
 
@@ -72,6 +72,10 @@ InfraredDecoderHandler* infrared_alloc_decoder(void);
  *              Note: ownership of returned ptr belongs to handler. So pointer is valid
  *              up to next infrared_free_decoder(), infrared_reset_decoder(),
  *              infrared_decode(), infrared_check_decoder_ready() calls.
+ *
+ * Only decoders which accepted the leading mark and space of a message are fed
+ * further timings. All decoders are fed again when those lose the message, and
+ * after infrared_reset_decoder() or infrared_check_decoder_ready().
  */
 const InfraredMessage*
     infrared_decode(InfraredDecoderHandler* handler, bool level, uint32_t duration);
@@ -92,6 +96,33 @@ const InfraredMessage*
  */
 const InfraredMessage* infrared_check_decoder_ready(InfraredDecoderHandler* handler);
 
+/**
+ * Callback for infrared_decode_timings().
+ *
+ * \param[in]   message     - decoded message, valid only during the call.
+ * \param[in]   context     - context passed to infrared_decode_timings().
+ */
+typedef void (*InfraredDecodeCallback)(const InfraredMessage* message, void* context);
+
+/**
+ * Decode captured signal at once.
+ * Equal to infrared_decode() call for every timing, followed by
+ * infrared_check_decoder_ready() as signal is over. Decoder is not reset.
+ *
+ * \param[in]   handler     - handler to INFRARED decoders. Should be acquired with \c infrared_alloc_decoder().
+ * \param[in]   timings     - timings of the signal, starting from mark (high level).
+ * \param[in]   timings_count - amount of timings.
+ * \param[in]   callback    - called for every decoded message, can be NULL.
+ * \param[in]   context     - context to pass to callback.
+ * \return      amount of decoded messages.
+ */
+size_t infrared_decode_timings(
+    InfraredDecoderHandler* handler,
+    const uint32_t* timings,
+    size_t timings_count,
+    InfraredDecodeCallback callback,
+    void* context);
+
 /**
  * Deinitialize decoder and free allocated memory.
  *
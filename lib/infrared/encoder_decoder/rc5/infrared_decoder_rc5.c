@@ -13,6 +13,11 @@ InfraredMessage* infrared_decoder_rc5_check_ready(void* ctx) {
     return infrared_common_decoder_check_ready(decoder->common_decoder);
 }
 
+bool infrared_decoder_rc5_is_idle(void* ctx) {
+    InfraredRc5Decoder* decoder = ctx;
+    return infrared_common_decoder_is_idle(decoder->common_decoder);
+}
+
 bool infrared_decoder_rc5_interpret(InfraredCommonDecoder* decoder) {
     furi_assert(decoder);
 
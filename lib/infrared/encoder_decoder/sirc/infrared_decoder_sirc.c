@@ -5,6 +5,10 @@ InfraredMessage* infrared_decoder_sirc_check_ready(void* ctx) {
     return infrared_common_decoder_check_ready(ctx);
 }
 
+bool infrared_decoder_sirc_is_idle(void* ctx) {
+    return infrared_common_decoder_is_idle(ctx);
+}
+
 bool infrared_decoder_sirc_interpret(InfraredCommonDecoder* decoder) {
     furi_assert(decoder);
 
@@ -2,9 +2,22 @@
 #include "tools/varint_pair.h"
 #include <toolbox/stream/file_stream.h>
 #include <toolbox/varint.h>
+#include <toolbox/compress.h>
 
-#define LFRFID_RAW_FILE_MAGIC   0x4C464952
-#define LFRFID_RAW_FILE_VERSION 1
+#define LFRFID_RAW_FILE_MAGIC      0x4C464952
+#define LFRFID_RAW_FILE_VERSION_V1 1
+#define LFRFID_RAW_FILE_VERSION    2
+
+#define LFRFID_RAW_FILE_FLAG_COMPRESSED (1UL << 0)
+
+// block of a compressed capture that is stored as is, the encoder could not take it
+#define LFRFID_RAW_FILE_BLOCK_STORED   (1U << 15)
+#define LFRFID_RAW_FILE_BLOCK_SIZE_MAX (LFRFID_RAW_FILE_BLOCK_STORED - 1U)
+
+#define LFRFID_RAW_FILE_SAMPLE_RATE 1000000
+
+// index entries kept in memory while writing, every other one is dropped when full
+#define LFRFID_RAW_FILE_INDEX_SIZE 256
 
 #define TAG "LfRfidRawFile"
 
@@ -14,8 +27,39 @@ typedef struct {
     float frequency;
     float duty_cycle;
     uint32_t max_buffer_size;
+} LFRFIDRawFileHeaderV1;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    float frequency;
+    float duty_cycle;
+    uint32_t max_buffer_size; // max decoded block size
+    uint32_t flags;
+    uint32_t sample_rate;
+    uint32_t pair_count;
+    uint32_t block_count;
+    uint32_t capture_ms;
+    uint32_t index_offset; // 0 if capture was not finished
+    uint32_t index_count;
+    uint32_t pulse_histogram[LFRFID_RAW_FILE_HISTOGRAM_SIZE];
 } LFRFIDRawFileHeader;
 
+_Static_assert(
+    offsetof(LFRFIDRawFileHeader, max_buffer_size) ==
+        offsetof(LFRFIDRawFileHeaderV1, max_buffer_size),
+    "V2 header must start with V1 header");
+
+typedef struct {
+    uint16_t size; // stored size, LFRFID_RAW_FILE_BLOCK_STORED if not compressed
+    uint16_t pair_count;
+} LFRFIDRawFileBlockHeader;
+
+typedef struct {
+    uint32_t offset;
+    uint32_t time_ms;
+} LFRFIDRawFileIndexEntry;
+
 struct LFRFIDRawFile {
     Stream* stream;
     uint32_t max_buffer_size;
@@ -23,21 +67,73 @@ struct LFRFIDRawFile {
     uint8_t* buffer;
     uint32_t buffer_size;
     size_t buffer_counter;
+
+    // v2
+    LFRFIDRawFileHeader header;
+    bool writing;
+    bool compressed;
+    Compress* compress;
+    uint8_t* block;
+    uint64_t capture_us;
+
+    LFRFIDRawFileIndexEntry* index;
+    size_t index_count;
+    uint32_t index_step;
+
+    size_t data_end;
+    size_t pairs_left;
+    uint32_t last_pulse;
+    uint32_t last_duration;
 };
 
+// Signed delta of two unsigned values as small unsigned: 0, -1, 1, -2, 2...
+static inline uint32_t lfrfid_raw_file_zigzag_encode(uint32_t delta) {
+    return (delta << 1) ^ (uint32_t)((int32_t)delta >> 31);
+}
+
+static inline uint32_t lfrfid_raw_file_zigzag_decode(uint32_t value) {
+    return (value >> 1) ^ (0U - (value & 1));
+}
+
 LFRFIDRawFile* lfrfid_raw_file_alloc(Storage* storage) {
     furi_check(storage);
 
     LFRFIDRawFile* file = malloc(sizeof(LFRFIDRawFile));
     file->stream = file_stream_alloc(storage);
     file->buffer = NULL;
+    file->block = NULL;
+    file->compress = NULL;
+    file->index = NULL;
     return file;
 }
 
+static bool lfrfid_raw_file_write_finish(LFRFIDRawFile* file) {
+    LFRFIDRawFileHeader* header = &file->header;
+
+    header->index_offset = stream_tell(file->stream);
+    header->index_count = file->index_count;
+
+    size_t index_size = file->index_count * sizeof(LFRFIDRawFileIndexEntry);
+    if(stream_write(file->stream, (uint8_t*)file->index, index_size) != index_size) {
+        return false;
+    }
+
+    if(!stream_seek(file->stream, 0, StreamOffsetFromStart)) return false;
+    return stream_write(file->stream, (uint8_t*)header, sizeof(LFRFIDRawFileHeader)) ==
+           sizeof(LFRFIDRawFileHeader);
+}
+
 void lfrfid_raw_file_free(LFRFIDRawFile* file) {
     furi_check(file);
 
+    if(file->writing && !lfrfid_raw_file_write_finish(file)) {
+        FURI_LOG_E(TAG, "failed to write index");
+    }
+
     if(file->buffer) free(file->buffer);
+    if(file->block) free(file->block);
+    if(file->index) free(file->index);
+    if(file->compress) compress_free(file->compress);
     stream_free(file->stream);
     free(file);
 }
@@ -56,61 +152,360 @@ bool lfrfid_raw_file_open_read(LFRFIDRawFile* file, const char* file_path) {
     return file_stream_open(file->stream, file_path, FSAM_READ, FSOM_OPEN_EXISTING);
 }
 
+void lfrfid_raw_file_set_compression(LFRFIDRawFile* file, bool compress) {
+    furi_check(file);
+    furi_check(!file->writing);
+
+    file->compressed = compress;
+}
+
 bool lfrfid_raw_file_write_header(
     LFRFIDRawFile* file,
     float frequency,
     float duty_cycle,
     uint32_t max_buffer_size) {
     furi_check(file);
+    furi_check(!file->writing);
+    // stored block size must fit the block header
+    furi_check(max_buffer_size <= (LFRFID_RAW_FILE_BLOCK_SIZE_MAX - sizeof(uint32_t)) / 2);
+
+    LFRFIDRawFileHeader* header = &file->header;
+    memset(header, 0, sizeof(LFRFIDRawFileHeader));
+    header->magic = LFRFID_RAW_FILE_MAGIC;
+    header->version = LFRFID_RAW_FILE_VERSION;
+    header->frequency = frequency;
+    header->duty_cycle = duty_cycle;
+    // delta encoded value may take one byte more than it did in the capture
+    header->max_buffer_size = max_buffer_size * 2;
+    header->flags = file->compressed ? LFRFID_RAW_FILE_FLAG_COMPRESSED : 0;
+    header->sample_rate = LFRFID_RAW_FILE_SAMPLE_RATE;
 
-    LFRFIDRawFileHeader header = {
-        .magic = LFRFID_RAW_FILE_MAGIC,
-        .version = LFRFID_RAW_FILE_VERSION,
-        .frequency = frequency,
-        .duty_cycle = duty_cycle,
-        .max_buffer_size = max_buffer_size};
+    size_t size = stream_write(file->stream, (uint8_t*)header, sizeof(LFRFIDRawFileHeader));
+    if(size != sizeof(LFRFIDRawFileHeader)) return false;
 
-    size_t size = stream_write(file->stream, (uint8_t*)&header, sizeof(LFRFIDRawFileHeader));
-    return size == sizeof(LFRFIDRawFileHeader);
+    file->max_buffer_size = header->max_buffer_size;
+    file->buffer = malloc(file->max_buffer_size);
+    if(file->compressed) {
+        file->block = malloc(file->max_buffer_size + sizeof(uint32_t));
+        file->compress =
+            compress_alloc(CompressTypeHeatshrink, &compress_config_heatshrink_default);
+    }
+    file->index = malloc(LFRFID_RAW_FILE_INDEX_SIZE * sizeof(LFRFIDRawFileIndexEntry));
+    file->index_count = 0;
+    file->index_step = 1;
+    file->capture_us = 0;
+    file->writing = true;
+
+    return true;
+}
+
+static void lfrfid_raw_file_index_add(LFRFIDRawFile* file, uint32_t offset, uint64_t time_us) {
+    if(file->header.block_count % file->index_step) return;
+
+    if(file->index_count == LFRFID_RAW_FILE_INDEX_SIZE) {
+        for(size_t i = 0; i < LFRFID_RAW_FILE_INDEX_SIZE / 2; i++) {
+            file->index[i] = file->index[i * 2];
+        }
+        file->index_count = LFRFID_RAW_FILE_INDEX_SIZE / 2;
+        file->index_step *= 2;
+        if(file->header.block_count % file->index_step) return;
+    }
+
+    file->index[file->index_count].offset = offset;
+    file->index[file->index_count].time_ms = time_us / 1000;
+    file->index_count++;
 }
 
 bool lfrfid_raw_file_write_buffer(LFRFIDRawFile* file, uint8_t* buffer_data, size_t buffer_size) {
     furi_check(file);
+    furi_check(file->writing);
     furi_check(buffer_data);
     furi_check(buffer_size);
+    furi_check(buffer_size * 2 <= file->max_buffer_size);
+
+    LFRFIDRawFileHeader* header = &file->header;
+    size_t block_offset = stream_tell(file->stream);
+    uint64_t block_time_us = file->capture_us;
+
+    // pairs are delta encoded from zero in every block, so any block can be decoded alone
+    LFRFIDRawFileBlockHeader block_header = {0};
+    uint32_t last_pulse = 0;
+    uint32_t last_duration = 0;
+    size_t encoded_size = 0;
+    size_t index = 0;
+
+    while(index < buffer_size) {
+        uint32_t pulse;
+        uint32_t duration;
+        size_t size;
+
+        if(!varint_pair_unpack(
+               &buffer_data[index], buffer_size - index, &pulse, &duration, &size)) {
+            break;
+        }
+        index += size;
+
+        encoded_size += varint_uint32_pack(
+            lfrfid_raw_file_zigzag_encode(pulse - last_pulse), &file->buffer[encoded_size]);
+        encoded_size += varint_uint32_pack(
+            lfrfid_raw_file_zigzag_encode(duration - last_duration),
+            &file->buffer[encoded_size]);
+        last_pulse = pulse;
+        last_duration = duration;
+
+        block_header.pair_count++;
+        file->capture_us += duration;
+        header->pulse_histogram[MIN(
+            pulse / LFRFID_RAW_FILE_HISTOGRAM_BIN_US, LFRFID_RAW_FILE_HISTOGRAM_SIZE - 1U)]++;
+    }
+
+    if(block_header.pair_count == 0) return true;
+    lfrfid_raw_file_index_add(file, block_offset, block_time_us);
 
-    size_t size;
-    size = stream_write(file->stream, (uint8_t*)&buffer_size, sizeof(size_t));
-    if(size != sizeof(size_t)) return false;
+    uint8_t* block_data = file->buffer;
+    uint16_t block_flags = 0;
+    if(file->compressed) {
+        size_t compressed_size = 0;
+        if(compress_encode(
+               file->compress,
+               file->buffer,
+               encoded_size,
+               file->block,
+               file->max_buffer_size + sizeof(uint32_t),
+               &compressed_size)) {
+            block_data = file->block;
+            encoded_size = compressed_size;
+        } else {
+            // keep the capture going, this block is stored as is
+            block_flags = LFRFID_RAW_FILE_BLOCK_STORED;
+        }
+    }
+    furi_check(encoded_size <= LFRFID_RAW_FILE_BLOCK_SIZE_MAX);
+    block_header.size = encoded_size | block_flags;
+
+    size_t size =
+        stream_write(file->stream, (uint8_t*)&block_header, sizeof(LFRFIDRawFileBlockHeader));
+    if(size != sizeof(LFRFIDRawFileBlockHeader)) return false;
+
+    size = stream_write(file->stream, block_data, encoded_size);
+    if(size != encoded_size) return false;
 
-    size = stream_write(file->stream, buffer_data, buffer_size);
-    if(size != buffer_size) return false;
+    header->pair_count += block_header.pair_count;
+    header->block_count++;
+    header->capture_ms = file->capture_us / 1000;
 
     return true;
 }
 
+static bool lfrfid_raw_file_read_header_v2(LFRFIDRawFile* file) {
+    LFRFIDRawFileHeader* header = &file->header;
+
+    size_t rest_size = sizeof(LFRFIDRawFileHeader) - sizeof(LFRFIDRawFileHeaderV1);
+    size_t size =
+        stream_read(file->stream, (uint8_t*)header + sizeof(LFRFIDRawFileHeaderV1), rest_size);
+    if(size != rest_size) return false;
+
+    file->compressed = header->flags & LFRFID_RAW_FILE_FLAG_COMPRESSED;
+    if(file->compressed) {
+        file->block = malloc(file->max_buffer_size + sizeof(uint32_t));
+        file->compress =
+            compress_alloc(CompressTypeHeatshrink, &compress_config_heatshrink_default);
+    }
+
+    // unfinished capture has no index, blocks go up to the end of file
+    size_t file_size = stream_size(file->stream);
+    if(header->index_offset) {
+        if(header->index_offset < sizeof(LFRFIDRawFileHeader) ||
+           header->index_offset > file_size ||
+           header->index_count >
+               (file_size - header->index_offset) / sizeof(LFRFIDRawFileIndexEntry)) {
+            FURI_LOG_E(TAG, "read header: bad index");
+            return false;
+        }
+    } else if(header->index_count) {
+        FURI_LOG_E(TAG, "read header: bad index");
+        return false;
+    }
+
+    file->data_end = header->index_offset ? header->index_offset : file_size;
+    if(header->index_count) {
+        size_t index_size = header->index_count * sizeof(LFRFIDRawFileIndexEntry);
+        if(!stream_seek(file->stream, header->index_offset, StreamOffsetFromStart)) return false;
+
+        file->index = malloc(index_size);
+        file->index_count = header->index_count;
+        if(stream_read(file->stream, (uint8_t*)file->index, index_size) != index_size) {
+            return false;
+        }
+
+        if(!stream_seek(file->stream, sizeof(LFRFIDRawFileHeader), StreamOffsetFromStart)) {
+            return false;
+        }
+    }
+
+    file->pairs_left = 0;
+    return true;
+}
+
 bool lfrfid_raw_file_read_header(LFRFIDRawFile* file, float* frequency, float* duty_cycle) {
     furi_check(file);
     furi_check(frequency);
     furi_check(duty_cycle);
 
-    LFRFIDRawFileHeader header;
-    size_t size = stream_read(file->stream, (uint8_t*)&header, sizeof(LFRFIDRawFileHeader));
-    if(size == sizeof(LFRFIDRawFileHeader)) {
-        if(header.magic == LFRFID_RAW_FILE_MAGIC && header.version == LFRFID_RAW_FILE_VERSION) {
-            *frequency = header.frequency;
-            *duty_cycle = header.duty_cycle;
-            file->max_buffer_size = header.max_buffer_size;
-            file->buffer = malloc(file->max_buffer_size);
-            file->buffer_size = 0;
-            file->buffer_counter = 0;
-            return true;
-        } else {
+    LFRFIDRawFileHeader* header = &file->header;
+    memset(header, 0, sizeof(LFRFIDRawFileHeader));
+
+    size_t size = stream_read(file->stream, (uint8_t*)header, sizeof(LFRFIDRawFileHeaderV1));
+    if(size != sizeof(LFRFIDRawFileHeaderV1)) return false;
+    if(header->magic != LFRFID_RAW_FILE_MAGIC) return false;
+    if(header->version != LFRFID_RAW_FILE_VERSION_V1 &&
+       header->version != LFRFID_RAW_FILE_VERSION) {
+        return false;
+    }
+
+    // writer never makes blocks bigger than the block header can hold
+    if(header->max_buffer_size == 0 ||
+       header->max_buffer_size > LFRFID_RAW_FILE_BLOCK_SIZE_MAX) {
+        FURI_LOG_E(TAG, "read header: bad buffer size");
+        return false;
+    }
+
+    file->max_buffer_size = header->max_buffer_size;
+    file->buffer = malloc(file->max_buffer_size);
+    file->buffer_size = 0;
+    file->buffer_counter = 0;
+
+    if(header->version == LFRFID_RAW_FILE_VERSION) {
+        if(!lfrfid_raw_file_read_header_v2(file)) return false;
+    }
+
+    *frequency = header->frequency;
+    *duty_cycle = header->duty_cycle;
+    return true;
+}
+
+bool lfrfid_raw_file_get_info(LFRFIDRawFile* file, LFRFIDRawFileInfo* info) {
+    furi_check(file);
+    furi_check(info);
+
+    const LFRFIDRawFileHeader* header = &file->header;
+    if(header->magic != LFRFID_RAW_FILE_MAGIC) return false;
+
+    memset(info, 0, sizeof(LFRFIDRawFileInfo));
+    info->version = header->version;
+    if(header->version == LFRFID_RAW_FILE_VERSION) {
+        info->sample_rate = header->sample_rate;
+        info->pair_count = header->pair_count;
+        info->block_count = header->block_count;
+        info->capture_ms = header->capture_ms;
+        info->compressed = header->flags & LFRFID_RAW_FILE_FLAG_COMPRESSED;
+        info->indexed = header->index_offset != 0;
+        memcpy(info->pulse_histogram, header->pulse_histogram, sizeof(info->pulse_histogram));
+    }
+
+    return true;
+}
+
+bool lfrfid_raw_file_seek(LFRFIDRawFile* file, uint32_t time_ms) {
+    furi_check(file);
+
+    if(file->header.version != LFRFID_RAW_FILE_VERSION || file->index_count == 0) {
+        return false;
+    }
+
+    size_t found = 0;
+    for(size_t i = 1; i < file->index_count; i++) {
+        if(file->index[i].time_ms > time_ms) break;
+        found = i;
+    }
+
+    file->pairs_left = 0;
+    return stream_seek(file->stream, file->index[found].offset, StreamOffsetFromStart);
+}
+
+static bool lfrfid_raw_file_read_block(LFRFIDRawFile* file, bool* pass_end) {
+    if(stream_tell(file->stream) >= file->data_end) {
+        // rewind stream and pass header
+        stream_seek(file->stream, sizeof(LFRFIDRawFileHeader), StreamOffsetFromStart);
+        if(pass_end) *pass_end = true;
+    }
+
+    LFRFIDRawFileBlockHeader block_header;
+    size_t length =
+        stream_read(file->stream, (uint8_t*)&block_header, sizeof(LFRFIDRawFileBlockHeader));
+    if(length != sizeof(LFRFIDRawFileBlockHeader)) {
+        FURI_LOG_E(TAG, "read pair: failed to read block header");
+        return false;
+    }
+
+    const bool compressed =
+        file->compressed && !(block_header.size & LFRFID_RAW_FILE_BLOCK_STORED);
+    size_t size = block_header.size & LFRFID_RAW_FILE_BLOCK_SIZE_MAX;
+    size_t max_size = file->max_buffer_size + (compressed ? sizeof(uint32_t) : 0);
+    if(size > max_size || block_header.pair_count == 0) {
+        FURI_LOG_E(TAG, "read pair: bad block");
+        return false;
+    }
+
+    uint8_t* block_data = compressed ? file->block : file->buffer;
+    length = stream_read(file->stream, block_data, size);
+    if(length != size) {
+        FURI_LOG_E(TAG, "read pair: failed to read data");
+        return false;
+    }
+
+    if(compressed) {
+        size_t stored_size = size;
+        if(!compress_decode(
+               file->compress,
+               file->block,
+               stored_size,
+               file->buffer,
+               file->max_buffer_size,
+               &size)) {
+            FURI_LOG_E(TAG, "read pair: failed to decompress");
             return false;
         }
-    } else {
-        return false;
     }
+
+    file->buffer_size = size;
+    file->buffer_counter = 0;
+    file->pairs_left = block_header.pair_count;
+    file->last_pulse = 0;
+    file->last_duration = 0;
+
+    return true;
+}
+
+static bool lfrfid_raw_file_read_pair_v2(
+    LFRFIDRawFile* file,
+    uint32_t* duration,
+    uint32_t* pulse,
+    bool* pass_end) {
+    if(file->pairs_left == 0) {
+        if(!lfrfid_raw_file_read_block(file, pass_end)) return false;
+    }
+
+    uint32_t delta[2];
+    size_t counter = file->buffer_counter;
+
+    for(size_t i = 0; i < COUNT_OF(delta); i++) {
+        if(counter >= file->buffer_size) {
+            FURI_LOG_E(TAG, "read pair: buffer is too small");
+            return false;
+        }
+        counter += varint_uint32_unpack(
+            &delta[i], &file->buffer[counter], (size_t)(file->buffer_size - counter));
+    }
+
+    file->last_pulse += lfrfid_raw_file_zigzag_decode(delta[0]);
+    file->last_duration += lfrfid_raw_file_zigzag_decode(delta[1]);
+    *pulse = file->last_pulse;
+    *duration = file->last_duration;
+
+    file->buffer_counter = counter;
+    file->pairs_left--;
+    return true;
 }
 
 bool lfrfid_raw_file_read_pair(
@@ -122,16 +517,21 @@ bool lfrfid_raw_file_read_pair(
     furi_check(duration);
     furi_check(pulse);
 
+    if(file->header.version == LFRFID_RAW_FILE_VERSION) {
+        return lfrfid_raw_file_read_pair_v2(file, duration, pulse, pass_end);
+    }
+
     size_t length = 0;
     if(file->buffer_counter >= file->buffer_size) {
         if(stream_eof(file->stream)) {
             // rewind stream and pass header
-            stream_seek(file->stream, sizeof(LFRFIDRawFileHeader), StreamOffsetFromStart);
+            stream_seek(file->stream, sizeof(LFRFIDRawFileHeaderV1), StreamOffsetFromStart);
             if(pass_end) *pass_end = true;
         }
 
-        length = stream_read(file->stream, (uint8_t*)&file->buffer_size, sizeof(size_t));
-        if(length != sizeof(size_t)) {
+        length =
+            stream_read(file->stream, (uint8_t*)&file->buffer_size, sizeof(file->buffer_size));
+        if(length != sizeof(file->buffer_size)) {
             FURI_LOG_E(TAG, "read pair: failed to read size");
             return false;
         }
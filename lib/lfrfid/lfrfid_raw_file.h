@@ -6,8 +6,23 @@
 extern "C" {
 #endif
 
+#define LFRFID_RAW_FILE_HISTOGRAM_SIZE   16
+#define LFRFID_RAW_FILE_HISTOGRAM_BIN_US 64
+
 typedef struct LFRFIDRawFile LFRFIDRawFile;
 
+typedef struct {
+    uint32_t version; /**< File format version */
+    uint32_t sample_rate; /**< Pulse and duration units per second */
+    uint32_t pair_count; /**< Captured pairs */
+    uint32_t block_count; /**< Captured blocks */
+    uint32_t capture_ms; /**< Capture length */
+    bool compressed; /**< Blocks are compressed */
+    bool indexed; /**< Capture was finished and has block index */
+    /** Pulse count by pulse length, LFRFID_RAW_FILE_HISTOGRAM_BIN_US wide bins */
+    uint32_t pulse_histogram[LFRFID_RAW_FILE_HISTOGRAM_SIZE];
+} LFRFIDRawFileInfo;
+
 /**
  * @brief Allocate a new LFRFIDRawFile instance
  * 
@@ -19,6 +34,9 @@ LFRFIDRawFile* lfrfid_raw_file_alloc(Storage* storage);
 /**
  * @brief Free a LFRFIDRawFile instance
  * 
+ * Finishes the capture if the file was written: block index and header statistics
+ * are written.
+ * 
  * @param file 
  */
 void lfrfid_raw_file_free(LFRFIDRawFile* file);
@@ -40,13 +58,23 @@ bool lfrfid_raw_file_open_write(LFRFIDRawFile* file, const char* file_path);
  */
 bool lfrfid_raw_file_open_read(LFRFIDRawFile* file, const char* file_path);
 
+/**
+ * @brief Enable compression of the written blocks
+ * 
+ * Must be called before lfrfid_raw_file_write_header.
+ * 
+ * @param file 
+ * @param compress 
+ */
+void lfrfid_raw_file_set_compression(LFRFIDRawFile* file, bool compress);
+
 /**
  * @brief Write RAW file header
  * 
  * @param file 
  * @param frequency 
  * @param duty_cycle 
- * @param max_buffer_size 
+ * @param max_buffer_size max size of the buffer passed to lfrfid_raw_file_write_buffer
  * @return bool 
  */
 bool lfrfid_raw_file_write_header(
@@ -58,6 +86,8 @@ bool lfrfid_raw_file_write_header(
 /**
  * @brief Write data to RAW file
  * 
+ * Buffer holds varint-encoded pairs, as captured. It is stored as one block.
+ * 
  * @param file 
  * @param buffer_data 
  * @param buffer_size 
@@ -75,6 +105,28 @@ bool lfrfid_raw_file_write_buffer(LFRFIDRawFile* file, uint8_t* buffer_data, siz
  */
 bool lfrfid_raw_file_read_header(LFRFIDRawFile* file, float* frequency, float* duty_cycle);
 
+/**
+ * @brief Get RAW file statistics, header must be read or written before
+ * 
+ * Version 1 files have no statistics, only version is filled.
+ * 
+ * @param file 
+ * @param info 
+ * @return bool 
+ */
+bool lfrfid_raw_file_get_info(LFRFIDRawFile* file, LFRFIDRawFileInfo* info);
+
+/**
+ * @brief Seek to the indexed block holding the given capture time
+ * 
+ * Reading continues from the start of that block.
+ * 
+ * @param file 
+ * @param time_ms 
+ * @return bool false if the file has no index
+ */
+bool lfrfid_raw_file_seek(LFRFIDRawFile* file, uint32_t time_ms);
+
 /**
  * @brief Read varint-encoded pair from RAW file
  * 
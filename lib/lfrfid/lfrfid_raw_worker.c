@@ -21,6 +21,9 @@ typedef struct {
 typedef struct {
     uint32_t emulate_buffer_arr[EMULATE_BUFFER_SIZE];
     uint32_t emulate_buffer_ccr[EMULATE_BUFFER_SIZE];
+    // next half, read ahead while DMA plays the buffer
+    uint32_t read_ahead_arr[EMULATE_BUFFER_SIZE / 2];
+    uint32_t read_ahead_ccr[EMULATE_BUFFER_SIZE / 2];
     RfidEmulateCtx ctx;
 } LFRFIDRawWorkerEmulateData;
 
@@ -237,6 +240,17 @@ static void rfid_emulate_dma_isr(bool half, void* context) {
     }
 }
 
+static bool lfrfid_raw_emulate_read_half(LFRFIDRawFile* file, uint32_t* arr, uint32_t* ccr) {
+    for(size_t i = 0; i < (EMULATE_BUFFER_SIZE / 2); i++) {
+        if(!lfrfid_raw_file_read_pair(file, &arr[i], &ccr[i], NULL)) return false;
+        arr[i] /= 8;
+        arr[i] -= 1;
+        ccr[i] /= 8;
+    }
+
+    return true;
+}
+
 static int32_t lfrfid_raw_emulate_worker_thread(void* thread_context) {
     LFRFIDRawWorker* worker = thread_context;
 
@@ -256,14 +270,15 @@ static int32_t lfrfid_raw_emulate_worker_thread(void* thread_context) {
         file_valid = lfrfid_raw_file_read_header(file, &worker->frequency, &worker->duty_cycle);
         if(!file_valid) break;
 
-        for(size_t i = 0; i < EMULATE_BUFFER_SIZE; i++) {
-            file_valid = lfrfid_raw_file_read_pair(
-                file, &data->emulate_buffer_arr[i], &data->emulate_buffer_ccr[i], NULL);
+        for(size_t start = 0; start < EMULATE_BUFFER_SIZE; start += (EMULATE_BUFFER_SIZE / 2)) {
+            file_valid = lfrfid_raw_emulate_read_half(
+                file, &data->emulate_buffer_arr[start], &data->emulate_buffer_ccr[start]);
             if(!file_valid) break;
-            data->emulate_buffer_arr[i] /= 8;
-            data->emulate_buffer_arr[i] -= 1;
-            data->emulate_buffer_ccr[i] /= 8;
         }
+        if(!file_valid) break;
+
+        file_valid =
+            lfrfid_raw_emulate_read_half(file, data->read_ahead_arr, data->read_ahead_ccr);
     } while(false);
 
     furi_hal_rfid_tim_emulate_dma_start(
@@ -291,17 +306,19 @@ static int32_t lfrfid_raw_emulate_worker_thread(void* thread_context) {
                     start = (EMULATE_BUFFER_SIZE / 2);
                 }
 
-                for(size_t i = 0; i < (EMULATE_BUFFER_SIZE / 2); i++) {
-                    file_valid = lfrfid_raw_file_read_pair(
-                        file,
-                        &data->emulate_buffer_arr[start + i],
-                        &data->emulate_buffer_ccr[start + i],
-                        NULL);
-                    if(!file_valid) break;
-                    data->emulate_buffer_arr[i] /= 8;
-                    data->emulate_buffer_arr[i] -= 1;
-                    data->emulate_buffer_ccr[i] /= 8;
-                }
+                // played half gets the data read ahead, so a slow file read
+                // has time till the next half is played too
+                memcpy(
+                    &data->emulate_buffer_arr[start],
+                    data->read_ahead_arr,
+                    sizeof(data->read_ahead_arr));
+                memcpy(
+                    &data->emulate_buffer_ccr[start],
+                    data->read_ahead_ccr,
+                    sizeof(data->read_ahead_ccr));
+
+                file_valid = lfrfid_raw_emulate_read_half(
+                    file, data->read_ahead_arr, data->read_ahead_ccr);
             } else if(size != 0) {
                 data->ctx.overrun_count++;
             }
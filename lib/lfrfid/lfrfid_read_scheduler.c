@@ -0,0 +1,316 @@
+#include "lfrfid_read_scheduler.h"
+
+#define TAG "LfRfidReadScheduler"
+
+// pairs per classification window
+#define LFRFID_READ_SCHEDULER_WINDOW_PAIRS 128
+
+// pair duration histogram
+#define LFRFID_READ_SCHEDULER_BIN_COUNT     64
+#define LFRFID_READ_SCHEDULER_ASK_BIN_SHIFT 4 // 16 us bins, up to 1 ms
+#define LFRFID_READ_SCHEDULER_PSK_BIN_SHIFT 6 // 64 us bins, up to 4 ms
+
+// tag signal: this many peaks (with their neighbour bins) hold most of the pairs
+#define LFRFID_READ_SCHEDULER_PEAK_COUNT       4
+#define LFRFID_READ_SCHEDULER_REGULAR_PERCENTS 75
+
+// card presence, same bounds as the card sense in the read worker
+#define LFRFID_READ_SCHEDULER_DUTY_MIN 0.2f
+#define LFRFID_READ_SCHEDULER_DUTY_MAX 0.8f
+
+// consecutive windows needed for a verdict
+#define LFRFID_READ_SCHEDULER_LOCK_WINDOWS     2
+#define LFRFID_READ_SCHEDULER_MISMATCH_WINDOWS 2
+
+typedef enum {
+    LFRFIDReadSchedulerFamilyASK,
+    LFRFIDReadSchedulerFamilyPSK,
+    LFRFIDReadSchedulerFamilyNum,
+} LFRFIDReadSchedulerFamily;
+
+struct LFRFIDReadScheduler {
+    LFRFIDFeature preferred;
+    LFRFIDFeature feature;
+    LFRFIDReadSchedulerVerdict verdict;
+
+    uint16_t histogram[LFRFID_READ_SCHEDULER_BIN_COUNT];
+    uint8_t bin_shift;
+    size_t window_pairs;
+    uint32_t window_pulse;
+    uint32_t window_duration;
+    size_t regular_windows;
+    size_t irregular_windows;
+
+    uint32_t elapsed_us;
+    bool phase_locked;
+    bool phase_mismatched;
+    bool phase_decoded;
+
+    LFRFIDReadSchedulerStats stats[LFRFIDReadSchedulerFamilyNum];
+};
+
+static LFRFIDReadSchedulerFamily lfrfid_read_scheduler_family(LFRFIDFeature feature) {
+    return (feature & LFRFIDFeaturePSK) ? LFRFIDReadSchedulerFamilyPSK :
+                                          LFRFIDReadSchedulerFamilyASK;
+}
+
+static void lfrfid_read_scheduler_window_reset(LFRFIDReadScheduler* scheduler) {
+    memset(scheduler->histogram, 0, sizeof(scheduler->histogram));
+    scheduler->window_pairs = 0;
+    scheduler->window_pulse = 0;
+    scheduler->window_duration = 0;
+}
+
+LFRFIDReadScheduler* lfrfid_read_scheduler_alloc(void) {
+    LFRFIDReadScheduler* scheduler = malloc(sizeof(LFRFIDReadScheduler));
+    lfrfid_read_scheduler_reset(scheduler);
+    return scheduler;
+}
+
+void lfrfid_read_scheduler_free(LFRFIDReadScheduler* scheduler) {
+    furi_check(scheduler);
+    free(scheduler);
+}
+
+void lfrfid_read_scheduler_reset(LFRFIDReadScheduler* scheduler) {
+    furi_check(scheduler);
+
+    memset(scheduler, 0, sizeof(LFRFIDReadScheduler));
+    scheduler->preferred = LFRFIDFeatureASK;
+    scheduler->feature = LFRFIDFeatureASK;
+    scheduler->verdict = LFRFIDReadSchedulerVerdictUnknown;
+}
+
+LFRFIDFeature lfrfid_read_scheduler_get_feature(LFRFIDReadScheduler* scheduler) {
+    furi_check(scheduler);
+    return scheduler->preferred;
+}
+
+void lfrfid_read_scheduler_phase_start(LFRFIDReadScheduler* scheduler, LFRFIDFeature feature) {
+    furi_check(scheduler);
+
+    scheduler->feature = feature;
+    scheduler->verdict = LFRFIDReadSchedulerVerdictUnknown;
+    if(lfrfid_read_scheduler_family(feature) == LFRFIDReadSchedulerFamilyPSK) {
+        scheduler->bin_shift = LFRFID_READ_SCHEDULER_PSK_BIN_SHIFT;
+    } else {
+        scheduler->bin_shift = LFRFID_READ_SCHEDULER_ASK_BIN_SHIFT;
+    }
+    lfrfid_read_scheduler_window_reset(scheduler);
+    scheduler->regular_windows = 0;
+    scheduler->irregular_windows = 0;
+
+    scheduler->elapsed_us = 0;
+    scheduler->phase_locked = false;
+    scheduler->phase_mismatched = false;
+    scheduler->phase_decoded = false;
+
+    scheduler->stats[lfrfid_read_scheduler_family(feature)].phase_count++;
+}
+
+// Share of the window pairs around the highest histogram peaks, in percents
+static uint32_t lfrfid_read_scheduler_peak_share(LFRFIDReadScheduler* scheduler) {
+    uint16_t* histogram = scheduler->histogram;
+    uint32_t peak_pairs = 0;
+
+    for(size_t peak = 0; peak < LFRFID_READ_SCHEDULER_PEAK_COUNT; peak++) {
+        size_t max_index = 0;
+        for(size_t i = 1; i < LFRFID_READ_SCHEDULER_BIN_COUNT; i++) {
+            if(histogram[i] > histogram[max_index]) max_index = i;
+        }
+        if(histogram[max_index] == 0) break;
+
+        // jitter spreads a peak over the neighbour bins
+        size_t from = (max_index > 0) ? max_index - 1 : 0;
+        size_t to = MIN(max_index + 1, (size_t)LFRFID_READ_SCHEDULER_BIN_COUNT - 1);
+        for(size_t i = from; i <= to; i++) {
+            peak_pairs += histogram[i];
+            histogram[i] = 0;
+        }
+    }
+
+    return peak_pairs * 100 / scheduler->window_pairs;
+}
+
+static void lfrfid_read_scheduler_window_classify(LFRFIDReadScheduler* scheduler) {
+    float duty = (float)scheduler->window_pulse / (float)scheduler->window_duration;
+    bool card = duty > LFRFID_READ_SCHEDULER_DUTY_MIN && duty < LFRFID_READ_SCHEDULER_DUTY_MAX;
+    bool regular = lfrfid_read_scheduler_peak_share(scheduler) >=
+                   LFRFID_READ_SCHEDULER_REGULAR_PERCENTS;
+
+    if(!card) {
+        scheduler->regular_windows = 0;
+        scheduler->irregular_windows = 0;
+        if(!scheduler->phase_decoded) {
+            scheduler->verdict = LFRFIDReadSchedulerVerdictIdle;
+        }
+    } else if(regular) {
+        scheduler->regular_windows++;
+        scheduler->irregular_windows = 0;
+        if(scheduler->regular_windows >= LFRFID_READ_SCHEDULER_LOCK_WINDOWS) {
+            scheduler->verdict = LFRFIDReadSchedulerVerdictLocked;
+            scheduler->phase_locked = true;
+        }
+    } else {
+        scheduler->irregular_windows++;
+        scheduler->regular_windows = 0;
+        // decoded protocol proves the family, whatever the statistics say
+        if(scheduler->irregular_windows >= LFRFID_READ_SCHEDULER_MISMATCH_WINDOWS &&
+           !scheduler->phase_decoded) {
+            scheduler->verdict = LFRFIDReadSchedulerVerdictMismatch;
+            scheduler->phase_mismatched = true;
+        }
+    }
+
+    lfrfid_read_scheduler_window_reset(scheduler);
+}
+
+void lfrfid_read_scheduler_feed(
+    LFRFIDReadScheduler* scheduler,
+    uint32_t pulse,
+    uint32_t duration) {
+    furi_check(scheduler);
+
+    scheduler->elapsed_us += duration;
+
+    size_t bin = MIN(duration >> scheduler->bin_shift, LFRFID_READ_SCHEDULER_BIN_COUNT - 1U);
+    scheduler->histogram[bin]++;
+    scheduler->window_pulse += pulse;
+    scheduler->window_duration += duration;
+    scheduler->window_pairs++;
+
+    if(scheduler->window_pairs >= LFRFID_READ_SCHEDULER_WINDOW_PAIRS) {
+        lfrfid_read_scheduler_window_classify(scheduler);
+    }
+}
+
+void lfrfid_read_scheduler_decoded(LFRFIDReadScheduler* scheduler) {
+    furi_check(scheduler);
+
+    if(!scheduler->phase_decoded) {
+        LFRFIDReadSchedulerStats* stats =
+            &scheduler->stats[lfrfid_read_scheduler_family(scheduler->feature)];
+        stats->decode_count++;
+        stats->first_decode_us = scheduler->elapsed_us;
+        stats->first_decode_us_total += scheduler->elapsed_us;
+        scheduler->phase_decoded = true;
+    }
+
+    scheduler->verdict = LFRFIDReadSchedulerVerdictLocked;
+    scheduler->phase_locked = true;
+}
+
+LFRFIDReadSchedulerVerdict lfrfid_read_scheduler_get_verdict(LFRFIDReadScheduler* scheduler) {
+    furi_check(scheduler);
+    return scheduler->verdict;
+}
+
+void lfrfid_read_scheduler_phase_end(LFRFIDReadScheduler* scheduler) {
+    furi_check(scheduler);
+
+    LFRFIDReadSchedulerFamily family = lfrfid_read_scheduler_family(scheduler->feature);
+    LFRFIDReadSchedulerStats* stats = &scheduler->stats[family];
+
+    if(scheduler->phase_locked) {
+        stats->lock_count++;
+        scheduler->preferred = scheduler->feature;
+    } else if(scheduler->phase_mismatched) {
+        stats->mismatch_count++;
+        scheduler->preferred = (family == LFRFIDReadSchedulerFamilyASK) ? LFRFIDFeaturePSK :
+                                                                          LFRFIDFeatureASK;
+    }
+
+    FURI_LOG_D(
+        TAG,
+        "%s phase: %s, %lu us, first decode at %ld us",
+        (family == LFRFIDReadSchedulerFamilyASK) ? "ASK" : "PSK",
+        scheduler->phase_locked     ? "locked" :
+        scheduler->phase_mismatched ? "mismatch" :
+                                      "no lock",
+        scheduler->elapsed_us,
+        scheduler->phase_decoded ? (int32_t)stats->first_decode_us : -1);
+}
+
+void lfrfid_read_scheduler_get_stats(
+    LFRFIDReadScheduler* scheduler,
+    LFRFIDFeature feature,
+    LFRFIDReadSchedulerStats* stats) {
+    furi_check(scheduler);
+    furi_check(stats);
+
+    *stats = scheduler->stats[lfrfid_read_scheduler_family(feature)];
+}
+
+ProtocolId lfrfid_read_scheduler_replay(
+    LFRFIDReadScheduler* scheduler,
+    ProtocolDict* dict,
+    LFRFIDRawFile* file) {
+    furi_check(scheduler);
+    furi_check(dict);
+    furi_check(file);
+
+    float frequency;
+    float duty_cycle;
+    if(!lfrfid_raw_file_read_header(file, &frequency, &duty_cycle)) {
+        FURI_LOG_E(TAG, "replay: bad header");
+        return PROTOCOL_NO;
+    }
+
+    // PSK is read with the half of the ASK carrier frequency
+    LFRFIDFeature feature = (frequency < 100000.0f) ? LFRFIDFeaturePSK : LFRFIDFeatureASK;
+
+    lfrfid_read_scheduler_phase_start(scheduler, feature);
+    protocol_dict_decoders_start(dict);
+
+    ProtocolId result = PROTOCOL_NO;
+    ProtocolId last_protocol = PROTOCOL_NO;
+    size_t max_data_size = protocol_dict_get_max_data_size(dict);
+    uint8_t* last_data = malloc(max_data_size);
+    uint8_t* protocol_data = malloc(max_data_size);
+    size_t last_read_count = 0;
+
+    uint32_t pulse;
+    uint32_t duration;
+    bool pass_end = false;
+
+    // same decoding and validation as the read worker
+    while(lfrfid_raw_file_read_pair(file, &duration, &pulse, &pass_end) && !pass_end) {
+        if(pulse > duration) continue;
+
+        lfrfid_read_scheduler_feed(scheduler, pulse, duration);
+
+        ProtocolId protocol = protocol_dict_decoders_feed_by_feature(dict, feature, true, pulse);
+        if(protocol == PROTOCOL_NO) {
+            protocol =
+                protocol_dict_decoders_feed_by_feature(dict, feature, false, duration - pulse);
+        }
+        if(protocol == PROTOCOL_NO) continue;
+
+        lfrfid_read_scheduler_decoded(scheduler);
+
+        size_t protocol_data_size = protocol_dict_get_data_size(dict, protocol);
+        protocol_dict_get_data(dict, protocol, protocol_data, protocol_data_size);
+
+        if(protocol == last_protocol &&
+           memcmp(last_data, protocol_data, protocol_data_size) == 0) {
+            last_read_count++;
+            if(last_read_count >= protocol_dict_get_validate_count(dict, protocol)) {
+                result = protocol;
+                break;
+            }
+        } else {
+            last_protocol = protocol;
+            memcpy(last_data, protocol_data, protocol_data_size);
+            last_read_count = 0;
+        }
+
+        protocol_dict_decoders_start(dict);
+    }
+
+    lfrfid_read_scheduler_phase_end(scheduler);
+
+    free(protocol_data);
+    free(last_data);
+
+    return result;
+}
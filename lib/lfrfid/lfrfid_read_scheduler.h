@@ -0,0 +1,142 @@
+/**
+ * @file lfrfid_read_scheduler.h
+ *
+ * LF RFID read scheduler: picks the demodulation (ASK or PSK) to read with.
+ *
+ * The scheduler watches edge timings of every read phase. A tag of the phase's
+ * modulation family gives a few sharp peaks in the pair duration histogram, so
+ * such phase is locked and read longer. A tag seen as irregular signal is of
+ * the other family, so such phase can be ended early. The family that worked
+ * last is remembered and tried first on the next read.
+ *
+ * Time is counted in captured microseconds, so a raw capture replayed offline
+ * gives the same results as the live read.
+ */
+#pragma once
+#include <furi.h>
+#include <toolbox/protocols/protocol_dict.h>
+#include "protocols/lfrfid_protocols.h"
+#include "lfrfid_raw_file.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct LFRFIDReadScheduler LFRFIDReadScheduler;
+
+typedef enum {
+    LFRFIDReadSchedulerVerdictUnknown, /**< Not enough data yet */
+    LFRFIDReadSchedulerVerdictIdle, /**< No card in the field */
+    LFRFIDReadSchedulerVerdictLocked, /**< Card of the phase modulation family */
+    LFRFIDReadSchedulerVerdictMismatch, /**< Card of the other modulation family */
+} LFRFIDReadSchedulerVerdict;
+
+typedef struct {
+    uint32_t phase_count; /**< Phases run */
+    uint32_t lock_count; /**< Phases locked to the family */
+    uint32_t mismatch_count; /**< Phases found to be of the other family */
+    uint32_t decode_count; /**< Phases with at least one decode */
+    uint32_t first_decode_us; /**< Time to the first decode, last decoding phase */
+    uint64_t first_decode_us_total; /**< Time to the first decode, sum of all phases */
+} LFRFIDReadSchedulerStats;
+
+/**
+ * @brief Allocate a new LFRFIDReadScheduler instance
+ *
+ * @return LFRFIDReadScheduler*
+ */
+LFRFIDReadScheduler* lfrfid_read_scheduler_alloc(void);
+
+/**
+ * @brief Free a LFRFIDReadScheduler instance
+ *
+ * @param scheduler
+ */
+void lfrfid_read_scheduler_free(LFRFIDReadScheduler* scheduler);
+
+/**
+ * @brief Forget the learned family and reset statistics
+ *
+ * @param scheduler
+ */
+void lfrfid_read_scheduler_reset(LFRFIDReadScheduler* scheduler);
+
+/**
+ * @brief Get the family to start the next read with
+ *
+ * @param scheduler
+ * @return LFRFIDFeature LFRFIDFeatureASK or LFRFIDFeaturePSK
+ */
+LFRFIDFeature lfrfid_read_scheduler_get_feature(LFRFIDReadScheduler* scheduler);
+
+/**
+ * @brief Start a read phase
+ *
+ * @param scheduler
+ * @param feature demodulation of the phase, LFRFIDFeatureASK or LFRFIDFeaturePSK
+ */
+void lfrfid_read_scheduler_phase_start(LFRFIDReadScheduler* scheduler, LFRFIDFeature feature);
+
+/**
+ * @brief Feed captured pulse and period into the scheduler
+ *
+ * @param scheduler
+ * @param pulse high level duration in us
+ * @param duration pulse period in us
+ */
+void lfrfid_read_scheduler_feed(LFRFIDReadScheduler* scheduler, uint32_t pulse, uint32_t duration);
+
+/**
+ * @brief Tell the scheduler that a protocol was decoded in the current phase
+ *
+ * @param scheduler
+ */
+void lfrfid_read_scheduler_decoded(LFRFIDReadScheduler* scheduler);
+
+/**
+ * @brief Get the verdict of the current phase
+ *
+ * @param scheduler
+ * @return LFRFIDReadSchedulerVerdict
+ */
+LFRFIDReadSchedulerVerdict lfrfid_read_scheduler_get_verdict(LFRFIDReadScheduler* scheduler);
+
+/**
+ * @brief End the current phase and learn from it
+ *
+ * @param scheduler
+ */
+void lfrfid_read_scheduler_phase_end(LFRFIDReadScheduler* scheduler);
+
+/**
+ * @brief Get statistics of the phases of one family
+ *
+ * @param scheduler
+ * @param feature LFRFIDFeatureASK or LFRFIDFeaturePSK
+ * @param stats
+ */
+void lfrfid_read_scheduler_get_stats(
+    LFRFIDReadScheduler* scheduler,
+    LFRFIDFeature feature,
+    LFRFIDReadSchedulerStats* stats);
+
+/**
+ * @brief Replay a raw capture through the scheduler and decoders, as one phase
+ *
+ * The file must be opened for reading. The header is read from the file and
+ * decides the family of the phase. Replay stops at the end of the capture or
+ * when a protocol is read as many times as the live read requires.
+ *
+ * @param scheduler
+ * @param dict
+ * @param file
+ * @return ProtocolId read protocol, PROTOCOL_NO if none
+ */
+ProtocolId lfrfid_read_scheduler_replay(
+    LFRFIDReadScheduler* scheduler,
+    ProtocolDict* dict,
+    LFRFIDRawFile* file);
+
+#ifdef __cplusplus
+}
+#endif
@@ -34,6 +34,7 @@ LFRFIDWorker* lfrfid_worker_alloc(ProtocolDict* dict) {
     worker->thread = furi_thread_alloc_ex("LfrfidWorker", 2048, lfrfid_worker_thread, worker);
 
     worker->protocols = dict;
+    worker->read_scheduler = lfrfid_read_scheduler_alloc();
 
     return worker;
 }
@@ -45,6 +46,7 @@ void lfrfid_worker_free(LFRFIDWorker* worker) {
         free(worker->raw_filename);
     }
 
+    lfrfid_read_scheduler_free(worker->read_scheduler);
     furi_thread_free(worker->thread);
     free(worker);
 }
@@ -8,6 +8,7 @@
 #include <furi.h>
 #include "lfrfid_worker.h"
 #include "lfrfid_raw_worker.h"
+#include "lfrfid_read_scheduler.h"
 #include "protocols/lfrfid_protocols.h"
 
 #ifdef __cplusplus
@@ -38,6 +39,7 @@ struct LFRFIDWorker {
     FuriThread* thread;
 
     LFRFIDWorkerReadType read_type;
+    LFRFIDReadScheduler* read_scheduler;
 
     LFRFIDWorkerReadCallback read_cb;
     LFRFIDWorkerWriteCallback write_cb;
@@ -28,6 +28,7 @@
 #define LFRFID_WORKER_READ_DROP_TIME_MS      50
 #define LFRFID_WORKER_READ_STABILIZE_TIME_MS 450
 #define LFRFID_WORKER_READ_SWITCH_TIME_MS    2000
+#define LFRFID_WORKER_READ_LOCK_TIME_MS      6000
 
 #define LFRFID_WORKER_WRITE_VERIFY_TIME_MS   2000
 #define LFRFID_WORKER_WRITE_DROP_TIME_MS     50
@@ -105,6 +106,26 @@ typedef enum {
     LFRFIDWorkerReadTimeout,
 } LFRFIDWorkerReadState;
 
+static void lfrfid_worker_read_log_decoder_stats(LFRFIDWorker* worker, LFRFIDFeature feature) {
+    if(furi_log_get_level() < FuriLogLevelDebug) return;
+
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+
+    for(size_t i = 0; i < LFRFIDProtocolMax; i++) {
+        if(!(protocol_dict_get_features(worker->protocols, i) & feature)) continue;
+
+        ProtocolDictDecoderStats stats;
+        protocol_dict_get_decoder_stats(worker->protocols, i, &stats);
+        FURI_LOG_D(
+            TAG,
+            "%s: %lu feeds, %lu us, parked %lu times",
+            protocol_dict_get_name(worker->protocols, i),
+            stats.feed_count,
+            (uint32_t)(stats.feed_cycles / cycles_per_us),
+            stats.park_count);
+    }
+}
+
 static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     LFRFIDWorker* worker,
     LFRFIDFeature feature,
@@ -130,6 +151,11 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     lfrfid_worker_delay(worker, LFRFID_WORKER_READ_STABILIZE_TIME_MS);
 
     protocol_dict_decoders_start(worker->protocols);
+    protocol_dict_reset_decoder_stats(worker->protocols);
+    lfrfid_read_scheduler_phase_start(worker->read_scheduler, feature);
+
+    // only auto read may cut or extend the phase
+    bool adaptive = worker->read_type == LFRFIDWorkerReadTypeAuto;
 
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
     furi_hal_gpio_init_simple(LFRFID_WORKER_READ_DEBUG_GPIO_VALUE, GpioModeOutputPushPull);
@@ -229,6 +255,8 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
                     }
                 }
 
+                lfrfid_read_scheduler_feed(worker->read_scheduler, pulse, duration);
+
                 ProtocolId protocol = PROTOCOL_NO;
 
                 protocol = protocol_dict_decoders_feed_by_feature(
@@ -241,6 +269,7 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
                 if(protocol != PROTOCOL_NO) {
                     // reset switch timer
                     switch_os_tick_last = furi_get_tick();
+                    lfrfid_read_scheduler_decoded(worker->read_scheduler);
 
                     size_t protocol_data_size =
                         protocol_dict_get_data_size(worker->protocols, protocol);
@@ -306,13 +335,32 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
             break;
         }
 
-        if((furi_get_tick() - switch_os_tick_last) > timeout) {
+        uint32_t phase_timeout = timeout;
+        if(adaptive) {
+            LFRFIDReadSchedulerVerdict verdict =
+                lfrfid_read_scheduler_get_verdict(worker->read_scheduler);
+
+            // card of the other family, no need to wait for the timeout
+            if(verdict == LFRFIDReadSchedulerVerdictMismatch) {
+                state = LFRFIDWorkerReadTimeout;
+                break;
+            }
+
+            // card of this family, give decoders more time
+            if(verdict == LFRFIDReadSchedulerVerdictLocked) {
+                phase_timeout = MAX(timeout, (uint32_t)LFRFID_WORKER_READ_LOCK_TIME_MS);
+            }
+        }
+
+        if((furi_get_tick() - switch_os_tick_last) > phase_timeout) {
             state = LFRFIDWorkerReadTimeout;
             break;
         }
     }
 
     FURI_LOG_D(TAG, "Read stopped");
+    lfrfid_worker_read_log_decoder_stats(worker, feature);
+    lfrfid_read_scheduler_phase_end(worker->read_scheduler);
 
     if(last_protocol != PROTOCOL_NO && worker->read_cb) {
         worker->read_cb(LFRFIDWorkerReadSenseCardEnd, last_protocol, worker->cb_ctx);
@@ -349,6 +397,9 @@ static void lfrfid_worker_mode_read_process(LFRFIDWorker* worker) {
 
     if(worker->read_type == LFRFIDWorkerReadTypePSKOnly) {
         feature = LFRFIDFeaturePSK;
+    } else if(worker->read_type == LFRFIDWorkerReadTypeAuto) {
+        // start with the family of the last card
+        feature = lfrfid_read_scheduler_get_feature(worker->read_scheduler);
     } else {
         feature = LFRFIDFeatureASK;
     }
@@ -254,6 +254,7 @@ const ProtocolBase protocol_awid = {
         {
             .start = (ProtocolDecoderStart)protocol_awid_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_awid_decoder_feed,
+            .duration_max = MAX_TIME,
         },
     .encoder =
         {
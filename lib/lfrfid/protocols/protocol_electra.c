@@ -428,6 +428,8 @@ const ProtocolBase protocol_electra = {
         {
             .start = (ProtocolDecoderStart)protocol_electra_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_electra_decoder_feed,
+            .duration_min = ELECTRA_READ_SHORT_TIME_LOW,
+            .duration_max = ELECTRA_READ_LONG_TIME_HIGH,
         },
     .encoder =
         {
@@ -29,6 +29,11 @@ typedef uint64_t EM4100Epilogue;
 #define EM_READ_LONG_TIME_BASE   (512)
 #define EM_READ_JITTER_TIME_BASE (100)
 
+#define EM_READ_DURATION_MIN(divisor) \
+    ((EM_READ_SHORT_TIME_BASE - EM_READ_JITTER_TIME_BASE) / (divisor))
+#define EM_READ_DURATION_MAX(divisor) \
+    ((EM_READ_LONG_TIME_BASE + EM_READ_JITTER_TIME_BASE) / (divisor))
+
 #define EM_ENCODED_DATA_HEADER (0xFF80000000000000ULL)
 
 typedef struct {
@@ -368,6 +373,8 @@ const ProtocolBase protocol_em4100 = {
         {
             .start = (ProtocolDecoderStart)protocol_em4100_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_em4100_decoder_feed,
+            .duration_min = EM_READ_DURATION_MIN(1),
+            .duration_max = EM_READ_DURATION_MAX(1),
         },
     .encoder =
         {
@@ -392,6 +399,8 @@ const ProtocolBase protocol_em4100_32 = {
         {
             .start = (ProtocolDecoderStart)protocol_em4100_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_em4100_decoder_feed,
+            .duration_min = EM_READ_DURATION_MIN(2),
+            .duration_max = EM_READ_DURATION_MAX(2),
         },
     .encoder =
         {
@@ -416,6 +425,8 @@ const ProtocolBase protocol_em4100_16 = {
         {
             .start = (ProtocolDecoderStart)protocol_em4100_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_em4100_decoder_feed,
+            .duration_min = EM_READ_DURATION_MIN(4),
+            .duration_max = EM_READ_DURATION_MAX(4),
         },
     .encoder =
         {
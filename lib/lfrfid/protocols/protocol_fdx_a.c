@@ -236,6 +236,7 @@ const ProtocolBase protocol_fdx_a = {
         {
             .start = (ProtocolDecoderStart)protocol_fdx_a_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_fdx_a_decoder_feed,
+            .duration_max = MAX_TIME,
         },
     .encoder =
         {
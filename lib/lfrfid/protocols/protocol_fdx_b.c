@@ -386,6 +386,8 @@ const ProtocolBase protocol_fdx_b = {
         {
             .start = (ProtocolDecoderStart)protocol_fdx_b_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_fdx_b_decoder_feed,
+            .duration_min = FDX_B_SHORT_TIME_LOW,
+            .duration_max = FDX_B_LONG_TIME_HIGH,
         },
     .encoder =
         {
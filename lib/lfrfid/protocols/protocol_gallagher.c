@@ -319,6 +319,8 @@ const ProtocolBase protocol_gallagher = {
         {
             .start = (ProtocolDecoderStart)protocol_gallagher_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_gallagher_decoder_feed,
+            .duration_min = GALLAGHER_READ_SHORT_TIME_LOW,
+            .duration_max = GALLAGHER_READ_LONG_TIME_HIGH,
         },
     .encoder =
         {
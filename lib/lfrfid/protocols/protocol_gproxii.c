@@ -304,6 +304,8 @@ const ProtocolBase protocol_gproxii = {
         {
             .start = (ProtocolDecoderStart)protocol_gproxii_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_gproxii_decoder_feed,
+            .duration_min = GPROXII_SHORT_TIME_LOW,
+            .duration_max = GPROXII_LONG_TIME_HIGH,
         },
     .encoder =
         {
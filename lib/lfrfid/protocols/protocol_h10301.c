@@ -378,6 +378,7 @@ const ProtocolBase protocol_h10301 = {
         {
             .start = (ProtocolDecoderStart)protocol_h10301_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_h10301_decoder_feed,
+            .duration_max = MAX_TIME,
         },
     .encoder =
         {
@@ -215,6 +215,7 @@ const ProtocolBase protocol_hid_ex_generic = {
         {
             .start = (ProtocolDecoderStart)protocol_hid_ex_generic_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_hid_ex_generic_decoder_feed,
+            .duration_max = MAX_TIME,
         },
     .encoder =
         {
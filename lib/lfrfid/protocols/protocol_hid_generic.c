@@ -276,6 +276,7 @@ const ProtocolBase protocol_hid_generic = {
         {
             .start = (ProtocolDecoderStart)protocol_hid_generic_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_hid_generic_decoder_feed,
+            .duration_max = MAX_TIME,
         },
     .encoder =
         {
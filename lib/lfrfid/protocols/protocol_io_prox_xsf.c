@@ -289,6 +289,7 @@ const ProtocolBase protocol_io_prox_xsf = {
         {
             .start = (ProtocolDecoderStart)protocol_io_prox_xsf_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_io_prox_xsf_decoder_feed,
+            .duration_max = MAX_TIME,
         },
     .encoder =
         {
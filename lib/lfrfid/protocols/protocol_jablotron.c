@@ -199,6 +199,8 @@ const ProtocolBase protocol_jablotron = {
         {
             .start = (ProtocolDecoderStart)protocol_jablotron_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_jablotron_decoder_feed,
+            .duration_min = JABLOTRON_SHORT_TIME_LOW,
+            .duration_max = JABLOTRON_LONG_TIME_HIGH,
         },
     .encoder =
         {
@@ -219,6 +219,8 @@ const ProtocolBase protocol_pac_stanley = {
         {
             .start = (ProtocolDecoderStart)protocol_pac_stanley_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_pac_stanley_decoder_feed,
+            .duration_min = PAC_STANLEY_MIN_TIME,
+            .duration_max = PAC_STANLEY_MAX_TIME,
         },
     .encoder =
         {
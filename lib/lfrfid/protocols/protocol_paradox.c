@@ -237,6 +237,7 @@ const ProtocolBase protocol_paradox = {
         {
             .start = (ProtocolDecoderStart)protocol_paradox_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_paradox_decoder_feed,
+            .duration_max = MAX_TIME,
         },
     .encoder =
         {
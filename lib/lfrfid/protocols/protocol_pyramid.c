@@ -271,6 +271,7 @@ const ProtocolBase protocol_pyramid = {
         {
             .start = (ProtocolDecoderStart)protocol_pyramid_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_pyramid_decoder_feed,
+            .duration_max = MAX_TIME,
         },
     .encoder =
         {
@@ -353,6 +353,8 @@ const ProtocolBase protocol_securakey = {
         {
             .start = (ProtocolDecoderStart)protocol_securakey_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_securakey_decoder_feed,
+            .duration_min = SECURAKEY_READ_SHORT_TIME_LOW,
+            .duration_max = SECURAKEY_READ_LONG_TIME_HIGH,
         },
     .encoder =
         {
@@ -192,6 +192,8 @@ const ProtocolBase protocol_viking = {
         {
             .start = (ProtocolDecoderStart)protocol_viking_decoder_start,
             .feed = (ProtocolDecoderFeed)protocol_viking_decoder_feed,
+            .duration_min = VIKING_READ_SHORT_TIME_LOW,
+            .duration_max = VIKING_READ_LONG_TIME_HIGH,
         },
     .encoder =
         {
@@ -51,8 +51,7 @@ static uint32_t crypto1_filter(uint32_t in) {
     return FURI_BIT(0xEC57E80A, out);
 }
 
-uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
-    furi_assert(crypto1);
+static inline uint8_t crypto1_step(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     uint8_t out = crypto1_filter(crypto1->odd);
     uint32_t feed = out & (!!is_encrypted);
     feed ^= !!in;
@@ -64,11 +63,16 @@ uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     return out;
 }
 
+uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    furi_assert(crypto1);
+    return crypto1_step(crypto1, in, is_encrypted);
+}
+
 uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
     uint8_t out = 0;
     for(uint8_t i = 0; i < 8; i++) {
-        out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+        out |= crypto1_step(crypto1, FURI_BIT(in, i), is_encrypted) << i;
     }
     return out;
 }
@@ -77,7 +81,7 @@ uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     furi_assert(crypto1);
     uint32_t out = 0;
     for(uint8_t i = 0; i < 32; i++) {
-        out |= (uint32_t)crypto1_bit(crypto1, BEBIT(in, i), is_encrypted) << (24 ^ i);
+        out |= (uint32_t)crypto1_step(crypto1, BEBIT(in, i), is_encrypted) << (24 ^ i);
     }
     return out;
 }
@@ -101,10 +105,10 @@ void crypto1_decrypt(Crypto1* crypto, const BitBuffer* buff, BitBuffer* out) {
     if(bits < 8) {
         uint8_t decrypted_byte = 0;
         uint8_t encrypted_byte = encrypted_data[0];
-        decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 0)) << 0;
-        decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 1)) << 1;
-        decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 2)) << 2;
-        decrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 3)) << 3;
+        decrypted_byte |= (crypto1_step(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 0)) << 0;
+        decrypted_byte |= (crypto1_step(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 1)) << 1;
+        decrypted_byte |= (crypto1_step(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 2)) << 2;
+        decrypted_byte |= (crypto1_step(crypto, 0, 0) ^ FURI_BIT(encrypted_byte, 3)) << 3;
         bit_buffer_set_byte(out, 0, decrypted_byte);
     } else {
         for(size_t i = 0; i < bits / 8; i++) {
@@ -125,7 +129,7 @@ void crypto1_encrypt(Crypto1* crypto, uint8_t* keystream, const BitBuffer* buff,
     if(bits < 8) {
         uint8_t encrypted_byte = 0;
         for(size_t i = 0; i < bits; i++) {
-            encrypted_byte |= (crypto1_bit(crypto, 0, 0) ^ FURI_BIT(plain_data[0], i)) << i;
+            encrypted_byte |= (crypto1_step(crypto, 0, 0) ^ FURI_BIT(plain_data[0], i)) << i;
         }
         bit_buffer_set_byte(out, 0, encrypted_byte);
     } else {
@@ -235,3 +239,126 @@ uint32_t crypto1_decrypt_nt_enc(uint32_t cuid, uint32_t nt_enc, MfClassicKey kno
         (nt_enc ^ crypto1_lfsr_rollback_word(&crypto_temp, nt_enc ^ cuid, 1));
     return decrypted_nt_enc;
 }
+
+// Bitsliced engine: lfsr[i] holds bit i of the LFSR stream for 32 keys, one key per bit.
+// Bit i of the stream is bit i of the key taken LSB first from key byte 0, each step
+// appends one bit, odd register bit k is lfsr[t + 47 - 2k] and even bit k is lfsr[t + 46 - 2k].
+
+static void crypto1_bs_transpose32(uint32_t* a) {
+    uint32_t m = 0x0000FFFF;
+    for(uint32_t j = 16; j != 0; j >>= 1, m ^= m << j) {
+        for(uint32_t k = 0; k < 32; k = (k + j + 1) & ~j) {
+            uint32_t t = (a[k] ^ (a[k + j] >> j)) & m;
+            a[k] ^= t;
+            a[k + j] ^= t << j;
+        }
+    }
+}
+
+void crypto1_bs_init(Crypto1Bs* bs, const MfClassicKey* keys, size_t count) {
+    furi_assert(bs);
+    furi_assert(keys);
+    furi_assert(count <= CRYPTO1_BS_LANES);
+
+    // Transpose swaps both bit and word order, keys are stored reversed to compensate
+    uint32_t low[CRYPTO1_BS_LANES] = {};
+    uint32_t high[CRYPTO1_BS_LANES] = {};
+    for(size_t i = 0; i < count; i++) {
+        const uint8_t* data = keys[i].data;
+        low[31 - i] = bit_lib_bytes_to_num_le(&data[0], 4);
+        high[31 - i] = bit_lib_bytes_to_num_le(&data[4], 2);
+    }
+    crypto1_bs_transpose32(low);
+    crypto1_bs_transpose32(high);
+
+    for(size_t i = 0; i < 32; i++) {
+        bs->lfsr[i] = low[31 - i];
+    }
+    for(size_t i = 0; i < 16; i++) {
+        bs->lfsr[32 + i] = high[31 - i];
+    }
+    bs->lanes = (count == CRYPTO1_BS_LANES) ? UINT32_MAX : ((1UL << count) - 1);
+}
+
+// Nibble filters 0xf22c and 0xd938, five input filter 0xEC57E80A split on its middle input
+static inline uint32_t crypto1_bs_fa(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    return c ^ ((b | (a ^ c)) & ~(d ^ (a & ~b)));
+}
+
+static inline uint32_t crypto1_bs_fb(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    return a ^ (b ^ ((a ^ (c ^ d)) | (c ^ (a | b))));
+}
+
+static inline uint32_t crypto1_bs_filter(const uint32_t* s) {
+    uint32_t g0 = crypto1_bs_fa(s[47], s[45], s[43], s[41]);
+    uint32_t g1 = crypto1_bs_fb(s[39], s[37], s[35], s[33]);
+    uint32_t g2 = crypto1_bs_fa(s[31], s[29], s[27], s[25]);
+    uint32_t g3 = crypto1_bs_fa(s[23], s[21], s[19], s[17]);
+    uint32_t g4 = crypto1_bs_fb(s[15], s[13], s[11], s[9]);
+
+    uint32_t f0 = (g4 | g0) & ~(g3 ^ (g1 | (g3 & ~(g4 & g0))));
+    uint32_t f1 = (g4 ^ (g3 & g1)) & ~(g3 & g0);
+    return f0 ^ (g2 & f1);
+}
+
+static inline uint32_t crypto1_bs_feedback(const uint32_t* s) {
+    // LF_POLY_ODD taps
+    uint32_t feed = s[43] ^ s[41] ^ s[39] ^ s[35] ^ s[29] ^ s[27] ^ s[25] ^ s[19] ^ s[17] ^
+                    s[15] ^ s[9] ^ s[5];
+    // LF_POLY_EVEN taps
+    feed ^= s[42] ^ s[24] ^ s[14] ^ s[12] ^ s[10] ^ s[0];
+    return feed;
+}
+
+static inline uint32_t crypto1_bs_broadcast(uint32_t value, uint8_t bit) {
+    return 0 - ((value >> bit) & 1);
+}
+
+uint32_t crypto1_bs_nonce_matches_encrypted_parity_bits(
+    const Crypto1Bs* bs,
+    uint32_t cuid,
+    uint32_t nt_enc,
+    uint8_t nt_par_enc,
+    uint32_t* nt) {
+    furi_assert(bs);
+
+    // Keystream needed by the parity check ends with bit 24, full nonce needs all 32
+    const size_t steps = nt ? 32 : 25;
+    uint32_t s[CRYPTO1_BS_LFSR_SIZE + 32];
+    // Decrypted nonce, bit 24 ^ i of the nonce is plain[i]
+    uint32_t plain[32];
+    uint32_t mask = bs->lanes;
+    uint32_t in = nt_enc ^ cuid;
+
+    memcpy(s, bs->lfsr, sizeof(bs->lfsr));
+    for(size_t i = 0; i < steps; i++) {
+        const uint32_t* p = &s[i];
+        uint32_t ks = crypto1_bs_filter(p);
+        s[CRYPTO1_BS_LFSR_SIZE + i] = crypto1_bs_feedback(p) ^ ks ^
+                                      crypto1_bs_broadcast(in, 24 ^ i);
+        plain[i] = ks ^ crypto1_bs_broadcast(nt_enc, 24 ^ i);
+
+        // Keystream bits 16, 8 and 0 encrypt the parity of nonce bytes 3, 2 and 1
+        if((i & 7) == 0 && i != 0) {
+            uint32_t parity = ks ^ crypto1_bs_broadcast(nt_par_enc, 4 - i / 8);
+            for(size_t j = i - 8; j < i; j++) {
+                parity ^= plain[j];
+            }
+            mask &= ~parity;
+            if(!mask) break;
+        }
+    }
+
+    if(nt && mask) {
+        for(size_t lane = 0; lane < CRYPTO1_BS_LANES; lane++) {
+            if(!(mask & (1UL << lane))) continue;
+            uint32_t value = 0;
+            for(size_t i = 0; i < 32; i++) {
+                value |= ((plain[i] >> lane) & 1) << (24 ^ i);
+            }
+            nt[lane] = value;
+        }
+    }
+
+    return mask;
+}
@@ -7,11 +7,20 @@
 extern "C" {
 #endif
 
+#define CRYPTO1_BS_LANES     (32U)
+#define CRYPTO1_BS_LFSR_SIZE (48U)
+
 typedef struct {
     uint32_t odd;
     uint32_t even;
 } Crypto1;
 
+/** Bitsliced initial states of up to CRYPTO1_BS_LANES keys */
+typedef struct {
+    uint32_t lfsr[CRYPTO1_BS_LFSR_SIZE];
+    uint32_t lanes;
+} Crypto1Bs;
+
 Crypto1* crypto1_alloc(void);
 
 void crypto1_free(Crypto1* instance);
@@ -49,6 +58,31 @@ uint32_t crypto1_decrypt_nt_enc(uint32_t cuid, uint32_t nt_enc, MfClassicKey kno
 
 uint32_t crypto1_prng_successor(uint32_t x, uint32_t n);
 
+/** Load keys into bitsliced lanes, lane i holds keys[i]
+ *
+ * @param bs Crypto1Bs instance
+ * @param keys Keys to check
+ * @param count Key count, up to CRYPTO1_BS_LANES
+ */
+void crypto1_bs_init(Crypto1Bs* bs, const MfClassicKey* keys, size_t count);
+
+/** Bitsliced crypto1_decrypt_nt_enc plus crypto1_nonce_matches_encrypted_parity_bits
+ *
+ * @param bs Crypto1Bs instance
+ * @param cuid Card UID
+ * @param nt_enc Encrypted nested nonce
+ * @param nt_par_enc Encrypted nonce parity bits
+ * @param nt Optional output of CRYPTO1_BS_LANES decrypted nonces, set for matching lanes
+ *
+ * @return Mask of lanes whose key matches nonce parity
+ */
+uint32_t crypto1_bs_nonce_matches_encrypted_parity_bits(
+    const Crypto1Bs* bs,
+    uint32_t cuid,
+    uint32_t nt_enc,
+    uint8_t nt_par_enc,
+    uint32_t* nt);
+
 #ifdef __cplusplus
 }
 #endif
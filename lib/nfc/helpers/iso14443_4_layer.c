@@ -50,6 +50,7 @@
 struct Iso14443_4Layer {
     uint8_t pcb;
     uint8_t pcb_prev;
+    bool rx_chaining;
 };
 
 static inline void iso14443_4_layer_update_pcb(Iso14443_4Layer* instance) {
@@ -73,6 +74,7 @@ void iso14443_4_layer_reset(Iso14443_4Layer* instance) {
     furi_assert(instance);
     instance->pcb_prev = 0;
     instance->pcb = ISO14443_4_BLOCK_PCB_I | ISO14443_4_BLOCK_PCB;
+    instance->rx_chaining = false;
 }
 
 void iso14443_4_layer_set_i_block(Iso14443_4Layer* instance, bool chaining, bool CID_present) {
@@ -108,11 +110,53 @@ void iso14443_4_layer_encode_block(
     iso14443_4_layer_update_pcb(instance);
 }
 
+void iso14443_4_layer_encode_block_bytes(
+    Iso14443_4Layer* instance,
+    const uint8_t* data,
+    size_t data_size,
+    BitBuffer* block_data) {
+    furi_assert(instance);
+
+    bit_buffer_append_byte(block_data, instance->pcb);
+    bit_buffer_append_bytes(block_data, data, data_size);
+
+    iso14443_4_layer_update_pcb(instance);
+}
+
+void iso14443_4_layer_encode_ack(Iso14443_4Layer* instance, BitBuffer* block_data) {
+    furi_assert(instance);
+
+    // Card answers R(ACK) with the next I-block of the chain carrying the same block number
+    const uint8_t block_pcb = instance->pcb & ISO14443_4_BLOCK_PCB_MASK;
+    bit_buffer_append_byte(block_data, ISO14443_4_BLOCK_PCB_R_MASK | block_pcb);
+
+    instance->pcb = ISO14443_4_BLOCK_PCB_I | block_pcb;
+    iso14443_4_layer_update_pcb(instance);
+}
+
+bool iso14443_4_layer_is_rx_chaining(const Iso14443_4Layer* instance) {
+    furi_assert(instance);
+
+    return instance->rx_chaining;
+}
+
 static inline uint8_t iso14443_4_layer_get_response_pcb(const BitBuffer* block_data) {
     const uint8_t* data = bit_buffer_get_data(block_data);
     return data[0];
 }
 
+// I-block answer to the last sent block, may announce more blocks with the chaining bit
+static bool
+    iso14443_4_layer_decode_i_block(Iso14443_4Layer* instance, const BitBuffer* block_data) {
+    if(bit_buffer_get_size_bytes(block_data) == 0) return false;
+
+    const uint8_t response_pcb = iso14443_4_layer_get_response_pcb(block_data);
+    if((response_pcb & ~ISO14443_4_BLOCK_PCB_I_CHAIN_MASK) != instance->pcb_prev) return false;
+
+    instance->rx_chaining = ISO14443_4_BLOCK_PCB_IS_CHAIN_ACTIVE(response_pcb);
+    return true;
+}
+
 bool iso14443_4_layer_decode_block(
     Iso14443_4Layer* instance,
     BitBuffer* output_data,
@@ -120,6 +164,7 @@ bool iso14443_4_layer_decode_block(
     furi_assert(instance);
 
     bool ret = false;
+    instance->rx_chaining = false;
 
     do {
         if(ISO14443_4_BLOCK_PCB_IS_R_BLOCK(instance->pcb_prev)) {
@@ -138,10 +183,34 @@ bool iso14443_4_layer_decode_block(
             if(bit_buffer_get_size_bytes(block_data) > 1)
                 bit_buffer_copy_right(output_data, block_data, 1);
         } else {
-            if(!bit_buffer_starts_with_byte(block_data, instance->pcb_prev)) break;
-            bit_buffer_copy_right(output_data, block_data, 1);
-            ret = true;
+            ret = iso14443_4_layer_decode_i_block(instance, block_data);
+            if(ret) bit_buffer_copy_right(output_data, block_data, 1);
+        }
+    } while(false);
+
+    return ret;
+}
+
+bool iso14443_4_layer_decode_chained_block(
+    Iso14443_4Layer* instance,
+    BitBuffer* output_data,
+    const BitBuffer* block_data) {
+    furi_assert(instance);
+
+    bool ret = false;
+
+    do {
+        if(!iso14443_4_layer_decode_i_block(instance, block_data)) break;
+
+        const size_t inf_size = bit_buffer_get_size_bytes(block_data) - 1;
+        if(bit_buffer_get_size_bytes(output_data) + inf_size >
+           bit_buffer_get_capacity_bytes(output_data)) {
+            instance->rx_chaining = false;
+            break;
         }
+
+        bit_buffer_append_right(output_data, block_data, 1);
+        ret = true;
     } while(false);
 
     return ret;
@@ -24,11 +24,26 @@ void iso14443_4_layer_encode_block(
     const BitBuffer* input_data,
     BitBuffer* block_data);
 
+void iso14443_4_layer_encode_block_bytes(
+    Iso14443_4Layer* instance,
+    const uint8_t* data,
+    size_t data_size,
+    BitBuffer* block_data);
+
+void iso14443_4_layer_encode_ack(Iso14443_4Layer* instance, BitBuffer* block_data);
+
 bool iso14443_4_layer_decode_block(
     Iso14443_4Layer* instance,
     BitBuffer* output_data,
     const BitBuffer* block_data);
 
+bool iso14443_4_layer_decode_chained_block(
+    Iso14443_4Layer* instance,
+    BitBuffer* output_data,
+    const BitBuffer* block_data);
+
+bool iso14443_4_layer_is_rx_chaining(const Iso14443_4Layer* instance);
+
 Iso14443_4aError iso14443_4_layer_decode_block_pwt_ext(
     Iso14443_4Layer* instance,
     BitBuffer* output_data,
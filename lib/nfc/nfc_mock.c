@@ -1,6 +1,7 @@
 #ifdef FW_CFG_unit_tests
 
 #include <lib/nfc/nfc.h>
+#include <lib/nfc/nfc_mock.h>
 #include <lib/nfc/helpers/iso14443_crc.h>
 #include <lib/nfc/protocols/iso14443_3a/iso14443_3a.h>
 #include <lib/nfc/protocols/felica/felica.h>
@@ -8,6 +9,7 @@
 #include <lib/nfc/protocols/felica/felica_poller_sync.h>
 
 #include <furi/furi.h>
+#include <furi_hal.h>
 
 #define NFC_MAX_BUFFER_SIZE (256)
 
@@ -19,6 +21,8 @@ typedef enum {
 FuriMessageQueue* poller_queue = NULL;
 FuriMessageQueue* listener_queue = NULL;
 
+static NfcMockStats nfc_mock_stats = {};
+
 typedef enum {
     NfcMessageTypeTx,
     NfcMessageTypeTimeout,
@@ -139,6 +143,16 @@ static void nfc_prepare_col_res_data(
     }
 }
 
+void nfc_mock_reset_stats(void) {
+    memset(&nfc_mock_stats, 0, sizeof(NfcMockStats));
+}
+
+void nfc_mock_get_stats(NfcMockStats* stats) {
+    furi_check(stats);
+
+    *stats = nfc_mock_stats;
+}
+
 Nfc* nfc_alloc(void) {
     Nfc* instance = malloc(sizeof(Nfc));
 
@@ -316,6 +330,7 @@ static int32_t nfc_worker_listener(void* context) {
         } else if(message.type == NfcMessageTypeTx) {
             nfc_test_print(
                 NfcTransportLogLevelInfo, "RDR", message.data.data, message.data.data_bits);
+            uint32_t start = DWT->CYCCNT;
             if(instance->software_col_res_required &&
                (instance->col_res_status != Iso14443_3aColResStatusDone)) {
                 nfc_worker_listener_pass_col_res(
@@ -325,6 +340,7 @@ static int32_t nfc_worker_listener(void* context) {
                 nfc_event.type = NfcEventTypeRxEnd;
                 instance->callback(nfc_event, instance->context);
             }
+            nfc_mock_stats.listener_cycles += DWT->CYCCNT - start;
         }
     }
 
@@ -413,6 +429,8 @@ NfcError nfc_listener_tx(Nfc* instance, const BitBuffer* tx_buffer) {
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
     bit_buffer_write_bytes(tx_buffer, message.data.data, bit_buffer_get_size_bytes(tx_buffer));
 
+    nfc_mock_stats.listener_frames++;
+    nfc_mock_stats.listener_bits += message.data.data_bits;
     furi_message_queue_put(poller_queue, &message, FuriWaitForever);
 
     return NfcErrorNone;
@@ -438,6 +456,8 @@ NfcError
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
     bit_buffer_write_bytes(tx_buffer, message.data.data, bit_buffer_get_size_bytes(tx_buffer));
     // Tx
+    nfc_mock_stats.poller_frames++;
+    nfc_mock_stats.poller_bits += message.data.data_bits;
     furi_check(furi_message_queue_put(listener_queue, &message, FuriWaitForever) == FuriStatusOk);
     // Rx
     FuriStatus status = furi_message_queue_get(poller_queue, &message, 50);
@@ -452,6 +472,8 @@ NfcError
         error = NfcErrorTimeout;
     }
 
+    if(error == NfcErrorTimeout) nfc_mock_stats.timeouts++;
+
     return error;
 }
 
@@ -0,0 +1,45 @@
+/**
+ * @file nfc_mock.h
+ * @brief Transport counters of the Nfc mock used in unit test builds.
+ *
+ * In unit test builds the Nfc transport layer is replaced by a mock that passes
+ * frames between a poller and a listener Nfc instance in memory. The counters
+ * below let benchmarks measure protocol layer throughput without RF hardware.
+ *
+ * Only available when the firmware is built with FW_CFG_unit_tests.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Nfc mock transport counters.
+ */
+typedef struct {
+    uint32_t poller_frames; /**< Frames sent by the poller. */
+    uint32_t poller_bits; /**< Bits sent by the poller. */
+    uint32_t listener_frames; /**< Frames sent by the listener. */
+    uint32_t listener_bits; /**< Bits sent by the listener. */
+    uint32_t timeouts; /**< Poller frames left without response. */
+    uint64_t listener_cycles; /**< CPU cycles the listener spent handling poller frames. */
+} NfcMockStats;
+
+/**
+ * @brief Reset all Nfc mock transport counters to zero.
+ */
+void nfc_mock_reset_stats(void);
+
+/**
+ * @brief Get current Nfc mock transport counters.
+ *
+ * @param[out] stats pointer to the structure to be filled with counters.
+ */
+void nfc_mock_get_stats(NfcMockStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
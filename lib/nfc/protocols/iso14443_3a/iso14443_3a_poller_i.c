@@ -42,13 +42,16 @@ static Iso14443_3aError iso14443_3a_poller_standard_frame_exchange(
             break;
         }
 
-        bit_buffer_copy(rx_buffer, instance->rx_buffer);
         if(!iso14443_crc_check(Iso14443CrcTypeA, instance->rx_buffer)) {
+            bit_buffer_copy(rx_buffer, instance->rx_buffer);
             ret = Iso14443_3aErrorWrongCrc;
             break;
         }
 
-        iso14443_crc_trim(rx_buffer);
+        // Copy payload only, CRC is left behind
+        const size_t rx_size =
+            bit_buffer_get_size_bytes(instance->rx_buffer) - ISO14443_CRC_SIZE;
+        bit_buffer_copy_left(rx_buffer, instance->rx_buffer, rx_size);
     } while(false);
 
     return ret;
@@ -12,6 +12,8 @@
 #define ISO14443_4A_WTXM_MASK               (0x3FU)
 #define ISO14443_4A_WTXM_MAX                (0x3BU)
 #define ISO14443_4A_SWTX                    (0xF2U)
+#define ISO14443_4A_FSC_DEFAULT             (32U)
+#define ISO14443_4A_BLOCK_OVERHEAD          (3U) // PCB and CRC
 
 Iso14443_4aError iso14443_4a_poller_halt(Iso14443_4aPoller* instance) {
     furi_check(instance);
@@ -56,6 +58,52 @@ Iso14443_4aError
     return error;
 }
 
+// Largest INF field of a block the card accepts: its frame size less PCB and CRC
+static size_t iso14443_4a_poller_get_inf_size_max(Iso14443_4aPoller* instance) {
+    size_t frame_size = ISO14443_4A_FSC_DEFAULT;
+    if(instance->data->ats_data.tl > 1) {
+        frame_size = iso14443_4a_get_frame_size_max(instance->data);
+    }
+
+    const size_t frame_size_max = bit_buffer_get_capacity_bytes(instance->tx_buffer);
+    if(frame_size == 0 || frame_size > frame_size_max) {
+        frame_size = frame_size_max;
+    }
+
+    return frame_size - ISO14443_4A_BLOCK_OVERHEAD;
+}
+
+// Exchange one block, answering waiting time extension requests from the card
+static Iso14443_4aError iso14443_4a_poller_trx_block(Iso14443_4aPoller* instance) {
+    Iso14443_3aError iso14443_3a_error = iso14443_3a_poller_send_standard_frame(
+        instance->iso14443_3a_poller,
+        instance->tx_buffer,
+        instance->rx_buffer,
+        iso14443_4a_get_fwt_fc_max(instance->data));
+    instance->frame_count++;
+
+    while(iso14443_3a_error == Iso14443_3aErrorNone &&
+          bit_buffer_starts_with_byte(instance->rx_buffer, ISO14443_4A_SWTX)) {
+        uint8_t wtxm = bit_buffer_get_byte(instance->rx_buffer, 1) & ISO14443_4A_WTXM_MASK;
+        if(wtxm > ISO14443_4A_WTXM_MAX) {
+            return Iso14443_4aErrorProtocol;
+        }
+
+        bit_buffer_reset(instance->tx_buffer);
+        bit_buffer_copy_left(instance->tx_buffer, instance->rx_buffer, 1);
+        bit_buffer_append_byte(instance->tx_buffer, wtxm);
+
+        iso14443_3a_error = iso14443_3a_poller_send_standard_frame(
+            instance->iso14443_3a_poller,
+            instance->tx_buffer,
+            instance->rx_buffer,
+            MAX(iso14443_4a_get_fwt_fc_max(instance->data) * wtxm, ISO14443_4A_FWT_MAX));
+        instance->frame_count++;
+    }
+
+    return iso14443_4a_process_error(iso14443_3a_error);
+}
+
 Iso14443_4aError iso14443_4a_poller_send_block(
     Iso14443_4aPoller* instance,
     const BitBuffer* tx_buffer,
@@ -64,53 +112,61 @@ Iso14443_4aError iso14443_4a_poller_send_block(
     furi_check(tx_buffer);
     furi_check(rx_buffer);
 
-    bit_buffer_reset(instance->tx_buffer);
-    iso14443_4_layer_encode_block(instance->iso14443_4_layer, tx_buffer, instance->tx_buffer);
+    const uint8_t* tx_data = bit_buffer_get_data(tx_buffer);
+    size_t tx_size = bit_buffer_get_size_bytes(tx_buffer);
+    const size_t inf_size_max = iso14443_4a_poller_get_inf_size_max(instance);
 
     Iso14443_4aError error = Iso14443_4aErrorNone;
 
     do {
-        Iso14443_3aError iso14443_3a_error = iso14443_3a_poller_send_standard_frame(
-            instance->iso14443_3a_poller,
-            instance->tx_buffer,
-            instance->rx_buffer,
-            iso14443_4a_get_fwt_fc_max(instance->data));
+        // Data longer than the card frame size goes as a chain, each part is acknowledged
+        while(tx_size > inf_size_max) {
+            iso14443_4_layer_set_i_block(instance->iso14443_4_layer, true, false);
+            bit_buffer_reset(instance->tx_buffer);
+            iso14443_4_layer_encode_block_bytes(
+                instance->iso14443_4_layer, tx_data, inf_size_max, instance->tx_buffer);
+
+            error = iso14443_4a_poller_trx_block(instance);
+            if(error != Iso14443_4aErrorNone) break;
+
+            if(!iso14443_4_layer_decode_block(
+                   instance->iso14443_4_layer, rx_buffer, instance->rx_buffer)) {
+                error = Iso14443_4aErrorProtocol;
+                break;
+            }
 
-        if(iso14443_3a_error != Iso14443_3aErrorNone) {
-            error = iso14443_4a_process_error(iso14443_3a_error);
-            break;
+            tx_data += inf_size_max;
+            tx_size -= inf_size_max;
         }
+        if(error != Iso14443_4aErrorNone) break;
 
-        if(bit_buffer_starts_with_byte(instance->rx_buffer, ISO14443_4A_SWTX)) {
-            do {
-                uint8_t wtxm = bit_buffer_get_byte(instance->rx_buffer, 1) & ISO14443_4A_WTXM_MASK;
-                if(wtxm > ISO14443_4A_WTXM_MAX) {
-                    return Iso14443_4aErrorProtocol;
-                }
-
-                bit_buffer_reset(instance->tx_buffer);
-                bit_buffer_copy_left(instance->tx_buffer, instance->rx_buffer, 1);
-                bit_buffer_append_byte(instance->tx_buffer, wtxm);
-
-                iso14443_3a_error = iso14443_3a_poller_send_standard_frame(
-                    instance->iso14443_3a_poller,
-                    instance->tx_buffer,
-                    instance->rx_buffer,
-                    MAX(iso14443_4a_get_fwt_fc_max(instance->data) * wtxm, ISO14443_4A_FWT_MAX));
-
-                if(iso14443_3a_error != Iso14443_3aErrorNone) {
-                    error = iso14443_4a_process_error(iso14443_3a_error);
-                    return error;
-                }
-
-            } while(bit_buffer_starts_with_byte(instance->rx_buffer, ISO14443_4A_SWTX));
-        }
+        bit_buffer_reset(instance->tx_buffer);
+        iso14443_4_layer_encode_block_bytes(
+            instance->iso14443_4_layer, tx_data, tx_size, instance->tx_buffer);
+
+        error = iso14443_4a_poller_trx_block(instance);
+        if(error != Iso14443_4aErrorNone) break;
 
         if(!iso14443_4_layer_decode_block(
                instance->iso14443_4_layer, rx_buffer, instance->rx_buffer)) {
             error = Iso14443_4aErrorProtocol;
             break;
         }
+
+        // Answer longer than our frame size comes as a chain, ask for each next part
+        while(iso14443_4_layer_is_rx_chaining(instance->iso14443_4_layer)) {
+            bit_buffer_reset(instance->tx_buffer);
+            iso14443_4_layer_encode_ack(instance->iso14443_4_layer, instance->tx_buffer);
+
+            error = iso14443_4a_poller_trx_block(instance);
+            if(error != Iso14443_4aErrorNone) break;
+
+            if(!iso14443_4_layer_decode_chained_block(
+                   instance->iso14443_4_layer, rx_buffer, instance->rx_buffer)) {
+                error = Iso14443_4aErrorProtocol;
+                break;
+            }
+        }
     } while(false);
 
     return error;
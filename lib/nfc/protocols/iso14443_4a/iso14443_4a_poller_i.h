@@ -36,6 +36,7 @@ struct Iso14443_4aPoller {
     Iso14443_4Layer* iso14443_4_layer;
     BitBuffer* tx_buffer;
     BitBuffer* rx_buffer;
+    uint32_t frame_count;
     Iso14443_4aPollerEventData iso14443_4a_event_data;
     Iso14443_4aPollerEvent iso14443_4a_event;
     NfcGenericEvent general_event;
@@ -1510,13 +1510,44 @@ NfcCommand mf_classic_poller_handler_nested_collect_nt_enc(MfClassicPoller* inst
     return command;
 }
 
+static uint32_t search_keys_for_nonce_key(
+    const MfClassicKey* keys,
+    size_t count,
+    MfClassicNestedNonceArray* nonce_array,
+    bool is_weak) {
+    Crypto1Bs bs;
+    uint32_t nt_plain[CRYPTO1_BS_LANES];
+
+    crypto1_bs_init(&bs, keys, count);
+    uint32_t match = bs.lanes;
+    for(uint8_t j = 0; j < nonce_array->count; j++) {
+        // Verify nonce matches encrypted parity bits for all nonces
+        match &= crypto1_bs_nonce_matches_encrypted_parity_bits(
+            &bs,
+            nonce_array->nonces[j].cuid,
+            nonce_array->nonces[j].nt_enc,
+            nonce_array->nonces[j].par,
+            is_weak ? nt_plain : NULL);
+        if(is_weak) {
+            for(uint32_t lanes = match; lanes; lanes &= lanes - 1) {
+                uint32_t lane = __builtin_ctz(lanes);
+                if(!crypto1_is_weak_prng_nonce(nt_plain[lane])) match &= ~(1UL << lane);
+            }
+        }
+        if(!match) break;
+    }
+
+    return match;
+}
+
 static MfClassicKey* search_dicts_for_nonce_key(
     MfClassicPollerDictAttackContext* dict_attack_ctx,
     MfClassicNestedNonceArray* nonce_array,
     KeysDict* system_dict,
     KeysDict* user_dict,
     bool is_weak) {
-    MfClassicKey stack_key;
+    // Keys are checked in bitsliced blocks, lane order follows dictionary order
+    MfClassicKey keys[CRYPTO1_BS_LANES];
     KeysDict* dicts[] = {user_dict, system_dict};
     bool is_resumed = dict_attack_ctx->nested_phase == MfClassicNestedPhaseDictAttackResume;
     bool found_resume_point = false;
@@ -1524,34 +1555,30 @@ static MfClassicKey* search_dicts_for_nonce_key(
     for(int i = 0; i < 2; i++) {
         if(!dicts[i]) continue;
         keys_dict_rewind(dicts[i]);
-        while(keys_dict_get_next_key(dicts[i], stack_key.data, sizeof(MfClassicKey))) {
+        size_t count = 0;
+        while((count = keys_dict_get_next_keys(
+                   dicts[i], (uint8_t*)keys, sizeof(MfClassicKey), CRYPTO1_BS_LANES)) > 0) {
             if(is_resumed && !found_resume_point) {
-                found_resume_point =
-                    (memcmp(
-                         dict_attack_ctx->current_key.data,
-                         stack_key.data,
-                         sizeof(MfClassicKey)) == 0);
-                continue;
-            }
-            bool full_match = true;
-            for(uint8_t j = 0; j < nonce_array->count; j++) {
-                // Verify nonce matches encrypted parity bits for all nonces
-                uint32_t nt_enc_plain = crypto1_decrypt_nt_enc(
-                    nonce_array->nonces[j].cuid, nonce_array->nonces[j].nt_enc, stack_key);
-                if(is_weak) {
-                    full_match &= crypto1_is_weak_prng_nonce(nt_enc_plain);
-                    if(!full_match) break;
+                size_t skip = 0;
+                while(skip < count && !found_resume_point) {
+                    found_resume_point =
+                        (memcmp(
+                             dict_attack_ctx->current_key.data,
+                             keys[skip].data,
+                             sizeof(MfClassicKey)) == 0);
+                    skip++;
                 }
-                full_match &= crypto1_nonce_matches_encrypted_parity_bits(
-                    nt_enc_plain,
-                    nt_enc_plain ^ nonce_array->nonces[j].nt_enc,
-                    nonce_array->nonces[j].par);
-                if(!full_match) break;
+                if(!found_resume_point) continue;
+                count -= skip;
+                memmove(keys, &keys[skip], count * sizeof(MfClassicKey));
+                if(count == 0) continue;
             }
-            if(full_match) {
+
+            uint32_t match = search_keys_for_nonce_key(keys, count, nonce_array, is_weak);
+            if(match) {
                 MfClassicKey* new_candidate = malloc(sizeof(MfClassicKey));
                 if(new_candidate == NULL) return NULL; // malloc failed
-                memcpy(new_candidate, &stack_key, sizeof(MfClassicKey));
+                memcpy(new_candidate, &keys[__builtin_ctz(match)], sizeof(MfClassicKey));
                 return new_candidate;
             }
         }
@@ -6,7 +6,7 @@
 
 #define TAG "MfDesfirePoller"
 
-#define MF_DESFIRE_BUF_SIZE        (64U)
+#define MF_DESFIRE_BUF_SIZE        (256U)
 #define MF_DESFIRE_RESULT_BUF_SIZE (512U)
 
 typedef NfcCommand (*MfDesfirePollerReadHandler)(MfDesfirePoller* instance);
@@ -52,6 +52,9 @@ static NfcCommand mf_desfire_poller_handler_idle(MfDesfirePoller* instance) {
     bit_buffer_reset(instance->tx_buffer);
     bit_buffer_reset(instance->rx_buffer);
 
+    instance->read_frame_count_start = instance->iso14443_4a_poller->frame_count;
+    instance->read_tick_start = furi_get_tick();
+
     iso14443_4a_copy(
         instance->data->iso14443_4a_data,
         iso14443_4a_poller_get_data(instance->iso14443_4a_poller));
@@ -179,6 +182,11 @@ static NfcCommand mf_desfire_poller_handler_read_fail(MfDesfirePoller* instance)
 
 static NfcCommand mf_desfire_poller_handler_read_success(MfDesfirePoller* instance) {
     FURI_LOG_D(TAG, "Read success.");
+    FURI_LOG_I(
+        TAG,
+        "Card read in %lu frames, %lu ms",
+        instance->iso14443_4a_poller->frame_count - instance->read_frame_count_start,
+        furi_get_tick() - instance->read_tick_start);
     iso14443_4a_poller_halt(instance->iso14443_4a_poller);
     instance->mf_desfire_event.type = MfDesfirePollerEventTypeReadSuccess;
     NfcCommand command = instance->callback(instance->general_event, instance->context);
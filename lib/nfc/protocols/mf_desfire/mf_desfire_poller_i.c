@@ -327,6 +327,7 @@ MfDesfireError mf_desfire_poller_read_file_settings_multi(
     return error;
 }
 
+// One read command for the whole file, additional frames are written straight into file data
 static MfDesfireError mf_desfire_poller_read_file(
     MfDesfirePoller* instance,
     MfDesfireFileId id,
@@ -339,37 +340,64 @@ static MfDesfireError mf_desfire_poller_read_file(
 
     MfDesfireError error = MfDesfireErrorNone;
     simple_array_init(data->data, size);
+    if(size == 0) return error;
 
-    size_t buffer_capacity = bit_buffer_get_capacity_bytes(instance->result_buffer);
-    uint32_t current_offset = offset;
-    uint32_t bytes_read = 0;
+    const uint32_t frame_count_start = instance->iso14443_4a_poller->frame_count;
+    const uint32_t tick_start = furi_get_tick();
 
-    while(bytes_read < size) {
-        size_t bytes_to_read = MIN(buffer_capacity, size - bytes_read);
-        bit_buffer_reset(instance->input_buffer);
-        bit_buffer_append_byte(instance->input_buffer, read_cmd);
-        bit_buffer_append_byte(instance->input_buffer, id);
-        bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&current_offset, 3);
-        bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&bytes_to_read, 3);
+    bit_buffer_reset(instance->input_buffer);
+    bit_buffer_append_byte(instance->input_buffer, read_cmd);
+    bit_buffer_append_byte(instance->input_buffer, id);
+    bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&offset, 3);
+    bit_buffer_append_bytes(instance->input_buffer, (const uint8_t*)&size, 3);
 
-        error = mf_desfire_send_chunks(instance, instance->input_buffer, instance->result_buffer);
-        if(error != MfDesfireErrorNone) break;
+    bit_buffer_reset(instance->tx_buffer);
+    bit_buffer_append_byte(instance->tx_buffer, MF_DESFIRE_STATUS_ADDITIONAL_FRAME);
+
+    uint8_t* file_data = simple_array_get_data(data->data);
+    const BitBuffer* tx_buffer = instance->input_buffer;
+    size_t bytes_read = 0;
+    uint8_t status_code = MF_DESFIRE_STATUS_ADDITIONAL_FRAME;
+
+    while(status_code == MF_DESFIRE_STATUS_ADDITIONAL_FRAME) {
+        Iso14443_4aError iso14443_4a_error = iso14443_4a_poller_send_block(
+            instance->iso14443_4a_poller, tx_buffer, instance->rx_buffer);
+        if(iso14443_4a_error != Iso14443_4aErrorNone) {
+            error = mf_desfire_process_error(iso14443_4a_error);
+            break;
+        }
 
-        size_t bytes_received = bit_buffer_get_size_bytes(instance->result_buffer);
-        if(bytes_received != bytes_to_read) {
-            FURI_LOG_W(TAG, "Read %zu out of %zu bytes", bytes_received, bytes_to_read);
+        const size_t rx_size = bit_buffer_get_size_bytes(instance->rx_buffer);
+        if(rx_size == 0 || bytes_read + rx_size - 1 > size) {
+            FURI_LOG_W(TAG, "Unexpected %zu bytes after %zu of %zu", rx_size, bytes_read, size);
             error = MfDesfireErrorProtocol;
             break;
         }
 
-        uint8_t* file_data = simple_array_get_data(data->data);
-        bit_buffer_write_bytes(instance->result_buffer, &file_data[current_offset], bytes_to_read);
-        bytes_read += bytes_to_read;
-        current_offset += bytes_to_read;
+        status_code = bit_buffer_get_byte(instance->rx_buffer, 0);
+        bit_buffer_write_bytes_mid(instance->rx_buffer, &file_data[bytes_read], 1, rx_size - 1);
+        bytes_read += rx_size - 1;
+        tx_buffer = instance->tx_buffer;
+    }
+
+    if(error == MfDesfireErrorNone) {
+        error = mf_desfire_process_status_code(status_code);
+    }
+    if(error == MfDesfireErrorNone && bytes_read != size) {
+        FURI_LOG_W(TAG, "Read %zu out of %zu bytes", bytes_read, size);
+        error = MfDesfireErrorProtocol;
     }
 
     if(error != MfDesfireErrorNone) {
         simple_array_reset(data->data);
+    } else {
+        FURI_LOG_D(
+            TAG,
+            "File %u: %zu bytes in %lu frames, %lu ms",
+            id,
+            size,
+            instance->iso14443_4a_poller->frame_count - frame_count_start,
+            furi_get_tick() - tick_start);
     }
 
     return error;
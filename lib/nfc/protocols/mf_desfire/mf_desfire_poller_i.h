@@ -38,6 +38,8 @@ struct MfDesfirePoller {
     BitBuffer* rx_buffer;
     BitBuffer* input_buffer;
     BitBuffer* result_buffer;
+    uint32_t read_frame_count_start;
+    uint32_t read_tick_start;
     MfDesfirePollerEventData mf_desfire_event_data;
     MfDesfirePollerEvent mf_desfire_event;
     NfcGenericEvent general_event;
@@ -71,6 +71,32 @@ static void mf_ultralight_listener_perform_read(
     mf_ultralight_single_counter_try_increase(instance);
 }
 
+static bool mf_ultralight_listener_send_cached_read(
+    MfUltralightListener* instance,
+    uint16_t start_page) {
+    bool sent = false;
+
+    do {
+        // Responses with restricted pages are assembled on request
+        bool access_success = true;
+        for(uint8_t i = 1; i < MF_ULTRALIGHT_READ_PAGE_CNT && access_success; i++) {
+            access_success = mf_ultralight_listener_check_access(
+                instance, start_page + i, MfUltralightListenerAccessTypeRead);
+        }
+        if(!access_success) break;
+
+        const uint8_t* frame = mf_ultralight_read_cache_get_frame(instance, start_page);
+        if(frame == NULL) break;
+
+        mf_ultralight_single_counter_try_increase(instance);
+        bit_buffer_copy_bytes(instance->tx_buffer, frame, sizeof(MfUltralightReadFrame));
+        iso14443_3a_listener_tx(instance->iso14443_3a_listener, instance->tx_buffer);
+        sent = true;
+    } while(false);
+
+    return sent;
+}
+
 static MfUltralightCommand mf_ultralight_listener_perform_write(
     MfUltralightListener* instance,
     const uint8_t* const rx_data,
@@ -93,6 +119,10 @@ static MfUltralightCommand mf_ultralight_listener_perform_write(
         memcpy(instance->data->page[page].data, rx_data, sizeof(MfUltralightPage));
     }
 
+    if(command == MfUltralightCommandProcessedACK) {
+        mf_ultralight_read_cache_invalidate(instance, start_page);
+    }
+
     return command;
 }
 
@@ -118,13 +148,16 @@ static MfUltralightCommand
             break;
         }
 
-        MfUltralightPage pages[4] = {};
-        mf_ultralight_listener_perform_read(pages, instance, start_page, 4, do_i2c_check);
+        command = MfUltralightCommandProcessed;
+        if(mf_ultralight_listener_send_cached_read(instance, start_page)) break;
+
+        MfUltralightPage pages[MF_ULTRALIGHT_READ_PAGE_CNT] = {};
+        mf_ultralight_listener_perform_read(
+            pages, instance, start_page, MF_ULTRALIGHT_READ_PAGE_CNT, do_i2c_check);
 
         bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, sizeof(pages));
         iso14443_3a_listener_send_standard_frame(
             instance->iso14443_3a_listener, instance->tx_buffer);
-        command = MfUltralightCommandProcessed;
 
     } while(false);
 
@@ -750,6 +783,7 @@ MfUltralightListener* mf_ultralight_listener_alloc(
     mf_ultralight_composite_command_reset(instance);
     instance->sector = 0;
     instance->tx_buffer = bit_buffer_alloc(MF_ULTRALIGHT_LISTENER_MAX_TX_BUFF_SIZE);
+    mf_ultralight_read_cache_prepare(instance);
 
     instance->mfu_event.data = &instance->mfu_event_data;
     instance->generic_event.protocol = NfcProtocolMfUltralight;
@@ -765,6 +799,19 @@ void mf_ultralight_listener_free(MfUltralightListener* instance) {
     furi_assert(instance->data);
     furi_assert(instance->tx_buffer);
 
+    if(instance->stats.responses) {
+        uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+        FURI_LOG_D(
+            TAG,
+            "%lu responses in %lu us avg, %lu us max. Read cache: %lu hits, %lu misses",
+            instance->stats.responses,
+            (uint32_t)(instance->stats.cycles_total / instance->stats.responses / cycles_per_us),
+            instance->stats.cycles_max / cycles_per_us,
+            instance->read_cache.hits,
+            instance->read_cache.misses);
+    }
+
+    mf_ultralight_read_cache_free(instance);
     bit_buffer_free(instance->tx_buffer);
     furi_string_free(instance->mirror.ascii_mirror_data);
     mbedtls_des3_free(&instance->des_context);
@@ -799,6 +846,7 @@ NfcCommand mf_ultralight_listener_run(NfcGenericEvent event, void* context) {
     NfcCommand command = NfcCommandContinue;
 
     if(iso14443_3a_event->type == Iso14443_3aListenerEventTypeReceivedStandardFrame) {
+        const uint32_t cycles_start = DWT->CYCCNT;
         MfUltralightCommand mfu_command = MfUltralightCommandNotFound;
         size_t size = bit_buffer_get_size(rx_buffer);
         uint8_t cmd = bit_buffer_get_byte(rx_buffer, 0);
@@ -815,6 +863,11 @@ NfcCommand mf_ultralight_listener_run(NfcGenericEvent event, void* context) {
             }
         }
         command = mf_ultralight_command_postprocess(mfu_command, instance);
+
+        const uint32_t cycles = DWT->CYCCNT - cycles_start;
+        instance->stats.responses++;
+        instance->stats.cycles_total += cycles;
+        instance->stats.cycles_max = MAX(instance->stats.cycles_max, cycles);
     } else if(
         iso14443_3a_event->type == Iso14443_3aListenerEventTypeReceivedData ||
         iso14443_3a_event->type == Iso14443_3aListenerEventTypeFieldOff ||
@@ -635,3 +635,85 @@ bool mf_ultralight_c_check_access(
 
     return access_success;
 }
+
+static void mf_ultralight_read_cache_fill(MfUltralightListener* instance, uint16_t start_page) {
+    MfUltralightReadCache* cache = &instance->read_cache;
+    MfUltralightPage pages[MF_ULTRALIGHT_READ_PAGE_CNT];
+
+    for(uint8_t i = 0; i < MF_ULTRALIGHT_READ_PAGE_CNT; i++) {
+        uint16_t page = start_page + i;
+        if(mf_ultralight_is_page_pwd_or_pack(instance->data->type, page)) {
+            memset(pages[i].data, 0, sizeof(MfUltralightPage));
+        } else {
+            pages[i] = instance->data->page[page % cache->pages_total];
+        }
+    }
+
+    bit_buffer_copy_bytes(instance->tx_buffer, (uint8_t*)pages, sizeof(pages));
+    iso14443_crc_append(Iso14443CrcTypeA, instance->tx_buffer);
+    bit_buffer_write_bytes(
+        instance->tx_buffer, cache->frames[start_page], sizeof(MfUltralightReadFrame));
+    FURI_BIT_SET(cache->valid[start_page / 32], start_page % 32);
+}
+
+void mf_ultralight_read_cache_prepare(MfUltralightListener* instance) {
+    MfUltralightReadCache* cache = &instance->read_cache;
+
+    // Page content of i2c tags depends on selected sector
+    if(mf_ultralight_is_i2c_tag(instance->data->type)) return;
+
+    cache->pages_total = instance->data->pages_total;
+    cache->frames = malloc(cache->pages_total * sizeof(MfUltralightReadFrame));
+    cache->valid = malloc((cache->pages_total + 31) / 32 * sizeof(uint32_t));
+
+    for(uint16_t i = 0; i < cache->pages_total; i++) {
+        mf_ultralight_read_cache_fill(instance, i);
+    }
+}
+
+void mf_ultralight_read_cache_free(MfUltralightListener* instance) {
+    MfUltralightReadCache* cache = &instance->read_cache;
+
+    free(cache->frames);
+    free(cache->valid);
+    cache->frames = NULL;
+    cache->valid = NULL;
+}
+
+const uint8_t*
+    mf_ultralight_read_cache_get_frame(MfUltralightListener* instance, uint16_t start_page) {
+    MfUltralightReadCache* cache = &instance->read_cache;
+    const uint8_t* frame = NULL;
+
+    do {
+        if(cache->frames == NULL || start_page >= cache->pages_total) break;
+
+        // Mirrored data changes with counter and authentication
+        if(mf_ultralight_support_feature(
+               instance->features, MfUltralightFeatureSupportAsciiMirror) &&
+           (instance->config != NULL) &&
+           (instance->config->mirror.mirror_conf != MfUltralightMirrorNone))
+            break;
+
+        if(FURI_BIT(cache->valid[start_page / 32], start_page % 32)) {
+            cache->hits++;
+        } else {
+            mf_ultralight_read_cache_fill(instance, start_page);
+            cache->misses++;
+        }
+        frame = cache->frames[start_page];
+    } while(false);
+
+    return frame;
+}
+
+void mf_ultralight_read_cache_invalidate(MfUltralightListener* instance, uint16_t page) {
+    MfUltralightReadCache* cache = &instance->read_cache;
+    if(cache->frames == NULL || page >= cache->pages_total) return;
+
+    // Page is a part of responses to READ from this page and from three pages before it
+    for(uint8_t i = 0; i < MF_ULTRALIGHT_READ_PAGE_CNT; i++) {
+        uint16_t start_page = (page + cache->pages_total - i) % cache->pages_total;
+        FURI_BIT_CLEAR(cache->valid[start_page / 32], start_page % 32);
+    }
+}
@@ -2,6 +2,7 @@
 
 #include "mf_ultralight_listener.h"
 #include <lib/nfc/protocols/iso14443_3a/iso14443_3a_listener.h>
+#include <nfc/helpers/iso14443_crc.h>
 #include <nfc/protocols/nfc_generic_event.h>
 
 #ifdef __cplusplus
@@ -47,6 +48,27 @@ typedef struct {
     FuriString* ascii_mirror_data;
 } MfUltralightMirrorMode;
 
+#define MF_ULTRALIGHT_READ_PAGE_CNT (4U)
+#define MF_ULTRALIGHT_READ_FRAME_SIZE \
+    (MF_ULTRALIGHT_READ_PAGE_CNT * MF_ULTRALIGHT_PAGE_SIZE + ISO14443_CRC_SIZE)
+
+typedef uint8_t MfUltralightReadFrame[MF_ULTRALIGHT_READ_FRAME_SIZE];
+
+// READ responses with CRC for every start page, ready to be sent as is
+typedef struct {
+    MfUltralightReadFrame* frames;
+    uint32_t* valid;
+    uint16_t pages_total;
+    uint32_t hits;
+    uint32_t misses;
+} MfUltralightReadCache;
+
+typedef struct {
+    uint32_t responses;
+    uint32_t cycles_max;
+    uint64_t cycles_total;
+} MfUltralightListenerStats;
+
 typedef uint16_t MfUltralightStaticLockData;
 typedef uint32_t MfUltralightDynamicLockData;
 
@@ -71,6 +93,8 @@ struct MfUltralightListener {
     mbedtls_des3_context des_context;
     uint8_t rndB[MF_ULTRALIGHT_C_AUTH_RND_BLOCK_SIZE];
     uint8_t encB[MF_ULTRALIGHT_C_AUTH_RND_BLOCK_SIZE];
+    MfUltralightReadCache read_cache;
+    MfUltralightListenerStats stats;
     void* context;
 };
 
@@ -95,6 +119,12 @@ bool mf_ultralight_composite_command_in_progress(MfUltralightListener* instance)
 MfUltralightCommand
     mf_ultralight_composite_command_run(MfUltralightListener* instance, BitBuffer* buffer);
 
+void mf_ultralight_read_cache_prepare(MfUltralightListener* instance);
+void mf_ultralight_read_cache_free(MfUltralightListener* instance);
+const uint8_t*
+    mf_ultralight_read_cache_get_frame(MfUltralightListener* instance, uint16_t start_page);
+void mf_ultralight_read_cache_invalidate(MfUltralightListener* instance, uint16_t page);
+
 bool mf_ultralight_is_i2c_tag(MfUltralightType type);
 bool mf_ultralight_i2c_validate_pages(
     uint16_t start_page,
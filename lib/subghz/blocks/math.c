@@ -1,5 +1,7 @@
 #include "math.h"
 
+#include <toolbox/crc.h>
+
 uint64_t subghz_protocol_blocks_reverse_key(uint64_t key, uint8_t bit_count) {
     uint64_t reverse_key = 0;
     for(uint8_t i = 0; i < bit_count; i++) {
@@ -105,6 +107,14 @@ uint16_t subghz_protocol_blocks_crc16lsb(
     size_t size,
     uint16_t polynomial,
     uint16_t init) {
+    // Reflected CCITT polynomial has a table driven implementation
+    if(polynomial == 0x8408) {
+        CrcContext context;
+        crc_resume(&context, CrcAlgorithmPicopass, CrcBackendSoftware, init);
+        crc_update(&context, message, size);
+        return crc_finish(&context);
+    }
+
     uint16_t remainder = init;
 
     for(size_t byte = 0; byte < size; ++byte) {
@@ -125,6 +135,14 @@ uint16_t subghz_protocol_blocks_crc16(
     size_t size,
     uint16_t polynomial,
     uint16_t init) {
+    // CCITT polynomial has a table driven implementation
+    if(polynomial == 0x1021) {
+        CrcContext context;
+        crc_resume(&context, CrcAlgorithmFelica, CrcBackendSoftware, init);
+        crc_update(&context, message, size);
+        return crc_finish(&context);
+    }
+
     uint16_t remainder = init;
 
     for(size_t byte = 0; byte < size; ++byte) {
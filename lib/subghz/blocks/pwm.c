@@ -0,0 +1,223 @@
+#include "pwm.h"
+#include "math.h"
+
+#include <furi.h>
+
+struct SubGhzBlockPwmTable {
+    size_t count; // Frame descriptions
+    size_t interval_count;
+    uint32_t* boundary; // Start of every interval, ascending, the first one is 0
+    uint8_t* classes; // interval_count rows of count classes
+};
+
+typedef struct {
+    uint32_t duration;
+    uint32_t delta;
+} SubGhzBlockPwmWindow;
+
+static void subghz_block_pwm_get_windows(
+    const SubGhzBlockPwmConst* pwm,
+    SubGhzBlockPwmWindow* header,
+    SubGhzBlockPwmWindow* start,
+    SubGhzBlockPwmWindow* te_short,
+    SubGhzBlockPwmWindow* te_long) {
+    const uint32_t te_delta = pwm->timing->te_delta;
+    header->duration = (uint32_t)pwm->timing->te_short * pwm->header_short;
+    header->delta = te_delta * pwm->header_delta;
+    start->duration = (uint32_t)pwm->timing->te_short * pwm->start_short;
+    start->delta = te_delta * pwm->start_delta;
+    te_short->duration = pwm->timing->te_short;
+    te_short->delta = te_delta;
+    te_long->duration = pwm->timing->te_long;
+    te_long->delta = te_delta * pwm->long_delta;
+}
+
+static inline uint32_t subghz_block_pwm_get_gap(const SubGhzBlockPwmConst* pwm) {
+    return (uint32_t)pwm->timing->te_short * pwm->gap_short +
+           (uint32_t)pwm->timing->te_delta * pwm->gap_delta;
+}
+
+static inline bool
+    subghz_block_pwm_window_match(const SubGhzBlockPwmWindow* window, uint32_t duration) {
+    return DURATION_DIFF(duration, window->duration) < window->delta;
+}
+
+uint8_t subghz_block_pwm_get_class(const SubGhzBlockPwmConst* pwm, uint32_t duration) {
+    furi_assert(pwm);
+    SubGhzBlockPwmWindow header, start, te_short, te_long;
+    subghz_block_pwm_get_windows(pwm, &header, &start, &te_short, &te_long);
+
+    uint8_t pulse_class = SubGhzBlockPwmClassNone;
+    if(subghz_block_pwm_window_match(&header, duration)) pulse_class |= SubGhzBlockPwmClassHeader;
+    if(subghz_block_pwm_window_match(&start, duration)) pulse_class |= SubGhzBlockPwmClassStart;
+    if(subghz_block_pwm_window_match(&te_short, duration))
+        pulse_class |= SubGhzBlockPwmClassShort;
+    if(subghz_block_pwm_window_match(&te_long, duration)) pulse_class |= SubGhzBlockPwmClassLong;
+    if(duration >= subghz_block_pwm_get_gap(pwm)) pulse_class |= SubGhzBlockPwmClassGap;
+    return pulse_class;
+}
+
+bool subghz_block_pwm_feed_class(
+    const SubGhzBlockPwmConst* pwm,
+    SubGhzBlockDecoder* decoder,
+    bool level,
+    uint8_t pulse_class) {
+    furi_assert(pwm);
+    furi_assert(decoder);
+    bool frame_end = false;
+
+    switch(decoder->parser_step) {
+    case SubGhzBlockPwmStepReset:
+        if((!level) && (pulse_class & SubGhzBlockPwmClassHeader)) {
+            decoder->parser_step = SubGhzBlockPwmStepFoundStartBit;
+        }
+        break;
+    case SubGhzBlockPwmStepFoundStartBit:
+        if(level && (pulse_class & SubGhzBlockPwmClassStart)) {
+            decoder->parser_step = SubGhzBlockPwmStepSaveDuration;
+            decoder->decode_data = 0;
+            decoder->decode_count_bit = 0;
+        } else if(level || !(pwm->flags & SubGhzBlockPwmFlagStartSkipLow)) {
+            decoder->parser_step = SubGhzBlockPwmStepReset;
+        }
+        break;
+    case SubGhzBlockPwmStepSaveDuration:
+        if(!level) {
+            if(pulse_class & SubGhzBlockPwmClassGap) {
+                if(!(pwm->flags & SubGhzBlockPwmFlagEndAfterCallback)) {
+                    decoder->parser_step = SubGhzBlockPwmStepFoundStartBit;
+                }
+                frame_end = true;
+            } else {
+                decoder->te_last = pulse_class;
+                decoder->parser_step = SubGhzBlockPwmStepCheckDuration;
+            }
+        } else if(!(pwm->flags & SubGhzBlockPwmFlagBitSkipHigh)) {
+            decoder->parser_step = SubGhzBlockPwmStepReset;
+        }
+        break;
+    case SubGhzBlockPwmStepCheckDuration:
+        if(level) {
+            const uint8_t inverted = (pwm->flags & SubGhzBlockPwmFlagInverted) ? 1 : 0;
+            if((decoder->te_last & SubGhzBlockPwmClassShort) &&
+               (pulse_class & SubGhzBlockPwmClassLong)) {
+                subghz_protocol_blocks_add_bit(decoder, 0 ^ inverted);
+                decoder->parser_step = SubGhzBlockPwmStepSaveDuration;
+            } else if(
+                (decoder->te_last & SubGhzBlockPwmClassLong) &&
+                (pulse_class & SubGhzBlockPwmClassShort)) {
+                subghz_protocol_blocks_add_bit(decoder, 1 ^ inverted);
+                decoder->parser_step = SubGhzBlockPwmStepSaveDuration;
+            } else {
+                decoder->parser_step = SubGhzBlockPwmStepReset;
+            }
+        } else {
+            decoder->parser_step = SubGhzBlockPwmStepReset;
+        }
+        break;
+    }
+
+    return frame_end;
+}
+
+bool subghz_block_pwm_feed(
+    const SubGhzBlockPwmConst* pwm,
+    SubGhzBlockDecoder* decoder,
+    bool level,
+    uint32_t duration) {
+    return subghz_block_pwm_feed_class(
+        pwm, decoder, level, subghz_block_pwm_get_class(pwm, duration));
+}
+
+void subghz_block_pwm_end_frame(SubGhzBlockDecoder* decoder) {
+    furi_assert(decoder);
+    decoder->decode_data = 0;
+    decoder->decode_count_bit = 0;
+    decoder->parser_step = SubGhzBlockPwmStepFoundStartBit;
+}
+
+void subghz_block_pwm_get_wake_window(
+    const SubGhzBlockPwmConst* pwm,
+    SubGhzDecoderWakeWindow* window) {
+    furi_assert(pwm);
+    furi_assert(window);
+    window->duration = (uint32_t)pwm->timing->te_short * pwm->header_short;
+    window->delta = (uint32_t)pwm->timing->te_delta * pwm->header_delta;
+}
+
+static int subghz_block_pwm_boundary_compare(const void* a, const void* b) {
+    uint32_t left = *(const uint32_t*)a;
+    uint32_t right = *(const uint32_t*)b;
+    return (left > right) - (left < right);
+}
+
+static size_t subghz_block_pwm_add_window(uint32_t* boundary, const SubGhzBlockPwmWindow* window) {
+    // DURATION_DIFF(duration, window) < delta is [duration - delta + 1, duration + delta)
+    if(!window->delta) return 0;
+    boundary[0] = (window->duration >= window->delta) ? window->duration - window->delta + 1 : 0;
+    boundary[1] = window->duration + window->delta;
+    return 2;
+}
+
+SubGhzBlockPwmTable*
+    subghz_block_pwm_table_alloc(const SubGhzBlockPwmConst* const* pwm, size_t count) {
+    furi_check(pwm || !count);
+    SubGhzBlockPwmTable* table = malloc(sizeof(SubGhzBlockPwmTable));
+    table->count = count;
+
+    // 0, 2 edges of 4 windows and the gap of every description
+    table->boundary = malloc((1 + count * 9) * sizeof(uint32_t));
+    size_t boundary_count = 0;
+    table->boundary[boundary_count++] = 0;
+    for(size_t i = 0; i < count; i++) {
+        SubGhzBlockPwmWindow window[4];
+        subghz_block_pwm_get_windows(pwm[i], &window[0], &window[1], &window[2], &window[3]);
+        for(size_t w = 0; w < COUNT_OF(window); w++) {
+            boundary_count +=
+                subghz_block_pwm_add_window(&table->boundary[boundary_count], &window[w]);
+        }
+        table->boundary[boundary_count++] = subghz_block_pwm_get_gap(pwm[i]);
+    }
+
+    qsort(table->boundary, boundary_count, sizeof(uint32_t), subghz_block_pwm_boundary_compare);
+    table->interval_count = 0;
+    for(size_t i = 0; i < boundary_count; i++) {
+        if(!table->interval_count ||
+           table->boundary[table->interval_count - 1] != table->boundary[i]) {
+            table->boundary[table->interval_count++] = table->boundary[i];
+        }
+    }
+
+    // Classes do not change inside an interval, its start stands for all of it
+    table->classes = malloc(table->interval_count * (count ? count : 1));
+    for(size_t interval = 0; interval < table->interval_count; interval++) {
+        for(size_t i = 0; i < count; i++) {
+            table->classes[interval * count + i] =
+                subghz_block_pwm_get_class(pwm[i], table->boundary[interval]);
+        }
+    }
+
+    return table;
+}
+
+void subghz_block_pwm_table_free(SubGhzBlockPwmTable* table) {
+    furi_check(table);
+    free(table->classes);
+    free(table->boundary);
+    free(table);
+}
+
+const uint8_t*
+    subghz_block_pwm_table_get_classes(const SubGhzBlockPwmTable* table, uint32_t duration) {
+    furi_assert(table);
+    // Last interval that starts at or before duration, boundary[0] is 0.
+    // Branchless halving, durations off the air are not predictable.
+    const uint32_t* interval = table->boundary;
+    size_t length = table->interval_count;
+    while(length > 1) {
+        size_t half = length / 2;
+        interval = (interval[half] <= duration) ? interval + half : interval;
+        length -= half;
+    }
+    return &table->classes[(interval - table->boundary) * table->count];
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "const.h"
+#include "decoder.h"
+#include "../types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Generic decoder for the common OOK PWM frame family:
+ *
+ * - header: long low pulse
+ * - start bit: high pulse
+ * - bits: low pulse followed by high pulse,
+ *   short + long is bit 0, long + short is bit 1
+ * - end of frame: low pulse not shorter than the gap
+ *
+ * All durations are multiples of SubGhzBlockConst timings, so a protocol only
+ * describes its frame and keeps its own acceptance rules.
+ */
+
+typedef enum {
+    SubGhzBlockPwmStepReset = 0,
+    SubGhzBlockPwmStepFoundStartBit,
+    SubGhzBlockPwmStepSaveDuration,
+    SubGhzBlockPwmStepCheckDuration,
+} SubGhzBlockPwmStep;
+
+typedef enum {
+    SubGhzBlockPwmFlagNone = 0,
+    /** Low pulses are skipped while waiting for the start bit instead of resetting */
+    SubGhzBlockPwmFlagStartSkipLow = (1 << 0),
+    /** High pulses are skipped while waiting for the low part of a bit instead of resetting */
+    SubGhzBlockPwmFlagBitSkipHigh = (1 << 1),
+    /** Short + long is bit 1, long + short is bit 0 */
+    SubGhzBlockPwmFlagInverted = (1 << 2),
+    /** Frame end leaves the state to subghz_block_pwm_end_frame, called after the callback */
+    SubGhzBlockPwmFlagEndAfterCallback = (1 << 3),
+} SubGhzBlockPwmFlag;
+
+typedef enum {
+    SubGhzBlockPwmClassNone = 0,
+    SubGhzBlockPwmClassHeader = (1 << 0), /**< Header low duration */
+    SubGhzBlockPwmClassStart = (1 << 1), /**< Start bit high duration */
+    SubGhzBlockPwmClassShort = (1 << 2), /**< te_short */
+    SubGhzBlockPwmClassLong = (1 << 3), /**< te_long */
+    SubGhzBlockPwmClassGap = (1 << 4), /**< End of frame gap */
+} SubGhzBlockPwmClass;
+
+typedef struct SubGhzBlockPwmConst {
+    const SubGhzBlockConst* timing; /**< te_short, te_long, te_delta */
+    uint8_t header_short; /**< Header low: te_short * header_short */
+    uint8_t header_delta; /**< Header tolerance: te_delta * header_delta */
+    uint8_t start_short; /**< Start bit high: te_short * start_short */
+    uint8_t start_delta; /**< Start bit tolerance: te_delta * start_delta */
+    uint8_t long_delta; /**< te_long tolerance: te_delta * long_delta */
+    uint8_t gap_short; /**< Gap low: at least te_short * gap_short + te_delta * gap_delta */
+    uint8_t gap_delta;
+    uint8_t flags; /**< SubGhzBlockPwmFlag */
+} SubGhzBlockPwmConst;
+
+/**
+ * Classify a duration against a frame description.
+ * @param pwm Pointer to a SubGhzBlockPwmConst frame description
+ * @param duration Duration of a level in, us
+ * @return SubGhzBlockPwmClass bits of all durations it matches
+ */
+uint8_t subghz_block_pwm_get_class(const SubGhzBlockPwmConst* pwm, uint32_t duration);
+
+/**
+ * Feed one classified pulse to the frame state machine.
+ * Same as subghz_block_pwm_feed, decoder->te_last holds the class of the low
+ * part of a bit instead of its duration.
+ * @param pwm Pointer to a SubGhzBlockPwmConst frame description
+ * @param decoder Pointer to a SubGhzBlockDecoder instance
+ * @param level Signal level true-high false-low
+ * @param pulse_class Class of the duration, see subghz_block_pwm_get_class
+ * @return true if a gap ended the frame, the caller checks bit count and data
+ */
+bool subghz_block_pwm_feed_class(
+    const SubGhzBlockPwmConst* pwm,
+    SubGhzBlockDecoder* decoder,
+    bool level,
+    uint8_t pulse_class);
+
+/**
+ * Feed one pulse to the frame state machine.
+ * Bits are accumulated in decoder->decode_data and decoder->decode_count_bit,
+ * they stay valid until the next start bit.
+ * @param pwm Pointer to a SubGhzBlockPwmConst frame description
+ * @param decoder Pointer to a SubGhzBlockDecoder instance
+ * @param level Signal level true-high false-low
+ * @param duration Duration of this level in, us
+ * @return true if a gap ended the frame, the caller checks bit count and data
+ */
+bool subghz_block_pwm_feed(
+    const SubGhzBlockPwmConst* pwm,
+    SubGhzBlockDecoder* decoder,
+    bool level,
+    uint32_t duration);
+
+/**
+ * Wait for the start bit of the next frame, clear the frame data.
+ * Decoders with SubGhzBlockPwmFlagEndAfterCallback call it when feed returns
+ * true, after their callback, so a receiver reset there keeps repeat frames.
+ * @param decoder Pointer to a SubGhzBlockDecoder instance
+ */
+void subghz_block_pwm_end_frame(SubGhzBlockDecoder* decoder);
+
+/**
+ * Get durations that move the state machine out of SubGhzBlockPwmStepReset.
+ * @param pwm Pointer to a SubGhzBlockPwmConst frame description
+ * @param window Output wake window
+ */
+void subghz_block_pwm_get_wake_window(
+    const SubGhzBlockPwmConst* pwm,
+    SubGhzDecoderWakeWindow* window);
+
+/** Classification of durations against several frame descriptions at once */
+typedef struct SubGhzBlockPwmTable SubGhzBlockPwmTable;
+
+/**
+ * Allocate a classification table.
+ * Window edges of all descriptions split durations into intervals with the
+ * same classes, so a duration is classified with one binary search.
+ * @param pwm Array of SubGhzBlockPwmConst frame descriptions
+ * @param count Number of frame descriptions
+ * @return SubGhzBlockPwmTable* pointer to a SubGhzBlockPwmTable instance
+ */
+SubGhzBlockPwmTable*
+    subghz_block_pwm_table_alloc(const SubGhzBlockPwmConst* const* pwm, size_t count);
+
+/**
+ * Free a classification table.
+ * @param table Pointer to a SubGhzBlockPwmTable instance
+ */
+void subghz_block_pwm_table_free(SubGhzBlockPwmTable* table);
+
+/**
+ * Classify a duration against all frame descriptions of the table.
+ * @param table Pointer to a SubGhzBlockPwmTable instance
+ * @param duration Duration of a level in, us
+ * @return Classes of the duration, one per frame description in table order
+ */
+const uint8_t*
+    subghz_block_pwm_table_get_classes(const SubGhzBlockPwmTable* table, uint32_t duration);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,11 +1,22 @@
 #include "registry.h"
 
 #include "cc1101_int/cc1101_int_interconnect.h"
+#include "replay/replay_interconnect.h"
 #include <flipper_application/plugins/plugin_manager.h>
 #include <loader/firmware_api/firmware_api.h>
 
 #define TAG "SubGhzDeviceRegistry"
 
+static const SubGhzDevice* const subghz_device_registry_builtin[] = {
+    &subghz_device_cc1101_int,
+#if defined(FW_CFG_unit_tests) || defined(FURI_DEBUG)
+    // Serves recordings instead of the air, not for release builds
+    &subghz_device_replay,
+#endif
+};
+
+#define SUBGHZ_DEVICE_REGISTRY_BUILTIN_COUNT COUNT_OF(subghz_device_registry_builtin)
+
 struct SubGhzDeviceRegistry {
     const SubGhzDevice** items;
     size_t size;
@@ -29,12 +40,16 @@ void subghz_device_registry_init(void) {
         FURI_LOG_E(TAG, "Failed to load all libs");
     }
 
-    subghz_device->size = plugin_manager_get_count(subghz_device->manager) + 1;
+    subghz_device->size =
+        plugin_manager_get_count(subghz_device->manager) + SUBGHZ_DEVICE_REGISTRY_BUILTIN_COUNT;
     subghz_device->items =
         (const SubGhzDevice**)malloc(sizeof(SubGhzDevice*) * subghz_device->size);
-    subghz_device->items[0] = &subghz_device_cc1101_int;
-    for(uint32_t i = 1; i < subghz_device->size; i++) {
-        const SubGhzDevice* plugin = plugin_manager_get_ep(subghz_device->manager, i - 1);
+    for(uint32_t i = 0; i < SUBGHZ_DEVICE_REGISTRY_BUILTIN_COUNT; i++) {
+        subghz_device->items[i] = subghz_device_registry_builtin[i];
+    }
+    for(uint32_t i = SUBGHZ_DEVICE_REGISTRY_BUILTIN_COUNT; i < subghz_device->size; i++) {
+        const SubGhzDevice* plugin = plugin_manager_get_ep(
+            subghz_device->manager, i - SUBGHZ_DEVICE_REGISTRY_BUILTIN_COUNT);
         subghz_device->items[i] = plugin;
     }
 
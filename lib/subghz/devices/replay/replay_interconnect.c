@@ -0,0 +1,418 @@
+#include "replay_interconnect.h"
+#include "../../subghz_file_encoder_worker.h"
+#include <furi_hal.h>
+
+#define TAG "SubGhzDeviceReplay"
+
+#define SUBGHZ_DEVICE_REPLAY_STACK_SIZE   4096
+#define SUBGHZ_DEVICE_REPLAY_LATE_US      2000 // Pacing is tick based, above that is a real delay
+#define SUBGHZ_DEVICE_REPLAY_OPEN_TIMEOUT 1000 // ms
+#define SUBGHZ_DEVICE_REPLAY_RSSI_RX      (-60.0f)
+#define SUBGHZ_DEVICE_REPLAY_RSSI_IDLE    (-100.0f)
+
+typedef struct {
+    uint32_t last;
+    uint64_t cycles;
+} SubGhzDeviceReplayClock;
+
+typedef struct {
+    FuriString* file_path;
+    uint32_t speed;
+    uint32_t frequency;
+
+    FuriThread* thread;
+    volatile bool running;
+    volatile bool rx_active;
+    volatile bool rx_complete;
+    volatile bool tx_complete;
+
+    FuriHalSubGhzCaptureCallback rx_callback;
+    void* rx_context;
+    FuriHalSubGhzAsyncTxCallback tx_callback;
+    void* tx_context;
+
+    int32_t* tx_buffer;
+    size_t tx_buffer_size;
+
+    SubGhzDeviceReplayStats stats;
+} SubGhzDeviceReplay;
+
+static SubGhzDeviceReplay* subghz_device_replay_instance = NULL;
+
+static void subghz_device_replay_clock_start(SubGhzDeviceReplayClock* clock) {
+    clock->last = DWT->CYCCNT;
+    clock->cycles = 0;
+}
+
+static uint64_t subghz_device_replay_clock_get_us(SubGhzDeviceReplayClock* clock) {
+    // Polled often enough for the 32 bit counter to never wrap twice
+    uint32_t now = DWT->CYCCNT;
+    clock->cycles += now - clock->last;
+    clock->last = now;
+    return clock->cycles / furi_hal_cortex_instructions_per_microsecond();
+}
+
+/** Sleep until the deadline
+ *
+ * Sleeps whole ticks only, pulses due within the current tick are delivered in
+ * a burst. This leaves the CPU to the consumers between bursts the same way an
+ * interrupt driven radio does.
+ *
+ * @return lateness, us
+ */
+static uint32_t subghz_device_replay_wait(SubGhzDeviceReplayClock* clock, uint64_t deadline) {
+    uint64_t now = subghz_device_replay_clock_get_us(clock);
+    if(deadline > now + 1000) {
+        furi_delay_ms((deadline - now) / 1000);
+        now = subghz_device_replay_clock_get_us(clock);
+    }
+    return (now > deadline) ? (now - deadline) : 0;
+}
+
+static int32_t subghz_device_replay_rx_thread(void* context) {
+    SubGhzDeviceReplay* instance = context;
+    SubGhzDeviceReplayStats* stats = &instance->stats;
+    SubGhzFileEncoderWorker* worker = subghz_file_encoder_worker_alloc();
+    SubGhzDeviceReplayClock clock;
+    uint64_t deadline = 0;
+    uint32_t start = furi_get_tick();
+
+    subghz_file_encoder_worker_start(worker, furi_string_get_cstr(instance->file_path), NULL);
+    subghz_device_replay_clock_start(&clock);
+
+    while(instance->running) {
+        LevelDuration level_duration = subghz_file_encoder_worker_get_level_duration(worker);
+        if(level_duration_is_reset(level_duration)) {
+            instance->rx_complete = true;
+            break;
+        } else if(level_duration_is_wait(level_duration)) {
+            // Worker gives no sign when the file can not be read
+            if(!stats->rx_pulse_count &&
+               (furi_get_tick() - start) > furi_ms_to_ticks(SUBGHZ_DEVICE_REPLAY_OPEN_TIMEOUT)) {
+                FURI_LOG_E(TAG, "Unable to read %s", furi_string_get_cstr(instance->file_path));
+                break;
+            }
+            furi_delay_tick(1);
+            continue;
+        }
+
+        bool level = level_duration_get_level(level_duration);
+        uint32_t duration = level_duration_get_duration(level_duration);
+        if(instance->speed) {
+            deadline += duration / instance->speed;
+            uint32_t late = subghz_device_replay_wait(&clock, deadline);
+            if(late > SUBGHZ_DEVICE_REPLAY_LATE_US) stats->rx_late_count++;
+            if(late > stats->rx_late_max) stats->rx_late_max = late;
+        }
+        instance->rx_callback(level, duration, instance->rx_context);
+        stats->rx_pulse_count++;
+    }
+
+    SubGhzFileEncoderWorkerStats worker_stats;
+    subghz_file_encoder_worker_get_stats(worker, &worker_stats);
+    stats->rx_source_underrun_count = worker_stats.underrun_count;
+
+    if(subghz_file_encoder_worker_is_running(worker)) {
+        subghz_file_encoder_worker_stop(worker);
+    }
+    subghz_file_encoder_worker_free(worker);
+    return 0;
+}
+
+static inline void
+    subghz_device_replay_tx_put(SubGhzDeviceReplay* instance, bool level, uint32_t duration) {
+    uint32_t idx = instance->stats.tx_sample_count++;
+    if(idx < instance->tx_buffer_size) {
+        instance->tx_buffer[idx] = level ? (int32_t)duration : -(int32_t)duration;
+    }
+}
+
+static int32_t subghz_device_replay_tx_thread(void* context) {
+    SubGhzDeviceReplay* instance = context;
+    SubGhzDeviceReplayStats* stats = &instance->stats;
+    SubGhzDeviceReplayClock clock;
+    uint64_t deadline = 0;
+    uint64_t budget = 0;
+    bool started = false;
+    bool level = false;
+    uint32_t duration = 0;
+    bool done = false;
+
+    subghz_device_replay_clock_start(&clock);
+
+    // Same as the DMA of a real radio: fill half of the buffer while the other half is on air,
+    // with consecutive durations of the same level merged and leading low level skipped
+    while(instance->running && !done) {
+        uint32_t refill_start = DWT->CYCCNT;
+        uint64_t airtime = 0;
+        size_t samples = 0;
+
+        while(samples < FURI_HAL_SUBGHZ_ASYNC_TX_BUFFER_HALF) {
+            LevelDuration level_duration = instance->tx_callback(instance->tx_context);
+            bool sample_level = false;
+            uint32_t sample_duration = FURI_HAL_SUBGHZ_ASYNC_TX_GUARD_TIME;
+
+            if(level_duration_is_reset(level_duration)) {
+                done = true;
+                break;
+            } else if(!level_duration_is_wait(level_duration)) {
+                sample_level = level_duration_get_level(level_duration);
+                sample_duration = level_duration_get_duration(level_duration);
+            }
+
+            if(!started) {
+                if(!sample_level) continue;
+                started = true;
+                level = true;
+            }
+            if(sample_level == level) {
+                duration += sample_duration;
+                continue;
+            }
+
+            subghz_device_replay_tx_put(instance, level, duration);
+            airtime += duration;
+            samples++;
+            level = sample_level;
+            duration = sample_duration;
+        }
+        if(done && started) {
+            subghz_device_replay_tx_put(instance, level, duration);
+            airtime += duration;
+        }
+
+        uint32_t refill_time =
+            (DWT->CYCCNT - refill_start) / furi_hal_cortex_instructions_per_microsecond();
+        stats->tx_refill_count++;
+        if(refill_time > stats->tx_refill_max) stats->tx_refill_max = refill_time;
+        // First half is filled before the transmission starts
+        if(stats->tx_refill_count > 1 && refill_time > budget) stats->tx_underrun_count++;
+        budget = airtime;
+
+        if(instance->speed) {
+            deadline += airtime / instance->speed;
+            subghz_device_replay_wait(&clock, deadline);
+        }
+    }
+
+    instance->tx_complete = true;
+    return 0;
+}
+
+static void subghz_device_replay_thread_start(FuriThreadCallback callback, bool realtime) {
+    SubGhzDeviceReplay* instance = subghz_device_replay_instance;
+    furi_check(instance);
+    furi_check(!instance->thread);
+
+    instance->running = true;
+    instance->thread =
+        furi_thread_alloc_ex(TAG, SUBGHZ_DEVICE_REPLAY_STACK_SIZE, callback, instance);
+    // Paced replay stands in for an interrupt, unpaced one must not starve the consumers
+    if(realtime) furi_thread_set_priority(instance->thread, FuriThreadPriorityHigh);
+    furi_thread_start(instance->thread);
+}
+
+static void subghz_device_replay_thread_stop(void) {
+    SubGhzDeviceReplay* instance = subghz_device_replay_instance;
+    if(!instance || !instance->thread) return;
+
+    instance->running = false;
+    furi_thread_join(instance->thread);
+    furi_thread_free(instance->thread);
+    instance->thread = NULL;
+}
+
+static bool subghz_device_replay_interconnect_begin(SubGhzDeviceConf* conf) {
+    UNUSED(conf);
+    if(!subghz_device_replay_instance) {
+        subghz_device_replay_instance = malloc(sizeof(SubGhzDeviceReplay));
+        subghz_device_replay_instance->file_path = furi_string_alloc();
+        subghz_device_replay_instance->speed = 1;
+    }
+    return true;
+}
+
+static void subghz_device_replay_interconnect_end(void) {
+    if(!subghz_device_replay_instance) return;
+
+    subghz_device_replay_thread_stop();
+    furi_string_free(subghz_device_replay_instance->file_path);
+    free(subghz_device_replay_instance);
+    subghz_device_replay_instance = NULL;
+}
+
+static bool subghz_device_replay_interconnect_is_connect(void) {
+    return true;
+}
+
+static void subghz_device_replay_interconnect_dummy(void) {
+}
+
+static void subghz_device_replay_interconnect_load_preset(
+    FuriHalSubGhzPreset preset,
+    uint8_t* preset_data) {
+    UNUSED(preset);
+    UNUSED(preset_data);
+}
+
+static uint32_t subghz_device_replay_interconnect_set_frequency(uint32_t frequency) {
+    furi_check(subghz_device_replay_instance);
+    subghz_device_replay_instance->frequency = frequency;
+    return frequency;
+}
+
+static void subghz_device_replay_interconnect_set_async_mirror_pin(const GpioPin* gpio) {
+    UNUSED(gpio);
+}
+
+static const GpioPin* subghz_device_replay_interconnect_get_data_gpio(void) {
+    return NULL;
+}
+
+static bool subghz_device_replay_interconnect_set_tx(void) {
+    return true;
+}
+
+static bool subghz_device_replay_interconnect_start_async_tx(void* callback, void* context) {
+    furi_check(subghz_device_replay_instance);
+    furi_check(callback);
+
+    SubGhzDeviceReplay* instance = subghz_device_replay_instance;
+    instance->tx_callback = callback;
+    instance->tx_context = context;
+    instance->tx_complete = false;
+    instance->stats.tx_sample_count = 0;
+    instance->stats.tx_refill_count = 0;
+    instance->stats.tx_underrun_count = 0;
+    instance->stats.tx_refill_max = 0;
+    subghz_device_replay_thread_start(subghz_device_replay_tx_thread, instance->speed != 0);
+    return true;
+}
+
+static bool subghz_device_replay_interconnect_is_async_complete_tx(void) {
+    furi_check(subghz_device_replay_instance);
+    return subghz_device_replay_instance->tx_complete;
+}
+
+static void subghz_device_replay_interconnect_start_async_rx(void* callback, void* context) {
+    furi_check(subghz_device_replay_instance);
+    furi_check(callback);
+
+    SubGhzDeviceReplay* instance = subghz_device_replay_instance;
+    instance->rx_callback = callback;
+    instance->rx_context = context;
+    instance->rx_complete = false;
+    instance->rx_active = true;
+    instance->stats.rx_pulse_count = 0;
+    instance->stats.rx_late_count = 0;
+    instance->stats.rx_late_max = 0;
+    instance->stats.rx_source_underrun_count = 0;
+    subghz_device_replay_thread_start(subghz_device_replay_rx_thread, instance->speed != 0);
+}
+
+static void subghz_device_replay_interconnect_stop_async_rx(void) {
+    subghz_device_replay_thread_stop();
+    if(subghz_device_replay_instance) subghz_device_replay_instance->rx_active = false;
+}
+
+static float subghz_device_replay_interconnect_get_rssi(void) {
+    return (subghz_device_replay_instance && subghz_device_replay_instance->rx_active) ?
+               SUBGHZ_DEVICE_REPLAY_RSSI_RX :
+               SUBGHZ_DEVICE_REPLAY_RSSI_IDLE;
+}
+
+static uint8_t subghz_device_replay_interconnect_get_lqi(void) {
+    return 0;
+}
+
+static bool subghz_device_replay_interconnect_rx_pipe_not_empty(void) {
+    return false;
+}
+
+static bool subghz_device_replay_interconnect_is_rx_data_crc_valid(void) {
+    return false;
+}
+
+static void subghz_device_replay_interconnect_read_packet(uint8_t* data, uint8_t* size) {
+    UNUSED(data);
+    *size = 0;
+}
+
+static void subghz_device_replay_interconnect_write_packet(const uint8_t* data, uint8_t size) {
+    UNUSED(data);
+    UNUSED(size);
+}
+
+static SubGhzTx subghz_device_replay_interconnect_check_tx(uint32_t frequency) {
+    UNUSED(frequency);
+    return SubGhzTxAllowed;
+}
+
+void subghz_device_replay_set_source(const char* file_path) {
+    furi_check(subghz_device_replay_instance);
+    furi_check(file_path);
+    furi_string_set(subghz_device_replay_instance->file_path, file_path);
+}
+
+void subghz_device_replay_set_speed(uint32_t speed) {
+    furi_check(subghz_device_replay_instance);
+    subghz_device_replay_instance->speed = speed;
+}
+
+void subghz_device_replay_set_tx_buffer(int32_t* buffer, size_t size) {
+    furi_check(subghz_device_replay_instance);
+    furi_check(buffer || !size);
+    subghz_device_replay_instance->tx_buffer = buffer;
+    subghz_device_replay_instance->tx_buffer_size = size;
+}
+
+bool subghz_device_replay_is_rx_complete(void) {
+    furi_check(subghz_device_replay_instance);
+    return subghz_device_replay_instance->rx_complete;
+}
+
+void subghz_device_replay_get_stats(SubGhzDeviceReplayStats* stats) {
+    furi_check(subghz_device_replay_instance);
+    furi_check(stats);
+    *stats = subghz_device_replay_instance->stats;
+}
+
+const SubGhzDeviceInterconnect subghz_device_replay_interconnect = {
+    .begin = subghz_device_replay_interconnect_begin,
+    .end = subghz_device_replay_interconnect_end,
+    .is_connect = subghz_device_replay_interconnect_is_connect,
+    .reset = subghz_device_replay_interconnect_dummy,
+    .sleep = subghz_device_replay_interconnect_dummy,
+    .idle = subghz_device_replay_interconnect_dummy,
+    .load_preset = subghz_device_replay_interconnect_load_preset,
+    .set_frequency = subghz_device_replay_interconnect_set_frequency,
+    .is_frequency_valid = furi_hal_subghz_is_frequency_valid,
+    .set_async_mirror_pin = subghz_device_replay_interconnect_set_async_mirror_pin,
+    .get_data_gpio = subghz_device_replay_interconnect_get_data_gpio,
+
+    .set_tx = subghz_device_replay_interconnect_set_tx,
+    .flush_tx = subghz_device_replay_interconnect_dummy,
+    .start_async_tx = subghz_device_replay_interconnect_start_async_tx,
+    .is_async_complete_tx = subghz_device_replay_interconnect_is_async_complete_tx,
+    .stop_async_tx = subghz_device_replay_thread_stop,
+
+    .set_rx = subghz_device_replay_interconnect_dummy,
+    .flush_rx = subghz_device_replay_interconnect_dummy,
+    .start_async_rx = subghz_device_replay_interconnect_start_async_rx,
+    .stop_async_rx = subghz_device_replay_interconnect_stop_async_rx,
+
+    .get_rssi = subghz_device_replay_interconnect_get_rssi,
+    .get_lqi = subghz_device_replay_interconnect_get_lqi,
+
+    .rx_pipe_not_empty = subghz_device_replay_interconnect_rx_pipe_not_empty,
+    .is_rx_data_crc_valid = subghz_device_replay_interconnect_is_rx_data_crc_valid,
+    .read_packet = subghz_device_replay_interconnect_read_packet,
+    .write_packet = subghz_device_replay_interconnect_write_packet,
+
+    .check_tx = subghz_device_replay_interconnect_check_tx,
+};
+
+const SubGhzDevice subghz_device_replay = {
+    .name = SUBGHZ_DEVICE_REPLAY_NAME,
+    .interconnect = &subghz_device_replay_interconnect,
+};
@@ -0,0 +1,65 @@
+/**
+ * @file replay_interconnect.h
+ * Virtual SubGhz radio device backed by a RAW recording.
+ *
+ * Async RX replays the recording through the capture callback at real time
+ * or at a multiple of it, async TX is pulled the same way the DMA of a real
+ * radio would pull it and stored into a buffer. Lets the whole RX/TX stack
+ * run and be measured without a radio.
+ */
+#pragma once
+#include "../types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SUBGHZ_DEVICE_REPLAY_NAME "replay"
+
+typedef struct {
+    uint32_t rx_pulse_count; /**< Pulses delivered to the capture callback */
+    uint32_t rx_late_count; /**< Pulses delivered more than a tick after their time */
+    uint32_t rx_late_max; /**< Worst delivery delay, us */
+    uint32_t rx_source_underrun_count; /**< Recording was not read from storage in time */
+    uint32_t tx_sample_count; /**< Samples pulled from the TX callback, same level merged */
+    uint32_t tx_refill_count; /**< Half buffer refills */
+    uint32_t tx_underrun_count; /**< Refills slower than airtime of the previous half */
+    uint32_t tx_refill_max; /**< Slowest refill, us */
+} SubGhzDeviceReplayStats;
+
+extern const SubGhzDevice subghz_device_replay;
+
+/** Set RAW recording served by async RX, device must be started with subghz_devices_begin
+ *
+ * @param file_path Path to a text or binary RAW file
+ */
+void subghz_device_replay_set_source(const char* file_path);
+
+/** Set replay speed
+ *
+ * @param speed 1 for real time, N to run N times faster, 0 to run without pacing
+ */
+void subghz_device_replay_set_speed(uint32_t speed);
+
+/** Set buffer receiving async TX samples, positive is high level, us
+ *
+ * @param buffer Buffer, NULL to only count samples
+ * @param size Buffer size in elements
+ */
+void subghz_device_replay_set_tx_buffer(int32_t* buffer, size_t size);
+
+/** Check whether the whole recording was delivered
+ *
+ * @return true if async RX reached the end of the recording
+ */
+bool subghz_device_replay_is_rx_complete(void);
+
+/** Get counters of the last async RX and TX runs
+ *
+ * @param stats Output statistics
+ */
+void subghz_device_replay_get_stats(SubGhzDeviceReplayStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -207,6 +207,9 @@ static uint64_t subghz_protocol_alutech_at_4n_decrypt(uint64_t data, const char*
         subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 4),
         subghz_protocol_alutech_at_4n_get_magic_data_in_file(file_name, 5)};
 
+    // Without the table the loop below takes 2^32 rounds
+    if(magic_data[3] == SUBGHZ_NO_ALUTECH_AT_4N_RAINBOW_TABLE) return data;
+
     uint32_t i = magic_data[0];
     do {
         data2 = data2 -
@@ -1,6 +1,7 @@
 #include "ansonic.h"
 #include "../blocks/const.h"
 #include "../blocks/decoder.h"
+#include "../blocks/pwm.h"
 #include "../blocks/encoder.h"
 #include "../blocks/generic.h"
 #include "../blocks/math.h"
@@ -21,6 +22,18 @@ static const SubGhzBlockConst subghz_protocol_ansonic_const = {
     .min_count_bit_for_found = 12,
 };
 
+static const SubGhzBlockPwmConst subghz_protocol_ansonic_pwm = {
+    .timing = &subghz_protocol_ansonic_const,
+    .header_short = 35,
+    .header_delta = 35,
+    .start_short = 1,
+    .start_delta = 1,
+    .long_delta = 1,
+    .gap_short = 4,
+    .gap_delta = 0,
+    .flags = SubGhzBlockPwmFlagStartSkipLow | SubGhzBlockPwmFlagInverted,
+};
+
 struct SubGhzProtocolDecoderAnsonic {
     SubGhzProtocolDecoderBase base;
 
@@ -35,13 +48,6 @@ struct SubGhzProtocolEncoderAnsonic {
     SubGhzBlockGeneric generic;
 };
 
-typedef enum {
-    AnsonicDecoderStepReset = 0,
-    AnsonicDecoderStepFoundStartBit,
-    AnsonicDecoderStepSaveDuration,
-    AnsonicDecoderStepCheckDuration,
-} AnsonicDecoderStep;
-
 const SubGhzProtocolDecoder subghz_protocol_ansonic_decoder = {
     .alloc = subghz_protocol_decoder_ansonic_alloc,
     .free = subghz_protocol_decoder_ansonic_free,
@@ -55,6 +61,11 @@ const SubGhzProtocolDecoder subghz_protocol_ansonic_decoder = {
     .deserialize = subghz_protocol_decoder_ansonic_deserialize,
     .get_string = subghz_protocol_decoder_ansonic_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_ansonic_is_idle,
+    .get_wake_window = subghz_protocol_decoder_ansonic_get_wake_window,
+    .pwm = &subghz_protocol_ansonic_pwm,
+    .feed_class = subghz_protocol_decoder_ansonic_feed_class,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_ansonic_encoder = {
@@ -206,81 +217,43 @@ void subghz_protocol_decoder_ansonic_free(void* context) {
 void subghz_protocol_decoder_ansonic_reset(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderAnsonic* instance = context;
-    instance->decoder.parser_step = AnsonicDecoderStepReset;
+    instance->decoder.parser_step = SubGhzBlockPwmStepReset;
 }
 
-void subghz_protocol_decoder_ansonic_feed(void* context, bool level, uint32_t duration) {
+bool subghz_protocol_decoder_ansonic_is_idle(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderAnsonic* instance = context;
+    return instance->decoder.parser_step == SubGhzBlockPwmStepReset;
+}
 
-    switch(instance->decoder.parser_step) {
-    case AnsonicDecoderStepReset:
-        if((!level) && (DURATION_DIFF(duration, subghz_protocol_ansonic_const.te_short * 35) <
-                        subghz_protocol_ansonic_const.te_delta * 35)) {
-            //Found header Ansonic
-            instance->decoder.parser_step = AnsonicDecoderStepFoundStartBit;
-        }
-        break;
-    case AnsonicDecoderStepFoundStartBit:
-        if(!level) {
-            break;
-        } else if(
-            DURATION_DIFF(duration, subghz_protocol_ansonic_const.te_short) <
-            subghz_protocol_ansonic_const.te_delta) {
-            //Found start bit Ansonic
-            instance->decoder.parser_step = AnsonicDecoderStepSaveDuration;
-            instance->decoder.decode_data = 0;
-            instance->decoder.decode_count_bit = 0;
-        } else {
-            instance->decoder.parser_step = AnsonicDecoderStepReset;
-        }
-        break;
-    case AnsonicDecoderStepSaveDuration:
-        if(!level) { //save interval
-            if(duration >= (subghz_protocol_ansonic_const.te_short * 4)) {
-                instance->decoder.parser_step = AnsonicDecoderStepFoundStartBit;
-                if(instance->decoder.decode_count_bit >=
-                   subghz_protocol_ansonic_const.min_count_bit_for_found) {
-                    instance->generic.serial = 0x0;
-                    instance->generic.btn = 0x0;
-
-                    instance->generic.data = instance->decoder.decode_data;
-                    instance->generic.data_count_bit = instance->decoder.decode_count_bit;
-                    if(instance->base.callback)
-                        instance->base.callback(&instance->base, instance->base.context);
-                }
-                break;
-            }
-            instance->decoder.te_last = duration;
-            instance->decoder.parser_step = AnsonicDecoderStepCheckDuration;
-        } else {
-            instance->decoder.parser_step = AnsonicDecoderStepReset;
-        }
-        break;
-    case AnsonicDecoderStepCheckDuration:
-        if(level) {
-            if((DURATION_DIFF(instance->decoder.te_last, subghz_protocol_ansonic_const.te_short) <
-                subghz_protocol_ansonic_const.te_delta) &&
-               (DURATION_DIFF(duration, subghz_protocol_ansonic_const.te_long) <
-                subghz_protocol_ansonic_const.te_delta)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 1);
-                instance->decoder.parser_step = AnsonicDecoderStepSaveDuration;
-            } else if(
-                (DURATION_DIFF(instance->decoder.te_last, subghz_protocol_ansonic_const.te_long) <
-                 subghz_protocol_ansonic_const.te_delta) &&
-                (DURATION_DIFF(duration, subghz_protocol_ansonic_const.te_short) <
-                 subghz_protocol_ansonic_const.te_delta)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 0);
-                instance->decoder.parser_step = AnsonicDecoderStepSaveDuration;
-            } else
-                instance->decoder.parser_step = AnsonicDecoderStepReset;
-        } else {
-            instance->decoder.parser_step = AnsonicDecoderStepReset;
-        }
-        break;
+void subghz_protocol_decoder_ansonic_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    subghz_block_pwm_get_wake_window(&subghz_protocol_ansonic_pwm, window);
+}
+
+void subghz_protocol_decoder_ansonic_feed_class(void* context, bool level, uint8_t pulse_class) {
+    furi_assert(context);
+    SubGhzProtocolDecoderAnsonic* instance = context;
+
+    if(subghz_block_pwm_feed_class(
+           &subghz_protocol_ansonic_pwm, &instance->decoder, level, pulse_class) &&
+       (instance->decoder.decode_count_bit >=
+        subghz_protocol_ansonic_const.min_count_bit_for_found)) {
+        instance->generic.serial = 0x0;
+        instance->generic.btn = 0x0;
+
+        instance->generic.data = instance->decoder.decode_data;
+        instance->generic.data_count_bit = instance->decoder.decode_count_bit;
+
+        if(instance->base.callback)
+            instance->base.callback(&instance->base, instance->base.context);
     }
 }
 
+void subghz_protocol_decoder_ansonic_feed(void* context, bool level, uint32_t duration) {
+    subghz_protocol_decoder_ansonic_feed_class(
+        context, level, subghz_block_pwm_get_class(&subghz_protocol_ansonic_pwm, duration));
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
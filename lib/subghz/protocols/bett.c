@@ -65,6 +65,9 @@ const SubGhzProtocolDecoder subghz_protocol_bett_decoder = {
     .deserialize = subghz_protocol_decoder_bett_deserialize,
     .get_string = subghz_protocol_decoder_bett_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_bett_is_idle,
+    .get_wake_window = subghz_protocol_decoder_bett_get_wake_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_bett_encoder = {
@@ -228,6 +231,18 @@ void subghz_protocol_decoder_bett_reset(void* context) {
     instance->decoder.parser_step = BETTDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_bett_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderBETT* instance = context;
+    return instance->decoder.parser_step == BETTDecoderStepReset;
+}
+
+void subghz_protocol_decoder_bett_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    furi_assert(window);
+    window->duration = subghz_protocol_bett_const.te_short * 44;
+    window->delta = subghz_protocol_bett_const.te_delta * 15;
+}
+
 void subghz_protocol_decoder_bett_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderBETT* instance = context;
@@ -2,6 +2,7 @@
 
 #include "../blocks/const.h"
 #include "../blocks/decoder.h"
+#include "../blocks/pwm.h"
 #include "../blocks/encoder.h"
 #include "../blocks/generic.h"
 #include "../blocks/math.h"
@@ -28,6 +29,18 @@ static const SubGhzBlockConst subghz_protocol_came_const = {
     .min_count_bit_for_found = 12,
 };
 
+static const SubGhzBlockPwmConst subghz_protocol_came_pwm = {
+    .timing = &subghz_protocol_came_const,
+    .header_short = 56,
+    .header_delta = 47,
+    .start_short = 1,
+    .start_delta = 1,
+    .long_delta = 1,
+    .gap_short = 4,
+    .gap_delta = 0,
+    .flags = SubGhzBlockPwmFlagStartSkipLow,
+};
+
 struct SubGhzProtocolDecoderCame {
     SubGhzProtocolDecoderBase base;
 
@@ -42,13 +55,6 @@ struct SubGhzProtocolEncoderCame {
     SubGhzBlockGeneric generic;
 };
 
-typedef enum {
-    CameDecoderStepReset = 0,
-    CameDecoderStepFoundStartBit,
-    CameDecoderStepSaveDuration,
-    CameDecoderStepCheckDuration,
-} CameDecoderStep;
-
 const SubGhzProtocolDecoder subghz_protocol_came_decoder = {
     .alloc = subghz_protocol_decoder_came_alloc,
     .free = subghz_protocol_decoder_came_free,
@@ -62,6 +68,11 @@ const SubGhzProtocolDecoder subghz_protocol_came_decoder = {
     .deserialize = subghz_protocol_decoder_came_deserialize,
     .get_string = subghz_protocol_decoder_came_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_came_is_idle,
+    .get_wake_window = subghz_protocol_decoder_came_get_wake_window,
+    .pwm = &subghz_protocol_came_pwm,
+    .feed_class = subghz_protocol_decoder_came_feed_class,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_came_encoder = {
@@ -235,82 +246,46 @@ void subghz_protocol_decoder_came_free(void* context) {
 void subghz_protocol_decoder_came_reset(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderCame* instance = context;
-    instance->decoder.parser_step = CameDecoderStepReset;
+    instance->decoder.parser_step = SubGhzBlockPwmStepReset;
 }
 
-void subghz_protocol_decoder_came_feed(void* context, bool level, uint32_t duration) {
+bool subghz_protocol_decoder_came_is_idle(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderCame* instance = context;
-    switch(instance->decoder.parser_step) {
-    case CameDecoderStepReset:
-        if((!level) && (DURATION_DIFF(duration, subghz_protocol_came_const.te_short * 56) <
-                        subghz_protocol_came_const.te_delta * 47)) {
-            //Found header CAME
-            instance->decoder.parser_step = CameDecoderStepFoundStartBit;
-        }
-        break;
-    case CameDecoderStepFoundStartBit:
-        if(!level) {
-            break;
-        } else if(
-            DURATION_DIFF(duration, subghz_protocol_came_const.te_short) <
-            subghz_protocol_came_const.te_delta) {
-            //Found start bit CAME
-            instance->decoder.parser_step = CameDecoderStepSaveDuration;
-            instance->decoder.decode_data = 0;
-            instance->decoder.decode_count_bit = 0;
-        } else {
-            instance->decoder.parser_step = CameDecoderStepReset;
-        }
-        break;
-    case CameDecoderStepSaveDuration:
-        if(!level) { //save interval
-            if(duration >= (subghz_protocol_came_const.te_short * 4)) {
-                instance->decoder.parser_step = CameDecoderStepFoundStartBit;
-                if((instance->decoder.decode_count_bit ==
-                    subghz_protocol_came_const.min_count_bit_for_found) ||
-                   (instance->decoder.decode_count_bit == AIRFORCE_COUNT_BIT) ||
-                   (instance->decoder.decode_count_bit == PRASTEL_COUNT_BIT) ||
-                   (instance->decoder.decode_count_bit == CAME_24_COUNT_BIT)) {
-                    instance->generic.serial = 0x0;
-                    instance->generic.btn = 0x0;
-
-                    instance->generic.data = instance->decoder.decode_data;
-                    instance->generic.data_count_bit = instance->decoder.decode_count_bit;
-
-                    if(instance->base.callback)
-                        instance->base.callback(&instance->base, instance->base.context);
-                }
-                break;
-            }
-            instance->decoder.te_last = duration;
-            instance->decoder.parser_step = CameDecoderStepCheckDuration;
-        } else {
-            instance->decoder.parser_step = CameDecoderStepReset;
-        }
-        break;
-    case CameDecoderStepCheckDuration:
-        if(level) {
-            if((DURATION_DIFF(instance->decoder.te_last, subghz_protocol_came_const.te_short) <
-                subghz_protocol_came_const.te_delta) &&
-               (DURATION_DIFF(duration, subghz_protocol_came_const.te_long) <
-                subghz_protocol_came_const.te_delta)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 0);
-                instance->decoder.parser_step = CameDecoderStepSaveDuration;
-            } else if(
-                (DURATION_DIFF(instance->decoder.te_last, subghz_protocol_came_const.te_long) <
-                 subghz_protocol_came_const.te_delta) &&
-                (DURATION_DIFF(duration, subghz_protocol_came_const.te_short) <
-                 subghz_protocol_came_const.te_delta)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 1);
-                instance->decoder.parser_step = CameDecoderStepSaveDuration;
-            } else
-                instance->decoder.parser_step = CameDecoderStepReset;
-        } else {
-            instance->decoder.parser_step = CameDecoderStepReset;
-        }
-        break;
+    return instance->decoder.parser_step == SubGhzBlockPwmStepReset;
+}
+
+void subghz_protocol_decoder_came_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    subghz_block_pwm_get_wake_window(&subghz_protocol_came_pwm, window);
+}
+
+void subghz_protocol_decoder_came_feed_class(void* context, bool level, uint8_t pulse_class) {
+    furi_assert(context);
+    SubGhzProtocolDecoderCame* instance = context;
+
+    if(!subghz_block_pwm_feed_class(
+           &subghz_protocol_came_pwm, &instance->decoder, level, pulse_class)) {
+        return;
     }
+
+    const uint8_t count_bit = instance->decoder.decode_count_bit;
+    if((count_bit == subghz_protocol_came_const.min_count_bit_for_found) ||
+       (count_bit == AIRFORCE_COUNT_BIT) || (count_bit == PRASTEL_COUNT_BIT) ||
+       (count_bit == CAME_24_COUNT_BIT)) {
+        instance->generic.serial = 0x0;
+        instance->generic.btn = 0x0;
+
+        instance->generic.data = instance->decoder.decode_data;
+        instance->generic.data_count_bit = instance->decoder.decode_count_bit;
+
+        if(instance->base.callback)
+            instance->base.callback(&instance->base, instance->base.context);
+    }
+}
+
+void subghz_protocol_decoder_came_feed(void* context, bool level, uint32_t duration) {
+    subghz_protocol_decoder_came_feed_class(
+        context, level, subghz_block_pwm_get_class(&subghz_protocol_came_pwm, duration));
 }
 
 uint32_t subghz_protocol_decoder_came_get_hash_data(void* context) {
@@ -65,6 +65,27 @@ void subghz_protocol_decoder_came_free(void* context);
  */
 void subghz_protocol_decoder_came_reset(void* context);
 
+/**
+ * Check whether the decoder is waiting for a preamble.
+ * @param context Pointer to a SubGhzProtocolDecoderCame instance
+ * @return true if the decoder is in its reset step
+ */
+bool subghz_protocol_decoder_came_is_idle(void* context);
+
+/**
+ * Get the range of durations that can wake an idle decoder.
+ * @param window Pointer to a SubGhzDecoderWakeWindow to fill
+ */
+void subghz_protocol_decoder_came_get_wake_window(SubGhzDecoderWakeWindow* window);
+
+/**
+ * Parse a pulse classified against subghz_protocol_decoder_came.pwm.
+ * @param context Pointer to a SubGhzProtocolDecoderCame instance
+ * @param level Signal level true-high false-low
+ * @param pulse_class SubGhzBlockPwmClass bits of the duration
+ */
+void subghz_protocol_decoder_came_feed_class(void* context, bool level, uint8_t pulse_class);
+
 /**
  * Parse a raw sequence of levels and durations received from the air.
  * @param context Pointer to a SubGhzProtocolDecoderCame instance
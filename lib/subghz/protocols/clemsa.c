@@ -64,6 +64,9 @@ const SubGhzProtocolDecoder subghz_protocol_clemsa_decoder = {
     .deserialize = subghz_protocol_decoder_clemsa_deserialize,
     .get_string = subghz_protocol_decoder_clemsa_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_clemsa_is_idle,
+    .get_wake_window = subghz_protocol_decoder_clemsa_get_wake_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_clemsa_encoder = {
@@ -228,6 +231,18 @@ void subghz_protocol_decoder_clemsa_reset(void* context) {
     instance->decoder.parser_step = ClemsaDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_clemsa_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderClemsa* instance = context;
+    return instance->decoder.parser_step == ClemsaDecoderStepReset;
+}
+
+void subghz_protocol_decoder_clemsa_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    furi_assert(window);
+    window->duration = subghz_protocol_clemsa_const.te_short * 51;
+    window->delta = subghz_protocol_clemsa_const.te_delta * 25;
+}
+
 void subghz_protocol_decoder_clemsa_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderClemsa* instance = context;
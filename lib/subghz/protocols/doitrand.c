@@ -2,6 +2,7 @@
 
 #include "../blocks/const.h"
 #include "../blocks/decoder.h"
+#include "../blocks/pwm.h"
 #include "../blocks/encoder.h"
 #include "../blocks/generic.h"
 #include "../blocks/math.h"
@@ -22,6 +23,18 @@ static const SubGhzBlockConst subghz_protocol_doitrand_const = {
     .min_count_bit_for_found = 37,
 };
 
+static const SubGhzBlockPwmConst subghz_protocol_doitrand_pwm = {
+    .timing = &subghz_protocol_doitrand_const,
+    .header_short = 62,
+    .header_delta = 30,
+    .start_short = 2,
+    .start_delta = 3,
+    .long_delta = 3,
+    .gap_short = 10,
+    .gap_delta = 1,
+    .flags = SubGhzBlockPwmFlagBitSkipHigh,
+};
+
 struct SubGhzProtocolDecoderDoitrand {
     SubGhzProtocolDecoderBase base;
 
@@ -36,13 +49,6 @@ struct SubGhzProtocolEncoderDoitrand {
     SubGhzBlockGeneric generic;
 };
 
-typedef enum {
-    DoitrandDecoderStepReset = 0,
-    DoitrandDecoderStepFoundStartBit,
-    DoitrandDecoderStepSaveDuration,
-    DoitrandDecoderStepCheckDuration,
-} DoitrandDecoderStep;
-
 const SubGhzProtocolDecoder subghz_protocol_doitrand_decoder = {
     .alloc = subghz_protocol_decoder_doitrand_alloc,
     .free = subghz_protocol_decoder_doitrand_free,
@@ -56,6 +62,11 @@ const SubGhzProtocolDecoder subghz_protocol_doitrand_decoder = {
     .deserialize = subghz_protocol_decoder_doitrand_deserialize,
     .get_string = subghz_protocol_decoder_doitrand_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_doitrand_is_idle,
+    .get_wake_window = subghz_protocol_decoder_doitrand_get_wake_window,
+    .pwm = &subghz_protocol_doitrand_pwm,
+    .feed_class = subghz_protocol_decoder_doitrand_feed_class,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_doitrand_encoder = {
@@ -205,79 +216,40 @@ void subghz_protocol_decoder_doitrand_free(void* context) {
 void subghz_protocol_decoder_doitrand_reset(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderDoitrand* instance = context;
-    instance->decoder.parser_step = DoitrandDecoderStepReset;
+    instance->decoder.parser_step = SubGhzBlockPwmStepReset;
 }
 
-void subghz_protocol_decoder_doitrand_feed(void* context, bool level, uint32_t duration) {
+bool subghz_protocol_decoder_doitrand_is_idle(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderDoitrand* instance = context;
+    return instance->decoder.parser_step == SubGhzBlockPwmStepReset;
+}
 
-    switch(instance->decoder.parser_step) {
-    case DoitrandDecoderStepReset:
-        if((!level) && (DURATION_DIFF(duration, subghz_protocol_doitrand_const.te_short * 62) <
-                        subghz_protocol_doitrand_const.te_delta * 30)) {
-            //Found Preambula
-            instance->decoder.parser_step = DoitrandDecoderStepFoundStartBit;
-        }
-        break;
-    case DoitrandDecoderStepFoundStartBit:
-        if(level && (DURATION_DIFF(duration, (subghz_protocol_doitrand_const.te_short * 2)) <
-                     subghz_protocol_doitrand_const.te_delta * 3)) {
-            //Found start bit
-            instance->decoder.parser_step = DoitrandDecoderStepSaveDuration;
-            instance->decoder.decode_data = 0;
-            instance->decoder.decode_count_bit = 0;
-        } else {
-            instance->decoder.parser_step = DoitrandDecoderStepReset;
-        }
-        break;
-    case DoitrandDecoderStepSaveDuration:
-        if(!level) {
-            if(duration >= ((uint32_t)subghz_protocol_doitrand_const.te_short * 10 +
-                            subghz_protocol_doitrand_const.te_delta)) {
-                instance->decoder.parser_step = DoitrandDecoderStepFoundStartBit;
-                if(instance->decoder.decode_count_bit ==
-                   subghz_protocol_doitrand_const.min_count_bit_for_found) {
-                    instance->generic.data = instance->decoder.decode_data;
-                    instance->generic.data_count_bit = instance->decoder.decode_count_bit;
-
-                    if(instance->base.callback)
-                        instance->base.callback(&instance->base, instance->base.context);
-                }
-                instance->decoder.decode_data = 0;
-                instance->decoder.decode_count_bit = 0;
-                break;
-            } else {
-                instance->decoder.te_last = duration;
-                instance->decoder.parser_step = DoitrandDecoderStepCheckDuration;
-            }
-        }
-        break;
-    case DoitrandDecoderStepCheckDuration:
-        if(level) {
-            if((DURATION_DIFF(instance->decoder.te_last, subghz_protocol_doitrand_const.te_short) <
-                subghz_protocol_doitrand_const.te_delta) &&
-               (DURATION_DIFF(duration, subghz_protocol_doitrand_const.te_long) <
-                subghz_protocol_doitrand_const.te_delta * 3)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 0);
-                instance->decoder.parser_step = DoitrandDecoderStepSaveDuration;
-            } else if(
-                (DURATION_DIFF(instance->decoder.te_last, subghz_protocol_doitrand_const.te_long) <
-                 subghz_protocol_doitrand_const.te_delta * 3) &&
-                (DURATION_DIFF(duration, subghz_protocol_doitrand_const.te_short) <
-                 subghz_protocol_doitrand_const.te_delta)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 1);
-                instance->decoder.parser_step = DoitrandDecoderStepSaveDuration;
-            } else {
-                instance->decoder.parser_step = DoitrandDecoderStepReset;
-            }
-        } else {
-            instance->decoder.parser_step = DoitrandDecoderStepReset;
-        }
-        break;
+void subghz_protocol_decoder_doitrand_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    subghz_block_pwm_get_wake_window(&subghz_protocol_doitrand_pwm, window);
+}
+
+void subghz_protocol_decoder_doitrand_feed_class(void* context, bool level, uint8_t pulse_class) {
+    furi_assert(context);
+    SubGhzProtocolDecoderDoitrand* instance = context;
+
+    if(subghz_block_pwm_feed_class(
+           &subghz_protocol_doitrand_pwm, &instance->decoder, level, pulse_class) &&
+       (instance->decoder.decode_count_bit ==
+        subghz_protocol_doitrand_const.min_count_bit_for_found)) {
+        instance->generic.data = instance->decoder.decode_data;
+        instance->generic.data_count_bit = instance->decoder.decode_count_bit;
+
+        if(instance->base.callback)
+            instance->base.callback(&instance->base, instance->base.context);
     }
 }
 
+void subghz_protocol_decoder_doitrand_feed(void* context, bool level, uint32_t duration) {
+    subghz_protocol_decoder_doitrand_feed_class(
+        context, level, subghz_block_pwm_get_class(&subghz_protocol_doitrand_pwm, duration));
+}
+
 /** 
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -50,6 +50,9 @@ const SubGhzProtocolDecoder subghz_protocol_dooya_decoder = {
     .deserialize = subghz_protocol_decoder_dooya_deserialize,
     .get_string = subghz_protocol_decoder_dooya_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_dooya_is_idle,
+    .get_wake_window = subghz_protocol_decoder_dooya_get_wake_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_dooya_encoder = {
@@ -218,6 +221,18 @@ void subghz_protocol_decoder_dooya_reset(void* context) {
     instance->decoder.parser_step = DooyaDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_dooya_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderDooya* instance = context;
+    return instance->decoder.parser_step == DooyaDecoderStepReset;
+}
+
+void subghz_protocol_decoder_dooya_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    furi_assert(window);
+    window->duration = subghz_protocol_dooya_const.te_long * 12;
+    window->delta = subghz_protocol_dooya_const.te_delta * 20;
+}
+
 void subghz_protocol_decoder_dooya_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderDooya* instance = context;
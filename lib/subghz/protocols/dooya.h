@@ -65,6 +65,19 @@ void subghz_protocol_decoder_dooya_free(void* context);
  */
 void subghz_protocol_decoder_dooya_reset(void* context);
 
+/**
+ * Check whether the decoder is waiting for a preamble.
+ * @param context Pointer to a SubGhzProtocolDecoderDooya instance
+ * @return true if the decoder is in its reset step
+ */
+bool subghz_protocol_decoder_dooya_is_idle(void* context);
+
+/**
+ * Get the range of durations that can wake an idle decoder.
+ * @param window Pointer to a SubGhzDecoderWakeWindow to fill
+ */
+void subghz_protocol_decoder_dooya_get_wake_window(SubGhzDecoderWakeWindow* window);
+
 /**
  * Parse a raw sequence of levels and durations received from the air.
  * @param context Pointer to a SubGhzProtocolDecoderDooya instance
@@ -2,6 +2,7 @@
 
 #include "../blocks/const.h"
 #include "../blocks/decoder.h"
+#include "../blocks/pwm.h"
 #include "../blocks/encoder.h"
 #include "../blocks/generic.h"
 #include "../blocks/math.h"
@@ -25,6 +26,18 @@ static const SubGhzBlockConst subghz_protocol_holtek_const = {
     .min_count_bit_for_found = 40,
 };
 
+static const SubGhzBlockPwmConst subghz_protocol_holtek_pwm = {
+    .timing = &subghz_protocol_holtek_const,
+    .header_short = 36,
+    .header_delta = 36,
+    .start_short = 1,
+    .start_delta = 1,
+    .long_delta = 2,
+    .gap_short = 10,
+    .gap_delta = 1,
+    .flags = SubGhzBlockPwmFlagNone,
+};
+
 struct SubGhzProtocolDecoderHoltek {
     SubGhzProtocolDecoderBase base;
 
@@ -39,13 +52,6 @@ struct SubGhzProtocolEncoderHoltek {
     SubGhzBlockGeneric generic;
 };
 
-typedef enum {
-    HoltekDecoderStepReset = 0,
-    HoltekDecoderStepFoundStartBit,
-    HoltekDecoderStepSaveDuration,
-    HoltekDecoderStepCheckDuration,
-} HoltekDecoderStep;
-
 const SubGhzProtocolDecoder subghz_protocol_holtek_decoder = {
     .alloc = subghz_protocol_decoder_holtek_alloc,
     .free = subghz_protocol_decoder_holtek_free,
@@ -59,6 +65,11 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_decoder = {
     .deserialize = subghz_protocol_decoder_holtek_deserialize,
     .get_string = subghz_protocol_decoder_holtek_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_holtek_is_idle,
+    .get_wake_window = subghz_protocol_decoder_holtek_get_wake_window,
+    .pwm = &subghz_protocol_holtek_pwm,
+    .feed_class = subghz_protocol_decoder_holtek_feed_class,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_holtek_encoder = {
@@ -211,83 +222,44 @@ void subghz_protocol_decoder_holtek_free(void* context) {
 void subghz_protocol_decoder_holtek_reset(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderHoltek* instance = context;
-    instance->decoder.parser_step = HoltekDecoderStepReset;
+    instance->decoder.parser_step = SubGhzBlockPwmStepReset;
 }
 
-void subghz_protocol_decoder_holtek_feed(void* context, bool level, uint32_t duration) {
+bool subghz_protocol_decoder_holtek_is_idle(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderHoltek* instance = context;
+    return instance->decoder.parser_step == SubGhzBlockPwmStepReset;
+}
 
-    switch(instance->decoder.parser_step) {
-    case HoltekDecoderStepReset:
-        if((!level) && (DURATION_DIFF(duration, subghz_protocol_holtek_const.te_short * 36) <
-                        subghz_protocol_holtek_const.te_delta * 36)) {
-            //Found Preambula
-            instance->decoder.parser_step = HoltekDecoderStepFoundStartBit;
-        }
-        break;
-    case HoltekDecoderStepFoundStartBit:
-        if((level) && (DURATION_DIFF(duration, subghz_protocol_holtek_const.te_short) <
-                       subghz_protocol_holtek_const.te_delta)) {
-            //Found StartBit
-            instance->decoder.parser_step = HoltekDecoderStepSaveDuration;
-            instance->decoder.decode_data = 0;
-            instance->decoder.decode_count_bit = 0;
-        } else {
-            instance->decoder.parser_step = HoltekDecoderStepReset;
-        }
-        break;
-    case HoltekDecoderStepSaveDuration:
-        //save duration
-        if(!level) {
-            if(duration >= ((uint32_t)subghz_protocol_holtek_const.te_short * 10 +
-                            subghz_protocol_holtek_const.te_delta)) {
-                if(instance->decoder.decode_count_bit ==
-                   subghz_protocol_holtek_const.min_count_bit_for_found) {
-                    if((instance->decoder.decode_data & HOLTEK_HEADER_MASK) == HOLTEK_HEADER) {
-                        instance->generic.data = instance->decoder.decode_data;
-                        instance->generic.data_count_bit = instance->decoder.decode_count_bit;
-
-                        if(instance->base.callback)
-                            instance->base.callback(&instance->base, instance->base.context);
-                    }
-                }
-                instance->decoder.decode_data = 0;
-                instance->decoder.decode_count_bit = 0;
-                instance->decoder.parser_step = HoltekDecoderStepFoundStartBit;
-                break;
-            } else {
-                instance->decoder.te_last = duration;
-
-                instance->decoder.parser_step = HoltekDecoderStepCheckDuration;
-            }
-        } else {
-            instance->decoder.parser_step = HoltekDecoderStepReset;
-        }
-        break;
-    case HoltekDecoderStepCheckDuration:
-        if(level) {
-            if((DURATION_DIFF(instance->decoder.te_last, subghz_protocol_holtek_const.te_short) <
-                subghz_protocol_holtek_const.te_delta) &&
-               (DURATION_DIFF(duration, subghz_protocol_holtek_const.te_long) <
-                subghz_protocol_holtek_const.te_delta * 2)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 0);
-                instance->decoder.parser_step = HoltekDecoderStepSaveDuration;
-            } else if(
-                (DURATION_DIFF(instance->decoder.te_last, subghz_protocol_holtek_const.te_long) <
-                 subghz_protocol_holtek_const.te_delta * 2) &&
-                (DURATION_DIFF(duration, subghz_protocol_holtek_const.te_short) <
-                 subghz_protocol_holtek_const.te_delta)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 1);
-                instance->decoder.parser_step = HoltekDecoderStepSaveDuration;
-            } else {
-                instance->decoder.parser_step = HoltekDecoderStepReset;
-            }
-        } else {
-            instance->decoder.parser_step = HoltekDecoderStepReset;
-        }
-        break;
+void subghz_protocol_decoder_holtek_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    subghz_block_pwm_get_wake_window(&subghz_protocol_holtek_pwm, window);
+}
+
+void subghz_protocol_decoder_holtek_feed_class(void* context, bool level, uint8_t pulse_class) {
+    furi_assert(context);
+    SubGhzProtocolDecoderHoltek* instance = context;
+
+    if(!subghz_block_pwm_feed_class(
+           &subghz_protocol_holtek_pwm, &instance->decoder, level, pulse_class)) {
+        return;
     }
+
+    if((instance->decoder.decode_count_bit ==
+        subghz_protocol_holtek_const.min_count_bit_for_found) &&
+       ((instance->decoder.decode_data & HOLTEK_HEADER_MASK) == HOLTEK_HEADER)) {
+        instance->generic.data = instance->decoder.decode_data;
+        instance->generic.data_count_bit = instance->decoder.decode_count_bit;
+
+        if(instance->base.callback)
+            instance->base.callback(&instance->base, instance->base.context);
+    }
+    // After the callback, a receiver reset in it must not drop the repeat frames
+    subghz_block_pwm_end_frame(&instance->decoder);
+}
+
+void subghz_protocol_decoder_holtek_feed(void* context, bool level, uint32_t duration) {
+    subghz_protocol_decoder_holtek_feed_class(
+        context, level, subghz_block_pwm_get_class(&subghz_protocol_holtek_pwm, duration));
 }
 
 /** 
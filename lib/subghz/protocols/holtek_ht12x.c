@@ -66,6 +66,9 @@ const SubGhzProtocolDecoder subghz_protocol_holtek_th12x_decoder = {
     .deserialize = subghz_protocol_decoder_holtek_th12x_deserialize,
     .get_string = subghz_protocol_decoder_holtek_th12x_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_holtek_th12x_is_idle,
+    .get_wake_window = subghz_protocol_decoder_holtek_th12x_get_wake_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_holtek_th12x_encoder = {
@@ -230,6 +233,18 @@ void subghz_protocol_decoder_holtek_th12x_reset(void* context) {
     instance->decoder.parser_step = Holtek_HT12XDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_holtek_th12x_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderHoltek_HT12X* instance = context;
+    return instance->decoder.parser_step == Holtek_HT12XDecoderStepReset;
+}
+
+void subghz_protocol_decoder_holtek_th12x_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    furi_assert(window);
+    window->duration = subghz_protocol_holtek_th12x_const.te_short * 36;
+    window->delta = subghz_protocol_holtek_th12x_const.te_delta * 36;
+}
+
 void subghz_protocol_decoder_holtek_th12x_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderHoltek_HT12X* instance = context;
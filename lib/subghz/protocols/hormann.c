@@ -53,6 +53,9 @@ const SubGhzProtocolDecoder subghz_protocol_hormann_decoder = {
     .deserialize = subghz_protocol_decoder_hormann_deserialize,
     .get_string = subghz_protocol_decoder_hormann_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_hormann_is_idle,
+    .get_wake_window = subghz_protocol_decoder_hormann_get_wake_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_hormann_encoder = {
@@ -216,6 +219,18 @@ void subghz_protocol_decoder_hormann_reset(void* context) {
     instance->decoder.parser_step = HormannDecoderStepReset;
 }
 
+bool subghz_protocol_decoder_hormann_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderHormann* instance = context;
+    return instance->decoder.parser_step == HormannDecoderStepReset;
+}
+
+void subghz_protocol_decoder_hormann_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    furi_assert(window);
+    window->duration = subghz_protocol_hormann_const.te_short * 24;
+    window->delta = subghz_protocol_hormann_const.te_delta * 24;
+}
+
 void subghz_protocol_decoder_hormann_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderHormann* instance = context;
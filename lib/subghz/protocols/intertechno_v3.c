@@ -58,6 +58,9 @@ const SubGhzProtocolDecoder subghz_protocol_intertechno_v3_decoder = {
     .deserialize = subghz_protocol_decoder_intertechno_v3_deserialize,
     .get_string = subghz_protocol_decoder_intertechno_v3_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_intertechno_v3_is_idle,
+    .get_wake_window = subghz_protocol_decoder_intertechno_v3_get_wake_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_intertechno_v3_encoder = {
@@ -236,6 +239,18 @@ void subghz_protocol_decoder_intertechno_v3_reset(void* context) {
     instance->decoder.parser_step = IntertechnoV3DecoderStepReset;
 }
 
+bool subghz_protocol_decoder_intertechno_v3_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderIntertechno_V3* instance = context;
+    return instance->decoder.parser_step == IntertechnoV3DecoderStepReset;
+}
+
+void subghz_protocol_decoder_intertechno_v3_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    furi_assert(window);
+    window->duration = subghz_protocol_intertechno_v3_const.te_short * 37;
+    window->delta = subghz_protocol_intertechno_v3_const.te_delta * 15;
+}
+
 void subghz_protocol_decoder_intertechno_v3_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderIntertechno_V3* instance = context;
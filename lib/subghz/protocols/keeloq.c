@@ -778,6 +778,217 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
     return false;
 }
 
+typedef enum {
+    KeeloqVariantSimple,
+    KeeloqVariantSimpleMirrored,
+    KeeloqVariantNormal,
+    KeeloqVariantNormalMirrored,
+    KeeloqVariantNormalCenturion,
+    KeeloqVariantSecure,
+    KeeloqVariantSecureMirrored,
+    KeeloqVariantMagicXorType1,
+    KeeloqVariantMagicXorType1Mirrored,
+    KeeloqVariantMagicSerialType1,
+    KeeloqVariantMagicSerialType2,
+    KeeloqVariantMagicSerialType3,
+    KeeloqVariantEnd,
+} KeeloqVariant;
+
+// Variants tried for KEELOQ_LEARNING_UNKNOWN keys, in order
+static const KeeloqVariant subghz_protocol_keeloq_unknown_variants[] = {
+    KeeloqVariantSimple,
+    KeeloqVariantSimpleMirrored,
+    KeeloqVariantNormal,
+    KeeloqVariantNormalMirrored,
+    KeeloqVariantSecure,
+    KeeloqVariantSecureMirrored,
+    KeeloqVariantMagicXorType1,
+    KeeloqVariantMagicXorType1Mirrored,
+    KeeloqVariantEnd,
+};
+
+/**
+ * Get the learning variant used for a known learning type.
+ * @param type Learning type from the keystore
+ * @param name Manufacture name
+ * @return KeeloqVariant, KeeloqVariantEnd for unknown and unsupported types
+ */
+static KeeloqVariant subghz_protocol_keeloq_get_variant(uint16_t type, const FuriString* name) {
+    switch(type) {
+    case KEELOQ_LEARNING_SIMPLE:
+        return KeeloqVariantSimple;
+    case KEELOQ_LEARNING_NORMAL:
+        return furi_string_cmp_str(name, "Centurion") == 0 ? KeeloqVariantNormalCenturion :
+                                                              KeeloqVariantNormal;
+    case KEELOQ_LEARNING_SECURE:
+        return KeeloqVariantSecure;
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+        return KeeloqVariantMagicXorType1;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+        return KeeloqVariantMagicSerialType1;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+        return KeeloqVariantMagicSerialType2;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        return KeeloqVariantMagicSerialType3;
+    default:
+        return KeeloqVariantEnd;
+    }
+}
+
+/**
+ * Get kl_type reported for a variant of a KEELOQ_LEARNING_UNKNOWN key.
+ * @param variant KeeloqVariant
+ * @return kl_type
+ */
+static uint8_t subghz_protocol_keeloq_get_kl_type(KeeloqVariant variant) {
+    switch(variant) {
+    case KeeloqVariantSimple:
+    case KeeloqVariantSimpleMirrored:
+        return 1;
+    case KeeloqVariantNormal:
+    case KeeloqVariantNormalMirrored:
+        return 2;
+    case KeeloqVariantSecure:
+    case KeeloqVariantSecureMirrored:
+        return 3;
+    default:
+        return 4;
+    }
+}
+
+/**
+ * Try to decrypt the hop part with one manufacture key and learning variant.
+ * @param instance Pointer to a SubGhzBlockGeneric instance
+ * @param fix Fix part of the parcel
+ * @param hop Hop encrypted part of the parcel
+ * @param key Manufacture key
+ * @param variant KeeloqVariant
+ * @return true if the decrypted data is valid
+ */
+static bool subghz_protocol_keeloq_check_variant(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    uint64_t key,
+    KeeloqVariant variant) {
+    // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
+    // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
+    // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
+    uint16_t end_serial = (uint16_t)(fix & 0xFF);
+    uint8_t btn = (uint8_t)(fix >> 28);
+
+    if(variant == KeeloqVariantSimpleMirrored || variant == KeeloqVariantNormalMirrored ||
+       variant == KeeloqVariantSecureMirrored || variant == KeeloqVariantMagicXorType1Mirrored) {
+        // Check for mirrored man
+        uint64_t man_rev = 0;
+        uint64_t man_rev_byte = 0;
+        for(uint8_t i = 0; i < 64; i += 8) {
+            man_rev_byte = (uint8_t)(key >> i);
+            man_rev = man_rev | man_rev_byte << (56 - i);
+        }
+        key = man_rev;
+    }
+
+    uint64_t man;
+    switch(variant) {
+    case KeeloqVariantSimple:
+    case KeeloqVariantSimpleMirrored:
+        man = key;
+        break;
+    case KeeloqVariantNormal:
+    case KeeloqVariantNormalMirrored:
+    case KeeloqVariantNormalCenturion:
+        // Normal Learning
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        man = subghz_protocol_keeloq_common_normal_learning(fix, key);
+        break;
+    case KeeloqVariantSecure:
+    case KeeloqVariantSecureMirrored:
+        man = subghz_protocol_keeloq_common_secure_learning(fix, instance->seed, key);
+        break;
+    case KeeloqVariantMagicXorType1:
+    case KeeloqVariantMagicXorType1Mirrored:
+        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
+        break;
+    case KeeloqVariantMagicSerialType1:
+        man = subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key);
+        break;
+    case KeeloqVariantMagicSerialType2:
+        man = subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key);
+        break;
+    case KeeloqVariantMagicSerialType3:
+        man = subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key);
+        break;
+    default:
+        return false;
+    }
+
+    uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+    if(variant == KeeloqVariantNormalCenturion) {
+        return subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn);
+    }
+    return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial);
+}
+
+/**
+ * Try all learning variants of a manufacture key.
+ * @param instance Pointer to a SubGhzBlockGeneric instance
+ * @param fix Fix part of the parcel
+ * @param hop Hop encrypted part of the parcel
+ * @param manufacture_code Pointer to a SubGhzKey
+ * @param variant Returned variant that matched
+ * @return true on success
+ */
+static bool subghz_protocol_keeloq_check_key(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    const SubGhzKey* manufacture_code,
+    KeeloqVariant* variant) {
+    if(manufacture_code->type == KEELOQ_LEARNING_UNKNOWN) {
+        for(const KeeloqVariant* v = subghz_protocol_keeloq_unknown_variants;
+            *v != KeeloqVariantEnd;
+            v++) {
+            if(subghz_protocol_keeloq_check_variant(
+                   instance, fix, hop, manufacture_code->key, *v)) {
+                *variant = *v;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    *variant = subghz_protocol_keeloq_get_variant(manufacture_code->type, manufacture_code->name);
+    return subghz_protocol_keeloq_check_variant(
+        instance, fix, hop, manufacture_code->key, *variant);
+}
+
+/**
+ * Remember the key that decoded the parcel and report its manufacture.
+ * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param fix Fix part of the parcel
+ * @param key_index Index of the key in the keystore
+ * @param variant KeeloqVariant that matched
+ * @param manufacture_name Returned manufacture name
+ */
+static void subghz_protocol_keeloq_set_manufacture(
+    SubGhzKeystore* keystore,
+    uint32_t fix,
+    uint32_t key_index,
+    KeeloqVariant variant,
+    const char** manufacture_name) {
+    const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(keystore->data, key_index);
+
+    *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+    keystore->mfname = *manufacture_name;
+    if(manufacture_code->type == KEELOQ_LEARNING_UNKNOWN) {
+        keystore->kl_type = subghz_protocol_keeloq_get_kl_type(variant);
+    }
+
+    SubGhzKeystoreHit hit = {.key_index = key_index, .variant = variant};
+    subghz_keystore_cache_store(keystore, fix & 0x0FFFFFFF, &hit);
+}
+
 /** 
  * Checking the accepted code against the database manafacture key
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -793,15 +1004,7 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     uint32_t hop,
     SubGhzKeystore* keystore,
     const char** manufacture_name) {
-    // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
-    // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
-    // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
-
-    uint16_t end_serial = (uint16_t)(fix & 0xFF);
-    uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
-    uint64_t man;
-    bool mf_not_set = false;
+    KeeloqVariant variant;
     // TODO:
     // if(mfname == 0x0) {
     //     mfname = "";
@@ -811,189 +1014,44 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
 
     if(strcmp(mfname, "Unknown") == 0) {
         return 1;
-    } else if(strcmp(mfname, "") == 0) {
-        mf_not_set = true;
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0) {
-                        if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    } else {
-                        if(subghz_protocol_keeloq_check_decrypt(
-                               instance, decrypt, btn, end_serial)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    }
-                    break;
-                case KEELOQ_LEARNING_SECURE:
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                    man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                    man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
 
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Secure Learning
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Magic xor type1 learning
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+    // Remote that was decoded before, try its key and variant first
+    SubGhzKeystoreHit hit;
+    if(subghz_keystore_cache_lookup(keystore, fix & 0x0FFFFFFF, &hit)) {
+        const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(keystore->data, hit.key_index);
+        if((mfname[0] == '\0' || furi_string_cmp_str(manufacture_code->name, mfname) == 0) &&
+           subghz_protocol_keeloq_check_variant(
+               instance, fix, hop, manufacture_code->key, hit.variant)) {
+            subghz_protocol_keeloq_set_manufacture(
+                keystore, fix, hit.key_index, hit.variant, manufacture_name);
+            return 1;
+        }
+    }
 
-                    break;
-                }
+    if(mfname[0] == '\0') {
+        // Manufacture is not set, keys are tried in file order
+        size_t count = SubGhzKeyArray_size(keystore->data);
+        for(size_t i = 0; i < count; i++) {
+            const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(keystore->data, i);
+            if(subghz_protocol_keeloq_check_key(instance, fix, hop, manufacture_code, &variant)) {
+                subghz_protocol_keeloq_set_manufacture(
+                    keystore, fix, i, variant, manufacture_name);
+                return 1;
+            }
+        }
+    } else {
+        const uint32_t* indexes;
+        size_t count = subghz_keystore_find_by_name(keystore, mfname, &indexes);
+        for(size_t i = 0; i < count; i++) {
+            const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(keystore->data, indexes[i]);
+            if(subghz_protocol_keeloq_check_key(instance, fix, hop, manufacture_code, &variant)) {
+                subghz_protocol_keeloq_set_manufacture(
+                    keystore, fix, indexes[i], variant, manufacture_name);
+                return 1;
             }
         }
+    }
 
     // MF not found
     *manufacture_name = "Unknown";
@@ -56,6 +56,9 @@ const SubGhzProtocolDecoder subghz_protocol_linear_delta3_decoder = {
     .deserialize = subghz_protocol_decoder_linear_delta3_deserialize,
     .get_string = subghz_protocol_decoder_linear_delta3_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_linear_delta3_is_idle,
+    .get_wake_window = subghz_protocol_decoder_linear_delta3_get_wake_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_linear_delta3_encoder = {
@@ -225,6 +228,18 @@ void subghz_protocol_decoder_linear_delta3_reset(void* context) {
     instance->last_data = 0;
 }
 
+bool subghz_protocol_decoder_linear_delta3_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderLinearDelta3* instance = context;
+    return instance->decoder.parser_step == LinearDecoderStepReset;
+}
+
+void subghz_protocol_decoder_linear_delta3_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    furi_assert(window);
+    window->duration = subghz_protocol_linear_delta3_const.te_short * 70;
+    window->delta = subghz_protocol_linear_delta3_const.te_delta * 24;
+}
+
 void subghz_protocol_decoder_linear_delta3_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderLinearDelta3* instance = context;
@@ -1,6 +1,7 @@
 #include "nice_flo.h"
 #include "../blocks/const.h"
 #include "../blocks/decoder.h"
+#include "../blocks/pwm.h"
 #include "../blocks/encoder.h"
 #include "../blocks/generic.h"
 #include "../blocks/math.h"
@@ -14,6 +15,18 @@ static const SubGhzBlockConst subghz_protocol_nice_flo_const = {
     .min_count_bit_for_found = 12,
 };
 
+static const SubGhzBlockPwmConst subghz_protocol_nice_flo_pwm = {
+    .timing = &subghz_protocol_nice_flo_const,
+    .header_short = 36,
+    .header_delta = 36,
+    .start_short = 1,
+    .start_delta = 1,
+    .long_delta = 1,
+    .gap_short = 4,
+    .gap_delta = 0,
+    .flags = SubGhzBlockPwmFlagStartSkipLow,
+};
+
 struct SubGhzProtocolDecoderNiceFlo {
     SubGhzProtocolDecoderBase base;
 
@@ -28,13 +41,6 @@ struct SubGhzProtocolEncoderNiceFlo {
     SubGhzBlockGeneric generic;
 };
 
-typedef enum {
-    NiceFloDecoderStepReset = 0,
-    NiceFloDecoderStepFoundStartBit,
-    NiceFloDecoderStepSaveDuration,
-    NiceFloDecoderStepCheckDuration,
-} NiceFloDecoderStep;
-
 const SubGhzProtocolDecoder subghz_protocol_nice_flo_decoder = {
     .alloc = subghz_protocol_decoder_nice_flo_alloc,
     .free = subghz_protocol_decoder_nice_flo_free,
@@ -48,6 +54,11 @@ const SubGhzProtocolDecoder subghz_protocol_nice_flo_decoder = {
     .deserialize = subghz_protocol_decoder_nice_flo_deserialize,
     .get_string = subghz_protocol_decoder_nice_flo_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_nice_flo_is_idle,
+    .get_wake_window = subghz_protocol_decoder_nice_flo_get_wake_window,
+    .pwm = &subghz_protocol_nice_flo_pwm,
+    .feed_class = subghz_protocol_decoder_nice_flo_feed_class,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_nice_flo_encoder = {
@@ -203,81 +214,43 @@ void subghz_protocol_decoder_nice_flo_free(void* context) {
 void subghz_protocol_decoder_nice_flo_reset(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderNiceFlo* instance = context;
-    instance->decoder.parser_step = NiceFloDecoderStepReset;
+    instance->decoder.parser_step = SubGhzBlockPwmStepReset;
 }
 
-void subghz_protocol_decoder_nice_flo_feed(void* context, bool level, uint32_t duration) {
+bool subghz_protocol_decoder_nice_flo_is_idle(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderNiceFlo* instance = context;
+    return instance->decoder.parser_step == SubGhzBlockPwmStepReset;
+}
 
-    switch(instance->decoder.parser_step) {
-    case NiceFloDecoderStepReset:
-        if((!level) && (DURATION_DIFF(duration, subghz_protocol_nice_flo_const.te_short * 36) <
-                        subghz_protocol_nice_flo_const.te_delta * 36)) {
-            //Found header Nice Flo
-            instance->decoder.parser_step = NiceFloDecoderStepFoundStartBit;
-        }
-        break;
-    case NiceFloDecoderStepFoundStartBit:
-        if(!level) {
-            break;
-        } else if(
-            DURATION_DIFF(duration, subghz_protocol_nice_flo_const.te_short) <
-            subghz_protocol_nice_flo_const.te_delta) {
-            //Found start bit Nice Flo
-            instance->decoder.parser_step = NiceFloDecoderStepSaveDuration;
-            instance->decoder.decode_data = 0;
-            instance->decoder.decode_count_bit = 0;
-        } else {
-            instance->decoder.parser_step = NiceFloDecoderStepReset;
-        }
-        break;
-    case NiceFloDecoderStepSaveDuration:
-        if(!level) { //save interval
-            if(duration >= (subghz_protocol_nice_flo_const.te_short * 4)) {
-                instance->decoder.parser_step = NiceFloDecoderStepFoundStartBit;
-                if(instance->decoder.decode_count_bit >=
-                   subghz_protocol_nice_flo_const.min_count_bit_for_found) {
-                    instance->generic.serial = 0x0;
-                    instance->generic.btn = 0x0;
-
-                    instance->generic.data = instance->decoder.decode_data;
-                    instance->generic.data_count_bit = instance->decoder.decode_count_bit;
-                    if(instance->base.callback)
-                        instance->base.callback(&instance->base, instance->base.context);
-                }
-                break;
-            }
-            instance->decoder.te_last = duration;
-            instance->decoder.parser_step = NiceFloDecoderStepCheckDuration;
-        } else {
-            instance->decoder.parser_step = NiceFloDecoderStepReset;
-        }
-        break;
-    case NiceFloDecoderStepCheckDuration:
-        if(level) {
-            if((DURATION_DIFF(instance->decoder.te_last, subghz_protocol_nice_flo_const.te_short) <
-                subghz_protocol_nice_flo_const.te_delta) &&
-               (DURATION_DIFF(duration, subghz_protocol_nice_flo_const.te_long) <
-                subghz_protocol_nice_flo_const.te_delta)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 0);
-                instance->decoder.parser_step = NiceFloDecoderStepSaveDuration;
-            } else if(
-                (DURATION_DIFF(instance->decoder.te_last, subghz_protocol_nice_flo_const.te_long) <
-                 subghz_protocol_nice_flo_const.te_delta) &&
-                (DURATION_DIFF(duration, subghz_protocol_nice_flo_const.te_short) <
-                 subghz_protocol_nice_flo_const.te_delta)) {
-                subghz_protocol_blocks_add_bit(&instance->decoder, 1);
-                instance->decoder.parser_step = NiceFloDecoderStepSaveDuration;
-            } else
-                instance->decoder.parser_step = NiceFloDecoderStepReset;
-        } else {
-            instance->decoder.parser_step = NiceFloDecoderStepReset;
-        }
-        break;
+void subghz_protocol_decoder_nice_flo_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    subghz_block_pwm_get_wake_window(&subghz_protocol_nice_flo_pwm, window);
+}
+
+void subghz_protocol_decoder_nice_flo_feed_class(void* context, bool level, uint8_t pulse_class) {
+    furi_assert(context);
+    SubGhzProtocolDecoderNiceFlo* instance = context;
+
+    if(subghz_block_pwm_feed_class(
+           &subghz_protocol_nice_flo_pwm, &instance->decoder, level, pulse_class) &&
+       (instance->decoder.decode_count_bit >=
+        subghz_protocol_nice_flo_const.min_count_bit_for_found)) {
+        instance->generic.serial = 0x0;
+        instance->generic.btn = 0x0;
+
+        instance->generic.data = instance->decoder.decode_data;
+        instance->generic.data_count_bit = instance->decoder.decode_count_bit;
+
+        if(instance->base.callback)
+            instance->base.callback(&instance->base, instance->base.context);
     }
 }
 
+void subghz_protocol_decoder_nice_flo_feed(void* context, bool level, uint32_t duration) {
+    subghz_protocol_decoder_nice_flo_feed_class(
+        context, level, subghz_block_pwm_get_class(&subghz_protocol_nice_flo_pwm, duration));
+}
+
 uint32_t subghz_protocol_decoder_nice_flo_get_hash_data(void* context) {
     furi_assert(context);
     SubGhzProtocolDecoderNiceFlo* instance = context;
@@ -66,6 +66,9 @@ const SubGhzProtocolDecoder subghz_protocol_princeton_decoder = {
     .deserialize = subghz_protocol_decoder_princeton_deserialize,
     .get_string = subghz_protocol_decoder_princeton_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_princeton_is_idle,
+    .get_wake_window = subghz_protocol_decoder_princeton_get_wake_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_princeton_encoder = {
@@ -442,6 +445,18 @@ void subghz_protocol_decoder_princeton_reset(void* context) {
     instance->last_data = 0;
 }
 
+bool subghz_protocol_decoder_princeton_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderPrinceton* instance = context;
+    return instance->decoder.parser_step == PrincetonDecoderStepReset;
+}
+
+void subghz_protocol_decoder_princeton_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    furi_assert(window);
+    window->duration = subghz_protocol_princeton_const.te_short * 36;
+    window->delta = subghz_protocol_princeton_const.te_delta * 36;
+}
+
 void subghz_protocol_decoder_princeton_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderPrinceton* instance = context;
@@ -1,6 +1,7 @@
 #include "raw.h"
 #include <lib/flipper_format/flipper_format.h>
 #include "../subghz_file_encoder_worker.h"
+#include "../subghz_raw_binary.h"
 
 #include "../blocks/const.h"
 #include "../blocks/generic.h"
@@ -31,6 +32,8 @@ struct SubGhzProtocolDecoderRAW {
     size_t sample_write;
     bool last_level;
     bool pause;
+    bool binary_format;
+    SubGhzRawBinaryWriter* binary_writer;
 };
 
 struct SubGhzProtocolEncoderRAW {
@@ -158,6 +161,18 @@ bool subghz_protocol_raw_save_to_file_init(
             break;
         }
 
+        if(instance->binary_format) {
+            uint32_t version = SUBGHZ_RAW_BINARY_VERSION;
+            if(!flipper_format_write_uint32(
+                   instance->flipper_file, SUBGHZ_RAW_BINARY_KEY, &version, 1)) {
+                FURI_LOG_E(TAG, "Unable to add " SUBGHZ_RAW_BINARY_KEY);
+                break;
+            }
+            instance->binary_writer = subghz_raw_binary_writer_alloc(
+                flipper_format_get_raw_stream(instance->flipper_file), true);
+            if(!instance->binary_writer) break;
+        }
+
         instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
         instance->file_is_open = RAWFileIsOpenWrite;
         instance->sample_write = 0;
@@ -175,7 +190,16 @@ static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* ins
     furi_assert(instance);
 
     bool is_write = false;
-    if(instance->file_is_open == RAWFileIsOpenWrite) {
+    if(instance->file_is_open == RAWFileIsOpenWrite && instance->binary_writer) {
+        if(!subghz_raw_binary_writer_add_block(
+               instance->binary_writer, instance->upload_raw, instance->ind_write)) {
+            FURI_LOG_E(TAG, "Unable to add RAW block");
+        } else {
+            instance->sample_write += instance->ind_write;
+            instance->ind_write = 0;
+            is_write = true;
+        }
+    } else if(instance->file_is_open == RAWFileIsOpenWrite) {
         if(!flipper_format_write_int32(
                instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write)) {
             FURI_LOG_E(TAG, "Unable to add RAW_Data");
@@ -193,6 +217,11 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
 
     if(instance->file_is_open == RAWFileIsOpenWrite && instance->ind_write)
         subghz_protocol_raw_save_to_file_write(instance);
+    if(instance->binary_writer) {
+        subghz_raw_binary_writer_finish(instance->binary_writer);
+        subghz_raw_binary_writer_free(instance->binary_writer);
+        instance->binary_writer = NULL;
+    }
     if(instance->file_is_open != RAWFileIsOpenClose) {
         free(instance->upload_raw);
         instance->upload_raw = NULL;
@@ -212,6 +241,13 @@ void subghz_protocol_raw_save_to_file_pause(SubGhzProtocolDecoderRAW* instance,
     }
 }
 
+void subghz_protocol_raw_save_to_file_set_binary(
+    SubGhzProtocolDecoderRAW* instance,
+    bool binary_format) {
+    furi_check(instance);
+    instance->binary_format = binary_format;
+}
+
 size_t subghz_protocol_raw_get_sample_write(SubGhzProtocolDecoderRAW* instance) {
     furi_check(instance);
     return instance->sample_write + instance->ind_write;
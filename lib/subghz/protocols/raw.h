@@ -111,6 +111,16 @@ void subghz_protocol_encoder_raw_stop(void* context);
  */
 void subghz_protocol_raw_save_to_file_pause(SubGhzProtocolDecoderRAW* instance, bool pause);
 
+/**
+ * Select the compact binary container for the next recording.
+ * Must be called before subghz_protocol_raw_save_to_file_init.
+ * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param binary_format true - binary container, false - RAW_Data text lines
+ */
+void subghz_protocol_raw_save_to_file_set_binary(
+    SubGhzProtocolDecoderRAW* instance,
+    bool binary_format);
+
 /**
  * Set callback on completion of file transfer.
  * @param instance Pointer to a SubGhzProtocolEncoderRAW instance
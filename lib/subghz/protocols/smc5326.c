@@ -74,6 +74,9 @@ const SubGhzProtocolDecoder subghz_protocol_smc5326_decoder = {
     .deserialize = subghz_protocol_decoder_smc5326_deserialize,
     .get_string = subghz_protocol_decoder_smc5326_get_string,
     .get_string_brief = NULL,
+
+    .is_idle = subghz_protocol_decoder_smc5326_is_idle,
+    .get_wake_window = subghz_protocol_decoder_smc5326_get_wake_window,
 };
 
 const SubGhzProtocolEncoder subghz_protocol_smc5326_encoder = {
@@ -238,6 +241,18 @@ void subghz_protocol_decoder_smc5326_reset(void* context) {
     instance->last_data = 0;
 }
 
+bool subghz_protocol_decoder_smc5326_is_idle(void* context) {
+    furi_assert(context);
+    SubGhzProtocolDecoderSMC5326* instance = context;
+    return instance->decoder.parser_step == SMC5326DecoderStepReset;
+}
+
+void subghz_protocol_decoder_smc5326_get_wake_window(SubGhzDecoderWakeWindow* window) {
+    furi_assert(window);
+    window->duration = subghz_protocol_smc5326_const.te_short * 24;
+    window->delta = subghz_protocol_smc5326_const.te_delta * 12;
+}
+
 void subghz_protocol_decoder_smc5326_feed(void* context, bool level, uint32_t duration) {
     furi_assert(context);
     SubGhzProtocolDecoderSMC5326* instance = context;
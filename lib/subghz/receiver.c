@@ -1,11 +1,21 @@
 #include "receiver.h"
 
 #include "registry.h"
+#include "blocks/pwm.h"
 
 #include <m-array.h>
 
+/* Durations are grouped into quasi-logarithmic buckets: 4 buckets per power of two.
+ * Anything longer than 2^SUBGHZ_RECEIVER_BUCKET_MSB_MAX us lands in the last octave.
+ */
+#define SUBGHZ_RECEIVER_BUCKET_MSB_MAX 23
+#define SUBGHZ_RECEIVER_BUCKET_COUNT   ((SUBGHZ_RECEIVER_BUCKET_MSB_MAX + 1) * 4)
+#define SUBGHZ_RECEIVER_MASK_BITS      32
+
 typedef struct {
     SubGhzProtocolEncoderBase* base;
+    uint32_t feed_count;
+    size_t pwm_index; // Column in pwm_table, slots in pwm_mask only
 } SubGhzReceiverSlot;
 
 ARRAY_DEF(SubGhzReceiverSlotArray, SubGhzReceiverSlot, M_POD_OPLIST);
@@ -16,10 +26,110 @@ struct SubGhzReceiver {
     SubGhzProtocolFlag filter;
     SubGhzProtocolFilter ignore_filter;
 
+    // Slot bitmasks, mask_words words each
+    size_t mask_words;
+    uint32_t* enabled_mask; // Slots allowed by filter and ignore_filter
+    uint32_t* active_mask; // Slots that must see every pulse
+    uint32_t* wake_table; // Per duration bucket: idle slots that this pulse can wake
+    uint32_t* pwm_mask; // Slots fed with pulse classes from pwm_table
+    uint32_t pulse_count;
+    SubGhzBlockPwmTable* pwm_table; // Pulse classes of all PWM frame decoders
+
     SubGhzReceiverCallback callback;
     void* context;
 };
 
+static inline size_t subghz_receiver_get_bucket(uint32_t duration) {
+    if(duration < 4) return duration;
+    uint32_t msb = 31 - __builtin_clz(duration);
+    if(msb > SUBGHZ_RECEIVER_BUCKET_MSB_MAX) return SUBGHZ_RECEIVER_BUCKET_COUNT - 1;
+    return (msb << 2) | ((duration >> (msb - 2)) & 0x3);
+}
+
+static inline bool subghz_receiver_slot_is_pwm(SubGhzReceiverSlot* slot) {
+    const SubGhzProtocolDecoder* decoder = slot->base->protocol->decoder;
+    return decoder->pwm && decoder->feed_class;
+}
+
+static inline bool subghz_receiver_slot_is_idle(SubGhzReceiverSlot* slot) {
+    const SubGhzProtocolDecoder* decoder = slot->base->protocol->decoder;
+    return decoder->is_idle && decoder->get_wake_window && decoder->is_idle(slot->base);
+}
+
+static void subghz_receiver_update_enabled_mask(SubGhzReceiver* instance) {
+    memset(instance->enabled_mask, 0, instance->mask_words * sizeof(uint32_t));
+
+    size_t index = 0;
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if((slot->base->protocol->flag & instance->filter) != 0 &&
+               (slot->base->protocol->filter & instance->ignore_filter) == 0) {
+                instance->enabled_mask[index / SUBGHZ_RECEIVER_MASK_BITS] |=
+                    1UL << (index % SUBGHZ_RECEIVER_MASK_BITS);
+            }
+            index++;
+        }
+}
+
+static void subghz_receiver_update_active_mask(SubGhzReceiver* instance) {
+    memset(instance->active_mask, 0, instance->mask_words * sizeof(uint32_t));
+
+    size_t index = 0;
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if(!subghz_receiver_slot_is_idle(slot)) {
+                instance->active_mask[index / SUBGHZ_RECEIVER_MASK_BITS] |=
+                    1UL << (index % SUBGHZ_RECEIVER_MASK_BITS);
+            }
+            index++;
+        }
+}
+
+static void subghz_receiver_build_wake_table(SubGhzReceiver* instance) {
+    size_t index = 0;
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            const SubGhzProtocolDecoder* decoder = slot->base->protocol->decoder;
+            if(decoder->is_idle && decoder->get_wake_window) {
+                SubGhzDecoderWakeWindow window;
+                decoder->get_wake_window(&window);
+                uint32_t duration_min =
+                    (window.duration > window.delta) ? window.duration - window.delta : 0;
+                uint32_t duration_max = window.duration + window.delta;
+
+                // Buckets are monotonic, so every bucket in between overlaps the window
+                size_t bucket_last = subghz_receiver_get_bucket(duration_max);
+                for(size_t bucket = subghz_receiver_get_bucket(duration_min);
+                    bucket <= bucket_last;
+                    bucket++) {
+                    instance->wake_table[bucket * instance->mask_words +
+                                         index / SUBGHZ_RECEIVER_MASK_BITS] |=
+                        1UL << (index % SUBGHZ_RECEIVER_MASK_BITS);
+                }
+            }
+            index++;
+        }
+}
+
+static void subghz_receiver_build_pwm_table(SubGhzReceiver* instance) {
+    const SubGhzBlockPwmConst** pwm =
+        malloc(SubGhzReceiverSlotArray_size(instance->slots) * sizeof(SubGhzBlockPwmConst*));
+    size_t pwm_count = 0;
+    size_t index = 0;
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            if(subghz_receiver_slot_is_pwm(slot)) {
+                slot->pwm_index = pwm_count;
+                instance->pwm_mask[index / SUBGHZ_RECEIVER_MASK_BITS] |=
+                    1UL << (index % SUBGHZ_RECEIVER_MASK_BITS);
+                pwm[pwm_count++] = slot->base->protocol->decoder->pwm;
+            }
+            index++;
+        }
+    instance->pwm_table = subghz_block_pwm_table_alloc(pwm, pwm_count);
+    free(pwm);
+}
+
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
     SubGhzReceiver* instance = malloc(sizeof(SubGhzReceiver));
     SubGhzReceiverSlotArray_init(instance->slots);
@@ -33,9 +143,28 @@ SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
         if(protocol->decoder && protocol->decoder->alloc) {
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
             slot->base = protocol->decoder->alloc(environment);
+            slot->feed_count = 0;
+            slot->pwm_index = 0;
         }
     }
 
+    size_t slot_count = SubGhzReceiverSlotArray_size(instance->slots);
+    instance->mask_words =
+        (slot_count + SUBGHZ_RECEIVER_MASK_BITS - 1) / SUBGHZ_RECEIVER_MASK_BITS;
+    if(!instance->mask_words) instance->mask_words = 1;
+    instance->enabled_mask = calloc(instance->mask_words, sizeof(uint32_t));
+    instance->active_mask = calloc(instance->mask_words, sizeof(uint32_t));
+    instance->wake_table =
+        calloc(SUBGHZ_RECEIVER_BUCKET_COUNT * instance->mask_words, sizeof(uint32_t));
+    instance->pwm_mask = calloc(instance->mask_words, sizeof(uint32_t));
+    instance->pulse_count = 0;
+
+    instance->filter = 0;
+    instance->ignore_filter = 0;
+    subghz_receiver_build_wake_table(instance);
+    subghz_receiver_build_pwm_table(instance);
+    subghz_receiver_update_active_mask(instance);
+
     instance->callback = NULL;
     instance->context = NULL;
     return instance;
@@ -55,20 +184,80 @@ void subghz_receiver_free(SubGhzReceiver* instance) {
         }
     SubGhzReceiverSlotArray_clear(instance->slots);
 
+    subghz_block_pwm_table_free(instance->pwm_table);
+    free(instance->pwm_mask);
+    free(instance->wake_table);
+    free(instance->active_mask);
+    free(instance->enabled_mask);
     free(instance);
 }
 
+static inline void
+    subghz_receiver_dispatch(SubGhzReceiver* instance, bool level, uint32_t duration) {
+    instance->pulse_count++;
+    const uint32_t* wake_mask =
+        &instance->wake_table[subghz_receiver_get_bucket(duration) * instance->mask_words];
+    const uint8_t* pwm_classes = NULL;
+
+    // Only slots that are busy decoding, or that this pulse can wake up, are fed.
+    // Slots are fed in order, a packet callback may reset the receiver.
+    for(size_t word = 0; word < instance->mask_words; word++) {
+        uint32_t pending = (instance->active_mask[word] | wake_mask[word]) &
+                           instance->enabled_mask[word];
+        const uint32_t pwm_mask = instance->pwm_mask[word];
+        while(pending) {
+            uint32_t bit = __builtin_ctz(pending);
+            pending &= pending - 1;
+
+            SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_get(
+                instance->slots, word * SUBGHZ_RECEIVER_MASK_BITS + bit);
+            const SubGhzProtocolDecoder* decoder = slot->base->protocol->decoder;
+            if(pwm_mask & (1UL << bit)) {
+                // One lookup classifies the pulse for every PWM frame decoder
+                if(!pwm_classes) {
+                    pwm_classes =
+                        subghz_block_pwm_table_get_classes(instance->pwm_table, duration);
+                }
+                decoder->feed_class(slot->base, level, pwm_classes[slot->pwm_index]);
+            } else {
+                decoder->feed(slot->base, level, duration);
+            }
+            slot->feed_count++;
+
+            if(subghz_receiver_slot_is_idle(slot)) {
+                instance->active_mask[word] &= ~(1UL << bit);
+            } else {
+                instance->active_mask[word] |= 1UL << bit;
+            }
+        }
+    }
+}
+
 void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration) {
     furi_check(instance);
     furi_check(instance->slots);
 
-    for
-        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
-            if((slot->base->protocol->flag & instance->filter) != 0 &&
-               (slot->base->protocol->filter & instance->ignore_filter) == 0) {
-                slot->base->protocol->decoder->feed(slot->base, level, duration);
-            }
+    subghz_receiver_dispatch(instance, level, duration);
+}
+
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* level_duration,
+    size_t count) {
+    furi_check(instance);
+    furi_check(instance->slots);
+    furi_check(level_duration || !count);
+
+    for(size_t i = 0; i < count; i++) {
+        if(level_duration_is_reset(level_duration[i])) {
+            subghz_receiver_reset(instance);
+        } else {
+            subghz_receiver_dispatch(
+                instance,
+                level_duration_get_level(level_duration[i]),
+                level_duration_get_duration(level_duration[i]));
         }
+    }
 }
 
 void subghz_receiver_reset(SubGhzReceiver* instance) {
@@ -79,6 +268,7 @@ void subghz_receiver_reset(SubGhzReceiver* instance) {
         M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
             slot->base->protocol->decoder->reset(slot->base);
         }
+    subghz_receiver_update_active_mask(instance);
 }
 
 static void subghz_receiver_rx_callback(SubGhzProtocolDecoderBase* decoder_base, void* context) {
@@ -107,6 +297,7 @@ void subghz_receiver_set_rx_callback(
 void subghz_receiver_set_filter(SubGhzReceiver* instance, SubGhzProtocolFlag filter) {
     furi_check(instance);
     instance->filter = filter;
+    subghz_receiver_update_enabled_mask(instance);
 }
 
 void subghz_receiver_set_ignore_filter(
@@ -114,6 +305,7 @@ void subghz_receiver_set_ignore_filter(
     SubGhzProtocolFilter ignore_filter) {
     furi_assert(instance);
     instance->ignore_filter = ignore_filter;
+    subghz_receiver_update_enabled_mask(instance);
 }
 
 SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
@@ -132,3 +324,36 @@ SubGhzProtocolDecoderBase* subghz_receiver_search_decoder_base_by_name(
         }
     return result;
 }
+
+size_t subghz_receiver_get_decoder_count(SubGhzReceiver* instance) {
+    furi_check(instance);
+    return SubGhzReceiverSlotArray_size(instance->slots);
+}
+
+SubGhzProtocolDecoderBase*
+    subghz_receiver_get_decoder_base_by_index(SubGhzReceiver* instance, size_t index) {
+    furi_check(instance);
+    furi_check(index < SubGhzReceiverSlotArray_size(instance->slots));
+    return (SubGhzProtocolDecoderBase*)SubGhzReceiverSlotArray_get(instance->slots, index)->base;
+}
+
+uint32_t subghz_receiver_get_decoder_feed_count(SubGhzReceiver* instance, size_t index) {
+    furi_check(instance);
+    furi_check(index < SubGhzReceiverSlotArray_size(instance->slots));
+    return SubGhzReceiverSlotArray_get(instance->slots, index)->feed_count;
+}
+
+uint32_t subghz_receiver_get_pulse_count(SubGhzReceiver* instance) {
+    furi_check(instance);
+    return instance->pulse_count;
+}
+
+void subghz_receiver_reset_stats(SubGhzReceiver* instance) {
+    furi_check(instance);
+
+    instance->pulse_count = 0;
+    for
+        M_EACH(slot, instance->slots, SubGhzReceiverSlotArray_t) {
+            slot->feed_count = 0;
+        }
+}
@@ -35,6 +35,19 @@ void subghz_receiver_free(SubGhzReceiver* instance);
  */
 void subghz_receiver_decode(SubGhzReceiver* instance, bool level, uint32_t duration);
 
+/**
+ * Parse a block of levels and durations received from the air.
+ * Equivalent to calling subghz_receiver_decode for every element,
+ * a reset element resets the receiver.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param level_duration Array of LevelDuration
+ * @param count Number of elements in the array
+ */
+void subghz_receiver_decode_batch(
+    SubGhzReceiver* instance,
+    const LevelDuration* level_duration,
+    size_t count);
+
 /**
  * Reset decoder SubGhzReceiver.
  * @param instance Pointer to a SubGhzReceiver instance
@@ -77,6 +90,43 @@ void subghz_receiver_set_ignore_filter(
 SubGhzProtocolDecoderBase*
     subghz_receiver_search_decoder_base_by_name(SubGhzReceiver* instance, const char* decoder_name);
 
+/**
+ * Get the number of decoders allocated by the receiver.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @return Decoder count
+ */
+size_t subghz_receiver_get_decoder_count(SubGhzReceiver* instance);
+
+/**
+ * Get a decoder by its index.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param index Decoder index, less than subghz_receiver_get_decoder_count
+ * @return SubGhzProtocolDecoderBase* pointer to a SubGhzProtocolDecoderBase instance
+ */
+SubGhzProtocolDecoderBase*
+    subghz_receiver_get_decoder_base_by_index(SubGhzReceiver* instance, size_t index);
+
+/**
+ * Get how many pulses were dispatched to a decoder since the last stats reset.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @param index Decoder index, less than subghz_receiver_get_decoder_count
+ * @return Number of pulses fed to the decoder
+ */
+uint32_t subghz_receiver_get_decoder_feed_count(SubGhzReceiver* instance, size_t index);
+
+/**
+ * Get how many pulses were passed to subghz_receiver_decode since the last stats reset.
+ * @param instance Pointer to a SubGhzReceiver instance
+ * @return Number of pulses
+ */
+uint32_t subghz_receiver_get_pulse_count(SubGhzReceiver* instance);
+
+/**
+ * Reset pulse and per-decoder feed counters.
+ * @param instance Pointer to a SubGhzReceiver instance
+ */
+void subghz_receiver_reset_stats(SubGhzReceiver* instance);
+
 #ifdef __cplusplus
 }
 #endif
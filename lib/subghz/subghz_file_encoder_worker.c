@@ -5,23 +5,42 @@
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/toolbox/strint.h>
+#include "subghz_raw_binary.h"
 
 #define TAG "SubGhzFileEncoderWorker"
 
-#define SUBGHZ_FILE_ENCODER_LOAD 512
+#define SUBGHZ_FILE_ENCODER_BLOCK_SIZE  256
+#define SUBGHZ_FILE_ENCODER_BLOCK_COUNT 8
+// Keep filling the current block while the consumer has this many blocks queued
+#define SUBGHZ_FILE_ENCODER_BLOCK_LOW 2
+
+typedef struct {
+    int32_t data[SUBGHZ_FILE_ENCODER_BLOCK_SIZE];
+    size_t size;
+} SubGhzFileEncoderBlock;
 
 struct SubGhzFileEncoderWorker {
     FuriThread* thread;
-    FuriStreamBuffer* stream;
+
+    // Single producer, single consumer ring of blocks.
+    // The worker thread owns blocks in [block_head, block_tail + COUNT),
+    // the consumer owns blocks in [block_tail, block_head).
+    SubGhzFileEncoderBlock* blocks;
+    volatile uint32_t block_head;
+    volatile uint32_t block_tail;
+    size_t read_position;
+    bool underrun; // Consumer ran dry and has not got data since
 
     Storage* storage;
     FlipperFormat* flipper_format;
 
     volatile bool worker_running;
     volatile bool worker_stopping;
-    bool is_storage_slow;
+    SubGhzFileEncoderWorkerStats stats;
     FuriString* str_data;
     FuriString* file_path;
+    SubGhzRawBinaryReader* binary_reader;
+    int32_t* binary_block;
     const SubGhzDevice* device;
 
     SubGhzFileEncoderWorkerCallbackEnd callback_end;
@@ -38,11 +57,57 @@ void subghz_file_encoder_worker_callback_end(
     instance->context_end = context_end;
 }
 
+static inline uint32_t subghz_file_encoder_worker_blocks_queued(SubGhzFileEncoderWorker* instance) {
+    return instance->block_head - instance->block_tail;
+}
+
+/** Hand the block being filled over to the consumer, wait for a free one
+ *
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @return false if the worker was stopped while waiting
+ */
+static bool subghz_file_encoder_worker_publish(SubGhzFileEncoderWorker* instance) {
+    SubGhzFileEncoderBlock* block =
+        &instance->blocks[instance->block_head % SUBGHZ_FILE_ENCODER_BLOCK_COUNT];
+    if(!block->size) return true;
+
+    // Block content must be visible before the consumer sees the new head
+    __DMB();
+    instance->block_head++;
+    instance->stats.block_count++;
+
+    while(subghz_file_encoder_worker_blocks_queued(instance) == SUBGHZ_FILE_ENCODER_BLOCK_COUNT) {
+        if(!instance->worker_running) return false;
+        furi_delay_ms(1);
+    }
+
+    instance->blocks[instance->block_head % SUBGHZ_FILE_ENCODER_BLOCK_COUNT].size = 0;
+    return true;
+}
+
 void subghz_file_encoder_worker_add_level_duration(
     SubGhzFileEncoderWorker* instance,
     int32_t duration) {
-    size_t ret = furi_stream_buffer_send(instance->stream, &duration, sizeof(int32_t), 100);
-    if(sizeof(int32_t) != ret) FURI_LOG_E(TAG, "Invalid add duration in the stream");
+    // Ring is full only if the worker was stopped while waiting for a free block
+    if(subghz_file_encoder_worker_blocks_queued(instance) == SUBGHZ_FILE_ENCODER_BLOCK_COUNT) {
+        return;
+    }
+    SubGhzFileEncoderBlock* block =
+        &instance->blocks[instance->block_head % SUBGHZ_FILE_ENCODER_BLOCK_COUNT];
+    block->data[block->size++] = duration;
+    if(block->size == SUBGHZ_FILE_ENCODER_BLOCK_SIZE) {
+        if(!subghz_file_encoder_worker_publish(instance)) {
+            FURI_LOG_E(TAG, "Invalid add duration in the stream");
+        }
+    }
+}
+
+static inline int32_t subghz_file_encoder_worker_clamp(int32_t duration) {
+    if((duration < -1000000) || (duration > 1000000)) {
+        //FURI_LOG_I("PARSE", "Number overflow - %d", duration);
+        return (duration > 0) ? 100 : -100;
+    }
+    return duration;
 }
 
 bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
@@ -59,16 +124,8 @@ bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, co
         // Parse next element
         int32_t duration;
         while(strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
-            if((duration < -1000000) || (duration > 1000000)) {
-                if(duration > 0) {
-                    subghz_file_encoder_worker_add_level_duration(instance, (int32_t)100);
-                } else {
-                    subghz_file_encoder_worker_add_level_duration(instance, (int32_t)-100);
-                }
-                //FURI_LOG_I("PARSE", "Number overflow - %d", duration);
-            } else {
-                subghz_file_encoder_worker_add_level_duration(instance, duration);
-            }
+            subghz_file_encoder_worker_add_level_duration(
+                instance, subghz_file_encoder_worker_clamp(duration));
             if(*str == ',') str++; // could also be `\0`
         }
 
@@ -78,6 +135,45 @@ bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, co
     return res;
 }
 
+static bool subghz_file_encoder_worker_binary_parse(SubGhzFileEncoderWorker* instance) {
+    size_t count =
+        subghz_raw_binary_reader_read_block(instance->binary_reader, instance->binary_block);
+    if(!count) return false;
+
+    for(size_t i = 0; i < count; i++) {
+        subghz_file_encoder_worker_add_level_duration(
+            instance, subghz_file_encoder_worker_clamp(instance->binary_block[i]));
+    }
+
+    return true;
+}
+
+/** Read the next chunk of the file into the current block
+ *
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @param stream Raw stream of the opened file
+ * @return false at the end of data
+ */
+static bool subghz_file_encoder_worker_load(SubGhzFileEncoderWorker* instance, Stream* stream) {
+    uint32_t start = DWT->CYCCNT;
+    bool res = false;
+
+    if(instance->binary_reader) {
+        res = subghz_file_encoder_worker_binary_parse(instance);
+    } else if(stream_read_line(stream, instance->str_data)) {
+        furi_string_trim(instance->str_data);
+        res = subghz_file_encoder_worker_data_parse(
+            instance, furi_string_get_cstr(instance->str_data));
+    }
+
+    uint32_t time_us = (DWT->CYCCNT - start) / furi_hal_cortex_instructions_per_microsecond();
+    instance->stats.read_count++;
+    instance->stats.read_time_total += time_us;
+    if(time_us > instance->stats.read_time_max) instance->stats.read_time_max = time_us;
+
+    return res;
+}
+
 void subghz_file_encoder_worker_get_text_progress(
     SubGhzFileEncoderWorker* instance,
     FuriString* output) {
@@ -85,17 +181,33 @@ void subghz_file_encoder_worker_get_text_progress(
     Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
     size_t total_size = stream_size(stream);
     size_t current_offset = stream_tell(stream);
-    size_t buffer_avail = furi_stream_buffer_bytes_available(instance->stream);
+    size_t buffer_avail = 0;
+    for(uint32_t i = instance->block_tail; i != instance->block_head; i++) {
+        buffer_avail += instance->blocks[i % SUBGHZ_FILE_ENCODER_BLOCK_COUNT].size;
+    }
+    buffer_avail = (buffer_avail - MIN(buffer_avail, instance->read_position)) * sizeof(int32_t);
+    buffer_avail = MIN(buffer_avail, current_offset);
 
-    furi_string_printf(output, "%03u%%", 100 * (current_offset - buffer_avail) / total_size);
+    furi_string_printf(
+        output, "%03u%%", total_size ? 100 * (current_offset - buffer_avail) / total_size : 0);
 }
 
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
     furi_assert(context);
     SubGhzFileEncoderWorker* instance = context;
-    int32_t duration;
-    int ret = furi_stream_buffer_receive(instance->stream, &duration, sizeof(int32_t), 0);
-    if(ret == sizeof(int32_t)) {
+    uint32_t tail = instance->block_tail;
+    if(tail != instance->block_head) {
+        SubGhzFileEncoderBlock* block = &instance->blocks[tail % SUBGHZ_FILE_ENCODER_BLOCK_COUNT];
+        int32_t duration = block->data[instance->read_position++];
+        if(instance->read_position == block->size) {
+            // Return the block to the worker
+            instance->read_position = 0;
+            __DMB();
+            instance->block_tail = tail + 1;
+        }
+        instance->stats.pulse_count++;
+        instance->underrun = false;
+
         LevelDuration level_duration = {.level = LEVEL_DURATION_RESET};
         if(duration < 0) {
             level_duration = level_duration_make(false, -duration);
@@ -108,7 +220,12 @@ LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
         }
         return level_duration;
     } else {
-        instance->is_storage_slow = true;
+        // Running dry after the first pulse means the storage did not keep up,
+        // counted once per dry spell as the consumer keeps asking until data comes
+        if(!instance->underrun && instance->stats.pulse_count && !instance->worker_stopping) {
+            instance->stats.underrun_count++;
+            instance->underrun = true;
+        }
         return level_duration_wait();
     }
 }
@@ -122,7 +239,6 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     SubGhzFileEncoderWorker* instance = context;
     FURI_LOG_I(TAG, "Worker start");
     bool res = false;
-    instance->is_storage_slow = false;
     Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
     do {
         if(!flipper_format_file_open_existing(
@@ -140,33 +256,45 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
 
         //skip the end of the previous line "\n"
         stream_seek(stream, 1, StreamOffsetFromCurrent);
+
+        // Binary recordings have a marker line in place of the first RAW_Data line
+        size_t data_start = stream_tell(stream);
+        if(stream_read_line(stream, instance->str_data) &&
+           subghz_raw_binary_is_marker(furi_string_get_cstr(instance->str_data))) {
+            instance->binary_reader = subghz_raw_binary_reader_alloc(stream);
+            if(!instance->binary_reader) break;
+        } else {
+            stream_seek(stream, data_start, StreamOffsetFromStart);
+        }
         res = true;
         instance->worker_stopping = false;
         FURI_LOG_I(TAG, "Start transmission");
     } while(0);
 
     while(res && instance->worker_running) {
-        size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
-        if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
-                furi_string_trim(instance->str_data);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance, furi_string_get_cstr(instance->str_data))) {
-                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                    break;
-                }
-            } else {
-                subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                break;
-            }
-        } else {
-            furi_delay_ms(1);
+        if(!subghz_file_encoder_worker_load(instance, stream)) {
+            subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
+            subghz_file_encoder_worker_publish(instance);
+            break;
+        }
+        // Publish partial blocks only when the consumer is about to run dry
+        if(subghz_file_encoder_worker_blocks_queued(instance) < SUBGHZ_FILE_ENCODER_BLOCK_LOW) {
+            if(!subghz_file_encoder_worker_publish(instance)) break;
         }
     }
     //waiting for the end of the transfer
-    if(instance->is_storage_slow) {
-        FURI_LOG_E(TAG, "Storage is slow");
+    if(instance->stats.underrun_count) {
+        FURI_LOG_E(TAG, "Storage is slow, underruns: %lu", instance->stats.underrun_count);
     }
+    FURI_LOG_D(
+        TAG,
+        "Blocks: %lu, reads: %lu, read time avg: %luus, max: %luus",
+        instance->stats.block_count,
+        instance->stats.read_count,
+        instance->stats.read_count ?
+            instance->stats.read_time_total / instance->stats.read_count :
+            0,
+        instance->stats.read_time_max);
 
     FURI_LOG_I(TAG, "End read file");
     while(instance->device && !subghz_devices_is_async_complete_tx(instance->device) &&
@@ -181,6 +309,10 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
         }
         furi_delay_ms(50);
     }
+    if(instance->binary_reader) {
+        subghz_raw_binary_reader_free(instance->binary_reader);
+        instance->binary_reader = NULL;
+    }
     flipper_format_file_close(instance->flipper_format);
 
     FURI_LOG_I(TAG, "Worker stop");
@@ -192,13 +324,14 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
 
     instance->thread =
         furi_thread_alloc_ex("SubGhzFEWorker", 2048, subghz_file_encoder_worker_thread, instance);
-    instance->stream = furi_stream_buffer_alloc(sizeof(int32_t) * 2048, sizeof(int32_t));
+    instance->blocks = malloc(sizeof(SubGhzFileEncoderBlock) * SUBGHZ_FILE_ENCODER_BLOCK_COUNT);
 
     instance->storage = furi_record_open(RECORD_STORAGE);
     instance->flipper_format = flipper_format_file_alloc(instance->storage);
 
     instance->str_data = furi_string_alloc();
     instance->file_path = furi_string_alloc();
+    instance->binary_block = malloc(SUBGHZ_RAW_BINARY_BLOCK_SIZE * sizeof(int32_t));
     instance->worker_stopping = true;
 
     return instance;
@@ -207,11 +340,12 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
 void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
     furi_assert(instance);
 
-    furi_stream_buffer_free(instance->stream);
+    free(instance->blocks);
     furi_thread_free(instance->thread);
 
     furi_string_free(instance->str_data);
     furi_string_free(instance->file_path);
+    free(instance->binary_block);
 
     flipper_format_free(instance->flipper_format);
     furi_record_close(RECORD_STORAGE);
@@ -226,7 +360,12 @@ bool subghz_file_encoder_worker_start(
     furi_assert(instance);
     furi_assert(!instance->worker_running);
 
-    furi_stream_buffer_reset(instance->stream);
+    instance->block_head = 0;
+    instance->block_tail = 0;
+    instance->read_position = 0;
+    instance->underrun = false;
+    instance->blocks[0].size = 0;
+    memset(&instance->stats, 0, sizeof(SubGhzFileEncoderWorkerStats));
     furi_string_set(instance->file_path, file_path);
     if(radio_device_name) {
         instance->device = subghz_devices_get_by_name(radio_device_name);
@@ -249,3 +388,11 @@ bool subghz_file_encoder_worker_is_running(SubGhzFileEncoderWorker* instance) {
     furi_assert(instance);
     return instance->worker_running;
 }
+
+void subghz_file_encoder_worker_get_stats(
+    SubGhzFileEncoderWorker* instance,
+    SubGhzFileEncoderWorkerStats* stats) {
+    furi_check(instance);
+    furi_check(stats);
+    *stats = instance->stats;
+}
@@ -10,6 +10,15 @@ typedef void (*SubGhzFileEncoderWorkerCallbackEnd)(void* context);
 
 typedef struct SubGhzFileEncoderWorker SubGhzFileEncoderWorker;
 
+typedef struct {
+    uint32_t pulse_count; /**< Pulses handed to the consumer */
+    uint32_t block_count; /**< Blocks published by the worker thread */
+    uint32_t underrun_count; /**< Times the consumer ran out of data mid-stream */
+    uint32_t read_count; /**< Storage reads, one per line or binary block */
+    uint32_t read_time_total; /**< Total storage read and parse time, us */
+    uint32_t read_time_max; /**< Longest storage read and parse time, us */
+} SubGhzFileEncoderWorkerStats;
+
 /** 
  * End callback SubGhzWorker.
  * @param instance SubGhzFileEncoderWorker instance
@@ -73,6 +82,15 @@ void subghz_file_encoder_worker_stop(SubGhzFileEncoderWorker* instance);
  */
 bool subghz_file_encoder_worker_is_running(SubGhzFileEncoderWorker* instance);
 
+/** 
+ * Get playback statistics. Underruns are counted once the first pulse was consumed.
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @param stats Output statistics
+ */
+void subghz_file_encoder_worker_get_stats(
+    SubGhzFileEncoderWorker* instance,
+    SubGhzFileEncoderWorkerStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
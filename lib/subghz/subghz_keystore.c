@@ -6,6 +6,7 @@
 
 #include <storage/storage.h>
 #include <toolbox/hex.h>
+#include <toolbox/crc32_calc.h>
 #include <toolbox/stream/stream.h>
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
@@ -22,15 +23,43 @@
 #define SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE 512
 #define SUBGHZ_KEYSTORE_FILE_ENCRYPTED_LINE_SIZE (SUBGHZ_KEYSTORE_FILE_DECRYPTED_LINE_SIZE * 2)
 
+#define SUBGHZ_KEYSTORE_COMPILED_EXTENSION ".kc"
+#define SUBGHZ_KEYSTORE_COMPILED_MAGIC     0x434B4753 // "SGKC"
+#define SUBGHZ_KEYSTORE_COMPILED_VERSION   2
+#define SUBGHZ_KEYSTORE_COMPILED_KEY_SLOT  FURI_HAL_CRYPTO_ENCLAVE_UNIQUE_KEY_SLOT
+
 typedef enum {
     SubGhzKeystoreEncryptionNone,
     SubGhzKeystoreEncryptionAES256,
 } SubGhzKeystoreEncryption;
 
+// Compiled keystore: header followed by an encrypted payload of key
+// entries and a pool of zero terminated names, padded to the AES block
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t key_slot;
+    uint16_t reserved;
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t source_crc;
+    uint32_t key_count;
+    uint32_t name_count;
+    uint32_t payload_size;
+    uint8_t iv[16];
+} SubGhzKeystoreCompiledHeader;
+
+typedef struct FURI_PACKED {
+    uint64_t key;
+    uint16_t type;
+    uint16_t name;
+} SubGhzKeystoreCompiledKey;
+
 SubGhzKeystore* subghz_keystore_alloc(void) {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
     SubGhzKeyArray_init(instance->data);
+    SubGhzKeystoreNameArray_init(instance->names);
 
     subghz_keystore_reset_kl(instance);
 
@@ -47,27 +76,179 @@ void subghz_keystore_reset_kl(SubGhzKeystore* instance) {
 void subghz_keystore_free(SubGhzKeystore* instance) {
     furi_assert(instance);
 
+    free(instance->name_index);
+    free(instance->name_start);
+
     for
         M_EACH(manufacture_code, instance->data, SubGhzKeyArray_t) {
-            furi_string_free(manufacture_code->name);
             manufacture_code->key = 0;
         }
     SubGhzKeyArray_clear(instance->data);
 
+    for
+        M_EACH(name, instance->names, SubGhzKeystoreNameArray_t) {
+            furi_string_free(*name);
+        }
+    SubGhzKeystoreNameArray_clear(instance->names);
+
     free(instance);
 }
 
+static FuriString* subghz_keystore_intern_name(SubGhzKeystore* instance, const char* name) {
+    // Keys of one manufacture are usually adjacent, check the latest name first
+    size_t count = SubGhzKeystoreNameArray_size(instance->names);
+    for(size_t i = count; i > 0; i--) {
+        FuriString* interned = *SubGhzKeystoreNameArray_get(instance->names, i - 1);
+        if(furi_string_cmp_str(interned, name) == 0) return interned;
+    }
+
+    FuriString* interned = furi_string_alloc_set(name);
+    SubGhzKeystoreNameArray_push_back(instance->names, interned);
+    return interned;
+}
+
 static void subghz_keystore_add_key(
     SubGhzKeystore* instance,
     const char* name,
     uint64_t key,
     uint16_t type) {
     SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
-    manufacture_code->name = furi_string_alloc_set(name);
+    manufacture_code->name = subghz_keystore_intern_name(instance, name);
     manufacture_code->key = key;
     manufacture_code->type = type;
 }
 
+static int subghz_keystore_compare_by_name(const void* a, const void* b, void* context) {
+    SubGhzKeyArray_t* data = context;
+    uint32_t index_a = *(const uint32_t*)a;
+    uint32_t index_b = *(const uint32_t*)b;
+    int ret = furi_string_cmp(
+        SubGhzKeyArray_cget(*data, index_a)->name, SubGhzKeyArray_cget(*data, index_b)->name);
+    if(ret == 0) ret = (index_a > index_b) - (index_a < index_b);
+    return ret;
+}
+
+static void subghz_keystore_build_index(SubGhzKeystore* instance) {
+    free(instance->name_index);
+    free(instance->name_start);
+    instance->name_index = NULL;
+    instance->name_start = NULL;
+    instance->name_count = 0;
+    subghz_keystore_cache_reset(instance);
+
+    size_t count = SubGhzKeyArray_size(instance->data);
+    if(!count) return;
+
+    instance->name_index = malloc(count * sizeof(uint32_t));
+    for(size_t i = 0; i < count; i++) {
+        instance->name_index[i] = i;
+    }
+    qsort_r(
+        instance->name_index,
+        count,
+        sizeof(uint32_t),
+        subghz_keystore_compare_by_name,
+        &instance->data);
+
+    // Count names first to allocate the start table once
+    const FuriString* previous = NULL;
+    for(size_t i = 0; i < count; i++) {
+        const FuriString* name = SubGhzKeyArray_cget(instance->data, instance->name_index[i])->name;
+        if(!previous || furi_string_cmp(previous, name) != 0) instance->name_count++;
+        previous = name;
+    }
+
+    instance->name_start = malloc((instance->name_count + 1) * sizeof(uint32_t));
+    size_t name = 0;
+    previous = NULL;
+    for(size_t i = 0; i < count; i++) {
+        const FuriString* current =
+            SubGhzKeyArray_cget(instance->data, instance->name_index[i])->name;
+        if(!previous || furi_string_cmp(previous, current) != 0) {
+            instance->name_start[name++] = i;
+        }
+        previous = current;
+    }
+    instance->name_start[name] = count;
+
+    FURI_LOG_D(TAG, "Indexed %zu keys, %zu names", count, instance->name_count);
+}
+
+size_t subghz_keystore_find_by_name(
+    SubGhzKeystore* instance,
+    const char* name,
+    const uint32_t** indexes) {
+    furi_check(instance);
+    furi_check(name);
+    furi_check(indexes);
+
+    size_t low = 0;
+    size_t high = instance->name_count;
+    while(low < high) {
+        size_t mid = low + (high - low) / 2;
+        uint32_t key_index = instance->name_index[instance->name_start[mid]];
+        int ret = furi_string_cmp_str(SubGhzKeyArray_cget(instance->data, key_index)->name, name);
+        if(ret == 0) {
+            *indexes = &instance->name_index[instance->name_start[mid]];
+            return instance->name_start[mid + 1] - instance->name_start[mid];
+        } else if(ret < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    *indexes = NULL;
+    return 0;
+}
+
+bool subghz_keystore_cache_lookup(SubGhzKeystore* instance, uint32_t serial, SubGhzKeystoreHit* hit) {
+    furi_check(instance);
+    furi_check(hit);
+
+    for(size_t i = 0; i < SUBGHZ_KEYSTORE_CACHE_SIZE; i++) {
+        SubGhzKeystoreCacheEntry* entry = &instance->cache[i];
+        if(entry->age && entry->serial == serial) {
+            entry->age = ++instance->cache_age;
+            *hit = entry->hit;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void subghz_keystore_cache_store(
+    SubGhzKeystore* instance,
+    uint32_t serial,
+    const SubGhzKeystoreHit* hit) {
+    furi_check(instance);
+    furi_check(hit);
+    furi_check(hit->key_index < SubGhzKeyArray_size(instance->data));
+
+    // Same serial or the least recently used entry, unused entries have age 0
+    SubGhzKeystoreCacheEntry* victim = &instance->cache[0];
+    for(size_t i = 0; i < SUBGHZ_KEYSTORE_CACHE_SIZE; i++) {
+        SubGhzKeystoreCacheEntry* entry = &instance->cache[i];
+        if(entry->age && entry->serial == serial) {
+            victim = entry;
+            break;
+        }
+        if(entry->age < victim->age) victim = entry;
+    }
+
+    victim->serial = serial;
+    victim->hit = *hit;
+    victim->age = ++instance->cache_age;
+}
+
+void subghz_keystore_cache_reset(SubGhzKeystore* instance) {
+    furi_check(instance);
+
+    memset(instance->cache, 0, sizeof(instance->cache));
+    instance->cache_age = 0;
+}
+
 static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
     uint64_t key = 0;
     uint16_t type = 0;
@@ -86,7 +267,8 @@ static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
 
 static void subghz_keystore_mess_with_iv(uint8_t* iv) {
     // Alignment check for `ldrd` instruction
-    furi_assert(((uint32_t)iv) % 4 == 0);
+    furi_assert(((uintptr_t)iv) % 4 == 0);
+#ifdef __arm__
     // Please do not share decrypted manufacture keys
     // Sharing them will bring some discomfort to legal owners
     // And potential legal action against you
@@ -110,6 +292,10 @@ static void subghz_keystore_mess_with_iv(uint8_t* iv) {
                  :
                  : "r"(iv)
                  : "r0", "r1", "r2", "r3", "memory");
+#else
+    // Host builds, key slot that uses the IV only exists on the device
+    UNUSED(iv);
+#endif
 }
 
 static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream, uint8_t* iv) {
@@ -190,6 +376,221 @@ static bool subghz_keystore_read_file(SubGhzKeystore* instance, Stream* stream,
     return result;
 }
 
+static bool subghz_keystore_get_source_crc(
+    Storage* storage,
+    const char* file_name,
+    uint32_t* crc) {
+    File* file = storage_file_alloc(storage);
+    bool result = false;
+
+    if(storage_file_open(file, file_name, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        *crc = crc32_calc_file(file, NULL, NULL);
+        result = storage_file_get_error(file) == FSE_OK;
+    }
+
+    storage_file_free(file);
+    return result;
+}
+
+static bool subghz_keystore_compiled_load(
+    SubGhzKeystore* instance,
+    Storage* storage,
+    const char* file_name,
+    const char* source_name,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    File* file = storage_file_alloc(storage);
+    SubGhzKeystoreCompiledHeader header;
+    uint8_t* payload = NULL;
+    bool key_loaded = false;
+    bool result = false;
+
+    do {
+        if(!storage_file_open(file, file_name, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != SUBGHZ_KEYSTORE_COMPILED_MAGIC ||
+           header.version != SUBGHZ_KEYSTORE_COMPILED_VERSION ||
+           header.key_slot != SUBGHZ_KEYSTORE_COMPILED_KEY_SLOT) {
+            FURI_LOG_W(TAG, "Compiled keystore format mismatch");
+            break;
+        }
+        // Size and timestamp avoid reading the source, the content is only
+        // compared when the timestamp moved. FAT keeps time in 2 second steps,
+        // so a same size rewrite within one step still passes as unchanged.
+        uint32_t source_crc = 0;
+        if(header.source_size != source_size ||
+           (header.source_timestamp != source_timestamp &&
+            (!subghz_keystore_get_source_crc(storage, source_name, &source_crc) ||
+             header.source_crc != source_crc))) {
+            FURI_LOG_I(TAG, "Compiled keystore is outdated");
+            break;
+        }
+        if(header.payload_size % 16 != 0 ||
+           header.payload_size != storage_file_size(file) - sizeof(header) ||
+           header.key_count > header.payload_size / sizeof(SubGhzKeystoreCompiledKey)) {
+            FURI_LOG_E(TAG, "Compiled keystore is damaged");
+            break;
+        }
+        size_t keys_size = header.key_count * sizeof(SubGhzKeystoreCompiledKey);
+        if(header.name_count > header.payload_size - keys_size) {
+            FURI_LOG_E(TAG, "Compiled keystore is damaged");
+            break;
+        }
+
+        // Whole payload in one read, decrypted in place
+        payload = malloc(header.payload_size + 1);
+        if(storage_file_read(file, payload, header.payload_size) != header.payload_size) break;
+        if(!furi_hal_crypto_enclave_load_key(SUBGHZ_KEYSTORE_COMPILED_KEY_SLOT, header.iv)) {
+            FURI_LOG_E(TAG, "Unable to load decryption key");
+            break;
+        }
+        key_loaded = true;
+        if(!furi_hal_crypto_decrypt(payload, payload, header.payload_size)) {
+            FURI_LOG_E(TAG, "Decryption failed");
+            break;
+        }
+        payload[header.payload_size] = '\0';
+
+        const SubGhzKeystoreCompiledKey* keys = (const SubGhzKeystoreCompiledKey*)payload;
+        size_t key = 0;
+        while(key < header.key_count && keys[key].name < header.name_count) key++;
+        if(key != header.key_count) {
+            FURI_LOG_E(TAG, "Compiled keystore keys are damaged");
+            break;
+        }
+
+        // Pool is zero terminated by the extra byte, names are interned as is
+        size_t name_base = SubGhzKeystoreNameArray_size(instance->names);
+        const char* pool = (const char*)&payload[keys_size];
+        const char* pool_end = (const char*)&payload[header.payload_size];
+        for(size_t n = 0; n < header.name_count; n++) {
+            SubGhzKeystoreNameArray_push_back(instance->names, furi_string_alloc_set(pool));
+            pool = MIN(pool + strlen(pool) + 1, pool_end);
+        }
+
+        SubGhzKeyArray_reserve(
+            instance->data, SubGhzKeyArray_size(instance->data) + header.key_count);
+        for(size_t i = 0; i < header.key_count; i++) {
+            SubGhzKey* manufacture_code = SubGhzKeyArray_push_raw(instance->data);
+            manufacture_code->name =
+                *SubGhzKeystoreNameArray_get(instance->names, name_base + keys[i].name);
+            manufacture_code->key = keys[i].key;
+            manufacture_code->type = keys[i].type;
+        }
+
+        FURI_LOG_I(TAG, "Loaded %lu compiled keys", header.key_count);
+        result = true;
+    } while(false);
+
+    if(key_loaded) furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_COMPILED_KEY_SLOT);
+    if(payload) {
+        memset(payload, 0, header.payload_size);
+        free(payload);
+    }
+    storage_file_free(file);
+
+    return result;
+}
+
+static bool subghz_keystore_compiled_save(
+    SubGhzKeystore* instance,
+    Storage* storage,
+    const char* file_name,
+    const char* source_name,
+    size_t first_key,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    size_t key_count = SubGhzKeyArray_size(instance->data) - first_key;
+    SubGhzKeystoreCompiledHeader header = {
+        .magic = SUBGHZ_KEYSTORE_COMPILED_MAGIC,
+        .version = SUBGHZ_KEYSTORE_COMPILED_VERSION,
+        .key_slot = SUBGHZ_KEYSTORE_COMPILED_KEY_SLOT,
+        .source_size = source_size,
+        .source_timestamp = source_timestamp,
+        .key_count = key_count,
+    };
+    uint32_t source_crc = 0;
+    if(!subghz_keystore_get_source_crc(storage, source_name, &source_crc)) return false;
+    header.source_crc = source_crc;
+
+    // Names used by the keys of this file, in order of first use
+    const FuriString** names = malloc(key_count * sizeof(FuriString*));
+    size_t pool_size = 0;
+    for(size_t i = 0; i < key_count; i++) {
+        const FuriString* name = SubGhzKeyArray_cget(instance->data, first_key + i)->name;
+        size_t n = 0;
+        while(n < header.name_count && names[n] != name) n++;
+        if(n == header.name_count) {
+            names[header.name_count++] = name;
+            pool_size += furi_string_size(name) + 1;
+        }
+    }
+
+    // Key entries address names with 16 bits, such a file stays text only
+    if(header.name_count > UINT16_MAX) {
+        FURI_LOG_W(TAG, "Too many names to compile keystore");
+        free(names);
+        return false;
+    }
+
+    size_t keys_size = key_count * sizeof(SubGhzKeystoreCompiledKey);
+    header.payload_size = keys_size + pool_size;
+    if(header.payload_size % 16) header.payload_size += 16 - header.payload_size % 16;
+
+    uint8_t* payload = malloc(header.payload_size);
+    SubGhzKeystoreCompiledKey* keys = (SubGhzKeystoreCompiledKey*)payload;
+    for(size_t i = 0; i < key_count; i++) {
+        const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(instance->data, first_key + i);
+        keys[i].key = manufacture_code->key;
+        keys[i].type = manufacture_code->type;
+        keys[i].name = 0;
+        while(names[keys[i].name] != manufacture_code->name) keys[i].name++;
+    }
+    char* pool = (char*)&payload[keys_size];
+    for(size_t n = 0; n < header.name_count; n++) {
+        size_t size = furi_string_size(names[n]) + 1;
+        memcpy(pool, furi_string_get_cstr(names[n]), size);
+        pool += size;
+    }
+
+    File* file = storage_file_alloc(storage);
+    bool key_loaded = false;
+    bool result = false;
+
+    do {
+        furi_hal_random_fill_buf(header.iv, sizeof(header.iv));
+        if(!furi_hal_crypto_enclave_load_key(SUBGHZ_KEYSTORE_COMPILED_KEY_SLOT, header.iv)) {
+            FURI_LOG_E(TAG, "Unable to load encryption key");
+            break;
+        }
+        key_loaded = true;
+        if(!furi_hal_crypto_encrypt(payload, payload, header.payload_size)) {
+            FURI_LOG_E(TAG, "Encryption failed");
+            break;
+        }
+
+        if(!storage_file_open(file, file_name, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(storage_file_write(file, payload, header.payload_size) != header.payload_size) break;
+
+        FURI_LOG_I(TAG, "Compiled %zu keys", key_count);
+        result = true;
+    } while(false);
+
+    if(key_loaded) furi_hal_crypto_enclave_unload_key(SUBGHZ_KEYSTORE_COMPILED_KEY_SLOT);
+    storage_file_free(file);
+    if(!result) {
+        FURI_LOG_E(TAG, "Unable to save compiled keystore");
+        storage_simply_remove(storage, file_name);
+    }
+
+    memset(payload, 0, header.payload_size);
+    free(payload);
+    free(names);
+
+    return result;
+}
+
 bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
     furi_assert(instance);
     bool result = false;
@@ -204,8 +605,31 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
 
+    // Compiled copy is used while the source file stays the same
+    FuriString* compiled_name =
+        furi_string_alloc_printf("%s%s", file_name, SUBGHZ_KEYSTORE_COMPILED_EXTENSION);
+    size_t first_key = SubGhzKeyArray_size(instance->data);
+    FileInfo source_info = {0};
+    uint32_t source_timestamp = 0;
+    bool source_known =
+        storage_common_stat(storage, file_name, &source_info) == FSE_OK &&
+        storage_common_timestamp(storage, file_name, &source_timestamp) == FSE_OK;
+    uint32_t source_size = source_info.size;
+
     FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
     do {
+        if(source_known &&
+           subghz_keystore_compiled_load(
+               instance,
+               storage,
+               furi_string_get_cstr(compiled_name),
+               file_name,
+               source_size,
+               source_timestamp)) {
+            result = true;
+            break;
+        }
+
         if(!flipper_format_file_open_existing(flipper_format, file_name)) {
             FURI_LOG_E(TAG, "Unable to open file for read: %s", file_name);
             break;
@@ -239,13 +663,27 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
             FURI_LOG_E(TAG, "Unknown encryption");
             break;
         }
+
+        if(result && source_known && SubGhzKeyArray_size(instance->data) > first_key) {
+            subghz_keystore_compiled_save(
+                instance,
+                storage,
+                furi_string_get_cstr(compiled_name),
+                file_name,
+                first_key,
+                source_size,
+                source_timestamp);
+        }
     } while(0);
     flipper_format_free(flipper_format);
+    furi_string_free(compiled_name);
 
     furi_record_close(RECORD_STORAGE);
 
     furi_string_free(filetype);
 
+    subghz_keystore_build_index(instance);
+
     return result;
 }
 
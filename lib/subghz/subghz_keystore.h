@@ -20,6 +20,11 @@ ARRAY_DEF(SubGhzKeyArray, SubGhzKey, M_POD_OPLIST)
 
 typedef struct SubGhzKeystore SubGhzKeystore;
 
+typedef struct {
+    uint32_t key_index; /**< Index of the key in SubGhzKeyArray */
+    uint8_t variant; /**< Protocol specific learning variant that matched */
+} SubGhzKeystoreHit;
+
 /**
  * Allocate SubGhzKeystore.
  * @return SubGhzKeystore* pointer to a SubGhzKeystore instance
@@ -77,6 +82,44 @@ bool subghz_keystore_raw_get_data(const char* file_name, size_t offset, uint8_t*
 
 void subghz_keystore_reset_kl(SubGhzKeystore* instance);
 
+/** 
+ * Get keys of a manufacture. Index is built when the keystore is loaded.
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param name Manufacture name
+ * @param indexes Returned array of key indexes in SubGhzKeyArray, in file order
+ * @return Number of keys, 0 if the name is unknown
+ */
+size_t subghz_keystore_find_by_name(
+    SubGhzKeystore* instance,
+    const char* name,
+    const uint32_t** indexes);
+
+/** 
+ * Look up the key that decoded a remote last time.
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param serial Remote serial number
+ * @param hit Returned key index and variant
+ * @return true if the serial is cached
+ */
+bool subghz_keystore_cache_lookup(SubGhzKeystore* instance, uint32_t serial, SubGhzKeystoreHit* hit);
+
+/** 
+ * Remember the key that decoded a remote, least recently used entry is replaced.
+ * @param instance Pointer to a SubGhzKeystore instance
+ * @param serial Remote serial number
+ * @param hit Key index and variant
+ */
+void subghz_keystore_cache_store(
+    SubGhzKeystore* instance,
+    uint32_t serial,
+    const SubGhzKeystoreHit* hit);
+
+/** 
+ * Forget all cached remotes.
+ * @param instance Pointer to a SubGhzKeystore instance
+ */
+void subghz_keystore_cache_reset(SubGhzKeystore* instance);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,9 +1,31 @@
 #pragma once
 
+#include "subghz_keystore.h"
 #include <m-array.h>
 
+#define SUBGHZ_KEYSTORE_CACHE_SIZE 16
+
+ARRAY_DEF(SubGhzKeystoreNameArray, FuriString*, M_PTR_OPLIST)
+
+typedef struct {
+    uint32_t serial;
+    uint32_t age;
+    SubGhzKeystoreHit hit;
+} SubGhzKeystoreCacheEntry;
+
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
+    // Interned manufacture names, shared by all keys with the same name
+    SubGhzKeystoreNameArray_t names;
     const char* mfname;
     uint8_t kl_type;
+
+    // Key indexes sorted by manufacture name, file order kept within a name
+    uint32_t* name_index;
+    // Start of every manufacture name in name_index, plus the end marker
+    uint32_t* name_start;
+    size_t name_count;
+
+    SubGhzKeystoreCacheEntry cache[SUBGHZ_KEYSTORE_CACHE_SIZE];
+    uint32_t cache_age;
 };
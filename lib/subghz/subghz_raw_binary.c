@@ -0,0 +1,407 @@
+#include "subghz_raw_binary.h"
+
+#include <furi.h>
+#include <flipper_format/flipper_format.h>
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/varint.h>
+#include <toolbox/strint.h>
+
+#define TAG "SubGhzRawBinary"
+
+#define SUBGHZ_RAW_BINARY_MAGIC           0x42524753 // "SGRB"
+#define SUBGHZ_RAW_BINARY_FLAG_INDEX      (1 << 0)
+#define SUBGHZ_RAW_BINARY_PAYLOAD_MAX     (SUBGHZ_RAW_BINARY_BLOCK_SIZE * 5)
+#define SUBGHZ_RAW_BINARY_INDEX_INIT_SIZE 32
+#define SUBGHZ_RAW_DATA_KEY               "RAW_Data"
+
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t flags;
+    uint16_t block_size;
+    uint32_t pulse_count;
+    uint32_t index_offset;
+} SubGhzRawBinaryHeader;
+
+typedef struct FURI_PACKED {
+    uint16_t pulse_count;
+    uint16_t payload_size;
+} SubGhzRawBinaryBlockHeader;
+
+struct SubGhzRawBinaryWriter {
+    Stream* stream;
+    size_t container_start;
+    SubGhzRawBinaryHeader header;
+
+    uint8_t* payload;
+    uint32_t* index;
+    uint32_t index_count;
+    uint32_t index_size;
+};
+
+struct SubGhzRawBinaryReader {
+    Stream* stream;
+    size_t container_start;
+    size_t data_end;
+    SubGhzRawBinaryHeader header;
+
+    uint8_t* payload;
+    uint32_t block_count;
+};
+
+SubGhzRawBinaryWriter* subghz_raw_binary_writer_alloc(Stream* stream, bool with_index) {
+    furi_check(stream);
+
+    SubGhzRawBinaryWriter* instance = malloc(sizeof(SubGhzRawBinaryWriter));
+    instance->stream = stream;
+    instance->container_start = stream_tell(stream);
+    instance->header.magic = SUBGHZ_RAW_BINARY_MAGIC;
+    instance->header.version = SUBGHZ_RAW_BINARY_VERSION;
+    instance->header.flags = with_index ? SUBGHZ_RAW_BINARY_FLAG_INDEX : 0;
+    instance->header.block_size = SUBGHZ_RAW_BINARY_BLOCK_SIZE;
+    instance->header.pulse_count = 0;
+    instance->header.index_offset = 0;
+    instance->payload = malloc(SUBGHZ_RAW_BINARY_PAYLOAD_MAX);
+
+    if(with_index) {
+        instance->index_size = SUBGHZ_RAW_BINARY_INDEX_INIT_SIZE;
+        instance->index = malloc(instance->index_size * sizeof(uint32_t));
+    }
+
+    size_t written =
+        stream_write(stream, (const uint8_t*)&instance->header, sizeof(SubGhzRawBinaryHeader));
+    if(written != sizeof(SubGhzRawBinaryHeader)) {
+        FURI_LOG_E(TAG, "Unable to write header");
+        subghz_raw_binary_writer_free(instance);
+        instance = NULL;
+    }
+
+    return instance;
+}
+
+bool subghz_raw_binary_writer_add_block(
+    SubGhzRawBinaryWriter* instance,
+    const int32_t* data,
+    size_t count) {
+    furi_check(instance);
+    furi_check(data);
+    furi_check(count <= SUBGHZ_RAW_BINARY_BLOCK_SIZE);
+
+    if(!count) return true;
+
+    SubGhzRawBinaryBlockHeader block = {.pulse_count = count, .payload_size = 0};
+    for(size_t i = 0; i < count; i++) {
+        block.payload_size += varint_int32_pack(data[i], &instance->payload[block.payload_size]);
+    }
+
+    uint32_t block_offset = stream_tell(instance->stream) - instance->container_start;
+
+    bool result = false;
+    do {
+        if(stream_write(instance->stream, (const uint8_t*)&block, sizeof(block)) != sizeof(block))
+            break;
+        if(stream_write(instance->stream, instance->payload, block.payload_size) !=
+           block.payload_size)
+            break;
+        result = true;
+    } while(false);
+
+    if(result) {
+        instance->header.pulse_count += count;
+        if(instance->index) {
+            if(instance->index_count == instance->index_size) {
+                instance->index_size *= 2;
+                instance->index =
+                    realloc(instance->index, instance->index_size * sizeof(uint32_t)); //-V701
+            }
+            instance->index[instance->index_count++] = block_offset;
+        }
+    } else {
+        FURI_LOG_E(TAG, "Unable to write block");
+    }
+
+    return result;
+}
+
+bool subghz_raw_binary_writer_finish(SubGhzRawBinaryWriter* instance) {
+    furi_check(instance);
+
+    Stream* stream = instance->stream;
+    bool result = false;
+    do {
+        if(instance->index) {
+            instance->header.index_offset = stream_tell(stream) - instance->container_start;
+            if(stream_write(
+                   stream,
+                   (const uint8_t*)&instance->index_count,
+                   sizeof(instance->index_count)) != sizeof(instance->index_count))
+                break;
+            size_t index_bytes = instance->index_count * sizeof(uint32_t);
+            if(stream_write(stream, (const uint8_t*)instance->index, index_bytes) != index_bytes)
+                break;
+        }
+
+        // Patch header with final counters
+        if(!stream_seek(stream, instance->container_start, StreamOffsetFromStart)) break;
+        if(stream_write(stream, (const uint8_t*)&instance->header, sizeof(instance->header)) !=
+           sizeof(instance->header))
+            break;
+        if(!stream_seek(stream, 0, StreamOffsetFromEnd)) break;
+
+        result = true;
+    } while(false);
+
+    if(!result) FURI_LOG_E(TAG, "Unable to finish container");
+    return result;
+}
+
+void subghz_raw_binary_writer_free(SubGhzRawBinaryWriter* instance) {
+    furi_check(instance);
+
+    free(instance->index);
+    free(instance->payload);
+    free(instance);
+}
+
+SubGhzRawBinaryReader* subghz_raw_binary_reader_alloc(Stream* stream) {
+    furi_check(stream);
+
+    SubGhzRawBinaryReader* instance = malloc(sizeof(SubGhzRawBinaryReader));
+    instance->stream = stream;
+    instance->container_start = stream_tell(stream);
+    instance->data_end = stream_size(stream);
+
+    bool result = false;
+    do {
+        if(stream_read(stream, (uint8_t*)&instance->header, sizeof(instance->header)) !=
+           sizeof(instance->header))
+            break;
+        if(instance->header.magic != SUBGHZ_RAW_BINARY_MAGIC) break;
+        if(instance->header.version != SUBGHZ_RAW_BINARY_VERSION) break;
+        if(instance->header.block_size > SUBGHZ_RAW_BINARY_BLOCK_SIZE) break;
+
+        if((instance->header.flags & SUBGHZ_RAW_BINARY_FLAG_INDEX) &&
+           instance->header.index_offset) {
+            instance->data_end = instance->container_start + instance->header.index_offset;
+            if(!stream_seek(stream, instance->data_end, StreamOffsetFromStart)) break;
+            if(stream_read(
+                   stream, (uint8_t*)&instance->block_count, sizeof(instance->block_count)) !=
+               sizeof(instance->block_count))
+                break;
+            if(!stream_seek(
+                   stream,
+                   instance->container_start + sizeof(instance->header),
+                   StreamOffsetFromStart))
+                break;
+        }
+        result = true;
+    } while(false);
+
+    if(result) {
+        instance->payload = malloc(SUBGHZ_RAW_BINARY_PAYLOAD_MAX);
+    } else {
+        FURI_LOG_E(TAG, "Invalid container");
+        free(instance);
+        instance = NULL;
+    }
+
+    return instance;
+}
+
+void subghz_raw_binary_reader_free(SubGhzRawBinaryReader* instance) {
+    furi_check(instance);
+
+    free(instance->payload);
+    free(instance);
+}
+
+size_t subghz_raw_binary_reader_read_block(SubGhzRawBinaryReader* instance, int32_t* data) {
+    furi_check(instance);
+    furi_check(data);
+
+    Stream* stream = instance->stream;
+    SubGhzRawBinaryBlockHeader block;
+
+    if(stream_tell(stream) + sizeof(block) > instance->data_end) return 0;
+    if(stream_read(stream, (uint8_t*)&block, sizeof(block)) != sizeof(block)) return 0;
+    if((block.pulse_count > SUBGHZ_RAW_BINARY_BLOCK_SIZE) ||
+       (block.payload_size > SUBGHZ_RAW_BINARY_PAYLOAD_MAX)) {
+        FURI_LOG_E(TAG, "Corrupted block");
+        return 0;
+    }
+    if(stream_read(stream, instance->payload, block.payload_size) != block.payload_size) return 0;
+
+    size_t offset = 0;
+    for(size_t i = 0; i < block.pulse_count; i++) {
+        if(offset >= block.payload_size) return i;
+        offset += varint_int32_unpack(
+            &data[i], &instance->payload[offset], block.payload_size - offset);
+    }
+
+    return block.pulse_count;
+}
+
+bool subghz_raw_binary_reader_seek_block(SubGhzRawBinaryReader* instance, uint32_t block) {
+    furi_check(instance);
+
+    if(block >= instance->block_count) return false;
+
+    Stream* stream = instance->stream;
+    uint32_t block_offset = 0;
+    size_t entry = instance->data_end + sizeof(uint32_t) + block * sizeof(uint32_t);
+
+    if(!stream_seek(stream, entry, StreamOffsetFromStart)) return false;
+    if(stream_read(stream, (uint8_t*)&block_offset, sizeof(block_offset)) !=
+       sizeof(block_offset))
+        return false;
+
+    return stream_seek(stream, instance->container_start + block_offset, StreamOffsetFromStart);
+}
+
+uint32_t subghz_raw_binary_reader_get_pulse_count(SubGhzRawBinaryReader* instance) {
+    furi_check(instance);
+    return instance->header.pulse_count;
+}
+
+uint32_t subghz_raw_binary_reader_get_block_count(SubGhzRawBinaryReader* instance) {
+    furi_check(instance);
+    return instance->block_count;
+}
+
+bool subghz_raw_binary_is_marker(const char* line) {
+    furi_check(line);
+    return strncmp(line, SUBGHZ_RAW_BINARY_KEY ":", strlen(SUBGHZ_RAW_BINARY_KEY ":")) == 0;
+}
+
+static bool subghz_raw_binary_copy_line(Stream* stream, FuriString* line) {
+    size_t size = furi_string_size(line);
+    if(stream_write_string(stream, line) != size) return false;
+    if(!size || furi_string_get_char(line, size - 1) != '\n') {
+        if(stream_write_char(stream, '\n') != 1) return false;
+    }
+    return true;
+}
+
+bool subghz_raw_binary_import_text(Storage* storage, const char* src_path, const char* dst_path) {
+    furi_check(storage);
+    furi_check(src_path);
+    furi_check(dst_path);
+
+    FlipperFormat* src = flipper_format_file_alloc(storage);
+    FlipperFormat* dst = flipper_format_file_alloc(storage);
+    Stream* src_stream = flipper_format_get_raw_stream(src);
+    Stream* dst_stream = flipper_format_get_raw_stream(dst);
+    FuriString* line = furi_string_alloc();
+    int32_t* block = malloc(SUBGHZ_RAW_BINARY_BLOCK_SIZE * sizeof(int32_t));
+    SubGhzRawBinaryWriter* writer = NULL;
+    size_t block_count = 0;
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_existing(src, src_path)) break;
+        if(!flipper_format_file_open_always(dst, dst_path)) break;
+
+        bool error = false;
+        while(!error && stream_read_line(src_stream, line)) {
+            if(!furi_string_start_with_str(line, SUBGHZ_RAW_DATA_KEY ":")) {
+                // Copy header keys, the container can not hold text after the data starts
+                if(!writer) error = !subghz_raw_binary_copy_line(dst_stream, line);
+                continue;
+            }
+            furi_string_trim(line);
+            const char* str = furi_string_get_cstr(line);
+
+            if(!writer) {
+                uint32_t version = SUBGHZ_RAW_BINARY_VERSION;
+                if(!flipper_format_write_uint32(dst, SUBGHZ_RAW_BINARY_KEY, &version, 1)) {
+                    error = true;
+                    break;
+                }
+                writer = subghz_raw_binary_writer_alloc(dst_stream, true);
+                if(!writer) {
+                    error = true;
+                    break;
+                }
+            }
+
+            char* value = strchr(str, ' ');
+            int32_t duration;
+            while(value &&
+                  strint_to_int32(value, &value, &duration, 10) == StrintParseNoError) {
+                block[block_count++] = duration;
+                if(block_count == SUBGHZ_RAW_BINARY_BLOCK_SIZE) {
+                    error = !subghz_raw_binary_writer_add_block(writer, block, block_count);
+                    block_count = 0;
+                    if(error) break;
+                }
+                if(*value == ',') value++;
+            }
+        }
+        if(error || !writer) break;
+
+        if(!subghz_raw_binary_writer_add_block(writer, block, block_count)) break;
+        if(!subghz_raw_binary_writer_finish(writer)) break;
+        result = true;
+    } while(false);
+
+    if(writer) subghz_raw_binary_writer_free(writer);
+    free(block);
+    furi_string_free(line);
+    flipper_format_free(dst);
+    flipper_format_free(src);
+
+    return result;
+}
+
+bool subghz_raw_binary_export_text(Storage* storage, const char* src_path, const char* dst_path) {
+    furi_check(storage);
+    furi_check(src_path);
+    furi_check(dst_path);
+
+    FlipperFormat* src = flipper_format_file_alloc(storage);
+    FlipperFormat* dst = flipper_format_file_alloc(storage);
+    Stream* src_stream = flipper_format_get_raw_stream(src);
+    Stream* dst_stream = flipper_format_get_raw_stream(dst);
+    FuriString* line = furi_string_alloc();
+    int32_t* block = malloc(SUBGHZ_RAW_BINARY_BLOCK_SIZE * sizeof(int32_t));
+    SubGhzRawBinaryReader* reader = NULL;
+    bool result = false;
+
+    do {
+        if(!flipper_format_file_open_existing(src, src_path)) break;
+        if(!flipper_format_file_open_always(dst, dst_path)) break;
+
+        bool error = false;
+        while(!reader && stream_read_line(src_stream, line)) {
+            if(subghz_raw_binary_is_marker(furi_string_get_cstr(line))) {
+                reader = subghz_raw_binary_reader_alloc(src_stream);
+                error = !reader;
+                break;
+            }
+            if(!subghz_raw_binary_copy_line(dst_stream, line)) {
+                error = true;
+                break;
+            }
+        }
+        if(error || !reader) break;
+
+        size_t count;
+        while((count = subghz_raw_binary_reader_read_block(reader, block))) {
+            if(!flipper_format_write_int32(dst, SUBGHZ_RAW_DATA_KEY, block, count)) {
+                error = true;
+                break;
+            }
+        }
+        if(error) break;
+
+        result = true;
+    } while(false);
+
+    if(reader) subghz_raw_binary_reader_free(reader);
+    free(block);
+    furi_string_free(line);
+    flipper_format_free(dst);
+    flipper_format_free(src);
+
+    return result;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file subghz_raw_binary.h
+ * Compact binary container for Sub-GHz RAW recordings.
+ *
+ * A binary RAW file keeps the usual FlipperFormat text header (Filetype,
+ * Frequency, Preset, Protocol), followed by a `RAW_Binary: <version>` marker
+ * line. Everything after the marker is the container:
+ *
+ * - SubGhzRawBinaryHeader
+ * - blocks: uint16 pulse count, uint16 payload size, zig-zag varint pulses
+ * - optional block index: uint32 block count, uint32 block offsets
+ *
+ * All offsets are relative to the container start, integers are little-endian.
+ */
+#pragma once
+
+#include <toolbox/stream/stream.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SUBGHZ_RAW_BINARY_KEY        "RAW_Binary"
+#define SUBGHZ_RAW_BINARY_VERSION    1
+#define SUBGHZ_RAW_BINARY_BLOCK_SIZE 512
+
+typedef struct SubGhzRawBinaryWriter SubGhzRawBinaryWriter;
+typedef struct SubGhzRawBinaryReader SubGhzRawBinaryReader;
+
+/**
+ * Allocate SubGhzRawBinaryWriter and write the container header.
+ * The stream must be positioned right after the marker line.
+ * @param stream Pointer to a Stream instance opened for writing
+ * @param with_index Write a block index when finished
+ * @return SubGhzRawBinaryWriter* pointer to a SubGhzRawBinaryWriter instance, NULL on write error
+ */
+SubGhzRawBinaryWriter* subghz_raw_binary_writer_alloc(Stream* stream, bool with_index);
+
+/**
+ * Append a block of pulses.
+ * @param instance Pointer to a SubGhzRawBinaryWriter instance
+ * @param data Signed durations, positive is high level, us
+ * @param count Number of pulses, up to SUBGHZ_RAW_BINARY_BLOCK_SIZE
+ * @return true on success
+ */
+bool subghz_raw_binary_writer_add_block(
+    SubGhzRawBinaryWriter* instance,
+    const int32_t* data,
+    size_t count);
+
+/**
+ * Write the block index and finalize the container header.
+ * @param instance Pointer to a SubGhzRawBinaryWriter instance
+ * @return true on success
+ */
+bool subghz_raw_binary_writer_finish(SubGhzRawBinaryWriter* instance);
+
+/**
+ * Free SubGhzRawBinaryWriter. Does not finish the container.
+ * @param instance Pointer to a SubGhzRawBinaryWriter instance
+ */
+void subghz_raw_binary_writer_free(SubGhzRawBinaryWriter* instance);
+
+/**
+ * Allocate SubGhzRawBinaryReader and read the container header.
+ * The stream must be positioned right after the marker line.
+ * @param stream Pointer to a Stream instance opened for reading
+ * @return SubGhzRawBinaryReader* pointer to a SubGhzRawBinaryReader instance, NULL if the container is invalid
+ */
+SubGhzRawBinaryReader* subghz_raw_binary_reader_alloc(Stream* stream);
+
+/**
+ * Free SubGhzRawBinaryReader.
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ */
+void subghz_raw_binary_reader_free(SubGhzRawBinaryReader* instance);
+
+/**
+ * Read next block of pulses.
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ * @param data Output buffer, at least SUBGHZ_RAW_BINARY_BLOCK_SIZE elements
+ * @return Number of pulses read, 0 at the end of data or on error
+ */
+size_t subghz_raw_binary_reader_read_block(SubGhzRawBinaryReader* instance, int32_t* data);
+
+/**
+ * Move to the block with given index. Requires a block index in the container.
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ * @param block Block number
+ * @return true on success
+ */
+bool subghz_raw_binary_reader_seek_block(SubGhzRawBinaryReader* instance, uint32_t block);
+
+/**
+ * Get total pulse count, 0 if the recording was not finished.
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ * @return Pulse count
+ */
+uint32_t subghz_raw_binary_reader_get_pulse_count(SubGhzRawBinaryReader* instance);
+
+/**
+ * Get block count, 0 if the container has no block index.
+ * @param instance Pointer to a SubGhzRawBinaryReader instance
+ * @return Block count
+ */
+uint32_t subghz_raw_binary_reader_get_block_count(SubGhzRawBinaryReader* instance);
+
+/**
+ * Check whether a line read after the Protocol key is the binary marker.
+ * @param line Line content
+ * @return true if the rest of the file is a binary container
+ */
+bool subghz_raw_binary_is_marker(const char* line);
+
+/**
+ * Convert a text RAW file to the binary container. Header keys are copied as is.
+ * @param storage Pointer to a Storage instance
+ * @param src_path Path of a text RAW file
+ * @param dst_path Path of the binary RAW file to create
+ * @return true on success
+ */
+bool subghz_raw_binary_import_text(Storage* storage, const char* src_path, const char* dst_path);
+
+/**
+ * Convert a binary RAW file back to `RAW_Data` text lines. Header keys are copied as is.
+ * @param storage Pointer to a Storage instance
+ * @param src_path Path of a binary RAW file
+ * @param dst_path Path of the text RAW file to create
+ * @return true on success
+ */
+bool subghz_raw_binary_export_text(Storage* storage, const char* src_path, const char* dst_path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,18 +4,28 @@
 
 #define TAG "SubGhzWorker"
 
+#define SUBGHZ_WORKER_STREAM_SIZE 4096
+#define SUBGHZ_WORKER_BLOCK_SIZE  64
+
 struct SubGhzWorker {
     FuriThread* thread;
     FuriStreamBuffer* stream;
 
     volatile bool running;
     volatile bool overrun;
+    volatile uint32_t overrun_count;
 
     LevelDuration filter_level_duration;
     uint16_t filter_duration;
 
+    // Raw block drained from the stream and filtered pairs produced from it
+    LevelDuration block[SUBGHZ_WORKER_BLOCK_SIZE];
+    LevelDuration pairs[SUBGHZ_WORKER_BLOCK_SIZE];
+    SubGhzWorkerStats stats;
+
     SubGhzWorkerOverrunCallback overrun_callback;
     SubGhzWorkerPairCallback pair_callback;
+    SubGhzWorkerBatchCallback batch_callback;
     void* context;
 };
 
@@ -35,7 +45,25 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     }
     size_t ret =
         furi_stream_buffer_send(instance->stream, &level_duration, sizeof(LevelDuration), 0);
-    if(sizeof(LevelDuration) != ret) instance->overrun = true;
+    if(sizeof(LevelDuration) != ret) {
+        instance->overrun = true;
+        instance->overrun_count++;
+    }
+}
+
+static void subghz_worker_flush_pairs(SubGhzWorker* instance, size_t count) {
+    if(!count) return;
+
+    if(instance->batch_callback) {
+        instance->batch_callback(instance->context, instance->pairs, count);
+    } else if(instance->pair_callback) {
+        for(size_t i = 0; i < count; i++) {
+            instance->pair_callback(
+                instance->context,
+                level_duration_get_level(instance->pairs[i]),
+                level_duration_get_duration(instance->pairs[i]));
+        }
+    }
 }
 
 /** Worker callback thread
@@ -46,12 +74,24 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 static int32_t subghz_worker_thread_callback(void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration;
     while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
+        size_t ret = furi_stream_buffer_receive(
+            instance->stream, instance->block, sizeof(instance->block), 10);
+        size_t received = ret / sizeof(LevelDuration);
+        if(!received) continue;
+
+        instance->stats.batch_count++;
+        instance->stats.pulse_count += received;
+        if(received > instance->stats.batch_size_max) instance->stats.batch_size_max = received;
+        if(received == SUBGHZ_WORKER_BLOCK_SIZE) instance->stats.batch_full_count++;
+
+        size_t pair_count = 0;
+        for(size_t i = 0; i < received; i++) {
+            LevelDuration level_duration = instance->block[i];
             if(level_duration_is_reset(level_duration)) {
+                // Pairs collected before the overrun still belong to the old stream
+                subghz_worker_flush_pairs(instance, pair_count);
+                pair_count = 0;
                 FURI_LOG_E(TAG, "Overrun buffer");
                 if(instance->overrun_callback) instance->overrun_callback(instance->context);
             } else {
@@ -63,17 +103,16 @@ static int32_t subghz_worker_thread_callback(void* context) {
                     instance->filter_level_duration.duration += duration;
 
                 } else if(instance->filter_level_duration.level != level) {
-                    if(instance->pair_callback)
-                        instance->pair_callback(
-                            instance->context,
-                            instance->filter_level_duration.level,
-                            instance->filter_level_duration.duration);
+                    instance->pairs[pair_count++] = level_duration_make(
+                        instance->filter_level_duration.level,
+                        instance->filter_level_duration.duration);
 
                     instance->filter_level_duration.duration = duration;
                     instance->filter_level_duration.level = level;
                 }
             }
         }
+        subghz_worker_flush_pairs(instance, pair_count);
     }
 
     return 0;
@@ -85,8 +124,8 @@ SubGhzWorker* subghz_worker_alloc(void) {
     instance->thread =
         furi_thread_alloc_ex("SubGhzWorker", 2048, subghz_worker_thread_callback, instance);
 
-    instance->stream =
-        furi_stream_buffer_alloc(sizeof(LevelDuration) * 4096, sizeof(LevelDuration));
+    instance->stream = furi_stream_buffer_alloc(
+        sizeof(LevelDuration) * SUBGHZ_WORKER_STREAM_SIZE, sizeof(LevelDuration));
 
     //setting default filter in us
     instance->filter_duration = 30;
@@ -115,6 +154,11 @@ void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCal
     instance->pair_callback = callback;
 }
 
+void subghz_worker_set_batch_callback(SubGhzWorker* instance, SubGhzWorkerBatchCallback callback) {
+    furi_check(instance);
+    instance->batch_callback = callback;
+}
+
 void subghz_worker_set_context(SubGhzWorker* instance, void* context) {
     furi_check(instance);
     instance->context = context;
@@ -124,6 +168,8 @@ void subghz_worker_start(SubGhzWorker* instance) {
     furi_check(instance);
     furi_check(!instance->running);
 
+    instance->overrun_count = 0;
+    memset(&instance->stats, 0, sizeof(SubGhzWorkerStats));
     instance->running = true;
 
     furi_thread_start(instance->thread);
@@ -136,6 +182,16 @@ void subghz_worker_stop(SubGhzWorker* instance) {
     instance->running = false;
 
     furi_thread_join(instance->thread);
+
+    instance->stats.overrun_count = instance->overrun_count;
+    FURI_LOG_D(
+        TAG,
+        "Pulses %lu, batches %lu (full %lu, max %lu), overruns %lu",
+        instance->stats.pulse_count,
+        instance->stats.batch_count,
+        instance->stats.batch_full_count,
+        instance->stats.batch_size_max,
+        instance->stats.overrun_count);
 }
 
 bool subghz_worker_is_running(SubGhzWorker* instance) {
@@ -147,3 +203,10 @@ void subghz_worker_set_filter(SubGhzWorker* instance, uint16_t timeout) {
     furi_check(instance);
     instance->filter_duration = timeout;
 }
+
+void subghz_worker_get_stats(SubGhzWorker* instance, SubGhzWorkerStats* stats) {
+    furi_check(instance);
+    furi_check(stats);
+    *stats = instance->stats;
+    stats->overrun_count = instance->overrun_count;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <furi_hal.h>
+#include <lib/toolbox/level_duration.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,6 +13,19 @@ typedef void (*SubGhzWorkerOverrunCallback)(void* context);
 
 typedef void (*SubGhzWorkerPairCallback)(void* context, bool level, uint32_t duration);
 
+typedef void (*SubGhzWorkerBatchCallback)(
+    void* context,
+    const LevelDuration* level_duration,
+    size_t count);
+
+typedef struct {
+    uint32_t pulse_count; ///< Raw pulses drained from the stream buffer
+    uint32_t batch_count; ///< Blocks drained from the stream buffer
+    uint32_t batch_full_count; ///< Blocks that filled the whole drain buffer
+    uint32_t batch_size_max; ///< Largest block drained at once
+    uint32_t overrun_count; ///< Pulses dropped because the stream buffer was full
+} SubGhzWorkerStats;
+
 void subghz_worker_rx_callback(bool level, uint32_t duration, void* context);
 
 /** 
@@ -42,6 +56,14 @@ void subghz_worker_set_overrun_callback(
  */
 void subghz_worker_set_pair_callback(SubGhzWorker* instance, SubGhzWorkerPairCallback callback);
 
+/** 
+ * Batch callback SubGhzWorker.
+ * Receives filtered pairs a block at a time, takes precedence over the pair callback.
+ * @param instance Pointer to a SubGhzWorker instance
+ * @param callback SubGhzWorkerBatchCallback callback
+ */
+void subghz_worker_set_batch_callback(SubGhzWorker* instance, SubGhzWorkerBatchCallback callback);
+
 /** 
  * Context callback SubGhzWorker.
  * @param instance Pointer to a SubGhzWorker instance
@@ -75,6 +97,13 @@ bool subghz_worker_is_running(SubGhzWorker* instance);
  */
 void subghz_worker_set_filter(SubGhzWorker* instance, uint16_t timeout);
 
+/** 
+ * Get statistics collected since the worker was last started.
+ * @param instance Pointer to a SubGhzWorker instance
+ * @param stats Pointer to a SubGhzWorkerStats to fill
+ */
+void subghz_worker_get_stats(SubGhzWorker* instance, SubGhzWorkerStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
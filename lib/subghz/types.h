@@ -30,6 +30,7 @@
 
 typedef struct SubGhzProtocolRegistry SubGhzProtocolRegistry;
 typedef struct SubGhzEnvironment SubGhzEnvironment;
+typedef struct SubGhzBlockPwmConst SubGhzBlockPwmConst;
 
 // Radio Preset
 typedef struct {
@@ -83,6 +84,18 @@ typedef uint32_t (*SubGhzGetHashDataLong)(void* decoder);
 typedef void (*SubGhzGetString)(void* decoder, FuriString* output);
 typedef void (*SubGhzGetStringBrief)(void* decoder, FuriString* output);
 
+/** Range of durations that can move an idle decoder out of its reset step:
+ * `DURATION_DIFF(duration, window.duration) < window.delta`
+ */
+typedef struct {
+    uint32_t duration;
+    uint32_t delta;
+} SubGhzDecoderWakeWindow;
+
+typedef bool (*SubGhzDecoderIsIdle)(void* decoder);
+typedef void (*SubGhzDecoderGetWakeWindow)(SubGhzDecoderWakeWindow* window);
+typedef void (*SubGhzDecoderFeedClass)(void* decoder, bool level, uint8_t pulse_class);
+
 // Encoder specific
 typedef void (*SubGhzEncoderStop)(void* encoder);
 typedef LevelDuration (*SubGhzEncoderYield)(void* context);
@@ -101,6 +114,14 @@ typedef struct {
 
     SubGhzGetHashDataLong get_hash_data_long;
     SubGhzGetStringBrief get_string_brief;
+
+    // Optional, lets the receiver skip pulses that can not wake an idle decoder
+    SubGhzDecoderIsIdle is_idle;
+    SubGhzDecoderGetWakeWindow get_wake_window;
+
+    // Optional, PWM frame decoders: the receiver classifies every pulse once for all of them
+    const SubGhzBlockPwmConst* pwm;
+    SubGhzDecoderFeedClass feed_class;
 } SubGhzProtocolDecoder;
 
 typedef struct {
@@ -4,6 +4,8 @@
 
 #define BITS_IN_BYTE (8)
 
+#define BIT_BUFFER_BYTE_WITH_PARITY_BITS (BITS_IN_BYTE + 1)
+
 struct BitBuffer {
     uint8_t* data;
     uint8_t* parity;
@@ -97,31 +99,38 @@ void bit_buffer_copy_bytes_with_parity(BitBuffer* buf, const uint8_t* data, size
     furi_check(buf);
     furi_check(data);
 
-    size_t bits_processed = 0;
-    size_t curr_byte = 0;
-
-    if(size_bits < BITS_IN_BYTE + 1) {
+    if(size_bits < BIT_BUFFER_BYTE_WITH_PARITY_BITS) {
         buf->size_bits = size_bits;
         buf->data[0] = data[0];
     } else {
-        furi_check(size_bits % (BITS_IN_BYTE + 1) == 0);
-        while(bits_processed < size_bits) {
-            buf->data[curr_byte] = data[bits_processed / BITS_IN_BYTE] >>
-                                   (bits_processed % BITS_IN_BYTE);
-            buf->data[curr_byte] |= data[bits_processed / BITS_IN_BYTE + 1]
-                                    << (BITS_IN_BYTE - bits_processed % BITS_IN_BYTE);
-            uint8_t bit =
-                FURI_BIT(data[bits_processed / BITS_IN_BYTE + 1], bits_processed % BITS_IN_BYTE);
-
-            if((bits_processed % BITS_IN_BYTE) == 0) {
-                buf->parity[curr_byte / BITS_IN_BYTE] = bit;
-            } else {
-                buf->parity[curr_byte / BITS_IN_BYTE] |= bit << (bits_processed % BITS_IN_BYTE);
+        furi_check(size_bits % BIT_BUFFER_BYTE_WITH_PARITY_BITS == 0);
+        const size_t size_bytes = size_bits / BIT_BUFFER_BYTE_WITH_PARITY_BITS;
+        furi_check(buf->capacity_bytes >= size_bytes);
+
+        // Bits are shifted in through a word, so every source byte is loaded once
+        uint32_t bits = 0;
+        size_t bits_count = 0;
+        uint8_t parity = 0;
+
+        for(size_t i = 0; i < size_bytes; i++) {
+            while(bits_count < BIT_BUFFER_BYTE_WITH_PARITY_BITS) {
+                bits |= (uint32_t)(*data++) << bits_count;
+                bits_count += BITS_IN_BYTE;
+            }
+
+            buf->data[i] = bits;
+            parity |= FURI_BIT(bits, BITS_IN_BYTE) << (i % BITS_IN_BYTE);
+            if((i % BITS_IN_BYTE) == BITS_IN_BYTE - 1) {
+                buf->parity[i / BITS_IN_BYTE] = parity;
+                parity = 0;
             }
-            bits_processed += BITS_IN_BYTE + 1;
-            curr_byte++;
+
+            bits >>= BIT_BUFFER_BYTE_WITH_PARITY_BITS;
+            bits_count -= BIT_BUFFER_BYTE_WITH_PARITY_BITS;
         }
-        buf->size_bits = curr_byte * BITS_IN_BYTE;
+
+        if(size_bytes % BITS_IN_BYTE) buf->parity[size_bytes / BITS_IN_BYTE] = parity;
+        buf->size_bits = size_bytes * BITS_IN_BYTE;
     }
 }
 
@@ -144,32 +153,28 @@ void bit_buffer_write_bytes_with_parity(
 
     size_t buf_size_bytes = bit_buffer_get_size_bytes(buf);
     size_t buf_size_with_parity_bytes =
-        (buf_size_bytes * (BITS_IN_BYTE + 1) + BITS_IN_BYTE) / BITS_IN_BYTE;
+        (buf_size_bytes * BIT_BUFFER_BYTE_WITH_PARITY_BITS + BITS_IN_BYTE) / BITS_IN_BYTE;
     furi_check(buf_size_with_parity_bytes <= size_bytes);
 
-    uint8_t next_par_bit = 0;
-    uint16_t curr_bit_pos = 0;
+    // Byte and parity bit are shifted in together, whole bytes are shifted out
+    uint32_t bits = 0;
+    size_t bits_count = 0;
     uint8_t* bitstream = dest;
 
     for(size_t i = 0; i < buf_size_bytes; i++) {
-        next_par_bit = FURI_BIT(buf->parity[i / BITS_IN_BYTE], i % BITS_IN_BYTE);
-        if(curr_bit_pos % BITS_IN_BYTE == 0) {
-            bitstream[curr_bit_pos / BITS_IN_BYTE] = buf->data[i];
-            curr_bit_pos += BITS_IN_BYTE;
-            bitstream[curr_bit_pos / BITS_IN_BYTE] = next_par_bit;
-            curr_bit_pos++;
-        } else {
-            bitstream[curr_bit_pos / BITS_IN_BYTE] |= buf->data[i]
-                                                      << (curr_bit_pos % BITS_IN_BYTE);
-            bitstream[curr_bit_pos / BITS_IN_BYTE + 1] =
-                buf->data[i] >> (BITS_IN_BYTE - curr_bit_pos % BITS_IN_BYTE);
-            bitstream[curr_bit_pos / BITS_IN_BYTE + 1] |= next_par_bit
-                                                          << (curr_bit_pos % BITS_IN_BYTE);
-            curr_bit_pos += BITS_IN_BYTE + 1;
+        uint32_t parity_bit = FURI_BIT(buf->parity[i / BITS_IN_BYTE], i % BITS_IN_BYTE);
+        bits |= (buf->data[i] | parity_bit << BITS_IN_BYTE) << bits_count;
+        bits_count += BIT_BUFFER_BYTE_WITH_PARITY_BITS;
+
+        while(bits_count >= BITS_IN_BYTE) {
+            *bitstream++ = bits;
+            bits >>= BITS_IN_BYTE;
+            bits_count -= BITS_IN_BYTE;
         }
     }
 
-    *bits_written = curr_bit_pos;
+    if(bits_count) *bitstream = bits;
+    *bits_written = buf_size_bytes * BIT_BUFFER_BYTE_WITH_PARITY_BITS;
 }
 
 void bit_buffer_write_bytes_mid(
@@ -0,0 +1,99 @@
+/**
+ * @file crc.h
+ * @brief CRC calculation for the protocols used across the firmware.
+ *
+ * Software backend is table driven, NFC frame CRCs are processed four bytes per
+ * step.
+ * Hardware backend runs on the MCU CRC unit and falls back to software when the
+ * unit is not available. Both produce the same results. It takes a mutex, so it
+ * needs a running kernel and an initialized HAL. crc32_calc_buffer() and
+ * crc32_calc_file() stay on software, the boot time updater calls them first.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    CrcAlgorithmIso14443A, /**< ISO14443-3A, CRC_A */
+    CrcAlgorithmIso14443B, /**< ISO14443-3B CRC_B, also ISO13239 (CRC-16/X-25) */
+    CrcAlgorithmPicopass, /**< ISO13239 polynomial with Picopass initial value */
+    CrcAlgorithmFelica, /**< FeliCa, CRC-16/XMODEM */
+    CrcAlgorithmCrc32, /**< CRC-32 as in zlib */
+
+    CrcAlgorithmNum,
+} CrcAlgorithm;
+
+typedef enum {
+    CrcBackendSoftware,
+    CrcBackendHardware,
+} CrcBackend;
+
+/**
+ * @brief Streaming CRC calculation context.
+ *
+ * Plain structure, may live on stack. Fields are private.
+ */
+typedef struct {
+    CrcAlgorithm algorithm;
+    CrcBackend backend;
+    uint32_t value;
+} CrcContext;
+
+/**
+ * @brief Start a new CRC calculation.
+ *
+ * @param[out] context pointer to the context to be initialized.
+ * @param[in] algorithm CRC algorithm.
+ * @param[in] backend backend to run the calculation on.
+ */
+void crc_init(CrcContext* context, CrcAlgorithm algorithm, CrcBackend backend);
+
+/**
+ * @brief Continue a CRC calculation from a previously finished CRC.
+ *
+ * Feeding more data after resume gives the CRC of the concatenated data.
+ *
+ * @param[out] context pointer to the context to be initialized.
+ * @param[in] algorithm CRC algorithm.
+ * @param[in] backend backend to run the calculation on.
+ * @param[in] crc CRC of the data fed so far, as returned by crc_finish().
+ */
+void crc_resume(CrcContext* context, CrcAlgorithm algorithm, CrcBackend backend, uint32_t crc);
+
+/**
+ * @brief Feed data into a CRC calculation.
+ *
+ * @param[in,out] context pointer to the context.
+ * @param[in] data pointer to the data.
+ * @param[in] size data size in bytes.
+ */
+void crc_update(CrcContext* context, const void* data, size_t size);
+
+/**
+ * @brief Get CRC of all the data fed so far.
+ *
+ * The context is not modified and may be fed further.
+ *
+ * @param[in] context pointer to the context.
+ * @returns CRC value.
+ */
+uint32_t crc_finish(const CrcContext* context);
+
+/**
+ * @brief Calculate CRC of a buffer with the software backend.
+ *
+ * @param[in] algorithm CRC algorithm.
+ * @param[in] data pointer to the data.
+ * @param[in] size data size in bytes.
+ * @returns CRC value.
+ */
+uint32_t crc_calculate(CrcAlgorithm algorithm, const void* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
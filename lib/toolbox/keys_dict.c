@@ -8,11 +8,36 @@
 
 #define TAG "KeysDict"
 
+#define KEYS_DICT_COMPILED_EXTENSION  ".kdc"
+#define KEYS_DICT_COMPILED_MAGIC      0x4344424B // "KBDC"
+#define KEYS_DICT_COMPILED_VERSION    1
+#define KEYS_DICT_COMPILED_BLOCK_KEYS 32
+
+// Compiled dictionary: header, keys in source order, then the same keys sorted
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t key_size;
+    uint16_t reserved;
+    uint32_t source_size;
+    uint32_t source_timestamp;
+    uint32_t key_count;
+} KeysDictCompiledHeader;
+
 struct KeysDict {
     Stream* stream;
     size_t key_size;
     size_t key_size_symbols;
     size_t total_keys;
+
+    Storage* storage;
+    FuriString* compiled_path;
+    // Keys are read from the compiled file while it is open
+    File* compiled;
+    size_t position;
+    uint8_t* block;
+    size_t block_start;
+    size_t block_count;
 };
 
 static inline void keys_dict_add_ending_new_line(KeysDict* instance) {
@@ -52,6 +77,217 @@ static bool keys_dict_read_key_line(KeysDict* instance, FuriString* line, bool*
     return false;
 }
 
+static bool keys_dict_get_source_info(
+    KeysDict* instance,
+    const char* path,
+    uint32_t* size,
+    uint32_t* timestamp) {
+    // Pending writes, such as the added line ending, must reach the file first
+    if(!buffered_file_stream_sync(instance->stream)) return false;
+    if(storage_common_timestamp(instance->storage, path, timestamp) != FSE_OK) return false;
+    *size = stream_size(instance->stream);
+
+    return true;
+}
+
+static bool keys_dict_compiled_open(KeysDict* instance, uint32_t size, uint32_t timestamp) {
+    File* file = storage_file_alloc(instance->storage);
+    KeysDictCompiledHeader header;
+    bool result = false;
+
+    do {
+        const char* path = furi_string_get_cstr(instance->compiled_path);
+        if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        if(storage_file_read(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(header.magic != KEYS_DICT_COMPILED_MAGIC ||
+           header.version != KEYS_DICT_COMPILED_VERSION ||
+           header.key_size != instance->key_size) {
+            FURI_LOG_W(TAG, "Compiled dictionary format mismatch");
+            break;
+        }
+        // Edits through KeysDict remove the copy. Other edits are caught by size and
+        // timestamp, FAT keeps time in 2 second steps and a same size edit within one
+        // step is missed.
+        if(header.source_size != size || header.source_timestamp != timestamp) {
+            FURI_LOG_I(TAG, "Compiled dictionary is outdated");
+            break;
+        }
+        if(storage_file_size(file) !=
+           sizeof(header) + (uint64_t)header.key_count * instance->key_size * 2) {
+            FURI_LOG_E(TAG, "Compiled dictionary is damaged");
+            break;
+        }
+
+        instance->compiled = file;
+        instance->total_keys = header.key_count;
+        instance->position = 0;
+        instance->block = malloc(KEYS_DICT_COMPILED_BLOCK_KEYS * instance->key_size);
+        instance->block_start = 0;
+        instance->block_count = 0;
+        result = true;
+    } while(false);
+
+    if(!result) storage_file_free(file);
+
+    return result;
+}
+
+static void keys_dict_compiled_close(KeysDict* instance) {
+    if(!instance->compiled) return;
+
+    storage_file_free(instance->compiled);
+    instance->compiled = NULL;
+    free(instance->block);
+    instance->block = NULL;
+}
+
+static void keys_dict_sort(uint8_t* keys, size_t count, size_t key_size) {
+    // Shell sort, no recursion and no comparator context needed
+    static const size_t gaps[] = {701, 301, 132, 57, 23, 10, 4, 1};
+    uint8_t* tmp = malloc(key_size);
+
+    for(size_t g = 0; g < COUNT_OF(gaps); g++) {
+        size_t gap = gaps[g];
+        for(size_t i = gap; i < count; i++) {
+            memcpy(tmp, &keys[i * key_size], key_size);
+            size_t j = i;
+            while(j >= gap && memcmp(&keys[(j - gap) * key_size], tmp, key_size) > 0) {
+                memcpy(&keys[j * key_size], &keys[(j - gap) * key_size], key_size);
+                j -= gap;
+            }
+            memcpy(&keys[j * key_size], tmp, key_size);
+        }
+    }
+
+    free(tmp);
+}
+
+static bool keys_dict_get_next_key_text(KeysDict* instance, uint8_t* key);
+
+static bool keys_dict_compiled_build(KeysDict* instance, uint32_t size, uint32_t timestamp) {
+    size_t keys_size = instance->total_keys * instance->key_size;
+    // Source order and sorted copy are built in memory, skip dictionaries that do not fit
+    if(keys_size * 2 > memmgr_heap_get_max_free_block() / 2) {
+        FURI_LOG_W(TAG, "Dictionary is too large to compile");
+        return false;
+    }
+
+    uint8_t* keys = malloc(keys_size * 2);
+    File* file = storage_file_alloc(instance->storage);
+    bool result = false;
+
+    do {
+        size_t count = 0;
+        stream_rewind(instance->stream);
+        while(count < instance->total_keys &&
+              keys_dict_get_next_key_text(instance, &keys[count * instance->key_size])) {
+            count++;
+        }
+        stream_rewind(instance->stream);
+        if(count != instance->total_keys) break;
+
+        memcpy(&keys[keys_size], keys, keys_size);
+        keys_dict_sort(&keys[keys_size], count, instance->key_size);
+
+        KeysDictCompiledHeader header = {
+            .magic = KEYS_DICT_COMPILED_MAGIC,
+            .version = KEYS_DICT_COMPILED_VERSION,
+            .key_size = instance->key_size,
+            .source_size = size,
+            .source_timestamp = timestamp,
+            .key_count = count,
+        };
+        const char* path = furi_string_get_cstr(instance->compiled_path);
+        if(!storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+        if(storage_file_write(file, &header, sizeof(header)) != sizeof(header)) break;
+        if(storage_file_write(file, keys, keys_size * 2) != keys_size * 2) break;
+
+        FURI_LOG_I(TAG, "Compiled dictionary with %zu keys", count);
+        result = true;
+    } while(false);
+
+    storage_file_free(file);
+    free(keys);
+
+    if(!result) {
+        FURI_LOG_E(TAG, "Unable to compile dictionary");
+        storage_common_remove(instance->storage, furi_string_get_cstr(instance->compiled_path));
+    }
+
+    return result;
+}
+
+// Continue from the text file, the compiled file will not match the modified source
+static void keys_dict_compiled_drop(KeysDict* instance, bool keep_position) {
+    size_t position = instance->position;
+
+    keys_dict_compiled_close(instance);
+    storage_common_remove(instance->storage, furi_string_get_cstr(instance->compiled_path));
+
+    stream_rewind(instance->stream);
+    if(keep_position) {
+        uint8_t* key = malloc(instance->key_size);
+        while(position-- && keys_dict_get_next_key_text(instance, key))
+            ;
+        free(key);
+    }
+}
+
+static bool keys_dict_compiled_get_next_key(KeysDict* instance, uint8_t* key) {
+    if(instance->position >= instance->total_keys) return false;
+
+    size_t key_size = instance->key_size;
+    if(instance->position < instance->block_start ||
+       instance->position >= instance->block_start + instance->block_count) {
+        size_t count =
+            MIN((size_t)KEYS_DICT_COMPILED_BLOCK_KEYS, instance->total_keys - instance->position);
+        uint32_t offset = sizeof(KeysDictCompiledHeader) + instance->position * key_size;
+        instance->block_count = 0;
+        if(!storage_file_seek(instance->compiled, offset, true)) return false;
+        if(storage_file_read(instance->compiled, instance->block, count * key_size) !=
+           count * key_size) {
+            return false;
+        }
+        instance->block_start = instance->position;
+        instance->block_count = count;
+    }
+
+    size_t index = instance->position - instance->block_start;
+    memcpy(key, &instance->block[index * key_size], key_size);
+    instance->position++;
+
+    return true;
+}
+
+static bool keys_dict_compiled_is_key_present(KeysDict* instance, const uint8_t* key) {
+    size_t key_size = instance->key_size;
+    uint32_t sorted = sizeof(KeysDictCompiledHeader) + instance->total_keys * key_size;
+    uint8_t* probe = malloc(key_size);
+    size_t low = 0;
+    size_t high = instance->total_keys;
+    bool key_found = false;
+
+    while(low < high) {
+        size_t mid = low + (high - low) / 2;
+        if(!storage_file_seek(instance->compiled, sorted + mid * key_size, true) ||
+           storage_file_read(instance->compiled, probe, key_size) != key_size) {
+            break;
+        }
+        int cmp = memcmp(probe, key, key_size);
+        if(cmp == 0) {
+            key_found = true;
+            break;
+        } else if(cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    free(probe);
+    return key_found;
+}
+
 bool keys_dict_check_presence(const char* path) {
     furi_check(path);
 
@@ -71,7 +307,9 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
     KeysDict* instance = malloc(sizeof(KeysDict));
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
+    instance->storage = storage;
     instance->stream = buffered_file_stream_alloc(storage);
+    instance->compiled_path = furi_string_alloc_printf("%s%s", path, KEYS_DICT_COMPILED_EXTENSION);
 
     FS_OpenMode open_mode = (mode == KeysDictModeOpenAlways) ? FSOM_OPEN_ALWAYS :
                                                                FSOM_OPEN_EXISTING;
@@ -92,6 +330,16 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
         keys_dict_add_ending_new_line(instance);
     }
 
+    uint32_t source_size = 0;
+    uint32_t source_timestamp = 0;
+    bool has_source_info =
+        file_exists && keys_dict_get_source_info(instance, path, &source_size, &source_timestamp);
+
+    if(has_source_info && keys_dict_compiled_open(instance, source_size, source_timestamp)) {
+        FURI_LOG_I(TAG, "Loaded compiled dictionary with %zu keys", instance->total_keys);
+        return instance;
+    }
+
     FuriString* line = furi_string_alloc();
 
     bool is_endfile = false;
@@ -109,6 +357,12 @@ KeysDict* keys_dict_alloc(const char* path, KeysDictMode mode, size_t key_size)
 
     furi_string_free(line);
 
+    // Next opens read the binary copy instead of parsing text
+    if(has_source_info && instance->total_keys > 0 &&
+       keys_dict_compiled_build(instance, source_size, source_timestamp)) {
+        keys_dict_compiled_open(instance, source_size, source_timestamp);
+    }
+
     return instance;
 }
 
@@ -116,8 +370,10 @@ void keys_dict_free(KeysDict* instance) {
     furi_check(instance);
     furi_check(instance->stream);
 
+    keys_dict_compiled_close(instance);
     buffered_file_stream_close(instance->stream);
     stream_free(instance->stream);
+    furi_string_free(instance->compiled_path);
     free(instance);
 
     furi_record_close(RECORD_STORAGE);
@@ -163,6 +419,11 @@ bool keys_dict_rewind(KeysDict* instance) {
     furi_check(instance);
     furi_check(instance->stream);
 
+    if(instance->compiled) {
+        instance->position = 0;
+        return true;
+    }
+
     return stream_rewind(instance->stream);
 }
 
@@ -182,18 +443,13 @@ static bool keys_dict_get_next_key_str(KeysDict* instance, FuriString* key) {
     return key_read;
 }
 
-bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
-    furi_check(instance);
-    furi_check(instance->stream);
-    furi_check(instance->key_size == key_size);
-    furi_check(key);
-
+static bool keys_dict_get_next_key_text(KeysDict* instance, uint8_t* key) {
     FuriString* temp_key = furi_string_alloc();
 
     bool key_read = keys_dict_get_next_key_str(instance, temp_key);
 
     if(key_read) {
-        size_t tmp_len = key_size;
+        size_t tmp_len = instance->key_size;
         uint64_t key_int = 0;
 
         keys_dict_str_to_int(instance, temp_key, &key_int);
@@ -208,6 +464,45 @@ bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
     return key_read;
 }
 
+bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size) {
+    furi_check(instance);
+    furi_check(instance->stream);
+    furi_check(instance->key_size == key_size);
+    furi_check(key);
+
+    if(instance->compiled) {
+        return keys_dict_compiled_get_next_key(instance, key);
+    }
+
+    return keys_dict_get_next_key_text(instance, key);
+}
+
+size_t keys_dict_get_next_keys(KeysDict* instance, uint8_t* keys, size_t key_size, size_t count) {
+    furi_check(instance);
+    furi_check(instance->stream);
+    furi_check(instance->key_size == key_size);
+    furi_check(keys);
+
+    size_t read = 0;
+
+    if(instance->compiled) {
+        // Straight into the caller buffer, the block cache stays valid
+        count = MIN(count, instance->total_keys - MIN(instance->position, instance->total_keys));
+        uint32_t offset = sizeof(KeysDictCompiledHeader) + instance->position * key_size;
+        if(count && storage_file_seek(instance->compiled, offset, true) &&
+           storage_file_read(instance->compiled, keys, count * key_size) == count * key_size) {
+            instance->position += count;
+            read = count;
+        }
+    } else {
+        while(read < count && keys_dict_get_next_key_text(instance, &keys[read * key_size])) {
+            read++;
+        }
+    }
+
+    return read;
+}
+
 static bool keys_dict_is_key_present_str(KeysDict* instance, FuriString* key) {
     furi_assert(instance);
     furi_assert(instance->stream);
@@ -240,6 +535,10 @@ bool keys_dict_is_key_present(KeysDict* instance, const uint8_t* key, size_t key
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    if(instance->compiled) {
+        return keys_dict_compiled_is_key_present(instance, key);
+    }
+
     FuriString* temp_key = furi_string_alloc();
 
     keys_dict_int_to_str(instance, key, temp_key);
@@ -277,6 +576,8 @@ bool keys_dict_add_key(KeysDict* instance, const uint8_t* key, size_t key_size)
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    if(instance->compiled) keys_dict_compiled_drop(instance, true);
+
     FuriString* temp_key = furi_string_alloc();
 
     keys_dict_int_to_str(instance, key, temp_key);
@@ -295,6 +596,8 @@ bool keys_dict_delete_key(KeysDict* instance, const uint8_t* key, size_t key_siz
     furi_check(instance->key_size == key_size);
     furi_check(key);
 
+    if(instance->compiled) keys_dict_compiled_drop(instance, false);
+
     bool key_removed = false;
 
     uint8_t* temp_key = malloc(key_size);
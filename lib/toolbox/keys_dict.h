@@ -25,6 +25,8 @@ bool keys_dict_check_presence(const char* path);
 
 /** Open or create list
  * Depending on mode, list will be opened or created.
+ * A binary copy of the list with a sorted key index is kept next to the file
+ * and rebuilt whenever the file changes, it is used for reading and lookups.
  *
  * @param path      - Path of the file that contain the list
  * @param mode      - ListKeysMode value
@@ -78,6 +80,19 @@ bool keys_dict_is_key_present(KeysDict* instance, const uint8_t* key, size_t key
 */
 bool keys_dict_get_next_key(KeysDict* instance, uint8_t* key, size_t key_size);
 
+/** Get next keys from the list in one call
+ * Reads up to count keys into a caller buffer, dictionaries compiled to the
+ * binary format are copied without parsing.
+ *
+ * @param instance  - KeysDict list instance
+ * @param keys      - Array of count keys where to store keys
+ * @param key_size  - Size of one key in bytes
+ * @param count     - Maximum number of keys to read
+ *
+ * @return Returns number of keys read, 0 when there are no more keys
+*/
+size_t keys_dict_get_next_keys(KeysDict* instance, uint8_t* keys, size_t key_size, size_t count);
+
 /** Add key to list
  *
  * @param instance  - KeysDict list instance
@@ -21,6 +21,10 @@ typedef bool (*ProtocolWriteData)(void* protocol, void* data);
 typedef struct {
     ProtocolDecoderStart start;
     ProtocolDecoderFeed feed;
+    // Window of durations the decoder acts upon, duration_max of 0 means any duration.
+    // Protocol dict parks decoders that keep getting durations outside of the window.
+    uint32_t duration_min;
+    uint32_t duration_max;
 } ProtocolDecoder;
 
 typedef struct {
@@ -1,9 +1,26 @@
 #include <furi.h>
 #include "protocol_dict.h"
 
+// Consecutive in-window durations after which a decoder is considered locked
+#define PROTOCOL_DICT_LOCK_HITS (16U)
+// Consecutive out-of-window durations after which a decoder is parked
+#define PROTOCOL_DICT_MISS_MAX        (8U)
+#define PROTOCOL_DICT_LOCKED_MISS_MAX (32U)
+// Parked decoders are restarted and fed again at least this often
+#define PROTOCOL_DICT_READMIT_EDGES (256U)
+
+typedef struct {
+    bool active;
+    uint8_t hits;
+    uint8_t misses;
+    ProtocolDictDecoderStats stats;
+} ProtocolDictDecoderState;
+
 struct ProtocolDict {
     const ProtocolBase** base;
     size_t count;
+    ProtocolDictDecoderState* decoders;
+    uint32_t edge_count;
     void* data[];
 };
 
@@ -13,9 +30,11 @@ ProtocolDict* protocol_dict_alloc(const ProtocolBase** protocols, size_t count)
     ProtocolDict* dict = malloc(sizeof(ProtocolDict) + (sizeof(void*) * count));
     dict->base = protocols;
     dict->count = count;
+    dict->decoders = malloc(sizeof(ProtocolDictDecoderState) * count);
 
     for(size_t i = 0; i < dict->count; i++) {
         dict->data[i] = dict->base[i]->alloc();
+        dict->decoders[i].active = true;
     }
 
     return dict;
@@ -28,6 +47,7 @@ void protocol_dict_free(ProtocolDict* dict) {
         dict->base[i]->free(dict->data[i]);
     }
 
+    free(dict->decoders);
     free(dict);
 }
 
@@ -87,6 +107,13 @@ const char* protocol_dict_get_manufacturer(ProtocolDict* dict, size_t protocol_i
     return dict->base[protocol_index]->manufacturer;
 }
 
+static void protocol_dict_decoder_admit(ProtocolDict* dict, size_t protocol_index) {
+    ProtocolDictDecoderState* state = &dict->decoders[protocol_index];
+    state->active = true;
+    state->hits = 0;
+    state->misses = 0;
+}
+
 void protocol_dict_decoders_start(ProtocolDict* dict) {
     furi_check(dict);
 
@@ -96,7 +123,11 @@ void protocol_dict_decoders_start(ProtocolDict* dict) {
         if(fn) {
             fn(dict->data[i]);
         }
+
+        protocol_dict_decoder_admit(dict, i);
     }
+
+    dict->edge_count = 0;
 }
 
 uint32_t protocol_dict_get_features(ProtocolDict* dict, size_t protocol_index) {
@@ -104,17 +135,77 @@ uint32_t protocol_dict_get_features(ProtocolDict* dict, size_t protocol_index) {
     return dict->base[protocol_index]->features;
 }
 
-ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t duration) {
-    furi_check(dict);
+// Track whether the decoder still sees its carrier pattern, returns false if it is parked
+static bool protocol_dict_decoder_schedule(
+    ProtocolDict* dict,
+    size_t protocol_index,
+    uint32_t duration,
+    bool readmit) {
+    const ProtocolDecoder* decoder = &dict->base[protocol_index]->decoder;
+    ProtocolDictDecoderState* state = &dict->decoders[protocol_index];
+
+    const bool in_window =
+        decoder->duration_max == 0 ||
+        (duration >= decoder->duration_min && duration <= decoder->duration_max);
+
+    if(!state->active) {
+        if(!in_window && !readmit) return false;
+
+        // Edges were skipped while parked, decoder state is stale
+        if(decoder->start) {
+            decoder->start(dict->data[protocol_index]);
+        }
+        protocol_dict_decoder_admit(dict, protocol_index);
+    }
+
+    if(in_window) {
+        state->misses = 0;
+        if(state->hits < PROTOCOL_DICT_LOCK_HITS) state->hits++;
+    } else {
+        const bool locked = state->hits >= PROTOCOL_DICT_LOCK_HITS;
+        const uint8_t misses_max = locked ? PROTOCOL_DICT_LOCKED_MISS_MAX : PROTOCOL_DICT_MISS_MAX;
+        if(++state->misses > misses_max) {
+            state->active = false;
+            state->stats.park_count++;
+            return false;
+        }
+    }
+
+    return true;
+}
 
+static bool protocol_dict_decoder_feed(
+    ProtocolDict* dict,
+    size_t protocol_index,
+    bool level,
+    uint32_t duration) {
+    ProtocolDictDecoderStats* stats = &dict->decoders[protocol_index].stats;
+
+    const uint32_t cycles = DWT->CYCCNT;
+    const bool done =
+        dict->base[protocol_index]->decoder.feed(dict->data[protocol_index], level, duration);
+    stats->feed_cycles += DWT->CYCCNT - cycles;
+    stats->feed_count++;
+
+    return done;
+}
+
+static ProtocolId protocol_dict_decoders_feed_internal(
+    ProtocolDict* dict,
+    const uint32_t* feature,
+    bool level,
+    uint32_t duration) {
     bool done = false;
     ProtocolId ready_protocol_id = PROTOCOL_NO;
+    const bool readmit = (++dict->edge_count % PROTOCOL_DICT_READMIT_EDGES) == 0;
 
     for(size_t i = 0; i < dict->count; i++) {
+        if(feature && !(dict->base[i]->features & *feature)) continue;
+
         ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
 
-        if(fn) {
-            if(fn(dict->data[i], level, duration)) {
+        if(fn && protocol_dict_decoder_schedule(dict, i, duration, readmit)) {
+            if(protocol_dict_decoder_feed(dict, i, level, duration)) {
                 if(!done) {
                     ready_protocol_id = i;
                     done = true;
@@ -126,33 +217,18 @@ ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t
     return ready_protocol_id;
 }
 
+ProtocolId protocol_dict_decoders_feed(ProtocolDict* dict, bool level, uint32_t duration) {
+    furi_check(dict);
+    return protocol_dict_decoders_feed_internal(dict, NULL, level, duration);
+}
+
 ProtocolId protocol_dict_decoders_feed_by_feature(
     ProtocolDict* dict,
     uint32_t feature,
     bool level,
     uint32_t duration) {
     furi_check(dict);
-
-    bool done = false;
-    ProtocolId ready_protocol_id = PROTOCOL_NO;
-
-    for(size_t i = 0; i < dict->count; i++) {
-        uint32_t features = dict->base[i]->features;
-        if(features & feature) {
-            ProtocolDecoderFeed fn = dict->base[i]->decoder.feed;
-
-            if(fn) {
-                if(fn(dict->data[i], level, duration)) {
-                    if(!done) {
-                        ready_protocol_id = i;
-                        done = true;
-                    }
-                }
-            }
-        }
-    }
-
-    return ready_protocol_id;
+    return protocol_dict_decoders_feed_internal(dict, &feature, level, duration);
 }
 
 ProtocolId protocol_dict_decoders_feed_by_id(
@@ -166,7 +242,7 @@ ProtocolId protocol_dict_decoders_feed_by_id(
     ProtocolDecoderFeed fn = dict->base[protocol_index]->decoder.feed;
 
     if(fn) {
-        if(fn(dict->data[protocol_index], level, duration)) {
+        if(protocol_dict_decoder_feed(dict, protocol_index, level, duration)) {
             ready_protocol_id = protocol_index;
         }
     }
@@ -174,6 +250,24 @@ ProtocolId protocol_dict_decoders_feed_by_id(
     return ready_protocol_id;
 }
 
+void protocol_dict_get_decoder_stats(
+    ProtocolDict* dict,
+    size_t protocol_index,
+    ProtocolDictDecoderStats* stats) {
+    furi_check(protocol_index < dict->count);
+    furi_check(stats);
+
+    *stats = dict->decoders[protocol_index].stats;
+}
+
+void protocol_dict_reset_decoder_stats(ProtocolDict* dict) {
+    furi_check(dict);
+
+    for(size_t i = 0; i < dict->count; i++) {
+        memset(&dict->decoders[i].stats, 0, sizeof(ProtocolDictDecoderStats));
+    }
+}
+
 bool protocol_dict_encoder_start(ProtocolDict* dict, size_t protocol_index) {
     furi_check(protocol_index < dict->count);
     ProtocolEncoderStart fn = dict->base[protocol_index]->encoder.start;
@@ -12,6 +12,12 @@ typedef int32_t ProtocolId;
 #define PROTOCOL_NO           (-1)
 #define PROTOCOL_ALL_FEATURES (0xFFFFFFFF)
 
+typedef struct {
+    uint32_t feed_count; // Durations fed into the decoder
+    uint32_t park_count; // Times the decoder lost its pattern and was parked
+    uint64_t feed_cycles; // CPU cycles spent in the decoder
+} ProtocolDictDecoderStats;
+
 ProtocolDict* protocol_dict_alloc(const ProtocolBase** protocols, size_t protocol_count);
 
 void protocol_dict_free(ProtocolDict* dict);
@@ -70,6 +76,13 @@ ProtocolId protocol_dict_get_protocol_by_name(ProtocolDict* dict, const char* na
 
 bool protocol_dict_get_write_data(ProtocolDict* dict, size_t protocol_index, void* data);
 
+void protocol_dict_get_decoder_stats(
+    ProtocolDict* dict,
+    size_t protocol_index,
+    ProtocolDictDecoderStats* stats);
+
+void protocol_dict_reset_decoder_stats(ProtocolDict* dict);
+
 #ifdef __cplusplus
 }
 #endif
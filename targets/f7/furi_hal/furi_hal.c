@@ -60,6 +60,7 @@ void furi_hal_init(void) {
     furi_hal_power_init();
     furi_hal_light_init();
     furi_hal_bt_init();
+    furi_hal_crc_init();
     furi_hal_memory_init();
 
 #ifndef FURI_RAM_EXEC
@@ -15,6 +15,7 @@
 
 #include <furi_hal_version.h>
 #include <furi_hal_power.h>
+#include <furi_hal_crc.h>
 #include <furi_hal_bus.c>
 #include <services/battery_service.h>
 #include <furi.h>
@@ -228,7 +229,10 @@ void furi_hal_bt_reinit(void) {
     furi_hal_bus_disable(FuriHalBusIPCC);
     furi_hal_bus_disable(FuriHalBusAES2);
     furi_hal_bus_disable(FuriHalBusPKA);
+    // CRC users fall back to software until furi_hal_bt_init enables it again
+    furi_hal_crc_lock();
     furi_hal_bus_disable(FuriHalBusCRC);
+    furi_hal_crc_unlock();
 
     furi_hal_bt_init();
     furi_hal_bt_unlock_core2();
@@ -0,0 +1,91 @@
+#include <furi_hal_crc.h>
+#include <furi_hal_bus.h>
+#include <furi.h>
+
+#include <stm32wbxx_ll_crc.h>
+
+#define TAG "FuriHalCrc"
+
+typedef struct {
+    FuriMutex* mutex;
+    uint8_t width;
+    bool reflected;
+} FuriHalCrc;
+
+static FuriHalCrc furi_hal_crc = {
+    .mutex = NULL,
+};
+
+// Bring a value between algorithm bit order and unit bit order
+static inline uint32_t furi_hal_crc_reflect(uint32_t value, uint8_t width) {
+    return __RBIT(value) >> (32 - width);
+}
+
+void furi_hal_crc_init(void) {
+    furi_hal_crc.mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    FURI_LOG_I(TAG, "Init OK");
+}
+
+void furi_hal_crc_lock(void) {
+    furi_check(furi_hal_crc.mutex);
+    furi_check(furi_mutex_acquire(furi_hal_crc.mutex, FuriWaitForever) == FuriStatusOk);
+}
+
+void furi_hal_crc_unlock(void) {
+    furi_check(furi_mutex_release(furi_hal_crc.mutex) == FuriStatusOk);
+}
+
+bool furi_hal_crc_acquire(void) {
+    furi_hal_crc_lock();
+
+    // Unit clock is owned by the BT HAL and is off while core2 is restarted
+    if(!furi_hal_bus_is_enabled(FuriHalBusCRC)) {
+        furi_hal_crc_unlock();
+        return false;
+    }
+
+    return true;
+}
+
+void furi_hal_crc_release(void) {
+    furi_hal_crc_unlock();
+}
+
+void furi_hal_crc_configure(uint32_t polynomial, uint8_t width, bool reflected) {
+    furi_check(width == 16 || width == 32);
+
+    LL_CRC_SetPolynomialSize(CRC, width == 16 ? LL_CRC_POLYLENGTH_16B : LL_CRC_POLYLENGTH_32B);
+    LL_CRC_SetPolynomialCoef(CRC, polynomial);
+    LL_CRC_SetInputDataReverseMode(
+        CRC, reflected ? LL_CRC_INDATA_REVERSE_BYTE : LL_CRC_INDATA_REVERSE_NONE);
+    LL_CRC_SetOutputDataReverseMode(CRC, LL_CRC_OUTDATA_REVERSE_NONE);
+
+    furi_hal_crc.width = width;
+    furi_hal_crc.reflected = reflected;
+}
+
+uint32_t furi_hal_crc_feed(uint32_t crc, const uint8_t* data, size_t size) {
+    furi_check(data || size == 0);
+
+    const uint8_t width = furi_hal_crc.width;
+    const bool reflected = furi_hal_crc.reflected;
+
+    LL_CRC_SetInitialData(CRC, reflected ? furi_hal_crc_reflect(crc, width) : crc);
+    LL_CRC_ResetCRCCalculationUnit(CRC);
+
+    // Unit takes words most significant byte first
+    size_t i = 0;
+    for(; i + sizeof(uint32_t) <= size; i += sizeof(uint32_t)) {
+        uint32_t word;
+        memcpy(&word, &data[i], sizeof(uint32_t));
+        LL_CRC_FeedData32(CRC, __REV(word));
+    }
+    for(; i < size; i++) {
+        LL_CRC_FeedData8(CRC, data[i]);
+    }
+
+    uint32_t value = LL_CRC_ReadData32(CRC);
+    if(width == 16) value &= 0xFFFFU;
+
+    return reflected ? furi_hal_crc_reflect(value, width) : value;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file furi_hal_crc.h
+ *
+ * CRC calculation unit HAL API
+ *
+ * The CRC unit computes CRCs of width 16 or 32 for any polynomial. Feeding is
+ * stateless: every call starts from the register value passed by the caller,
+ * so several streams can be interleaved between acquire and release.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Initialize CRC HAL */
+void furi_hal_crc_init(void);
+
+/** Lock CRC unit against other users, regardless of its clock
+ *
+ * Used by the owner of the unit clock: the clock must only be disabled with
+ * the unit locked, so that no calculation is cut short.
+ */
+void furi_hal_crc_lock(void);
+
+/** Unlock CRC unit */
+void furi_hal_crc_unlock(void);
+
+/** Acquire CRC unit
+ *
+ * Blocks until other users release the unit.
+ *
+ * @return     true if the unit is clocked and ready, false otherwise (the unit
+ *             is released in this case)
+ */
+bool furi_hal_crc_acquire(void);
+
+/** Release CRC unit */
+void furi_hal_crc_release(void);
+
+/** Configure CRC unit, must be called with the unit acquired
+ *
+ * @param      polynomial  polynomial in normal (MSB first) form
+ * @param      width       CRC width in bits, 16 or 32
+ * @param      reflected   true for LSB first (reflected) algorithms
+ */
+void furi_hal_crc_configure(uint32_t polynomial, uint8_t width, bool reflected);
+
+/** Feed data into CRC unit, must be called with the unit acquired
+ *
+ * @param      crc   register value to continue from, in algorithm bit order
+ * @param      data  pointer to data
+ * @param      size  data size in bytes
+ *
+ * @return     register value after data, in algorithm bit order
+ */
+uint32_t furi_hal_crc_feed(uint32_t crc, const uint8_t* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif